@@ -94,6 +94,11 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Use a TLSF (two-level segregated fit) allocator with segregated free lists.
+ * The allocation and free take constant time regardless of the number of allocations
+ * and the adjacent free cells are always joined so `LV_MEM_AUTO_DEFRAG` is not used.*/
+#  define LV_MEM_TLSF         0
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
@@ -104,6 +109,12 @@ typedef int16_t lv_coord_t;
  * The standard functions might or might not be faster depending on their implementation. */
 #define LV_MEMCPY_MEMSET_STD    0
 
+/* Size of a static arena in bytes for the temporary draw buffers (`_lv_mem_buf_get`). 0: disable
+ * The buffers are taken by bumping a pointer and the arena is rewound when they are released
+ * and at the end of every refreshed area. If the arena is full the buffers are allocated from the heap.
+ * With `LV_USE_TILE_RENDER` every worker has its own arena. */
+#define LV_MEM_BUF_ARENA_SIZE   0
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -154,6 +165,11 @@ typedef int16_t lv_coord_t;
 /*Declare the type of the user data of animations (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_anim_user_data_t;
 
+/* 1: Run the animations from an array and calculate their values grouped by their path functions.
+ * The callbacks are called in the same order as without batching.
+ * The objects with style transitions are invalidated only once before refreshing the display*/
+#define LV_USE_ANIM_BATCH       0
+
 #endif
 
 /* 1: Enable shadow drawing on rectangles*/
@@ -162,9 +178,24 @@ typedef void * lv_anim_user_data_t;
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ * A cached shadow has shadow size^2 RAM cost*/
 #define LV_SHADOW_CACHE_SIZE    0
+#if LV_SHADOW_CACHE_SIZE
+/* The cached shadows are allocated with `lv_mem_alloc`.
+ * If any of these limits is reached the least recently used shadow is dropped.*/
+#  define LV_SHADOW_CACHE_ENTRY_CNT  4                                                   /*Max. number of cached shadows*/
+#  define LV_SHADOW_CACHE_MEM_SIZE   (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)  /*Max. memory used by the cache [bytes]*/
 #endif
+#endif
+
+/* Cache the anti-aliased quarter circles of the rounded corners (radius masks)
+ * and copy the rows of the corners from the cache instead of calculating them with square roots.
+ * LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE is the max. memory used by the cached circles in bytes.
+ * A circle with `radius` needs `radius * (radius + 4)` bytes.
+ * The circles are allocated with `lv_mem_alloc`.
+ * If the limit is reached the least recently used circle which is not drawn currently is dropped.
+ * 0: to disable caching*/
+#define LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE  0
 
 /*1: enable outline drawing on rectangles*/
 #define LV_USE_OUTLINE  1
@@ -178,12 +209,56 @@ typedef void * lv_anim_user_data_t;
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
+/* 1: Blend with SSE2/AVX2 or NEON instructions if the compiler targets them (e.g. `-msse2`, `-mavx2`, `-mfpu=neon`).
+ * Used with 32 bit and not swapped 16 bit color depth if `LV_COLOR_SCREEN_TRANSP == 0`.
+ * The result is the same as with the software blending.*/
+#define LV_USE_BLEND_SIMD       0
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #define LV_USE_OPA_SCALE        1
 
 /* 1: Use image zoom and rotation*/
 #define LV_USE_IMG_TRANSFORM    1
 
+/* 1: Keep the already resolved style properties of every part of the objects in a flat table.
+ * The properties are resolved on first use in the current state of the part
+ * and dropped by `lv_obj_refresh_style()` and `lv_obj_report_style_mod()`.
+ * It costs a table of ~50 bytes plus 4 or 8 bytes for every resolved property of a part.*/
+#define LV_USE_STYLE_FLAT_CACHE 0
+
+/* 1: Index the properties of the styles by their ID when a style is read first.
+ * It makes finding a property O(log n) and skipping a style without the property O(1).
+ * Adding or removing properties drops the index and it's built again on the next read.
+ * It costs ~32 bytes plus 2 bytes for every property of the styles which were read.*/
+#define LV_USE_STYLE_INDEX      0
+
+/* 1: Keep the tasks of every priority in a min-heap ordered by their next run.
+ * `lv_task_handler()` checks only the first task of the priorities to find the ready tasks
+ * and the time till the next run instead of walking all the tasks.
+ * The ready tasks of the same priority run in the order of their deadline.*/
+#define LV_USE_TASK_HEAP        0
+
+/* 1: Index the objects of the screens and layers in a grid to find the clicked object.
+ * The index is built again when the objects were created, deleted, moved or resized
+ * and no such change happened since the previous search.
+ * It costs ~1 kB per screen plus a pointer for every object and 2 bytes for every grid cell an object covers.*/
+#define LV_USE_INDEV_SEARCH_INDEX 0
+
+/* 1: Don't draw the objects which are fully hidden by opaque objects drawn later on the same area.
+ * The largest opaque objects are looked up once for every area to redraw.
+ * It costs an extra walk of the objects of the screen and a few cover checks for every area.*/
+#define LV_USE_REFR_OCCLUSION   0
+
+/* 1: Merge and split the invalidated areas by comparing the pixels to redraw with the overhead of an area.
+ * The areas inside an other area are dropped, overlapping areas are cut to their uncovered parts
+ * and areas are merged when the extra pixels of the merged area cost less than redrawing one more area.
+ * If the buffer of the areas is full the new area is merged into the area which grows least instead of
+ * redrawing the whole screen. `lv_refr_get_area_stat()` tells the redrawn and the really invalidated pixels.*/
+#define LV_USE_REFR_AREA_MERGE  0
+#if LV_USE_REFR_AREA_MERGE
+#  define LV_REFR_AREA_COST     1024    /*The overhead of redrawing one more area in pixels*/
+#endif
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
 #if LV_USE_GROUP
@@ -210,11 +285,35 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 /*1: Use VG-Lite for CPU offload on NXP RTxxx platforms */
 #define LV_USE_GPU_NXP_VG_LITE   0
 
+/* 1: Split the areas to redraw into horizontal tiles and render them on worker threads.
+ * The display driver's `render_tiles_cb` has to run `lv_refr_tile(i)` on worker `i` for every tile.
+ * The mask list and the temporary buffers are kept per worker.
+ * The heap, the image cache and the font bitmaps are shared so they are guarded by a recursive lock.*/
+#define LV_USE_TILE_RENDER      0
+#if LV_USE_TILE_RENDER
+#  define LV_TILE_RENDER_WORKER_NUM     4                    /*Max. number of tiles rendered at once*/
+#  define LV_TILE_RENDER_INCLUDE        <pthread.h>          /*Header for the thread related functions*/
+#  define LV_TILE_RENDER_WORKER_ID      (my_worker_id())     /*Expression evaluating to the calling worker's index (0: the `lv_task_handler` thread)*/
+#  define LV_TILE_RENDER_LOCK           (my_lock())          /*Expression locking a recursive mutex*/
+#  define LV_TILE_RENDER_UNLOCK         (my_unlock())        /*Expression unlocking the same mutex*/
+#endif
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_fs_drv_user_data_t;
+
+/*1: Register a driver using the POSIX `open`, `read`, etc. functions in `lv_init()`.
+ * Its files can be memory mapped so the images and fonts are used from the file without copying*/
+#define LV_USE_FS_POSIX         0
+#if LV_USE_FS_POSIX
+#  define LV_FS_POSIX_LETTER    'P'     /*The driver letter. E.g. "P:folder/img.bin"*/
+#  define LV_FS_POSIX_PATH      ""      /*Prefix of the paths. E.g. "/" for absolute paths or "/usr/share/app/"*/
+#endif
+
+/*1: Enable `lv_fs_pack_mount()` to serve the files of an archive created by `scripts/lv_pack.py`*/
+#define LV_USE_FS_PACK          0
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -223,6 +322,15 @@ typedef void * lv_fs_drv_user_data_t;
 /*1: Show CPU usage and FPS count in the right bottom corner*/
 #define LV_USE_PERF_MONITOR     0
 
+/*1: Record the time of the refresh phases, the design callbacks and `flush_cb` (see `lv_profiler.h`)*/
+#define LV_USE_PROFILER         0
+#if LV_USE_PROFILER
+#  define LV_PROFILER_TIME_INCLUDE  <stdint.h>               /*Header for the time function*/
+/*The default has only 1 ms resolution. Use a microsecond timer (e.g. a free-running hardware timer) if available.*/
+#  define LV_PROFILER_TIME_GET      (lv_tick_get() * 1000)   /*Expression evaluating to the current time in microseconds*/
+#  define LV_PROFILER_EVENT_CNT     1024                     /*Number of events in the ring buffer*/
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #define LV_USE_API_EXTENSION_V6  1
 #define LV_USE_API_EXTENSION_V7  1
@@ -245,6 +353,23 @@ typedef void * lv_fs_drv_user_data_t;
  * Set it to 0 to disable caching */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Max. memory used by the images decoded into the RAM by the cached decoders [bytes].
+ * If it's exceeded the images with the least life are closed. 0: no limit*/
+#define LV_IMG_CACHE_MEM_SIZE       0
+
+/* 1: Convert the cached `LV_IMG_CF_TRUE_COLOR_ALPHA` images to a color map with runs of
+ * transparent, opaque and semi-transparent pixels in every row.
+ * The opaque runs are copied and the transparent runs are skipped while drawing.
+ * It uses about `w * h * sizeof(lv_color_t)` bytes extra RAM per image. Requires `LV_IMG_CACHE_DEF_SIZE > 0`.
+ * The variables (`lv_img_dsc_t`) used directly are not converted as their pixels can be changed (e.g. by a canvas)*/
+#define LV_IMG_CACHE_RUNS           0
+
+/* Read this many bytes at once from the image files opened by the built-in decoder
+ * and take the next lines from this buffer while they are in it.
+ * So the images which can't be opened at once are read with one file access per block instead of per line.
+ * The buffer is allocated for every opened image file. 0: read the lines one by one*/
+#define LV_IMG_DECODER_READAHEAD_SIZE   0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -432,6 +557,17 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+/* Cache the rendered glyph bitmaps (e.g. the decompressed glyphs of compressed fonts).
+ * The bitmaps are allocated with `lv_mem_alloc` and
+ * the least recently used glyphs are dropped if the limit is reached.
+ * LV_FONT_GLYPH_CACHE_MEM_SIZE is the max. memory used by the cached glyphs in bytes.
+ * 0: disable caching */
+#define LV_FONT_GLYPH_CACHE_MEM_SIZE    0
+
+/* Number of glyph descriptors cached per font by the fonts loaded with `lv_font_load_lazy()`.
+ * Each uses ~12 bytes*/
+#define LV_FONT_LOADER_LAZY_DSC_CNT     64
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -648,6 +784,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Store the line breaks and line widths of the labels (8 bytes per line in the heap)
+ *to find the visible lines and letters without measuring the text again*/
+#  define LV_LABEL_LINE_CACHE             0
 #endif
 
 /*LED (dependencies: -)*/
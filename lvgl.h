@@ -26,6 +26,9 @@ extern "C" {
 #include "src/lv_misc/lv_task.h"
 #include "src/lv_misc/lv_math.h"
 #include "src/lv_misc/lv_async.h"
+#include "src/lv_misc/lv_profiler.h"
+#include "src/lv_misc/lv_fs_posix.h"
+#include "src/lv_misc/lv_fs_pack.h"
 
 #include "src/lv_hal/lv_hal.h"
 
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+
+'''
+Pack the files of a folder (e.g. `.bin` images and `.fnt` fonts) into a read only archive
+which can be mounted as a drive with `lv_fs_pack_mount()`.
+
+Layout of the archive (little endian):
+  header    "LVPK", version (u16), align (u16), entry_cnt, bucket_cnt, buckets_ofs, entries_ofs, names_ofs, reserved (u32)
+  buckets   bucket_cnt * u32: index + 1 of the first entry in the hash bucket (0: empty)
+  entries   entry_cnt * (hash, next, name_ofs (u32), name_len (u16), compression (u8), reserved (u8),
+                         data_ofs, size, raw_size (u32)). `next` is the index + 1 of the next entry in the bucket
+  names     the '\\0' terminated paths relative to the folder with '/' separators
+  data      the content of the files, every file aligned to `align` bytes
+
+The paths are hashed with 32 bit FNV-1a. The compressed entries use PackBits like RLE:
+a control byte `c` < 128 is followed by `c + 1` literal bytes, else the next byte is repeated `c - 125` times.
+'''
+
+import argparse
+import os
+import struct
+import sys
+
+if sys.version_info < (3,6,0):
+  print("Python >=3.6 is required", file=sys.stderr)
+  exit(1)
+
+HEADER_FMT = '<4sHHIIIIII'
+ENTRY_FMT = '<IIIHBBIII'
+VERSION = 1
+COMPR_NONE = 0
+COMPR_RLE = 1
+
+def fnv1a(data):
+  h = 2166136261
+  for b in data:
+    h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+  return h
+
+def rle_compress(data):
+  out = bytearray()
+  lit = bytearray()
+  i = 0
+  n = len(data)
+  while i < n:
+    run = 1
+    while i + run < n and run < 130 and data[i + run] == data[i]:
+      run += 1
+    if run >= 3:
+      while lit:
+        out.append(len(lit[:128]) - 1)
+        out += lit[:128]
+        lit = lit[128:]
+      out.append(run + 125)
+      out.append(data[i])
+      i += run
+    else:
+      lit.append(data[i])
+      i += 1
+  while lit:
+    out.append(len(lit[:128]) - 1)
+    out += lit[:128]
+    lit = lit[128:]
+  return bytes(out)
+
+def rle_decompress(data):
+  out = bytearray()
+  i = 0
+  while i < len(data):
+    c = data[i]
+    if c < 128:
+      out += data[i + 1:i + 2 + c]
+      i += 2 + c
+    else:
+      out += bytes([data[i + 1]]) * (c - 125)
+      i += 2
+  return bytes(out)
+
+def align_up(v, align):
+  return (v + align - 1) // align * align
+
+def collect(folder, exts):
+  files = []
+  for root, dirs, names in os.walk(folder):
+    dirs.sort()
+    for name in sorted(names):
+      if exts and os.path.splitext(name)[1].lower().lstrip('.') not in exts:
+        continue
+      path = os.path.join(root, name)
+      files.append((os.path.relpath(path, folder).replace(os.sep, '/'), path))
+  return files
+
+def pack(files, out_path, align, compress):
+  bucket_cnt = 1
+  while bucket_cnt < len(files):
+    bucket_cnt *= 2
+
+  buckets_ofs = struct.calcsize(HEADER_FMT)
+  entries_ofs = buckets_ofs + 4 * bucket_cnt
+  names_ofs = entries_ofs + struct.calcsize(ENTRY_FMT) * len(files)
+
+  names = bytearray()
+  name_ofs = []
+  for name, _ in files:
+    name_ofs.append(names_ofs + len(names))
+    names += name.encode('utf-8') + b'\0'
+
+  buckets = [0] * bucket_cnt
+  entries = []
+  data = bytearray()
+  data_ofs = align_up(names_ofs + len(names), align)
+  raw_total = 0
+  for i, (name, path) in enumerate(files):
+    name_b = name.encode('utf-8')
+    with open(path, 'rb') as f:
+      raw = f.read()
+    raw_total += len(raw)
+
+    compr = COMPR_NONE
+    stored = raw
+    if compress:
+      rle = rle_compress(raw)
+      # Keep the compressed data only if it's worth to decompress it on open
+      if len(rle) < len(raw) * 7 // 8:
+        assert rle_decompress(rle) == raw
+        compr = COMPR_RLE
+        stored = rle
+
+    ofs = align_up(data_ofs + len(data), align)
+    data += b'\0' * (ofs - data_ofs - len(data))
+    data += stored
+
+    h = fnv1a(name_b)
+    b = h & (bucket_cnt - 1)
+    entries.append([h, buckets[b], name_ofs[i], len(name_b), compr, 0, ofs, len(stored), len(raw)])
+    buckets[b] = i + 1
+
+  with open(out_path, 'wb') as f:
+    f.write(struct.pack(HEADER_FMT, b'LVPK', VERSION, align, len(files), bucket_cnt,
+                        buckets_ofs, entries_ofs, names_ofs, 0))
+    f.write(struct.pack('<%dI' % bucket_cnt, *buckets))
+    for e in entries:
+      f.write(struct.pack(ENTRY_FMT, *e))
+    f.write(names)
+    f.write(b'\0' * (data_ofs - names_ofs - len(names)))
+    f.write(data)
+    size = f.tell()
+
+  print("Packed %d files (%d bytes) into %s (%d bytes)" % (len(files), raw_total, out_path, size))
+
+def main():
+  parser = argparse.ArgumentParser(description='''Pack the files of a folder into an archive for `lv_fs_pack_mount()`.
+Example: python lv_pack.py assets -o assets.lvpk --compress''')
+  parser.add_argument('folder', help='The folder to pack. The paths in the archive are relative to it.')
+  parser.add_argument('-o', '--output', required=True, help='The archive to create')
+  parser.add_argument('--align', type=int, default=8,
+                      help='Align the files to this many bytes (power of 2, default 8). E.g. 4096 to page align them.')
+  parser.add_argument('--compress', action='store_true',
+                      help='RLE compress the files which get at least 1/8 smaller. They are decompressed into the RAM on open.')
+  parser.add_argument('--ext', nargs='*', default=[],
+                      help='Pack only the files with these extensions. E.g. --ext bin fnt')
+  args = parser.parse_args()
+
+  if args.align < 1 or args.align & (args.align - 1) or args.align > 0x8000:
+    print("--align should be a power of 2 up to 32768", file=sys.stderr)
+    exit(1)
+
+  files = collect(args.folder, [e.lower().lstrip('.') for e in args.ext])
+  pack(files, args.output, args.align, args.compress)
+
+if __name__ == '__main__':
+  main()
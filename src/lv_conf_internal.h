@@ -231,6 +231,17 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Use a TLSF (two-level segregated fit) allocator with segregated free lists.
+ * The allocation and free take constant time regardless of the number of allocations
+ * and the adjacent free cells are always joined so `LV_MEM_AUTO_DEFRAG` is not used.*/
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -265,6 +276,18 @@
 #  endif
 #endif
 
+/* Size of a static arena in bytes for the temporary draw buffers (`_lv_mem_buf_get`). 0: disable
+ * The buffers are taken by bumping a pointer and the arena is rewound when they are released
+ * and at the end of every refreshed area. If the arena is full the buffers are allocated from the heap.
+ * With `LV_USE_TILE_RENDER` every worker has its own arena. */
+#ifndef LV_MEM_BUF_ARENA_SIZE
+#  ifdef CONFIG_LV_MEM_BUF_ARENA_SIZE
+#    define LV_MEM_BUF_ARENA_SIZE CONFIG_LV_MEM_BUF_ARENA_SIZE
+#  else
+#    define  LV_MEM_BUF_ARENA_SIZE   0
+#  endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -386,6 +409,17 @@
 
 /*Declare the type of the user data of animations (can be e.g. `void *`, `int`, `struct`)*/
 
+/* 1: Run the animations from an array and calculate their values grouped by their path functions.
+ * The callbacks are called in the same order as without batching.
+ * The objects with style transitions are invalidated only once before refreshing the display*/
+#ifndef LV_USE_ANIM_BATCH
+#  ifdef CONFIG_LV_USE_ANIM_BATCH
+#    define LV_USE_ANIM_BATCH CONFIG_LV_USE_ANIM_BATCH
+#  else
+#    define  LV_USE_ANIM_BATCH       0
+#  endif
+#endif
+
 #endif
 
 /* 1: Enable shadow drawing on rectangles*/
@@ -400,7 +434,7 @@
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ * A cached shadow has shadow size^2 RAM cost*/
 #ifndef LV_SHADOW_CACHE_SIZE
 #  ifdef CONFIG_LV_SHADOW_CACHE_SIZE
 #    define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -408,6 +442,39 @@
 #    define  LV_SHADOW_CACHE_SIZE    0
 #  endif
 #endif
+#if LV_SHADOW_CACHE_SIZE
+/* The cached shadows are allocated with `lv_mem_alloc`.
+ * If any of these limits is reached the least recently used shadow is dropped.*/
+#ifndef LV_SHADOW_CACHE_ENTRY_CNT
+#  ifdef CONFIG_LV_SHADOW_CACHE_ENTRY_CNT
+#    define LV_SHADOW_CACHE_ENTRY_CNT CONFIG_LV_SHADOW_CACHE_ENTRY_CNT
+#  else
+#    define  LV_SHADOW_CACHE_ENTRY_CNT  4                                                   /*Max. number of cached shadows*/
+#  endif
+#endif
+#ifndef LV_SHADOW_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#    define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#  else
+#    define  LV_SHADOW_CACHE_MEM_SIZE   (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)  /*Max. memory used by the cache [bytes]*/
+#  endif
+#endif
+#endif
+#endif
+
+/* Cache the anti-aliased quarter circles of the rounded corners (radius masks)
+ * and copy the rows of the corners from the cache instead of calculating them with square roots.
+ * LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE is the max. memory used by the cached circles in bytes.
+ * A circle with `radius` needs `radius * (radius + 4)` bytes.
+ * The circles are allocated with `lv_mem_alloc`.
+ * If the limit is reached the least recently used circle which is not drawn currently is dropped.
+ * 0: to disable caching*/
+#ifndef LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+#    define LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE CONFIG_LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+#  else
+#    define  LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE  0
+#  endif
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -446,6 +513,17 @@
 #  endif
 #endif
 
+/* 1: Blend with SSE2/AVX2 or NEON instructions if the compiler targets them (e.g. `-msse2`, `-mavx2`, `-mfpu=neon`).
+ * Used with 32 bit and not swapped 16 bit color depth if `LV_COLOR_SCREEN_TRANSP == 0`.
+ * The result is the same as with the software blending.*/
+#ifndef LV_USE_BLEND_SIMD
+#  ifdef CONFIG_LV_USE_BLEND_SIMD
+#    define LV_USE_BLEND_SIMD CONFIG_LV_USE_BLEND_SIMD
+#  else
+#    define  LV_USE_BLEND_SIMD       0
+#  endif
+#endif
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #ifndef LV_USE_OPA_SCALE
 #  ifdef CONFIG_LV_USE_OPA_SCALE
@@ -464,6 +542,87 @@
 #  endif
 #endif
 
+/* 1: Keep the already resolved style properties of every part of the objects in a flat table.
+ * The properties are resolved on first use in the current state of the part
+ * and dropped by `lv_obj_refresh_style()` and `lv_obj_report_style_mod()`.
+ * It costs a table of ~50 bytes plus 4 or 8 bytes for every resolved property of a part.*/
+#ifndef LV_USE_STYLE_FLAT_CACHE
+#  ifdef CONFIG_LV_USE_STYLE_FLAT_CACHE
+#    define LV_USE_STYLE_FLAT_CACHE CONFIG_LV_USE_STYLE_FLAT_CACHE
+#  else
+#    define  LV_USE_STYLE_FLAT_CACHE 0
+#  endif
+#endif
+
+/* 1: Index the properties of the styles by their ID when a style is read first.
+ * It makes finding a property O(log n) and skipping a style without the property O(1).
+ * Adding or removing properties drops the index and it's built again on the next read.
+ * It costs ~32 bytes plus 2 bytes for every property of the styles which were read.*/
+#ifndef LV_USE_STYLE_INDEX
+#  ifdef CONFIG_LV_USE_STYLE_INDEX
+#    define LV_USE_STYLE_INDEX CONFIG_LV_USE_STYLE_INDEX
+#  else
+#    define  LV_USE_STYLE_INDEX      0
+#  endif
+#endif
+
+/* 1: Keep the tasks of every priority in a min-heap ordered by their next run.
+ * `lv_task_handler()` checks only the first task of the priorities to find the ready tasks
+ * and the time till the next run instead of walking all the tasks.
+ * The ready tasks of the same priority run in the order of their deadline.*/
+#ifndef LV_USE_TASK_HEAP
+#  ifdef CONFIG_LV_USE_TASK_HEAP
+#    define LV_USE_TASK_HEAP CONFIG_LV_USE_TASK_HEAP
+#  else
+#    define  LV_USE_TASK_HEAP        0
+#  endif
+#endif
+
+/* 1: Index the objects of the screens and layers in a grid to find the clicked object.
+ * The index is built again when the objects were created, deleted, moved or resized
+ * and no such change happened since the previous search.
+ * It costs ~1 kB per screen plus a pointer for every object and 2 bytes for every grid cell an object covers.*/
+#ifndef LV_USE_INDEV_SEARCH_INDEX
+#  ifdef CONFIG_LV_USE_INDEV_SEARCH_INDEX
+#    define LV_USE_INDEV_SEARCH_INDEX CONFIG_LV_USE_INDEV_SEARCH_INDEX
+#  else
+#    define  LV_USE_INDEV_SEARCH_INDEX 0
+#  endif
+#endif
+
+/* 1: Don't draw the objects which are fully hidden by opaque objects drawn later on the same area.
+ * The largest opaque objects are looked up once for every area to redraw.
+ * It costs an extra walk of the objects of the screen and a few cover checks for every area.*/
+#ifndef LV_USE_REFR_OCCLUSION
+#  ifdef CONFIG_LV_USE_REFR_OCCLUSION
+#    define LV_USE_REFR_OCCLUSION CONFIG_LV_USE_REFR_OCCLUSION
+#  else
+#    define  LV_USE_REFR_OCCLUSION   0
+#  endif
+#endif
+
+/* 1: Merge and split the invalidated areas by comparing the pixels to redraw with the overhead of an area.
+ * The areas inside an other area are dropped, overlapping areas are cut to their uncovered parts
+ * and areas are merged when the extra pixels of the merged area cost less than redrawing one more area.
+ * If the buffer of the areas is full the new area is merged into the area which grows least instead of
+ * redrawing the whole screen. `lv_refr_get_area_stat()` tells the redrawn and the really invalidated pixels.*/
+#ifndef LV_USE_REFR_AREA_MERGE
+#  ifdef CONFIG_LV_USE_REFR_AREA_MERGE
+#    define LV_USE_REFR_AREA_MERGE CONFIG_LV_USE_REFR_AREA_MERGE
+#  else
+#    define  LV_USE_REFR_AREA_MERGE  0
+#  endif
+#endif
+#if LV_USE_REFR_AREA_MERGE
+#ifndef LV_REFR_AREA_COST
+#  ifdef CONFIG_LV_REFR_AREA_COST
+#    define LV_REFR_AREA_COST CONFIG_LV_REFR_AREA_COST
+#  else
+#    define  LV_REFR_AREA_COST     1024    /*The overhead of redrawing one more area in pixels*/
+#  endif
+#endif
+#endif
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #ifndef LV_USE_GROUP
 #  ifdef CONFIG_LV_USE_GROUP
@@ -531,6 +690,55 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* 1: Split the areas to redraw into horizontal tiles and render them on worker threads.
+ * The display driver's `render_tiles_cb` has to run `lv_refr_tile(i)` on worker `i` for every tile.
+ * The mask list and the temporary buffers are kept per worker.
+ * The heap, the image cache and the font bitmaps are shared so they are guarded by a recursive lock.*/
+#ifndef LV_USE_TILE_RENDER
+#  ifdef CONFIG_LV_USE_TILE_RENDER
+#    define LV_USE_TILE_RENDER CONFIG_LV_USE_TILE_RENDER
+#  else
+#    define  LV_USE_TILE_RENDER      0
+#  endif
+#endif
+#if LV_USE_TILE_RENDER
+#ifndef LV_TILE_RENDER_WORKER_NUM
+#  ifdef CONFIG_LV_TILE_RENDER_WORKER_NUM
+#    define LV_TILE_RENDER_WORKER_NUM CONFIG_LV_TILE_RENDER_WORKER_NUM
+#  else
+#    define  LV_TILE_RENDER_WORKER_NUM     4                    /*Max. number of tiles rendered at once*/
+#  endif
+#endif
+#ifndef LV_TILE_RENDER_INCLUDE
+#  ifdef CONFIG_LV_TILE_RENDER_INCLUDE
+#    define LV_TILE_RENDER_INCLUDE CONFIG_LV_TILE_RENDER_INCLUDE
+#  else
+#    define  LV_TILE_RENDER_INCLUDE        <pthread.h>          /*Header for the thread related functions*/
+#  endif
+#endif
+#ifndef LV_TILE_RENDER_WORKER_ID
+#  ifdef CONFIG_LV_TILE_RENDER_WORKER_ID
+#    define LV_TILE_RENDER_WORKER_ID CONFIG_LV_TILE_RENDER_WORKER_ID
+#  else
+#    define  LV_TILE_RENDER_WORKER_ID      (my_worker_id())     /*Expression evaluating to the calling worker's index (0: the `lv_task_handler` thread)*/
+#  endif
+#endif
+#ifndef LV_TILE_RENDER_LOCK
+#  ifdef CONFIG_LV_TILE_RENDER_LOCK
+#    define LV_TILE_RENDER_LOCK CONFIG_LV_TILE_RENDER_LOCK
+#  else
+#    define  LV_TILE_RENDER_LOCK           (my_lock())          /*Expression locking a recursive mutex*/
+#  endif
+#endif
+#ifndef LV_TILE_RENDER_UNLOCK
+#  ifdef CONFIG_LV_TILE_RENDER_UNLOCK
+#    define LV_TILE_RENDER_UNLOCK CONFIG_LV_TILE_RENDER_UNLOCK
+#  else
+#    define  LV_TILE_RENDER_UNLOCK         (my_unlock())        /*Expression unlocking the same mutex*/
+#  endif
+#endif
+#endif
+
 /* 1: Enable file system (might be required for images */
 #ifndef LV_USE_FILESYSTEM
 #  ifdef CONFIG_LV_USE_FILESYSTEM
@@ -541,6 +749,41 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #endif
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
+
+/*1: Register a driver using the POSIX `open`, `read`, etc. functions in `lv_init()`.
+ * Its files can be memory mapped so the images and fonts are used from the file without copying*/
+#ifndef LV_USE_FS_POSIX
+#  ifdef CONFIG_LV_USE_FS_POSIX
+#    define LV_USE_FS_POSIX CONFIG_LV_USE_FS_POSIX
+#  else
+#    define  LV_USE_FS_POSIX         0
+#  endif
+#endif
+#if LV_USE_FS_POSIX
+#ifndef LV_FS_POSIX_LETTER
+#  ifdef CONFIG_LV_FS_POSIX_LETTER
+#    define LV_FS_POSIX_LETTER CONFIG_LV_FS_POSIX_LETTER
+#  else
+#    define  LV_FS_POSIX_LETTER    'P'     /*The driver letter. E.g. "P:folder/img.bin"*/
+#  endif
+#endif
+#ifndef LV_FS_POSIX_PATH
+#  ifdef CONFIG_LV_FS_POSIX_PATH
+#    define LV_FS_POSIX_PATH CONFIG_LV_FS_POSIX_PATH
+#  else
+#    define  LV_FS_POSIX_PATH      ""      /*Prefix of the paths. E.g. "/" for absolute paths or "/usr/share/app/"*/
+#  endif
+#endif
+#endif
+
+/*1: Enable `lv_fs_pack_mount()` to serve the files of an archive created by `scripts/lv_pack.py`*/
+#ifndef LV_USE_FS_PACK
+#  ifdef CONFIG_LV_USE_FS_PACK
+#    define LV_USE_FS_PACK CONFIG_LV_USE_FS_PACK
+#  else
+#    define  LV_USE_FS_PACK          0
+#  endif
+#endif
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -561,6 +804,39 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Record the time of the refresh phases, the design callbacks and `flush_cb` (see `lv_profiler.h`)*/
+#ifndef LV_USE_PROFILER
+#  ifdef CONFIG_LV_USE_PROFILER
+#    define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+#  else
+#    define  LV_USE_PROFILER         0
+#  endif
+#endif
+#if LV_USE_PROFILER
+#ifndef LV_PROFILER_TIME_INCLUDE
+#  ifdef CONFIG_LV_PROFILER_TIME_INCLUDE
+#    define LV_PROFILER_TIME_INCLUDE CONFIG_LV_PROFILER_TIME_INCLUDE
+#  else
+#    define  LV_PROFILER_TIME_INCLUDE  <stdint.h>               /*Header for the time function*/
+#  endif
+#endif
+/*The default has only 1 ms resolution. Use a microsecond timer (e.g. a free-running hardware timer) if available.*/
+#ifndef LV_PROFILER_TIME_GET
+#  ifdef CONFIG_LV_PROFILER_TIME_GET
+#    define LV_PROFILER_TIME_GET CONFIG_LV_PROFILER_TIME_GET
+#  else
+#    define  LV_PROFILER_TIME_GET      (lv_tick_get() * 1000)   /*Expression evaluating to the current time in microseconds*/
+#  endif
+#endif
+#ifndef LV_PROFILER_EVENT_CNT
+#  ifdef CONFIG_LV_PROFILER_EVENT_CNT
+#    define LV_PROFILER_EVENT_CNT CONFIG_LV_PROFILER_EVENT_CNT
+#  else
+#    define  LV_PROFILER_EVENT_CNT     1024                     /*Number of events in the ring buffer*/
+#  endif
+#endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #ifndef LV_USE_API_EXTENSION_V6
 #  ifdef CONFIG_LV_USE_API_EXTENSION_V6
@@ -613,6 +889,41 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Max. memory used by the images decoded into the RAM by the cached decoders [bytes].
+ * If it's exceeded the images with the least life are closed. 0: no limit*/
+#ifndef LV_IMG_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+#    define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+#  else
+#    define  LV_IMG_CACHE_MEM_SIZE       0
+#  endif
+#endif
+
+/* 1: Convert the cached `LV_IMG_CF_TRUE_COLOR_ALPHA` images to a color map with runs of
+ * transparent, opaque and semi-transparent pixels in every row.
+ * The opaque runs are copied and the transparent runs are skipped while drawing.
+ * It uses about `w * h * sizeof(lv_color_t)` bytes extra RAM per image. Requires `LV_IMG_CACHE_DEF_SIZE > 0`.
+ * The variables (`lv_img_dsc_t`) used directly are not converted as their pixels can be changed (e.g. by a canvas)*/
+#ifndef LV_IMG_CACHE_RUNS
+#  ifdef CONFIG_LV_IMG_CACHE_RUNS
+#    define LV_IMG_CACHE_RUNS CONFIG_LV_IMG_CACHE_RUNS
+#  else
+#    define  LV_IMG_CACHE_RUNS           0
+#  endif
+#endif
+
+/* Read this many bytes at once from the image files opened by the built-in decoder
+ * and take the next lines from this buffer while they are in it.
+ * So the images which can't be opened at once are read with one file access per block instead of per line.
+ * The buffer is allocated for every opened image file. 0: read the lines one by one*/
+#ifndef LV_IMG_DECODER_READAHEAD_SIZE
+#  ifdef CONFIG_LV_IMG_DECODER_READAHEAD_SIZE
+#    define LV_IMG_DECODER_READAHEAD_SIZE CONFIG_LV_IMG_DECODER_READAHEAD_SIZE
+#  else
+#    define  LV_IMG_DECODER_READAHEAD_SIZE   0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1115,6 +1426,29 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Cache the rendered glyph bitmaps (e.g. the decompressed glyphs of compressed fonts).
+ * The bitmaps are allocated with `lv_mem_alloc` and
+ * the least recently used glyphs are dropped if the limit is reached.
+ * LV_FONT_GLYPH_CACHE_MEM_SIZE is the max. memory used by the cached glyphs in bytes.
+ * 0: disable caching */
+#ifndef LV_FONT_GLYPH_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_MEM_SIZE
+#    define LV_FONT_GLYPH_CACHE_MEM_SIZE CONFIG_LV_FONT_GLYPH_CACHE_MEM_SIZE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_MEM_SIZE    0
+#  endif
+#endif
+
+/* Number of glyph descriptors cached per font by the fonts loaded with `lv_font_load_lazy()`.
+ * Each uses ~12 bytes*/
+#ifndef LV_FONT_LOADER_LAZY_DSC_CNT
+#  ifdef CONFIG_LV_FONT_LOADER_LAZY_DSC_CNT
+#    define LV_FONT_LOADER_LAZY_DSC_CNT CONFIG_LV_FONT_LOADER_LAZY_DSC_CNT
+#  else
+#    define  LV_FONT_LOADER_LAZY_DSC_CNT     64
+#  endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1677,6 +2011,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Store the line breaks and line widths of the labels (8 bytes per line in the heap)
+ *to find the visible lines and letters without measuring the text again*/
+#ifndef LV_LABEL_LINE_CACHE
+#  ifdef CONFIG_LV_LABEL_LINE_CACHE
+#    define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+#  else
+#    define  LV_LABEL_LINE_CACHE             0
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -15,6 +15,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -24,9 +25,31 @@
     #warning "LV_INDEV_DRAG_THROW must be greater than 0"
 #endif
 
+#if LV_USE_INDEV_SEARCH_INDEX
+/*Number of grid cells in both directions*/
+#define SEARCH_INDEX_GRID       16
+#define SEARCH_INDEX_CELL_NUM   (SEARCH_INDEX_GRID * SEARCH_INDEX_GRID)
+
+/*Max. number of screens and layers to keep an index for*/
+#define SEARCH_INDEX_MAX_CNT    8
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_INDEV_SEARCH_INDEX
+typedef struct {
+    lv_obj_t * root;
+    uint32_t gen;           /*The generation the index was built in*/
+    uint32_t seen_gen;      /*The generation in the previous search*/
+    lv_area_t area;         /*Hit area of `root` covered by the grid*/
+    lv_coord_t cell_w;
+    lv_coord_t cell_h;
+    lv_obj_t ** objs;       /*The objects in the order of the search: the top child first and the children before the parent*/
+    uint32_t * cell_start;  /*Start of every cell in `items`. Stored after `objs`*/
+    uint16_t * items;       /*ID of the objects in `objs` on every cell in the order of the search*/
+} search_index_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -45,12 +68,24 @@ static void indev_drag_throw(lv_indev_proc_t * proc);
 static lv_obj_t * get_dragged_obj(lv_obj_t * obj);
 static void indev_gesture(lv_indev_proc_t * proc);
 static bool indev_reset_check(lv_indev_proc_t * proc);
+static bool search_obj_is_target(lv_obj_t * obj);
+#if LV_USE_INDEV_SEARCH_INDEX
+    static search_index_t * search_index_get(lv_obj_t * root);
+    static void search_index_free(search_index_t * idx);
+    static bool search_index_build(search_index_t * idx);
+    static uint32_t search_index_collect(lv_obj_t * obj, lv_obj_t ** objs, uint32_t id);
+    static bool search_index_get_cells(const search_index_t * idx, lv_obj_t * obj, lv_area_t * cells);
+    static lv_obj_t * search_index_query(search_index_t * idx, lv_point_t * point);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_indev_t * indev_act;
 static lv_obj_t * indev_obj_act = NULL;
+#if LV_USE_INDEV_SEARCH_INDEX
+    static uint32_t search_index_gen;
+#endif
 
 /**********************
  *      MACROS
@@ -66,6 +101,11 @@ static lv_obj_t * indev_obj_act = NULL;
 void _lv_indev_init(void)
 {
     lv_indev_reset(NULL, NULL); /*Reset all input devices*/
+
+#if LV_USE_INDEV_SEARCH_INDEX
+    _lv_ll_init(&LV_GC_ROOT(_lv_indev_search_index_ll), sizeof(search_index_t));
+    search_index_gen = 0;
+#endif
 }
 
 /**
@@ -129,6 +169,36 @@ void _lv_indev_read_task(lv_task_t * task)
     LV_LOG_TRACE("indev read task finished");
 }
 
+/**
+ * Mark the search index of the screens outdated.
+ * Called when an object is created, deleted, moved, resized, reordered or its hit area changes.
+ */
+void _lv_indev_search_index_inv(void)
+{
+#if LV_USE_INDEV_SEARCH_INDEX
+    search_index_gen++;
+#endif
+}
+
+/**
+ * Free the search index of a screen or layer. Called when a screen is deleted.
+ * @param root pointer to a screen or layer
+ */
+void _lv_indev_search_index_drop(lv_obj_t * root)
+{
+#if LV_USE_INDEV_SEARCH_INDEX
+    search_index_t * idx;
+    _LV_LL_READ(LV_GC_ROOT(_lv_indev_search_index_ll), idx) {
+        if(idx->root == root) {
+            search_index_free(idx);
+            break;
+        }
+    }
+#else
+    LV_UNUSED(root);
+#endif
+}
+
 /**
  * Get the currently processed input device. Can be used in action functions too.
  * @return pointer to the currently processed input device or NULL if no input device processing
@@ -1146,6 +1216,14 @@ static void indev_proc_reset_query_handler(lv_indev_t * indev)
  */
 lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 {
+#if LV_USE_INDEV_SEARCH_INDEX
+    /*Use the index of the screens and layers if it's up to date*/
+    if(obj->parent == NULL && obj->adv_hittest == 0) {
+        search_index_t * idx = search_index_get(obj);
+        if(idx) return search_index_query(idx, point);
+    }
+#endif
+
     lv_obj_t * found_p = NULL;
 
     /*If the point is on this object check its children too*/
@@ -1161,27 +1239,263 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
             }
         }
 
-        /*If then the children was not ok, and this obj is clickable
-         * and it or its parent is not hidden then save this object*/
-        if(found_p == NULL && lv_obj_get_click(obj) != false) {
-            lv_obj_t * hidden_i = obj;
-            while(hidden_i != NULL) {
-                if(lv_obj_get_hidden(hidden_i) == true) break;
-                hidden_i = lv_obj_get_parent(hidden_i);
-            }
-            /*No parent found with hidden == true*/
-            if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
-                if(hidden_i == NULL && (lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) == false) found_p = obj;
+        /*If then the children was not ok save this object if it can be clicked*/
+        if(found_p == NULL && search_obj_is_target(obj)) found_p = obj;
+    }
+
+    return found_p;
+}
+
+/**
+ * Check whether an object can be the target of the search
+ * @param obj pointer to an object
+ * @return true: the object is clickable, it or its parents are not hidden and it's not disabled
+ */
+static bool search_obj_is_target(lv_obj_t * obj)
+{
+    if(lv_obj_get_click(obj) == false) return false;
+
+    lv_obj_t * hidden_i = obj;
+    while(hidden_i != NULL) {
+        if(lv_obj_get_hidden(hidden_i) == true) return false;
+        hidden_i = lv_obj_get_parent(hidden_i);
+    }
+
+    /*No parent found with hidden == true*/
+    if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
+        if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) return false;
+    }
+
+    return true;
+}
+
+#if LV_USE_INDEV_SEARCH_INDEX
+
+/**
+ * Get the index of a screen or layer and make it the most recently used.
+ * The index is built only if nothing has changed since the previous search
+ * to not build it in every search while the objects are moving.
+ * @param root pointer to a screen or layer
+ * @return pointer to an up to date index or NULL if it can't be used now
+ */
+static search_index_t * search_index_get(lv_obj_t * root)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_indev_search_index_ll);
+    search_index_t * head = _lv_ll_get_head(ll);
+    search_index_t * idx;
+    _LV_LL_READ(*ll, idx) {
+        if(idx->root == root) break;
+    }
+
+    if(idx == NULL) {
+        /*Drop the least recently used index if there are too many*/
+        if(_lv_ll_get_len(ll) >= SEARCH_INDEX_MAX_CNT) search_index_free(_lv_ll_get_tail(ll));
+
+        idx = _lv_ll_ins_head(ll);
+        if(idx == NULL) return NULL;
+        _lv_memset_00(idx, sizeof(search_index_t));
+        idx->root = root;
+        idx->seen_gen = search_index_gen;
+        return NULL;
+    }
+
+    if(idx != head) _lv_ll_move_before(ll, idx, head);
+
+    if(idx->objs && idx->gen == search_index_gen) return idx;
+
+    /*Wait until a search finds the same objects as the previous*/
+    if(idx->seen_gen != search_index_gen) {
+        idx->seen_gen = search_index_gen;
+        return NULL;
+    }
+
+    return search_index_build(idx) ? idx : NULL;
+}
+
+/**
+ * Remove an index from the list and free it
+ * @param idx pointer to an index
+ */
+static void search_index_free(search_index_t * idx)
+{
+    lv_mem_free(idx->objs);
+    lv_mem_free(idx->items);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_indev_search_index_ll), idx);
+    lv_mem_free(idx);
+}
+
+/**
+ * Build the index of a screen or layer again
+ * @param idx pointer to an index
+ * @return true: the index is built; false: there are too many objects or not enough memory
+ */
+static bool search_index_build(search_index_t * idx)
+{
+    lv_mem_free(idx->objs);
+    lv_mem_free(idx->items);
+    idx->objs = NULL;
+    idx->items = NULL;
+
+    lv_obj_t * root = idx->root;
+    lv_obj_t * obj;
+    uint32_t obj_cnt = search_index_collect(root, NULL, 0);
+    if(obj_cnt > UINT16_MAX) return false;
+
+    /*The grid covers the hit area of the root*/
+    lv_area_t * area = &idx->area;
+    lv_area_copy(area, &root->coords);
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    area->x1 -= root->ext_click_pad_hor;
+    area->x2 += root->ext_click_pad_hor;
+    area->y1 -= root->ext_click_pad_ver;
+    area->y2 += root->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    area->x1 -= root->ext_click_pad.x1;
+    area->x2 += root->ext_click_pad.x2;
+    area->y1 -= root->ext_click_pad.y1;
+    area->y2 += root->ext_click_pad.y2;
+#endif
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t h = lv_area_get_height(area);
+    if(w <= 0 || h <= 0) return false;
+    idx->cell_w = (w + SEARCH_INDEX_GRID - 1) / SEARCH_INDEX_GRID;
+    idx->cell_h = (h + SEARCH_INDEX_GRID - 1) / SEARCH_INDEX_GRID;
+
+    idx->objs = lv_mem_alloc(obj_cnt * sizeof(lv_obj_t *) + (SEARCH_INDEX_CELL_NUM + 1) * sizeof(uint32_t));
+    if(idx->objs == NULL) return false;
+    idx->cell_start = (uint32_t *)&idx->objs[obj_cnt];
+    search_index_collect(root, idx->objs, 0);
+
+    /*Count the objects on the cells*/
+    uint32_t * cell_start = idx->cell_start;
+    _lv_memset_00(cell_start, (SEARCH_INDEX_CELL_NUM + 1) * sizeof(uint32_t));
+    uint32_t i;
+    lv_coord_t cx;
+    lv_coord_t cy;
+    lv_area_t cells;
+    for(i = 0; i < obj_cnt; i++) {
+        if(search_index_get_cells(idx, idx->objs[i], &cells) == false) continue;
+        for(cy = cells.y1; cy <= cells.y2; cy++) {
+            for(cx = cells.x1; cx <= cells.x2; cx++) {
+                cell_start[cy * SEARCH_INDEX_GRID + cx + 1]++;
             }
-            else {
-                if(hidden_i == NULL) found_p = obj;
+        }
+    }
+
+    for(i = 0; i < SEARCH_INDEX_CELL_NUM; i++) cell_start[i + 1] += cell_start[i];
+
+    idx->items = lv_mem_alloc(cell_start[SEARCH_INDEX_CELL_NUM] * sizeof(uint16_t));
+    if(idx->items == NULL) {
+        lv_mem_free(idx->objs);
+        idx->objs = NULL;
+        return false;
+    }
+
+    /*Add the objects to the cells in the order of the search.
+     *`cell_start` is used as a write position and shifted back at the end.*/
+    for(i = 0; i < obj_cnt; i++) {
+        obj = idx->objs[i];
+        if(search_index_get_cells(idx, obj, &cells) == false) continue;
+        for(cy = cells.y1; cy <= cells.y2; cy++) {
+            for(cx = cells.x1; cx <= cells.x2; cx++) {
+                idx->items[cell_start[cy * SEARCH_INDEX_GRID + cx]++] = (uint16_t)i;
             }
         }
     }
 
-    return found_p;
+    for(i = SEARCH_INDEX_CELL_NUM; i > 0; i--) cell_start[i] = cell_start[i - 1];
+    cell_start[0] = 0;
+
+    idx->gen = search_index_gen;
+    return true;
 }
 
+/**
+ * Collect an object and its children in the order of `lv_indev_search_obj`
+ * @param obj pointer to an object
+ * @param objs store the objects here or only count them if NULL
+ * @param id ID of the next object in `objs`
+ * @return ID of the next object after `obj` and its children
+ */
+static uint32_t search_index_collect(lv_obj_t * obj, lv_obj_t ** objs, uint32_t id)
+{
+    lv_obj_t * i;
+    _LV_LL_READ(obj->child_ll, i) {
+        id = search_index_collect(i, objs, id);
+    }
+
+    if(objs) objs[id] = obj;
+    return id + 1;
+}
+
+/**
+ * Get the grid cells on which an object can be hit
+ * @param idx pointer to an index
+ * @param obj pointer to an object
+ * @param cells store the first and last cell's column and row here
+ * @return false: the object can't be hit on the grid
+ */
+static bool search_index_get_cells(const search_index_t * idx, lv_obj_t * obj, lv_area_t * cells)
+{
+    lv_area_t a;
+    /*The custom hit test can hit anywhere*/
+    if(obj->adv_hittest) {
+        lv_area_copy(&a, &idx->area);
+    }
+    else {
+        lv_area_copy(&a, &obj->coords);
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+        a.x1 -= obj->ext_click_pad_hor;
+        a.x2 += obj->ext_click_pad_hor;
+        a.y1 -= obj->ext_click_pad_ver;
+        a.y2 += obj->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+        a.x1 -= obj->ext_click_pad.x1;
+        a.x2 += obj->ext_click_pad.x2;
+        a.y1 -= obj->ext_click_pad.y1;
+        a.y2 += obj->ext_click_pad.y2;
+#endif
+        if(_lv_area_intersect(&a, &a, &idx->area) == false) return false;
+    }
+
+    cells->x1 = (a.x1 - idx->area.x1) / idx->cell_w;
+    cells->x2 = (a.x2 - idx->area.x1) / idx->cell_w;
+    cells->y1 = (a.y1 - idx->area.y1) / idx->cell_h;
+    cells->y2 = (a.y2 - idx->area.y1) / idx->cell_h;
+    return true;
+}
+
+/**
+ * Search the most top, clickable object by a point with an index.
+ * Gives the same result as the recursive search.
+ * @param idx pointer to an up to date index
+ * @param point pointer to a point for searching the most top child
+ * @return pointer to the found object or NULL if there was no suitable object
+ */
+static lv_obj_t * search_index_query(search_index_t * idx, lv_point_t * point)
+{
+    lv_obj_t * root = idx->root;
+    if(lv_obj_hittest(root, point) == false) return NULL;
+
+    uint32_t cell = ((point->y - idx->area.y1) / idx->cell_h) * SEARCH_INDEX_GRID +
+                    (point->x - idx->area.x1) / idx->cell_w;
+    uint32_t i;
+    for(i = idx->cell_start[cell]; i < idx->cell_start[cell + 1]; i++) {
+        lv_obj_t * obj = idx->objs[idx->items[i]];
+
+        /*The object and all of its parents need to be hit*/
+        lv_obj_t * par = obj;
+        while(par != root && lv_obj_hittest(par, point)) par = par->parent;
+        if(par != root) continue;
+
+        if(search_obj_is_target(obj)) return obj;
+    }
+
+    return NULL;
+}
+
+#endif /*LV_USE_INDEV_SEARCH_INDEX*/
+
 /**
  * Handle focus/defocus on click for POINTER input devices
  * @param proc pointer to the state of the indev
@@ -40,6 +40,18 @@ void _lv_indev_init(void);
  */
 void _lv_indev_read_task(lv_task_t * task);
 
+/**
+ * Mark the search index of the screens outdated.
+ * Called when an object is created, deleted, moved, resized, reordered or its hit area changes.
+ */
+void _lv_indev_search_index_inv(void);
+
+/**
+ * Free the search index of a screen or layer. Called when a screen is deleted.
+ * @param root pointer to a screen or layer
+ */
+void _lv_indev_search_index_drop(lv_obj_t * root);
+
 /**
  * Get the currently processed input device. Can be used in action functions too.
  * @return pointer to the currently processed input device or NULL if no input device processing
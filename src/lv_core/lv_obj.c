@@ -18,6 +18,8 @@
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_async.h"
 #include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_fs_posix.h"
+#include "../lv_misc/lv_fs_pack.h"
 #include "../lv_misc/lv_gc.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
@@ -132,14 +134,26 @@ static void trans_anim_start_cb(lv_anim_t * a);
 static void trans_anim_ready_cb(lv_anim_t * a);
 static void opa_scale_anim(lv_obj_t * obj, lv_anim_value_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
+#if LV_USE_ANIM_BATCH
+static void trans_inv_later(lv_obj_t * obj);
+#endif
 #endif
 static void lv_event_mark_deleted(lv_obj_t * obj);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
 static void lv_obj_del_async_cb(void * obj);
 static void obj_del_core(lv_obj_t * obj);
+static lv_style_int_t get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_color_t get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_opa_t get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static const void * get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
 static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop);
 static void update_style_cache_children(lv_obj_t * obj);
+static bool style_prop_needs_refr(lv_style_property_t prop);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+#if LV_USE_STYLE_FLAT_CACHE
+static lv_style_list_t * get_flat_style_list(const lv_obj_t * obj, uint8_t part, lv_style_property_t * prop);
+static void invalidate_style_flat(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+#endif
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot);
 static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, style_snapshot_t * shot2);
 
@@ -149,6 +163,10 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+#if LV_USE_ANIMATION && LV_USE_ANIM_BATCH
+    static uint32_t trans_inv_cnt;
+    static uint32_t trans_inv_size;
+#endif
 
 /**********************
  *      MACROS
@@ -177,6 +195,12 @@ void lv_init(void)
 
 #if LV_USE_FILESYSTEM
     _lv_fs_init();
+#if LV_USE_FS_POSIX
+    _lv_fs_posix_init();
+#endif
+#if LV_USE_FS_PACK
+    _lv_fs_pack_init();
+#endif
 #endif
 
 #if LV_USE_ANIMATION
@@ -200,6 +224,11 @@ void lv_init(void)
 #endif
 
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(lv_style_trans_t));
+#if LV_USE_ANIMATION && LV_USE_ANIM_BATCH
+    LV_GC_ROOT(_lv_obj_trans_inv) = NULL;
+    trans_inv_cnt = 0;
+    trans_inv_size = 0;
+#endif
 
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
@@ -216,6 +245,9 @@ void lv_init(void)
     _lv_indev_init();
 
     _lv_img_decoder_init();
+    _lv_draw_shadow_cache_init();
+    _lv_draw_mask_radius_cache_init();
+    _lv_font_glyph_cache_init();
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
@@ -337,6 +369,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     }
 
     _lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
+    _lv_indev_search_index_inv();
 
     new_obj->ext_draw_pad = 0;
 
@@ -684,6 +717,12 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
     obj->parent = parent;
+    _lv_indev_search_index_inv();
+
+#if LV_USE_STYLE_FLAT_CACHE
+    /*The inherited properties come from the new parent*/
+    invalidate_style_flat(obj, LV_OBJ_PART_ALL, LV_STYLE_PROP_ALL);
+#endif
 
     if(new_base_dir != LV_BIDI_DIR_RTL) {
         lv_obj_set_pos(obj, old_pos.x, old_pos.y);
@@ -719,6 +758,7 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+    _lv_indev_search_index_inv();
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -742,6 +782,7 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+    _lv_indev_search_index_inv();
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -794,6 +835,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y2 += diff.y;
 
     refresh_children_position(obj, diff.x, diff.y);
+    _lv_indev_search_index_inv();
 
     /*Inform the object about its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -861,6 +903,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_indev_search_index_inv();
 
     /*Send a signal to the object with its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -1163,6 +1206,8 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     (void)top;    /*Unused*/
     (void)bottom; /*Unused*/
 #endif
+
+    _lv_indev_search_index_inv();
 }
 
 /*---------------------
@@ -1357,8 +1402,12 @@ bool lv_obj_remove_style_local_prop(lv_obj_t * obj, uint8_t part, lv_style_prope
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     lv_style_t * style = lv_obj_get_local_style(obj, part);
-    if(style) return lv_style_remove_prop(style, prop);
-    else return false;
+    if(style == NULL) return false;
+
+#if LV_USE_STYLE_FLAT_CACHE
+    invalidate_style_flat(obj, part, prop);
+#endif
+    return lv_style_remove_prop(style, prop);
 }
 
 /**
@@ -1374,49 +1423,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, uint8_t part, lv_style_property_t prop
     invalidate_style_cache(obj, part, prop);
 
     /*If a real style refresh is required*/
-    bool real_refr = false;
-    switch(prop) {
-        case LV_STYLE_PROP_ALL:
-        case LV_STYLE_CLIP_CORNER:
-        case LV_STYLE_SIZE:
-        case LV_STYLE_TRANSFORM_WIDTH:
-        case LV_STYLE_TRANSFORM_HEIGHT:
-        case LV_STYLE_TRANSFORM_ANGLE:
-        case LV_STYLE_TRANSFORM_ZOOM:
-        case LV_STYLE_PAD_TOP:
-        case LV_STYLE_PAD_BOTTOM:
-        case LV_STYLE_PAD_LEFT:
-        case LV_STYLE_PAD_RIGHT:
-        case LV_STYLE_PAD_INNER:
-        case LV_STYLE_MARGIN_TOP:
-        case LV_STYLE_MARGIN_BOTTOM:
-        case LV_STYLE_MARGIN_LEFT:
-        case LV_STYLE_MARGIN_RIGHT:
-        case LV_STYLE_OUTLINE_WIDTH:
-        case LV_STYLE_OUTLINE_PAD:
-        case LV_STYLE_OUTLINE_OPA:
-        case LV_STYLE_SHADOW_WIDTH:
-        case LV_STYLE_SHADOW_OPA:
-        case LV_STYLE_SHADOW_OFS_X:
-        case LV_STYLE_SHADOW_OFS_Y:
-        case LV_STYLE_SHADOW_SPREAD:
-        case LV_STYLE_VALUE_LETTER_SPACE:
-        case LV_STYLE_VALUE_LINE_SPACE:
-        case LV_STYLE_VALUE_OFS_X:
-        case LV_STYLE_VALUE_OFS_Y:
-        case LV_STYLE_VALUE_ALIGN:
-        case LV_STYLE_VALUE_STR:
-        case LV_STYLE_VALUE_FONT:
-        case LV_STYLE_VALUE_OPA:
-        case LV_STYLE_TEXT_LETTER_SPACE:
-        case LV_STYLE_TEXT_LINE_SPACE:
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_LINE_WIDTH:
-            real_refr = true;
-            break;
-        default:
-            real_refr = false;
-    }
+    bool real_refr = style_prop_needs_refr(prop);
 
     if(real_refr) {
         lv_obj_invalidate(obj);
@@ -1513,6 +1520,7 @@ void lv_obj_set_adv_hittest(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->adv_hittest = en == false ? 0 : 1;
+    _lv_indev_search_index_inv();
 }
 
 /**
@@ -1726,6 +1734,11 @@ void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     obj->state = new_state;
 
+#if LV_USE_STYLE_FLAT_CACHE
+    /*The children might inherit properties in the new state*/
+    invalidate_style_flat(obj, LV_OBJ_PART_ALL, LV_STYLE_PROP_ALL);
+#endif
+
     if(cmp_res == STYLE_COMPARE_SAME) {
         return;
     }
@@ -1848,6 +1861,24 @@ void lv_obj_finish_transitions(lv_obj_t * obj, uint8_t part)
     /*Free all related transition data*/
     trans_del(obj, part, 0xFF, NULL);
 }
+
+#if LV_USE_ANIM_BATCH
+/**
+ * Invalidate the objects whose style transitions changed since the last call.
+ * Called before refreshing a display.
+ */
+void _lv_obj_trans_inv_flush(void)
+{
+    lv_obj_t ** objs = LV_GC_ROOT(_lv_obj_trans_inv);
+    uint32_t i;
+    for(i = 0; i < trans_inv_cnt; i++) {
+        if(objs[i] == NULL) continue;
+        objs[i]->trans_inv = 0;
+        lv_obj_invalidate(objs[i]);
+    }
+    trans_inv_cnt = 0;
+}
+#endif
 #endif
 
 /**
@@ -2567,119 +2598,20 @@ lv_style_list_t * lv_obj_get_style_list(const lv_obj_t * obj, uint8_t part)
  */
 lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_style_int_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_CLIP_CORNER:
-                    if(list->clip_corner_off) def = true;
-                    break;
-                case LV_STYLE_TEXT_LETTER_SPACE:
-                case LV_STYLE_TEXT_LINE_SPACE:
-                    if(list->text_space_zero) def = true;
-                    break;
-                case LV_STYLE_TRANSFORM_ANGLE:
-                case LV_STYLE_TRANSFORM_WIDTH:
-                case LV_STYLE_TRANSFORM_HEIGHT:
-                case LV_STYLE_TRANSFORM_ZOOM:
-                    if(list->transform_all_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_WIDTH:
-                    if(list->border_width_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_SIDE:
-                    if(list->border_side_full) def = true;
-                    break;
-                case LV_STYLE_BORDER_POST:
-                    if(list->border_post_off) def = true;
-                    break;
-                case LV_STYLE_OUTLINE_WIDTH:
-                    if(list->outline_width_zero) def = true;
-                    break;
-                case LV_STYLE_RADIUS:
-                    if(list->radius_zero) def = true;
-                    break;
-                case LV_STYLE_SHADOW_WIDTH:
-                    if(list->shadow_width_zero) def = true;
-                    break;
-                case LV_STYLE_PAD_TOP:
-                case LV_STYLE_PAD_BOTTOM:
-                case LV_STYLE_PAD_LEFT:
-                case LV_STYLE_PAD_RIGHT:
-                    if(list->pad_all_zero) def = true;
-                    break;
-                case LV_STYLE_MARGIN_TOP:
-                case LV_STYLE_MARGIN_BOTTOM:
-                case LV_STYLE_MARGIN_LEFT:
-                case LV_STYLE_MARGIN_RIGHT:
-                    if(list->margin_all_zero) def = true;
-                    break;
-                case LV_STYLE_BG_BLEND_MODE:
-                case LV_STYLE_BORDER_BLEND_MODE:
-                case LV_STYLE_IMAGE_BLEND_MODE:
-                case LV_STYLE_LINE_BLEND_MODE:
-                case LV_STYLE_OUTLINE_BLEND_MODE:
-                case LV_STYLE_PATTERN_BLEND_MODE:
-                case LV_STYLE_SHADOW_BLEND_MODE:
-                case LV_STYLE_TEXT_BLEND_MODE:
-                case LV_STYLE_VALUE_BLEND_MODE:
-                    if(list->blend_mode_all_normal) def = true;
-                    break;
-                case LV_STYLE_TEXT_DECOR:
-                    if(list->text_decor_none) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_int(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
+#if LV_USE_STYLE_FLAT_CACHE
+    lv_style_property_t flat_prop = prop;
+    lv_style_list_t * list = get_flat_style_list(obj, part, &flat_prop);
+    if(list) {
+        lv_style_value_t v;
+        if(_lv_style_list_get_flat(list, flat_prop, &v) == LV_RES_OK) return v._int;
 
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BORDER_SIDE:
-            return LV_BORDER_SIDE_FULL;
-        case LV_STYLE_SIZE:
-            return LV_DPI / 20;
-        case LV_STYLE_SCALE_WIDTH:
-            return LV_DPI / 8;
-        case LV_STYLE_BG_GRAD_STOP:
-            return 255;
-        case LV_STYLE_TRANSFORM_ZOOM:
-            return LV_IMG_ZOOM_NONE;
+        v._int = get_style_int(obj, part, prop);
+        _lv_style_list_set_flat(list, flat_prop, &v);
+        return v._int;
     }
+#endif
 
-    return 0;
+    return get_style_int(obj, part, prop);
 }
 
 /**
@@ -2698,44 +2630,20 @@ lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_styl
  */
 lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_color_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_color(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
+#if LV_USE_STYLE_FLAT_CACHE
+    lv_style_property_t flat_prop = prop;
+    lv_style_list_t * list = get_flat_style_list(obj, part, &flat_prop);
+    if(list) {
+        lv_style_value_t v;
+        if(_lv_style_list_get_flat(list, flat_prop, &v) == LV_RES_OK) return v._color;
 
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_COLOR:
-        case LV_STYLE_BG_GRAD_COLOR:
-            return LV_COLOR_WHITE;
+        v._color = get_style_color(obj, part, prop);
+        _lv_style_list_set_flat(list, flat_prop, &v);
+        return v._color;
     }
+#endif
 
-    return LV_COLOR_BLACK;
+    return get_style_color(obj, part, prop);
 }
 
 /**
@@ -2754,146 +2662,52 @@ lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_
  */
 lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
+#if LV_USE_STYLE_FLAT_CACHE
+    lv_style_property_t flat_prop = prop;
+    lv_style_list_t * list = get_flat_style_list(obj, part, &flat_prop);
+    if(list) {
+        lv_style_value_t v;
+        if(_lv_style_list_get_flat(list, flat_prop, &v) == LV_RES_OK) return v._opa;
 
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
+        v._opa = get_style_opa(obj, part, prop);
+        _lv_style_list_set_flat(list, flat_prop, &v);
+        return v._opa;
+    }
+#endif
 
-    lv_opa_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+    return get_style_opa(obj, part, prop);
+}
 
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_OPA_SCALE:
-                    if(list->opa_scale_cover) def = true;
-                    break;
-                case LV_STYLE_BG_OPA:
-                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
-                    if(list->bg_opa_transp) def = true;
-                    break;
-                case LV_STYLE_IMAGE_RECOLOR_OPA:
-                    if(list->img_recolor_opa_transp) def = true;
-                    break;
-            }
+/**
+ * Get a style property of a part of an object in the object's current state.
+ * If there is a running transitions it is taken into account
+ * @param obj pointer to an object
+ * @param part the part of the object which style property should be get.
+ * E.g. `LV_OBJ_PART_MAIN`, `LV_BTN_PART_MAIN`, `LV_SLIDER_PART_KNOB`
+ * @param prop the property to get. E.g. `LV_STYLE_TEXT_FONT`.
+ *  The state of the object will be added internally
+ * @return the value of the property of the given part in the current state.
+ * If the property is not found a default value will be returned.
+ * @note shouldn't be used directly. Use the specific property get functions instead.
+ *       For example: `lv_obj_style_get_border_opa()`
+ * @note for performance reasons it's not checked if the property really has pointer type
+ */
+const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+#if LV_USE_STYLE_FLAT_CACHE
+    lv_style_property_t flat_prop = prop;
+    lv_style_list_t * list = get_flat_style_list(obj, part, &flat_prop);
+    if(list) {
+        lv_style_value_t v;
+        if(_lv_style_list_get_flat(list, flat_prop, &v) == LV_RES_OK) return v._ptr;
 
-            if(def) {
-                break;
-            }
-        }
+        v._ptr = get_style_ptr(obj, part, prop);
+        _lv_style_list_set_flat(list, flat_prop, &v);
+        return v._ptr;
+    }
+#endif
 
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_opa(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_OPA:
-        case LV_STYLE_IMAGE_RECOLOR_OPA:
-        case LV_STYLE_PATTERN_RECOLOR_OPA:
-            return LV_OPA_TRANSP;
-    }
-
-    return LV_OPA_COVER;
-}
-
-/**
- * Get a style property of a part of an object in the object's current state.
- * If there is a running transitions it is taken into account
- * @param obj pointer to an object
- * @param part the part of the object which style property should be get.
- * E.g. `LV_OBJ_PART_MAIN`, `LV_BTN_PART_MAIN`, `LV_SLIDER_PART_KNOB`
- * @param prop the property to get. E.g. `LV_STYLE_TEXT_FONT`.
- *  The state of the object will be added internally
- * @return the value of the property of the given part in the current state.
- * If the property is not found a default value will be returned.
- * @note shouldn't be used directly. Use the specific property get functions instead.
- *       For example: `lv_obj_style_get_border_opa()`
- * @note for performance reasons it's not checked if the property really has pointer type
- */
-const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
-{
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    const void * value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_VALUE_STR:
-                    if(list->value_txt_str) def = true;
-                    break;
-                case LV_STYLE_PATTERN_IMAGE:
-                    if(list->pattern_img_null) def = true;
-                    break;
-                case LV_STYLE_TEXT_FONT:
-                    if(list->text_font_normal) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_ptr(list, prop, &value_act);
-        if(res == LV_RES_OK)  return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_VALUE_FONT:
-            return lv_theme_get_font_normal();
-#if LV_USE_ANIMATION
-        case LV_STYLE_TRANSITION_PATH:
-            return &lv_anim_path_def;
-#endif
-    }
-
-    return NULL;
+    return get_style_ptr(obj, part, prop);
 }
 
 /**
@@ -3786,9 +3600,19 @@ static void obj_del_core(lv_obj_t * obj)
 #if LV_USE_ANIMATION
     lv_anim_del(obj, NULL);
     trans_del(obj, 0xFF, 0xFF, NULL);
+#if LV_USE_ANIM_BATCH
+    if(obj->trans_inv) {
+        lv_obj_t ** objs = LV_GC_ROOT(_lv_obj_trans_inv);
+        uint32_t j;
+        for(j = 0; j < trans_inv_cnt; j++) {
+            if(objs[j] == obj) objs[j] = NULL;
+        }
+    }
+#endif
 #endif
 
     lv_event_mark_deleted(obj);
+    _lv_indev_search_index_inv();
 
     /* Reset all input devices if the object to delete is used*/
     lv_indev_t * indev = lv_indev_get_next(NULL);
@@ -3817,6 +3641,7 @@ static void obj_del_core(lv_obj_t * obj)
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
         _lv_ll_remove(&d->scr_ll, obj);
+        _lv_indev_search_index_drop(obj);
     }
     else {
         _lv_ll_remove(&(par->child_ll), obj);
@@ -4417,6 +4242,9 @@ static void trans_del(lv_obj_t * obj, uint8_t part, lv_style_property_t prop, lv
             lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
             lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
             lv_style_remove_prop(style_trans, tr->prop);
+#if LV_USE_STYLE_FLAT_CACHE
+            invalidate_style_flat(tr->obj, tr->part, tr->prop);
+#endif
 
             lv_anim_del(tr, NULL);
             _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4458,6 +4286,15 @@ static void trans_anim_cb(lv_style_trans_t * tr, lv_anim_value_t v)
         else x = tr->end_value._ptr;
         _lv_style_set_ptr(style, tr->prop, x);
     }
+
+#if LV_USE_ANIM_BATCH
+    if(style_prop_needs_refr(tr->prop) == false) {
+        invalidate_style_cache(tr->obj, tr->part, tr->prop);
+        trans_inv_later(tr->obj);
+        return;
+    }
+#endif
+
     lv_obj_refresh_style(tr->obj, tr->part, tr->prop);
 
 }
@@ -4511,12 +4348,47 @@ static void trans_anim_ready_cb(lv_anim_t * a)
         lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
         lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
         lv_style_remove_prop(style_trans, tr->prop);
+#if LV_USE_STYLE_FLAT_CACHE
+        invalidate_style_flat(tr->obj, tr->part, tr->prop);
+#endif
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
     lv_mem_free(tr);
 }
 
+#if LV_USE_ANIM_BATCH
+/**
+ * Invalidate an object only once before the next refresh
+ * even if several transitions of it change in a step of the animations.
+ * @param obj pointer to an object
+ */
+static void trans_inv_later(lv_obj_t * obj)
+{
+    if(obj->trans_inv) return;
+
+    if(trans_inv_cnt == trans_inv_size) {
+        uint32_t new_size = trans_inv_size ? trans_inv_size * 2 : 8;
+        lv_obj_t ** objs = lv_mem_realloc(LV_GC_ROOT(_lv_obj_trans_inv), new_size * sizeof(lv_obj_t *));
+        LV_ASSERT_MEM(objs);
+        if(objs == NULL) {
+            lv_obj_invalidate(obj);
+            return;
+        }
+        LV_GC_ROOT(_lv_obj_trans_inv) = objs;
+        trans_inv_size = new_size;
+    }
+
+    ((lv_obj_t **)LV_GC_ROOT(_lv_obj_trans_inv))[trans_inv_cnt] = obj;
+    trans_inv_cnt++;
+    obj->trans_inv = 1;
+
+    /*Be sure the display will be refreshed*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp && disp->refr_task) lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+}
+#endif
+
 static void opa_scale_anim(lv_obj_t * obj, lv_anim_value_t v)
 {
     lv_obj_set_style_local_opa_scale(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, v);
@@ -4524,7 +4396,7 @@ static void opa_scale_anim(lv_obj_t * obj, lv_anim_value_t v)
 
 static void fade_in_anim_ready(lv_anim_t * a)
 {
-    lv_style_remove_prop(lv_obj_get_local_style(a->var, LV_OBJ_PART_MAIN), LV_STYLE_OPA_SCALE);
+    lv_obj_remove_style_local_prop(a->var, LV_OBJ_PART_MAIN, LV_STYLE_OPA_SCALE);
 }
 
 #endif
@@ -4554,6 +4426,323 @@ static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_fin
     return false;
 }
 
+/**
+ * Get the value of an integer typed style property by checking the styles of the part and the parents.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property or its default value if not set
+ */
+static lv_style_int_t get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_style_int_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_CLIP_CORNER:
+                    if(list->clip_corner_off) def = true;
+                    break;
+                case LV_STYLE_TEXT_LETTER_SPACE:
+                case LV_STYLE_TEXT_LINE_SPACE:
+                    if(list->text_space_zero) def = true;
+                    break;
+                case LV_STYLE_TRANSFORM_ANGLE:
+                case LV_STYLE_TRANSFORM_WIDTH:
+                case LV_STYLE_TRANSFORM_HEIGHT:
+                case LV_STYLE_TRANSFORM_ZOOM:
+                    if(list->transform_all_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_WIDTH:
+                    if(list->border_width_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_SIDE:
+                    if(list->border_side_full) def = true;
+                    break;
+                case LV_STYLE_BORDER_POST:
+                    if(list->border_post_off) def = true;
+                    break;
+                case LV_STYLE_OUTLINE_WIDTH:
+                    if(list->outline_width_zero) def = true;
+                    break;
+                case LV_STYLE_RADIUS:
+                    if(list->radius_zero) def = true;
+                    break;
+                case LV_STYLE_SHADOW_WIDTH:
+                    if(list->shadow_width_zero) def = true;
+                    break;
+                case LV_STYLE_PAD_TOP:
+                case LV_STYLE_PAD_BOTTOM:
+                case LV_STYLE_PAD_LEFT:
+                case LV_STYLE_PAD_RIGHT:
+                    if(list->pad_all_zero) def = true;
+                    break;
+                case LV_STYLE_MARGIN_TOP:
+                case LV_STYLE_MARGIN_BOTTOM:
+                case LV_STYLE_MARGIN_LEFT:
+                case LV_STYLE_MARGIN_RIGHT:
+                    if(list->margin_all_zero) def = true;
+                    break;
+                case LV_STYLE_BG_BLEND_MODE:
+                case LV_STYLE_BORDER_BLEND_MODE:
+                case LV_STYLE_IMAGE_BLEND_MODE:
+                case LV_STYLE_LINE_BLEND_MODE:
+                case LV_STYLE_OUTLINE_BLEND_MODE:
+                case LV_STYLE_PATTERN_BLEND_MODE:
+                case LV_STYLE_SHADOW_BLEND_MODE:
+                case LV_STYLE_TEXT_BLEND_MODE:
+                case LV_STYLE_VALUE_BLEND_MODE:
+                    if(list->blend_mode_all_normal) def = true;
+                    break;
+                case LV_STYLE_TEXT_DECOR:
+                    if(list->text_decor_none) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_int(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BORDER_SIDE:
+            return LV_BORDER_SIDE_FULL;
+        case LV_STYLE_SIZE:
+            return LV_DPI / 20;
+        case LV_STYLE_SCALE_WIDTH:
+            return LV_DPI / 8;
+        case LV_STYLE_BG_GRAD_STOP:
+            return 255;
+        case LV_STYLE_TRANSFORM_ZOOM:
+            return LV_IMG_ZOOM_NONE;
+    }
+
+    return 0;
+}
+
+/**
+ * Get the value of a color typed style property by checking the styles of the part and the parents.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property or its default value if not set
+ */
+static lv_color_t get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_color_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_color(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+            return LV_COLOR_WHITE;
+    }
+
+    return LV_COLOR_BLACK;
+}
+
+/**
+ * Get the value of an opacity typed style property by checking the styles of the part and the parents.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property or its default value if not set
+ */
+static lv_opa_t get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_opa_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_OPA_SCALE:
+                    if(list->opa_scale_cover) def = true;
+                    break;
+                case LV_STYLE_BG_OPA:
+                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
+                    if(list->bg_opa_transp) def = true;
+                    break;
+                case LV_STYLE_IMAGE_RECOLOR_OPA:
+                    if(list->img_recolor_opa_transp) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_opa(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_OPA:
+        case LV_STYLE_IMAGE_RECOLOR_OPA:
+        case LV_STYLE_PATTERN_RECOLOR_OPA:
+            return LV_OPA_TRANSP;
+    }
+
+    return LV_OPA_COVER;
+}
+
+/**
+ * Get the value of a pointer typed style property by checking the styles of the part and the parents.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get. The state of the object will be added internally
+ * @return the value of the property or its default value if not set
+ */
+static const void * get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    const void * value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_VALUE_STR:
+                    if(list->value_txt_str) def = true;
+                    break;
+                case LV_STYLE_PATTERN_IMAGE:
+                    if(list->pattern_img_null) def = true;
+                    break;
+                case LV_STYLE_TEXT_FONT:
+                    if(list->text_font_normal) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_ptr(list, prop, &value_act);
+        if(res == LV_RES_OK)  return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_VALUE_FONT:
+            return lv_theme_get_font_normal();
+#if LV_USE_ANIMATION
+        case LV_STYLE_TRANSITION_PATH:
+            return &lv_anim_path_def;
+#endif
+    }
+
+    return NULL;
+}
+
 static bool style_prop_is_cacheble(lv_style_property_t prop)
 {
 
@@ -4614,6 +4803,14 @@ static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop)
 
     lv_style_list_t * list = lv_obj_get_style_list(obj, part);
 
+    /*The workers rendering the tiles can draw the same object at the same time.
+     *Let only one of them write the bits of the list and skip the update if an other one has already done it.*/
+    _LV_WORKER_LOCK();
+    if(list->valid_cache) {
+        _LV_WORKER_UNLOCK();
+        return;
+    }
+
     bool ignore_cache_ori = list->ignore_cache;
     list->ignore_cache = 1;
 
@@ -4686,6 +4883,7 @@ static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop)
 #endif
     list->ignore_cache = ignore_cache_ori;
     list->valid_cache = 1;
+    _LV_WORKER_UNLOCK();
 }
 
 /**
@@ -4725,6 +4923,56 @@ static void update_style_cache_children(lv_obj_t * obj)
 
 }
 
+/**
+ * Tell whether a property can change the size, the layout or the children of an object
+ * @param prop a style property
+ * @return true: the object needs a real style refresh; false: invalidating the object is enough
+ */
+static bool style_prop_needs_refr(lv_style_property_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_PROP_ALL:
+        case LV_STYLE_CLIP_CORNER:
+        case LV_STYLE_SIZE:
+        case LV_STYLE_TRANSFORM_WIDTH:
+        case LV_STYLE_TRANSFORM_HEIGHT:
+        case LV_STYLE_TRANSFORM_ANGLE:
+        case LV_STYLE_TRANSFORM_ZOOM:
+        case LV_STYLE_PAD_TOP:
+        case LV_STYLE_PAD_BOTTOM:
+        case LV_STYLE_PAD_LEFT:
+        case LV_STYLE_PAD_RIGHT:
+        case LV_STYLE_PAD_INNER:
+        case LV_STYLE_MARGIN_TOP:
+        case LV_STYLE_MARGIN_BOTTOM:
+        case LV_STYLE_MARGIN_LEFT:
+        case LV_STYLE_MARGIN_RIGHT:
+        case LV_STYLE_OUTLINE_WIDTH:
+        case LV_STYLE_OUTLINE_PAD:
+        case LV_STYLE_OUTLINE_OPA:
+        case LV_STYLE_SHADOW_WIDTH:
+        case LV_STYLE_SHADOW_OPA:
+        case LV_STYLE_SHADOW_OFS_X:
+        case LV_STYLE_SHADOW_OFS_Y:
+        case LV_STYLE_SHADOW_SPREAD:
+        case LV_STYLE_VALUE_LETTER_SPACE:
+        case LV_STYLE_VALUE_LINE_SPACE:
+        case LV_STYLE_VALUE_OFS_X:
+        case LV_STYLE_VALUE_OFS_Y:
+        case LV_STYLE_VALUE_ALIGN:
+        case LV_STYLE_VALUE_STR:
+        case LV_STYLE_VALUE_FONT:
+        case LV_STYLE_VALUE_OPA:
+        case LV_STYLE_TEXT_LETTER_SPACE:
+        case LV_STYLE_TEXT_LINE_SPACE:
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_LINE_WIDTH:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /**
  * Mark the object and all of it's children's style lists as invalid.
  * The cache will be updated when a cached property asked nest time
@@ -4732,6 +4980,10 @@ static void update_style_cache_children(lv_obj_t * obj)
  */
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
+#if LV_USE_STYLE_FLAT_CACHE
+    invalidate_style_flat(obj, part, prop);
+#endif
+
     if(style_prop_is_cacheble(prop) == false) return;
 
     for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
@@ -4753,6 +5005,67 @@ static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_proper
     }
 }
 
+#if LV_USE_STYLE_FLAT_CACHE
+/**
+ * Get the style list of a part if its flat cache can be used to get a property
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop pointer to a property. The current state of the part will be added to it.
+ * @return the style list or NULL if the flat cache can't be used now
+ */
+static lv_style_list_t * get_flat_style_list(const lv_obj_t * obj, uint8_t part, lv_style_property_t * prop)
+{
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+
+    /*The cache is ignored when the styles are checked in an other state (e.g. for a transition)*/
+    if(list == NULL || list->ignore_cache) return NULL;
+
+    lv_state_t state = lv_obj_get_state(obj, part);
+    *prop = (*prop & (~LV_STYLE_STATE_MASK)) | ((uint16_t)state << LV_STYLE_STATE_POS);
+    return list;
+}
+
+/**
+ * Drop a property from the flat style caches of an object.
+ * The inherited properties are dropped from the children too.
+ * @param obj pointer to an object
+ * @param part the part of the object or `LV_OBJ_PART_ALL`
+ * @param prop the property to drop or `LV_STYLE_PROP_ALL`
+ */
+static void invalidate_style_flat(lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    bool inherit = prop == LV_STYLE_PROP_ALL || (prop & LV_STYLE_INHERIT_MASK) ? true : false;
+
+    /*The other parts inherit from the main part*/
+    if(part == LV_OBJ_PART_ALL || inherit) {
+        for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
+            lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+            if(list == NULL) break;
+            _lv_style_list_invalidate_flat(list, prop);
+        }
+
+        for(part = _LV_OBJ_PART_REAL_FIRST; part < 0xFF; part++) {
+            lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+            if(list == NULL) break;
+            _lv_style_list_invalidate_flat(list, prop);
+        }
+    }
+    else {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list) _lv_style_list_invalidate_flat(list, prop);
+    }
+
+    if(inherit == false) return;
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        invalidate_style_flat(child, LV_OBJ_PART_ALL, prop);
+        child = lv_obj_get_child(obj, child);
+    }
+}
+#endif
+
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot)
 {
     _lv_obj_disable_style_caching(obj, true);
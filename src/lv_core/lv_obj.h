@@ -229,6 +229,9 @@ typedef struct _lv_obj_t {
 
     lv_drag_dir_t drag_dir  : 3; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir  : 2; /**< Base direction of texts related to this object */
+#if LV_USE_ANIMATION && LV_USE_ANIM_BATCH
+    uint8_t trans_inv       : 1; /**< 1: Invalidate the object before the next refresh (see `_lv_obj_trans_inv_flush`)*/
+#endif
 
 #if LV_USE_GROUP != 0
     void * group_p;
@@ -824,6 +827,14 @@ void lv_obj_clear_state(lv_obj_t * obj, lv_state_t state);
  * @param part part of the object, e.g `LV_BRN_PART_MAIN` or `LV_OBJ_PART_ALL` for all parts
  */
 void lv_obj_finish_transitions(lv_obj_t * obj, uint8_t part);
+
+#if LV_USE_ANIM_BATCH
+/**
+ * Invalidate the objects whose style transitions changed since the last call.
+ * Called before refreshing a display.
+ */
+void _lv_obj_trans_inv_flush(void);
+#endif
 #endif
 
 /**
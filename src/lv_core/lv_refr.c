@@ -15,6 +15,7 @@
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_profiler.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
@@ -29,20 +30,58 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/* Don't split the areas into tiles lower than this*/
+#define TILE_MIN_HEIGHT 16
+
+#if LV_USE_REFR_OCCLUSION
+/* Max. number of opaque objects checked when an object is drawn*/
+#define OCCLUSION_MAX_NUM   8
+
+/* Ignore the opaque objects which hide less than 1/OCCLUSION_MIN_RATIO of the area*/
+#define OCCLUSION_MIN_RATIO 32
+
+#define occluders       occluders_workers[_LV_WORKER_ID]
+#define occluder_cnt    occluder_cnt_workers[_LV_WORKER_ID]
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_REFR_OCCLUSION
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;     /*The part of the refreshed area hidden by `obj`*/
+    uint32_t size;      /*Size of `area`*/
+    bool drawn;         /*`obj` is drawn (or skipped) so it can't hide the next objects*/
+} occluder_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+#if LV_USE_REFR_AREA_MERGE
+    static void lv_refr_merge_closest(lv_disp_t * disp, const lv_area_t * area_p);
+    static bool lv_refr_cut_area(uint32_t keep, uint32_t cut);
+    static uint32_t lv_refr_get_area_pieces(lv_area_t * pieces, const lv_area_t * area_p, const lv_area_t * keep_p);
+    static uint32_t lv_refr_get_union_size(void);
+#endif
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_area_part_mask(const lv_area_t * start_mask);
+#if LV_USE_TILE_RENDER
+    static void lv_refr_tiles(const lv_area_t * start_mask);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static void lv_refr_obj_design(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode);
+#if LV_USE_REFR_OCCLUSION
+    static void lv_refr_get_occluders(lv_obj_t * top_p, const lv_area_t * area_p);
+    static void lv_refr_add_occluders(lv_obj_t * obj, const lv_area_t * clip_p, const lv_area_t * area_p);
+    static bool lv_refr_obj_is_occluded(lv_obj_t * obj, const lv_area_t * area_p);
+#endif
 static void lv_refr_vdb_flush(void);
 
 /**********************
@@ -54,6 +93,16 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
 #endif
+#if LV_USE_TILE_RENDER
+    static lv_area_t tile_areas[LV_TILE_RENDER_WORKER_NUM];
+#endif
+#if LV_USE_REFR_AREA_MERGE
+    static lv_refr_area_stat_t area_stat;
+#endif
+#if LV_USE_REFR_OCCLUSION
+    static occluder_t occluders_workers[_LV_WORKER_NUM][OCCLUSION_MAX_NUM];
+    static uint8_t occluder_cnt_workers[_LV_WORKER_NUM];
+#endif
 
 /**********************
  *      MACROS
@@ -138,12 +187,19 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         /*Save the area*/
         if(disp->inv_p < LV_INV_BUF_SIZE) {
             lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+            disp->inv_p++;
+        }
+#if LV_USE_REFR_AREA_MERGE
+        else {   /*If no place for the area merge it into the area which grows the least*/
+            lv_refr_merge_closest(disp, &com_area);
         }
+#else
         else {   /*If no place for the area add the screen*/
             disp->inv_p = 0;
             lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+            disp->inv_p++;
         }
-        disp->inv_p++;
+#endif
         lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
     }
 }
@@ -181,6 +237,10 @@ void _lv_disp_refr_task(lv_task_t * task)
 
     disp_refr = task->user_data;
 
+#if LV_USE_ANIMATION && LV_USE_ANIM_BATCH
+    _lv_obj_trans_inv_flush();
+#endif
+
 #if LV_USE_PERF_MONITOR == 0
     /* Ensure the task does not run again automatically.
      * This is done before refreshing in case refreshing invalidates something else.
@@ -194,7 +254,13 @@ void _lv_disp_refr_task(lv_task_t * task)
         return;
     }
 
-    lv_refr_join_area();
+    if(disp_refr->inv_p != 0) {
+        LV_PROFILER_FRAME_BEGIN();
+
+        LV_PROFILER_BEGIN(prof_join);
+        lv_refr_join_area();
+        LV_PROFILER_END(prof_join, LV_PROFILER_PHASE_JOIN, NULL);
+    }
 
     lv_refr_areas();
 
@@ -258,6 +324,8 @@ void _lv_disp_refr_task(lv_task_t * task)
             }
         } /*End of true double buffer handling*/
 
+        LV_PROFILER_FRAME_END();
+
         /*Clean up*/
         _lv_memset_00(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
         _lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
@@ -328,6 +396,31 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_USE_REFR_AREA_MERGE
+/**
+ * Get the redrawn and the really invalidated pixels of the refreshes
+ * @param stat pointer to a variable to store the counters
+ */
+void lv_refr_get_area_stat(lv_refr_area_stat_t * stat)
+{
+    _lv_memcpy_small(stat, &area_stat, sizeof(lv_refr_area_stat_t));
+}
+#endif
+
+#if LV_USE_TILE_RENDER
+/**
+ * Render a tile of the area being refreshed.
+ * Should be called from the display driver's `render_tiles_cb` on the worker whose ID is `tile_id`.
+ * @param tile_id index of the tile to render `[0 .. tile_cnt - 1]`
+ */
+void lv_refr_tile(uint32_t tile_id)
+{
+    if(tile_id >= LV_TILE_RENDER_WORKER_NUM) return;
+
+    lv_refr_area_part_mask(&tile_areas[tile_id]);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -337,6 +430,88 @@ uint32_t lv_refr_get_fps_avg(void)
  */
 static void lv_refr_join_area(void)
 {
+#if LV_USE_REFR_AREA_MERGE
+    if(disp_refr->inv_p == 0) return;
+
+    area_stat.px_ideal = lv_refr_get_union_size();
+    area_stat.px_ideal_sum += area_stat.px_ideal;
+
+    uint32_t i;
+    uint32_t j;
+    bool changed;
+
+    /*Join the areas while the extra pixels of the joined area cost less than one more area.
+     *Areas inside an other area have no extra pixels so they are always joined*/
+    do {
+        changed = false;
+        for(i = 0; i < disp_refr->inv_p; i++) {
+            if(disp_refr->inv_area_joined[i] != 0) continue;
+            for(j = i + 1; j < disp_refr->inv_p; j++) {
+                if(disp_refr->inv_area_joined[j] != 0) continue;
+
+                lv_area_t * a1 = &disp_refr->inv_areas[i];
+                lv_area_t * a2 = &disp_refr->inv_areas[j];
+                uint32_t covered = lv_area_get_size(a1) + lv_area_get_size(a2);
+                lv_area_t com_area;
+                if(_lv_area_intersect(&com_area, a1, a2)) covered -= lv_area_get_size(&com_area);
+
+                lv_area_t joined_area;
+                _lv_area_join(&joined_area, a1, a2);
+                if(lv_area_get_size(&joined_area) - covered <= LV_REFR_AREA_COST) {
+                    lv_area_copy(a1, &joined_area);
+                    disp_refr->inv_area_joined[j] = 1;
+                    changed = true;
+                }
+            }
+        }
+    } while(changed);
+
+    /*Remove the overlapping parts of the remaining areas to not draw them twice.
+     *Cut one of the areas or join them if the extra pixels cost less than the parts (or there is no place for the parts).
+     *With a rounder the parts might overlap again so don't cut them*/
+    if(disp_refr->driver.rounder_cb) return;
+
+    do {
+        changed = false;
+        for(i = 0; i < disp_refr->inv_p; i++) {
+            if(disp_refr->inv_area_joined[i] != 0) continue;
+            for(j = i + 1; j < disp_refr->inv_p; j++) {
+                if(disp_refr->inv_area_joined[j] != 0) continue;
+
+                lv_area_t * a1 = &disp_refr->inv_areas[i];
+                lv_area_t * a2 = &disp_refr->inv_areas[j];
+                lv_area_t com_area;
+                if(_lv_area_intersect(&com_area, a1, a2) == false) continue;
+
+                /*Cut the area which falls apart to less parts*/
+                lv_area_t pieces[4];
+                uint32_t cut_i_num = lv_refr_get_area_pieces(pieces, a1, a2);
+                uint32_t cut_j_num = lv_refr_get_area_pieces(pieces, a2, a1);
+                uint32_t piece_num = LV_MATH_MIN(cut_i_num, cut_j_num);
+
+                lv_area_t joined_area;
+                _lv_area_join(&joined_area, a1, a2);
+                uint32_t covered = lv_area_get_size(a1) + lv_area_get_size(a2) - lv_area_get_size(&com_area);
+                uint32_t join_cost = lv_area_get_size(&joined_area) - covered;
+                uint32_t cut_cost = piece_num > 0 ? (piece_num - 1) * LV_REFR_AREA_COST : 0;
+
+                bool cut_ok = false;
+                if(cut_cost < join_cost) {
+                    if(cut_i_num < cut_j_num) cut_ok = lv_refr_cut_area(j, i);
+                    else cut_ok = lv_refr_cut_area(i, j);
+                }
+
+                if(cut_ok == false) {
+                    lv_area_copy(a1, &joined_area);
+                    disp_refr->inv_area_joined[j] = 1;
+                }
+                changed = true;
+
+                if(disp_refr->inv_area_joined[i] != 0) break;
+            }
+        }
+    } while(changed);
+#else
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
@@ -367,8 +542,168 @@ static void lv_refr_join_area(void)
             }
         }
     }
+#endif
 }
 
+#if LV_USE_REFR_AREA_MERGE
+/**
+ * Merge an area into the invalidated area of a display which grows the least by it.
+ * Used when the buffer of the areas is full.
+ * @param disp pointer to a display
+ * @param area_p pointer to the area to merge
+ */
+static void lv_refr_merge_closest(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    uint32_t closest = 0;
+    uint32_t closest_grow = UINT32_MAX;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t joined_area;
+        _lv_area_join(&joined_area, &disp->inv_areas[i], area_p);
+        uint32_t grow = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+        if(grow < closest_grow) {
+            closest_grow = grow;
+            closest = i;
+        }
+    }
+
+    _lv_area_join(&disp->inv_areas[closest], &disp->inv_areas[closest], area_p);
+}
+
+/**
+ * Remove the common part of two invalidated areas from one of them.
+ * The first part of the cut area is stored in its place and the others in the joined or unused places.
+ * @param keep index of the area to keep
+ * @param cut index of the area to cut
+ * @return true: the area was cut; false: there is no place for the parts
+ */
+static bool lv_refr_cut_area(uint32_t keep, uint32_t cut)
+{
+    lv_area_t pieces[4];
+    uint32_t piece_num = lv_refr_get_area_pieces(pieces, &disp_refr->inv_areas[cut], &disp_refr->inv_areas[keep]);
+    if(piece_num == 0) {
+        disp_refr->inv_area_joined[cut] = 1;
+        return true;
+    }
+
+    /*Check if there is place for the new parts*/
+    uint32_t free_num = LV_INV_BUF_SIZE - disp_refr->inv_p;
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p && free_num < piece_num - 1; i++) {
+        if(disp_refr->inv_area_joined[i] != 0) free_num++;
+    }
+    if(free_num < piece_num - 1) return false;
+
+    lv_area_copy(&disp_refr->inv_areas[cut], &pieces[0]);
+
+    uint32_t p;
+    i = 0;
+    for(p = 1; p < piece_num; p++) {
+        while(i < disp_refr->inv_p && disp_refr->inv_area_joined[i] == 0) i++;
+        if(i == disp_refr->inv_p) disp_refr->inv_p++;
+        lv_area_copy(&disp_refr->inv_areas[i], &pieces[p]);
+        disp_refr->inv_area_joined[i] = 0;
+    }
+
+    return true;
+}
+
+/**
+ * Get the parts of an area which are not on an other area
+ * @param pieces store the parts here (max. 4)
+ * @param area_p pointer to an area
+ * @param keep_p pointer to an area which is on `area_p`
+ * @return number of parts
+ */
+static uint32_t lv_refr_get_area_pieces(lv_area_t * pieces, const lv_area_t * area_p, const lv_area_t * keep_p)
+{
+    uint32_t num = 0;
+    lv_coord_t y1 = LV_MATH_MAX(area_p->y1, keep_p->y1);
+    lv_coord_t y2 = LV_MATH_MIN(area_p->y2, keep_p->y2);
+
+    if(area_p->y1 < keep_p->y1) {
+        lv_area_set(&pieces[num], area_p->x1, area_p->y1, area_p->x2, keep_p->y1 - 1);
+        num++;
+    }
+    if(area_p->y2 > keep_p->y2) {
+        lv_area_set(&pieces[num], area_p->x1, keep_p->y2 + 1, area_p->x2, area_p->y2);
+        num++;
+    }
+    if(area_p->x1 < keep_p->x1) {
+        lv_area_set(&pieces[num], area_p->x1, y1, keep_p->x1 - 1, y2);
+        num++;
+    }
+    if(area_p->x2 > keep_p->x2) {
+        lv_area_set(&pieces[num], keep_p->x2 + 1, y1, area_p->x2, y2);
+        num++;
+    }
+
+    return num;
+}
+
+/**
+ * Get the number of pixels covered by the invalidated areas (counting the common parts only once)
+ * @return number of pixels
+ */
+static uint32_t lv_refr_get_union_size(void)
+{
+    /*Sort the top and bottom edges of the areas to get horizontal bands*/
+    lv_coord_t ys[LV_INV_BUF_SIZE * 2];
+    uint32_t y_num = 0;
+    uint32_t i;
+    uint32_t k;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        lv_coord_t edges[2] = {disp_refr->inv_areas[i].y1, disp_refr->inv_areas[i].y2 + 1};
+        uint32_t e;
+        for(e = 0; e < 2; e++) {
+            k = 0;
+            while(k < y_num && ys[k] < edges[e]) k++;
+            if(k < y_num && ys[k] == edges[e]) continue;
+
+            uint32_t m;
+            for(m = y_num; m > k; m--) ys[m] = ys[m - 1];
+            ys[k] = edges[e];
+            y_num++;
+        }
+    }
+
+    /*Add the length of the areas' sorted and merged horizontal ranges in every band*/
+    uint32_t size = 0;
+    uint32_t b;
+    for(b = 0; b + 1 < y_num; b++) {
+        lv_coord_t x1s[LV_INV_BUF_SIZE];
+        lv_coord_t x2s[LV_INV_BUF_SIZE];
+        uint32_t x_num = 0;
+        for(i = 0; i < disp_refr->inv_p; i++) {
+            const lv_area_t * a = &disp_refr->inv_areas[i];
+            if(a->y1 > ys[b] || a->y2 < ys[b + 1] - 1) continue;
+
+            k = x_num;
+            while(k > 0 && x1s[k - 1] > a->x1) {
+                x1s[k] = x1s[k - 1];
+                x2s[k] = x2s[k - 1];
+                k--;
+            }
+            x1s[k] = a->x1;
+            x2s[k] = a->x2;
+            x_num++;
+        }
+
+        uint32_t w = 0;
+        lv_coord_t x_end = LV_COORD_MIN;
+        for(k = 0; k < x_num; k++) {
+            if(x2s[k] <= x_end) continue;
+            w += x2s[k] - LV_MATH_MAX(x1s[k] - 1, x_end);
+            x_end = x2s[k];
+        }
+
+        size += w * (ys[b + 1] - ys[b]);
+    }
+
+    return size;
+}
+#endif
+
 /**
  * Refresh the joined areas
  */
@@ -378,6 +713,10 @@ static void lv_refr_areas(void)
 
     if(disp_refr->inv_p == 0) return;
 
+#if LV_USE_REFR_AREA_MERGE
+    area_stat.area_cnt = 0;
+#endif
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -400,8 +739,16 @@ static void lv_refr_areas(void)
             lv_refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+#if LV_USE_REFR_AREA_MERGE
+            area_stat.area_cnt++;
+#endif
         }
     }
+
+#if LV_USE_REFR_AREA_MERGE
+    area_stat.px_drawn = px_num;
+    area_stat.px_drawn_sum += px_num;
+#endif
 }
 
 /**
@@ -508,18 +855,76 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         }
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
-
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     _lv_area_intersect(&start_mask, area_p, &vdb->area);
 
+#if LV_USE_TILE_RENDER
+    lv_refr_tiles(&start_mask);
+#else
+    lv_refr_area_part_mask(&start_mask);
+#endif
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+#if LV_USE_TILE_RENDER
+/**
+ * Split an area into horizontal tiles and let the display driver render them in parallel.
+ * The tiles are rendered into their own rows of the VDB so they don't overlap.
+ * @param start_mask the area to render (absolute coordinates, inside the VDB)
+ */
+static void lv_refr_tiles(const lv_area_t * start_mask)
+{
+    lv_coord_t h = lv_area_get_height(start_mask);
+    uint32_t tile_cnt = h / TILE_MIN_HEIGHT;
+    if(tile_cnt > LV_TILE_RENDER_WORKER_NUM) tile_cnt = LV_TILE_RENDER_WORKER_NUM;
+
+    if(tile_cnt < 2 || disp_refr->driver.render_tiles_cb == NULL) {
+        lv_refr_area_part_mask(start_mask);
+        return;
+    }
+
+    lv_coord_t y = start_mask->y1;
+    uint32_t i;
+    for(i = 0; i < tile_cnt; i++) {
+        lv_coord_t tile_h = (h - (y - start_mask->y1)) / (tile_cnt - i);
+        tile_areas[i].x1 = start_mask->x1;
+        tile_areas[i].x2 = start_mask->x2;
+        tile_areas[i].y1 = y;
+        tile_areas[i].y2 = y + tile_h - 1;
+        y += tile_h;
+    }
+
+    disp_refr->driver.render_tiles_cb(&disp_refr->driver, tile_cnt);
+}
+#endif
+
+/**
+ * Draw the screens and the layers on an area of the VDB.
+ * @param start_mask the area to draw (absolute coordinates, inside the VDB)
+ */
+static void lv_refr_area_part_mask(const lv_area_t * start_mask)
+{
+    lv_obj_t * top_act_scr = NULL;
+    lv_obj_t * top_prev_scr = NULL;
+
+    /*The draw temporaries taken from the arena are dropped when the area is ready*/
+    uint32_t arena_mark = _lv_mem_buf_arena_get_mark();
+
+#if LV_USE_REFR_OCCLUSION
+    occluder_cnt = 0;
+#endif
+
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
+    top_act_scr = lv_refr_get_top_obj(start_mask, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
+        top_prev_scr = lv_refr_get_top_obj(start_mask, disp_refr->prev_scr);
     }
 
     /*Draw a display background if there is no top object*/
@@ -534,7 +939,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             if(res == LV_RES_OK) {
                 lv_area_t a;
                 lv_area_set(&a, 0, 0, header.w - 1, header.h - 1);
-                lv_draw_img(&a, &start_mask, disp_refr->bg_img, &dsc);
+                lv_draw_img(&a, start_mask, disp_refr->bg_img, &dsc);
             }
             else {
                 LV_LOG_WARN("Can't draw the background image")
@@ -545,7 +950,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             lv_draw_rect_dsc_init(&dsc);
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
-            lv_draw_rect(&start_mask, &start_mask, &dsc);
+            lv_draw_rect(start_mask, start_mask, &dsc);
 
         }
     }
@@ -556,25 +961,37 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             top_prev_scr = disp_refr->prev_scr;
         }
         /*Do the refreshing from the top object*/
-        lv_refr_obj_and_children(top_prev_scr, &start_mask);
+        LV_PROFILER_BEGIN(prof_prev_scr);
+        lv_refr_obj_and_children(top_prev_scr, start_mask);
+        LV_PROFILER_END(prof_prev_scr, LV_PROFILER_PHASE_REFR_OBJ, "prev_scr");
 
     }
 
     if(top_act_scr == NULL) {
         top_act_scr = disp_refr->act_scr;
     }
+
+#if LV_USE_REFR_OCCLUSION
+    /*Find the opaque objects of the actual screen which can hide the objects drawn before them.
+     *The previous screen is drawn below the actual one (e.g. in screen load animations) so don't skip its objects.*/
+    if(disp_refr->prev_scr == NULL) lv_refr_get_occluders(top_act_scr, start_mask);
+#endif
     /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_act_scr, &start_mask);
+    LV_PROFILER_BEGIN(prof_act_scr);
+    lv_refr_obj_and_children(top_act_scr, start_mask);
+    LV_PROFILER_END(prof_act_scr, LV_PROFILER_PHASE_REFR_OBJ, "act_scr");
+
+#if LV_USE_REFR_OCCLUSION
+    occluder_cnt = 0;
+#endif
 
     /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    LV_PROFILER_BEGIN(prof_layers);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), start_mask);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), start_mask);
+    LV_PROFILER_END(prof_layers, LV_PROFILER_PHASE_REFR_OBJ, "layers");
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
-    }
+    _lv_mem_buf_arena_rewind(arena_mark);
 }
 
 /**
@@ -653,7 +1070,7 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
         }
 
         /*Call the post draw design function of the parents of the to object*/
-        if(par->design_cb) par->design_cb(par, mask_p, LV_DESIGN_DRAW_POST);
+        lv_refr_obj_design(par, mask_p, LV_DESIGN_DRAW_POST);
 
         /*The new border will be there last parents,
          *so the 'younger' brothers of parent will be refreshed*/
@@ -687,11 +1104,16 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     obj_area.y2 += ext_size;
     union_ok = _lv_area_intersect(&obj_ext_mask, mask_ori_p, &obj_area);
 
+#if LV_USE_REFR_OCCLUSION
+    /*Skip the object and its children if an opaque object drawn later hides them*/
+    if(union_ok != false && lv_refr_obj_is_occluded(obj, &obj_ext_mask)) return;
+#endif
+
     /*Draw the parent and its children only if they ore on 'mask_parent'*/
     if(union_ok != false) {
 
         /* Redraw the object */
-        if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        lv_refr_obj_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -737,10 +1159,189 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         }
 
         /* If all the children are redrawn make 'post draw' design */
-        if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+        lv_refr_obj_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+    }
+}
+
+/**
+ * Call the design callback of an object (if any)
+ * @param obj pointer to an object
+ * @param mask_p the object can be drawn only here
+ * @param mode `LV_DESIGN_DRAW_MAIN` or `LV_DESIGN_DRAW_POST`
+ */
+static void lv_refr_obj_design(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode)
+{
+    if(obj->design_cb == NULL) return;
+
+    LV_PROFILER_BEGIN(prof_design);
+    obj->design_cb(obj, mask_p, mode);
+#if LV_USE_PROFILER
+    lv_obj_type_t types;
+    lv_obj_get_type(obj, &types);
+    LV_PROFILER_END(prof_design, LV_PROFILER_PHASE_DESIGN, types.type[0]);
+#endif
+}
+
+#if LV_USE_REFR_OCCLUSION
+/**
+ * Collect the largest opaque objects which are drawn from a top object on an area.
+ * The objects are checked in the same order as `lv_refr_obj_and_children` draws them.
+ * @param top_p the drawing starts from this object
+ * @param area_p the area to refresh
+ */
+static void lv_refr_get_occluders(lv_obj_t * top_p, const lv_area_t * area_p)
+{
+    occluder_cnt = 0;
+    if(top_p == NULL) return;
+
+    /*The objects are visible only on their parents*/
+    lv_area_t clip;
+    lv_area_copy(&clip, area_p);
+    lv_obj_t * par = lv_obj_get_parent(top_p);
+    while(par != NULL) {
+        if(_lv_area_intersect(&clip, &clip, &par->coords) == false) return;
+        par = lv_obj_get_parent(par);
+    }
+
+    lv_obj_t * obj = top_p;
+    par = lv_obj_get_parent(top_p);
+    lv_refr_add_occluders(obj, &clip, area_p);
+
+    /*The 'younger' siblings of the top object and its parents are drawn too*/
+    while(par != NULL) {
+        /*Get the area where the children of `par` are visible*/
+        lv_area_copy(&clip, area_p);
+        lv_obj_t * i = par;
+        while(i != NULL) {
+            _lv_area_intersect(&clip, &clip, &i->coords);
+            i = lv_obj_get_parent(i);
+        }
+
+        i = _lv_ll_get_prev(&par->child_ll, obj);
+        while(i != NULL) {
+            lv_refr_add_occluders(i, &clip, area_p);
+            i = _lv_ll_get_prev(&par->child_ll, i);
+        }
+
+        obj = par;
+        par = lv_obj_get_parent(par);
     }
 }
 
+/**
+ * Add an object and its children to the opaque objects if they cover a large enough part of the area.
+ * Only the `OCCLUSION_MAX_NUM` largest parts are kept. (Called recursively)
+ * @param obj pointer to an object
+ * @param clip_p `obj` is visible only here
+ * @param area_p the area to refresh
+ */
+static void lv_refr_add_occluders(lv_obj_t * obj, const lv_area_t * clip_p, const lv_area_t * area_p)
+{
+    if(obj->hidden) return;
+
+    lv_area_t part;
+    if(_lv_area_intersect(&part, clip_p, &obj->coords) == false) return;
+
+    uint32_t min_size = lv_area_get_size(area_p) / OCCLUSION_MIN_RATIO;
+    uint32_t part_size = lv_area_get_size(&part);
+
+    /*The children are visible only on the same part so they can't hide more*/
+    if(part_size < min_size) return;
+    if(occluder_cnt == OCCLUSION_MAX_NUM && part_size <= occluders[OCCLUSION_MAX_NUM - 1].size) return;
+
+    lv_design_res_t design_res = obj->design_cb(obj, &part, LV_DESIGN_COVER_CHK);
+
+    /*The children are masked by `obj` so they don't hide the objects drawn before `obj`*/
+    if(design_res == LV_DESIGN_RES_MASKED) return;
+
+    /*The rounded corners don't cover so try without the bands of the corners*/
+    if(design_res == LV_DESIGN_RES_NOT_COVER) {
+        lv_coord_t r = lv_obj_get_style_radius(obj, LV_OBJ_PART_MAIN);
+        if(r > 0 && r < lv_area_get_height(&obj->coords) / 2) {
+            lv_area_t inner;
+            lv_area_copy(&inner, &part);
+            inner.y1 = LV_MATH_MAX(part.y1, obj->coords.y1 + r);
+            inner.y2 = LV_MATH_MIN(part.y2, obj->coords.y2 - r);
+            if(inner.y1 <= inner.y2 && lv_area_get_size(&inner) >= min_size) {
+                design_res = obj->design_cb(obj, &inner, LV_DESIGN_COVER_CHK);
+                if(design_res == LV_DESIGN_RES_COVER) lv_area_copy(&part, &inner);
+            }
+        }
+    }
+
+#if LV_USE_OPA_SCALE
+    if(design_res == LV_DESIGN_RES_COVER && lv_obj_get_style_opa_scale(obj, LV_OBJ_PART_MAIN) != LV_OPA_COVER) {
+        design_res = LV_DESIGN_RES_NOT_COVER;
+    }
+#endif
+
+    if(design_res == LV_DESIGN_RES_COVER) {
+        /*Insert it by size and drop the smallest if there is no more space*/
+        uint32_t size = lv_area_get_size(&part);
+        uint8_t i = occluder_cnt < OCCLUSION_MAX_NUM ? occluder_cnt : OCCLUSION_MAX_NUM - 1;
+        if(i == occluder_cnt || size > occluders[i].size) {
+            while(i > 0 && occluders[i - 1].size < size) {
+                occluders[i] = occluders[i - 1];
+                i--;
+            }
+            occluders[i].obj = obj;
+            lv_area_copy(&occluders[i].area, &part);
+            occluders[i].size = size;
+            occluders[i].drawn = false;
+            if(occluder_cnt < OCCLUSION_MAX_NUM) occluder_cnt++;
+        }
+    }
+
+    lv_obj_t * child;
+    _LV_LL_READ_BACK(obj->child_ll, child) {
+        lv_refr_add_occluders(child, &part, area_p);
+    }
+}
+
+/**
+ * Check whether an object is hidden by an opaque object drawn after it.
+ * Called before drawing an object.
+ * @param obj pointer to an object
+ * @param area_p the area where `obj` and its children would be drawn
+ * @return true: `obj` and its children can be skipped
+ */
+static bool lv_refr_obj_is_occluded(lv_obj_t * obj, const lv_area_t * area_p)
+{
+    uint8_t i;
+    bool occluded = false;
+    for(i = 0; i < occluder_cnt; i++) {
+        occluder_t * occ = &occluders[i];
+        if(occ->drawn) continue;
+
+        /*Reached an opaque object. It hides only the objects drawn before it.*/
+        if(occ->obj == obj) {
+            occ->drawn = true;
+            continue;
+        }
+
+        if(occluded == false && _lv_area_is_in(area_p, &occ->area, 0)) {
+            /*The children of `obj` are drawn on `obj`*/
+            lv_obj_t * par = occ->obj;
+            while(par != NULL && par != obj) par = lv_obj_get_parent(par);
+            if(par == NULL) occluded = true;
+        }
+    }
+
+    /*The opaque children of a skipped object won't be drawn*/
+    if(occluded) {
+        for(i = 0; i < occluder_cnt; i++) {
+            occluder_t * occ = &occluders[i];
+            if(occ->drawn) continue;
+            lv_obj_t * par = occ->obj;
+            while(par != NULL && par != obj) par = lv_obj_get_parent(par);
+            if(par == obj) occ->drawn = true;
+        }
+    }
+
+    return occluded;
+}
+#endif
+
 static void lv_refr_vdb_rotate_180(lv_disp_drv_t *drv, lv_area_t *area, lv_color_t *color_p) {
     lv_coord_t area_w = lv_area_get_width(area);
     lv_coord_t area_h = lv_area_get_height(area);
@@ -924,12 +1525,14 @@ static void lv_refr_vdb_flush(void)
     if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
 
     if(disp->driver.flush_cb) {
+        LV_PROFILER_BEGIN(prof_flush);
         /*Rotate the buffer to the display's native orientation if necessary*/
         if(disp->driver.rotated != LV_DISP_ROT_NONE && disp->driver.sw_rotate) {
             lv_refr_vdb_rotate(&vdb->area, vdb->buf_act);
         } else {
             disp->driver.flush_cb(&disp->driver, &vdb->area, color_p);
         }
+        LV_PROFILER_END(prof_flush, LV_PROFILER_PHASE_FLUSH, NULL);
     }
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
@@ -26,6 +26,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_REFR_AREA_MERGE
+/** Pixel counters of the refreshes*/
+typedef struct {
+    uint32_t px_drawn;      /**< Pixels redrawn in the last refresh*/
+    uint32_t px_ideal;      /**< Pixels really invalidated in the last refresh (the union of the areas)*/
+    uint32_t area_cnt;      /**< Number of areas redrawn in the last refresh*/
+    uint32_t px_drawn_sum;  /**< Pixels redrawn since start up*/
+    uint32_t px_ideal_sum;  /**< Pixels really invalidated since start up*/
+} lv_refr_area_stat_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -86,6 +97,23 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_USE_REFR_AREA_MERGE
+/**
+ * Get the redrawn and the really invalidated pixels of the refreshes
+ * @param stat pointer to a variable to store the counters
+ */
+void lv_refr_get_area_stat(lv_refr_area_stat_t * stat);
+#endif
+
+#if LV_USE_TILE_RENDER
+/**
+ * Render a tile of the area being refreshed.
+ * Should be called from the display driver's `render_tiles_cb` on the worker whose ID is `tile_id`.
+ * @param tile_id index of the tile to render `[0 .. tile_cnt - 1]`
+ */
+void lv_refr_tile(uint32_t tile_id);
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
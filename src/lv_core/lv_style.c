@@ -12,15 +12,40 @@
 /*********************
  *      DEFINES
  *********************/
+#define STYLE_PROP_ID_CNT   0xE0    /*Property IDs are `(group << 4) + id` with `group <= 0xD`*/
+#define STYLE_PROP_WORD_CNT (STYLE_PROP_ID_CNT / 32)
+
+#if LV_USE_STYLE_FLAT_CACHE
+#define STYLE_FLAT_GROW     8       /*Number of values to allocate at once*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_STYLE_FLAT_CACHE
+typedef struct _lv_style_flat_t {
+    uint32_t resolved[STYLE_PROP_WORD_CNT];     /*1 bit for every resolved property ID*/
+    uint8_t prev_cnt[STYLE_PROP_WORD_CNT];      /*Number of resolved properties in the previous words*/
+    uint8_t cnt;                                /*Number of resolved properties*/
+    uint8_t size;                               /*Number of allocated values*/
+    uint8_t state;                              /*The state in which the properties were resolved*/
+    lv_style_value_t * values;                  /*The values of the resolved properties ordered by ID*/
+} lv_style_flat_t;
+#endif
+
+#if LV_USE_STYLE_INDEX
+typedef struct _lv_style_index_t {
+    uint32_t has[STYLE_PROP_WORD_CNT];      /*1 bit for every property ID in the style*/
+    uint16_t cnt;                           /*Number of properties in the style*/
+    uint16_t * ofs;                         /*Index of the properties in `map` ordered by ID*/
+} lv_style_index_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t * style, lv_style_property_t prop);
+LV_ATTRIBUTE_FAST_MEM static inline int32_t find_property_index(const lv_style_t * style, lv_style_property_t prop);
 static lv_style_t * get_alloc_local_style(lv_style_list_t * list);
 static inline bool style_resize(lv_style_t * style, size_t sz);
 static inline lv_style_property_t get_style_prop(const lv_style_t * style, size_t idx);
@@ -28,6 +53,14 @@ static inline uint8_t get_style_prop_id(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_attr(const lv_style_t * style, size_t idx);
 static inline size_t get_prop_size(uint8_t prop_id);
 static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
+#if LV_USE_STYLE_FLAT_CACHE
+static inline uint32_t flat_get_index(const lv_style_flat_t * flat, uint8_t id);
+static void flat_free(lv_style_list_t * list);
+#endif
+#if LV_USE_STYLE_INDEX
+static void index_build(lv_style_t * style);
+static void index_free(lv_style_t * style);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -69,6 +102,9 @@ void lv_style_copy(lv_style_t * style_dest, const lv_style_t * style_src)
     uint16_t size = _lv_style_get_mem_size(style_src);
     if(size == 0) return;
 
+#if LV_USE_STYLE_INDEX
+    index_free(style_dest);
+#endif
     style_dest->map = lv_mem_alloc(size);
     if(style_dest->map)
         _lv_memcpy(style_dest->map, style_src->map, size);
@@ -214,6 +250,10 @@ void _lv_style_list_add_style(lv_style_list_t * list, lv_style_t * style)
     new_styles[first_style] = style;
     list->style_cnt++;
     list->style_list = new_styles;
+
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, LV_STYLE_PROP_ALL);
+#endif
 }
 
 /**
@@ -239,6 +279,10 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
     }
     if(found == false) return;
 
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, LV_STYLE_PROP_ALL);
+#endif
+
     if(list->style_cnt == 1) {
         lv_mem_free(list->style_list);
         list->style_list = NULL;
@@ -299,6 +343,10 @@ void _lv_style_list_reset(lv_style_list_t * list)
     list->has_trans = 0;
     list->skip_trans = 0;
 
+#if LV_USE_STYLE_FLAT_CACHE
+    flat_free(list);
+#endif
+
     /* Intentionally leave `ignore_trans` as it is,
      * because it's independent from the styles in the list*/
 }
@@ -309,6 +357,9 @@ void _lv_style_list_reset(lv_style_list_t * list)
  */
 void lv_style_reset(lv_style_t * style)
 {
+#if LV_USE_STYLE_INDEX
+    index_free(style);
+#endif
     lv_mem_free(style->map);
     lv_style_init(style);
 }
@@ -517,7 +568,7 @@ void _lv_style_set_ptr(lv_style_t * style, lv_style_property_t prop, const void
  */
 int16_t _lv_style_get_int(const lv_style_t * style, lv_style_property_t prop, lv_style_int_t * res)
 {
-    int32_t id = get_property_index(style, prop);
+    int32_t id = find_property_index(style, prop);
     if(id < 0) {
         return -1;
     }
@@ -545,7 +596,7 @@ int16_t _lv_style_get_int(const lv_style_t * style, lv_style_property_t prop, lv
  */
 int16_t _lv_style_get_opa(const lv_style_t * style, lv_style_property_t prop, lv_opa_t * res)
 {
-    int32_t id = get_property_index(style, prop);
+    int32_t id = find_property_index(style, prop);
     if(id < 0) {
         return -1;
     }
@@ -573,7 +624,7 @@ int16_t _lv_style_get_opa(const lv_style_t * style, lv_style_property_t prop, lv
  */
 int16_t _lv_style_get_color(const lv_style_t * style, lv_style_property_t prop, lv_color_t * res)
 {
-    int32_t id = get_property_index(style, prop);
+    int32_t id = find_property_index(style, prop);
     if(id < 0) {
         return -1;
     }
@@ -601,7 +652,7 @@ int16_t _lv_style_get_color(const lv_style_t * style, lv_style_property_t prop,
  */
 int16_t _lv_style_get_ptr(const lv_style_t * style, lv_style_property_t prop, const void ** res)
 {
-    int32_t id = get_property_index(style, prop);
+    int32_t id = find_property_index(style, prop);
     if(id < 0) {
         return -1;
     }
@@ -686,6 +737,10 @@ void _lv_style_list_set_local_int(lv_style_list_t * list, lv_style_property_t pr
 
     lv_style_t * local = get_alloc_local_style(list);
     _lv_style_set_int(local, prop, value);
+
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, prop);
+#endif
 }
 
 /**
@@ -702,6 +757,10 @@ void _lv_style_list_set_local_opa(lv_style_list_t * list, lv_style_property_t pr
 
     lv_style_t * local = get_alloc_local_style(list);
     _lv_style_set_opa(local, prop, value);
+
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, prop);
+#endif
 }
 
 /**
@@ -718,6 +777,10 @@ void _lv_style_list_set_local_color(lv_style_list_t * list, lv_style_property_t
 
     lv_style_t * local = get_alloc_local_style(list);
     _lv_style_set_color(local, prop, value);
+
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, prop);
+#endif
 }
 
 /**
@@ -734,6 +797,10 @@ void _lv_style_list_set_local_ptr(lv_style_list_t * list, lv_style_property_t pr
 
     lv_style_t * local = get_alloc_local_style(list);
     _lv_style_set_ptr(local, prop, value);
+
+#if LV_USE_STYLE_FLAT_CACHE
+    _lv_style_list_invalidate_flat(list, prop);
+#endif
 }
 
 /**
@@ -938,6 +1005,141 @@ lv_res_t _lv_style_list_get_ptr(lv_style_list_t * list, lv_style_property_t prop
     else return LV_RES_INV;
 }
 
+#if LV_USE_STYLE_FLAT_CACHE
+/**
+ * Get an already resolved property from the flat cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state in which it was resolved.
+ * E.g. `LV_STYLE_BORDER_WIDTH | (LV_STATE_PRESSED << LV_STYLE_STATE_POS)`
+ * @param res pointer to a buffer to store the result
+ * @return LV_RES_OK: the property is resolved in the given state
+ *         LV_RES_INV: the property is not resolved yet
+ */
+lv_res_t _lv_style_list_get_flat(lv_style_list_t * list, lv_style_property_t prop, lv_style_value_t * res)
+{
+    uint8_t id = prop & LV_STYLE_ID_MASK;
+    uint8_t state = (prop & LV_STYLE_STATE_MASK) >> LV_STYLE_STATE_POS;
+    if(id >= STYLE_PROP_ID_CNT) return LV_RES_INV;
+
+    lv_res_t found = LV_RES_INV;
+
+    /*The objects might be drawn by more workers at once*/
+    _LV_WORKER_LOCK();
+    lv_style_flat_t * flat = list->flat;
+    if(flat && flat->state == state && (flat->resolved[id >> 5] & ((uint32_t)1 << (id & 0x1F)))) {
+        *res = flat->values[flat_get_index(flat, id)];
+        found = LV_RES_OK;
+    }
+    _LV_WORKER_UNLOCK();
+
+    return found;
+}
+
+/**
+ * Save a resolved property in the flat cache of a style list.
+ * The properties resolved in an other state are dropped.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state in which it was resolved.
+ * @param value the resolved value
+ */
+void _lv_style_list_set_flat(lv_style_list_t * list, lv_style_property_t prop, const lv_style_value_t * value)
+{
+    uint8_t id = prop & LV_STYLE_ID_MASK;
+    uint8_t state = (prop & LV_STYLE_STATE_MASK) >> LV_STYLE_STATE_POS;
+    if(id >= STYLE_PROP_ID_CNT) return;
+
+    _LV_WORKER_LOCK();
+    lv_style_flat_t * flat = list->flat;
+    if(flat == NULL) {
+        flat = lv_mem_alloc(sizeof(lv_style_flat_t));
+        if(flat == NULL) {
+            _LV_WORKER_UNLOCK();
+            return;
+        }
+        _lv_memset_00(flat, sizeof(lv_style_flat_t));
+        flat->state = state;
+        list->flat = flat;
+    }
+    else if(flat->state != state) {
+        /*Start again in the new state but keep the allocated values*/
+        _lv_memset_00(flat->resolved, sizeof(flat->resolved));
+        _lv_memset_00(flat->prev_cnt, sizeof(flat->prev_cnt));
+        flat->cnt = 0;
+        flat->state = state;
+    }
+
+    uint8_t w = id >> 5;
+    uint32_t bit = (uint32_t)1 << (id & 0x1F);
+    uint32_t i = flat_get_index(flat, id);
+
+    /*Might be resolved by an other worker in the meantime*/
+    if(flat->resolved[w] & bit) {
+        flat->values[i] = *value;
+        _LV_WORKER_UNLOCK();
+        return;
+    }
+
+    if(flat->cnt == flat->size) {
+        lv_style_value_t * new_values = lv_mem_realloc(flat->values, (flat->size + STYLE_FLAT_GROW) * sizeof(lv_style_value_t));
+        if(new_values == NULL) {
+            _LV_WORKER_UNLOCK();
+            return;
+        }
+        flat->values = new_values;
+        flat->size += STYLE_FLAT_GROW;
+    }
+
+    /*Make space for the new value to keep the values ordered by ID*/
+    uint32_t j;
+    for(j = flat->cnt; j > i; j--) {
+        flat->values[j] = flat->values[j - 1];
+    }
+    flat->values[i] = *value;
+    flat->cnt++;
+    flat->resolved[w] |= bit;
+    for(w++; w < STYLE_PROP_WORD_CNT; w++) flat->prev_cnt[w]++;
+
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Drop a resolved property from the flat cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property or `LV_STYLE_PROP_ALL` to drop all of them
+ */
+void _lv_style_list_invalidate_flat(lv_style_list_t * list, lv_style_property_t prop)
+{
+    _LV_WORKER_LOCK();
+    lv_style_flat_t * flat = list->flat;
+    if(flat == NULL) {
+        _LV_WORKER_UNLOCK();
+        return;
+    }
+
+    uint8_t id = prop & LV_STYLE_ID_MASK;
+    if(id >= STYLE_PROP_ID_CNT) {
+        /*`LV_STYLE_PROP_ALL`: keep the allocated values for the next resolutions*/
+        _lv_memset_00(flat->resolved, sizeof(flat->resolved));
+        _lv_memset_00(flat->prev_cnt, sizeof(flat->prev_cnt));
+        flat->cnt = 0;
+    }
+    else {
+        uint8_t w = id >> 5;
+        uint32_t bit = (uint32_t)1 << (id & 0x1F);
+        if(flat->resolved[w] & bit) {
+            uint32_t j;
+            for(j = flat_get_index(flat, id); j < flat->cnt - 1U; j++) {
+                flat->values[j] = flat->values[j + 1];
+            }
+            flat->cnt--;
+            flat->resolved[w] &= ~bit;
+            for(w++; w < STYLE_PROP_WORD_CNT; w++) flat->prev_cnt[w]--;
+        }
+    }
+    _LV_WORKER_UNLOCK();
+}
+#endif
+
 /**
  * Check whether a style is valid (initialized correctly)
  * @param style pointer to a style
@@ -1004,6 +1206,46 @@ LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t
 
     size_t i = 0;
 
+#if LV_USE_STYLE_INDEX
+    lv_style_index_t * index = style->index;
+    if(index) {
+        /*Quickly skip the styles without this property*/
+        if(id_to_find >= STYLE_PROP_ID_CNT) return -1;
+        if((index->has[id_to_find >> 5] & ((uint32_t)1 << (id_to_find & 0x1F))) == 0) return -1;
+
+        /*Find the first property with this ID. The other states of it are after it.*/
+        uint32_t first = 0;
+        uint32_t last = index->cnt;
+        while(first < last) {
+            uint32_t mid = (first + last) >> 1;
+            if(get_style_prop_id(style, index->ofs[mid]) < id_to_find) first = mid + 1;
+            else last = mid;
+        }
+
+        for(; first < index->cnt; first++) {
+            i = index->ofs[first];
+            if(get_style_prop_id(style, i) != id_to_find) break;
+
+            lv_style_attr_t attr_i;
+            attr_i = get_style_prop_attr(style, i);
+
+            /*If the state perfectly matches return this property*/
+            if(LV_STYLE_ATTR_GET_STATE(attr_i) == LV_STYLE_ATTR_GET_STATE(attr)) {
+                return i;
+            }
+            /*Be sure the property not specifies other state than the requested*/
+            else if((LV_STYLE_ATTR_GET_STATE(attr_i) & (~LV_STYLE_ATTR_GET_STATE(attr))) == 0) {
+                if(LV_STYLE_ATTR_GET_STATE(attr_i) > weight) {
+                    weight = LV_STYLE_ATTR_GET_STATE(attr_i);
+                    id_guess = i;
+                }
+            }
+        }
+
+        return id_guess;
+    }
+#endif
+
     uint8_t prop_id;
     while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
         if(prop_id == id_to_find) {
@@ -1032,6 +1274,22 @@ LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t
     return id_guess;
 }
 
+/**
+ * Get a property's index like `get_property_index()` but index the style first if enabled.
+ * Used when the properties are read, not when they are set.
+ * @param style pointer to a style
+ * @param prop a style property ORed with a state.
+ * @return the index of the best matching property in `style->map` or -1 if not found
+ */
+LV_ATTRIBUTE_FAST_MEM static inline int32_t find_property_index(const lv_style_t * style, lv_style_property_t prop)
+{
+#if LV_USE_STYLE_INDEX
+    if(style && style->map && style->index == NULL) index_build((lv_style_t *)style);
+#endif
+
+    return get_property_index(style, prop);
+}
+
 /**
  * Get the local style from a style list. Allocate it if not exists yet.
  * @param list pointer to a style list
@@ -1065,6 +1323,11 @@ static lv_style_t * get_alloc_local_style(lv_style_list_t * list)
  */
 static inline bool style_resize(lv_style_t * style, size_t sz)
 {
+#if LV_USE_STYLE_INDEX
+    /*Properties are added or removed so the index is outdated*/
+    index_free(style);
+#endif
+
     uint8_t * new_map = lv_mem_realloc(style->map, sz);
     if(sz && new_map == NULL) return false;
     style->map = new_map;
@@ -1132,3 +1395,103 @@ static inline size_t get_next_prop_index(uint8_t prop_id, size_t idx)
 {
     return idx + get_prop_size(prop_id);
 }
+
+#if LV_USE_STYLE_FLAT_CACHE
+/**
+ * Get the index of a property in the values of a flat cache.
+ * The resolved properties with smaller ID are stored before it.
+ * @param flat pointer to a flat cache
+ * @param id ID of a property (`prop & LV_STYLE_ID_MASK`)
+ * @return index in `flat->values`
+ */
+static inline uint32_t flat_get_index(const lv_style_flat_t * flat, uint8_t id)
+{
+    uint32_t v = flat->resolved[id >> 5] & (((uint32_t)1 << (id & 0x1F)) - 1);
+
+    /*Count the set bits*/
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    v = (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+
+    return flat->prev_cnt[id >> 5] + v;
+}
+
+/**
+ * Free the flat cache of a style list
+ * @param list pointer to a style list
+ */
+static void flat_free(lv_style_list_t * list)
+{
+    _LV_WORKER_LOCK();
+    if(list->flat) {
+        if(list->flat->values) lv_mem_free(list->flat->values);
+        lv_mem_free(list->flat);
+        list->flat = NULL;
+    }
+    _LV_WORKER_UNLOCK();
+}
+#endif
+
+#if LV_USE_STYLE_INDEX
+/**
+ * Index the properties of a style by their ID
+ * @param style pointer to a style
+ */
+static void index_build(lv_style_t * style)
+{
+    /*The styles might be read by more workers at once*/
+    _LV_WORKER_LOCK();
+    if(style->index) {
+        _LV_WORKER_UNLOCK();
+        return;
+    }
+
+    uint32_t cnt = 0;
+    size_t i = 0;
+    uint8_t prop_id;
+    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
+        cnt++;
+        i = get_next_prop_index(prop_id, i);
+    }
+
+    lv_style_index_t * index = lv_mem_alloc(sizeof(lv_style_index_t) + cnt * sizeof(uint16_t));
+    if(index == NULL) {
+        _LV_WORKER_UNLOCK();
+        return;
+    }
+    _lv_memset_00(index->has, sizeof(index->has));
+    index->cnt = cnt;
+    index->ofs = (uint16_t *)(index + 1);
+
+    /*Insert the properties ordered by ID*/
+    uint32_t n = 0;
+    i = 0;
+    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
+        if(prop_id < STYLE_PROP_ID_CNT) index->has[prop_id >> 5] |= (uint32_t)1 << (prop_id & 0x1F);
+
+        uint32_t j;
+        for(j = n; j > 0 && get_style_prop_id(style, index->ofs[j - 1]) > prop_id; j--) {
+            index->ofs[j] = index->ofs[j - 1];
+        }
+        index->ofs[j] = i;
+        n++;
+
+        i = get_next_prop_index(prop_id, i);
+    }
+
+    style->index = index;
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Free the index of a style
+ * @param style pointer to a style
+ */
+static void index_free(lv_style_t * style)
+{
+    if(style->index == NULL) return;
+
+    lv_mem_free(style->index);
+    style->index = NULL;
+}
+#endif
@@ -213,14 +213,30 @@ typedef struct {
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
 #endif
+#if LV_USE_STYLE_INDEX
+    struct _lv_style_index_t * index;   /*The properties ordered by ID (built on the first read)*/
+#endif
 } lv_style_t;
 
 typedef int16_t lv_style_int_t;
 
+#if LV_USE_STYLE_FLAT_CACHE
+/*A resolved value of a property with any type*/
+typedef union {
+    lv_style_int_t _int;
+    lv_color_t _color;
+    lv_opa_t _opa;
+    const void * _ptr;
+} lv_style_value_t;
+#endif
+
 typedef struct {
     lv_style_t ** style_list;
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
+#endif
+#if LV_USE_STYLE_FLAT_CACHE
+    struct _lv_style_flat_t * flat;     /*The already resolved properties (allocated on demand)*/
 #endif
     uint32_t style_cnt     : 6;
     uint32_t has_local     : 1;
@@ -565,6 +581,35 @@ lv_res_t _lv_style_list_get_opa(lv_style_list_t * list, lv_style_property_t prop
  */
 lv_res_t _lv_style_list_get_ptr(lv_style_list_t * list, lv_style_property_t prop, const void ** res);
 
+#if LV_USE_STYLE_FLAT_CACHE
+/**
+ * Get an already resolved property from the flat cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state in which it was resolved.
+ * E.g. `LV_STYLE_BORDER_WIDTH | (LV_STATE_PRESSED << LV_STYLE_STATE_POS)`
+ * @param res pointer to a buffer to store the result
+ * @return LV_RES_OK: the property is resolved in the given state
+ *         LV_RES_INV: the property is not resolved yet
+ */
+lv_res_t _lv_style_list_get_flat(lv_style_list_t * list, lv_style_property_t prop, lv_style_value_t * res);
+
+/**
+ * Save a resolved property in the flat cache of a style list.
+ * The properties resolved in an other state are dropped.
+ * @param list pointer to a style list
+ * @param prop a style property ORed with the state in which it was resolved.
+ * @param value the resolved value
+ */
+void _lv_style_list_set_flat(lv_style_list_t * list, lv_style_property_t prop, const lv_style_value_t * value);
+
+/**
+ * Drop a resolved property from the flat cache of a style list.
+ * @param list pointer to a style list
+ * @param prop a style property or `LV_STYLE_PROP_ALL` to drop all of them
+ */
+void _lv_style_list_invalidate_flat(lv_style_list_t * list, lv_style_property_t prop);
+#endif
+
 /**
  * Check whether a style is valid (initialized correctly)
  * @param style pointer to a style
@@ -7,8 +7,11 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_blend.h"
+#include "lv_draw_blend_simd.h"
 #include "lv_img_decoder.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_profiler.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_core/lv_refr.h"
 
@@ -71,8 +74,13 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
  **********************/
 
 #if (LV_USE_GPU || LV_USE_GPU_STM32_DMA2D) && (LV_USE_GPU_NXP_PXP == 0) && (LV_USE_GPU_NXP_VG_LITE == 0)
+#if LV_USE_TILE_RENDER
+    LV_ATTRIBUTE_DMA static lv_color_t blend_buf_workers[_LV_WORKER_NUM][LV_HOR_RES_MAX];
+    #define blend_buf blend_buf_workers[_LV_WORKER_ID]
+#else
     LV_ATTRIBUTE_DMA static lv_color_t blend_buf[LV_HOR_RES_MAX];
 #endif
+#endif
 
 /**********************
  *      MACROS
@@ -168,6 +176,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
 
+    LV_PROFILER_BEGIN(prof_blend);
     if(disp->driver.set_px_cb) {
         fill_set_px(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res);
     }
@@ -179,6 +188,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         fill_blended(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res, mode);
     }
 #endif
+    LV_PROFILER_ACC(prof_blend, LV_PROFILER_PHASE_BLEND);
 }
 
 /**
@@ -235,6 +245,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         int32_t i;
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
+    LV_PROFILER_BEGIN(prof_blend);
     if(disp->driver.set_px_cb) {
         map_set_px(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
     }
@@ -246,6 +257,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         map_blended(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res, mode);
     }
 #endif
+    LV_PROFILER_ACC(prof_blend, LV_PROFILER_PHASE_BLEND);
 }
 
 /**********************
@@ -356,7 +368,11 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
 #endif
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
+#if _LV_BLEND_SIMD
+                _lv_blend_simd_fill(disp_buf_first, color, opa, NULL, draw_area_w, LV_BLEND_MODE_NORMAL);
+#else
                 lv_color_fill(disp_buf_first, color, draw_area_w);
+#endif
                 disp_buf_first += disp_w;
             }
         }
@@ -405,6 +421,15 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
+
+#if _LV_BLEND_SIMD
+            for(y = 0; y < draw_area_h; y++) {
+                _lv_blend_simd_fill(disp_buf_first, color, opa, NULL, draw_area_w, LV_BLEND_MODE_NORMAL);
+                disp_buf_first += disp_w;
+            }
+            return;
+#endif
+
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -444,6 +469,15 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
         }
 #endif
 
+#if _LV_BLEND_SIMD
+        for(y = 0; y < draw_area_h; y++) {
+            _lv_blend_simd_fill(disp_buf_first, color, opa, mask, draw_area_w, LV_BLEND_MODE_NORMAL);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
+        }
+        return;
+#endif
+
         /*Buffer the result color to avoid recalculating the same color*/
         lv_color_t last_dest_color;
         lv_color_t last_res_color;
@@ -590,10 +624,21 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     int32_t x;
     int32_t y;
 
+#if _LV_BLEND_SIMD
+    int32_t line_w = lv_area_get_width(draw_area);
+    const lv_opa_t * mask_line = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        _lv_blend_simd_fill(disp_buf_tmp + draw_area->x1, color, opa, mask_line, line_w, mode);
+        disp_buf_tmp += disp_w;
+        if(mask_line) mask_line += line_w;
+    }
+    return;
+#endif
+
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         lv_color_t last_dest_color = LV_COLOR_BLACK;
-        lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+        lv_color_t last_res_color = blend_fp(color, last_dest_color, opa);
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(last_dest_color.full != disp_buf_tmp[x].full) {
@@ -841,6 +886,14 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 #endif
 
             /*Software rendering*/
+#if _LV_BLEND_SIMD
+            for(y = 0; y < draw_area_h; y++) {
+                _lv_blend_simd_map(disp_buf_first, map_buf_first, opa, NULL, draw_area_w, LV_BLEND_MODE_NORMAL);
+                disp_buf_first += disp_w;
+                map_buf_first += map_w;
+            }
+            return;
+#endif
 
             for(y = 0; y < draw_area_h; y++) {
                 for(x = 0; x < draw_area_w; x++) {
@@ -862,6 +915,16 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     }
     /*Masked*/
     else {
+#if _LV_BLEND_SIMD
+        for(y = 0; y < draw_area_h; y++) {
+            _lv_blend_simd_map(disp_buf_first, map_buf_first, opa, mask, draw_area_w, LV_BLEND_MODE_NORMAL);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
+            map_buf_first += map_w;
+        }
+        return;
+#endif
+
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             /*Go to the first pixel of the row */
@@ -986,6 +1049,18 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
     int32_t x;
     int32_t y;
 
+#if _LV_BLEND_SIMD
+    const lv_opa_t * mask_line = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask;
+    map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        _lv_blend_simd_map(disp_buf_tmp + draw_area->x1, map_buf_tmp, opa, mask_line, draw_area_w, mode);
+        disp_buf_tmp += disp_w;
+        map_buf_tmp += map_w;
+        if(mask_line) mask_line += draw_area_w;
+    }
+    return;
+#endif
+
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         /*Go to the first px of the row*/
@@ -1009,6 +1084,8 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
          * but it corresponds to zero index. So prepare `mask_tmp` accordingly. */
         const lv_opa_t * mask_tmp = mask - draw_area->x1;
 
+        /*Go to the first px of the row and compensate the indexing from `draw_area->x1`*/
+        map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
         map_buf_tmp -= draw_area->x1;
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
@@ -1043,6 +1120,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #if LV_COLOR_DEPTH == 8
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 7);
 #elif LV_COLOR_DEPTH == 16
 #if LV_COLOR_16_SWAP == 0
@@ -1056,6 +1134,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #elif LV_COLOR_DEPTH == 32
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 255);
 #endif
 
@@ -0,0 +1,581 @@
+/**
+ * @file lv_draw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend_simd.h"
+#include "../lv_misc/lv_math.h"
+
+#if _LV_BLEND_SIMD
+
+#if _LV_BLEND_SIMD_AVX2
+    #include <immintrin.h>
+#elif _LV_BLEND_SIMD_SSE2
+    #include <emmintrin.h>
+#elif _LV_BLEND_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if _LV_BLEND_SIMD_AVX2
+    #define VECT_SIZE           32
+    #define VECT(op)            _mm256_##op
+    #define VECT_LOAD(p)        _mm256_loadu_si256((const __m256i *)(p))
+    #define VECT_STORE(p, v)    _mm256_storeu_si256((__m256i *)(p), v)
+    #define VECT_ZERO()         _mm256_setzero_si256()
+    #define VECT_AND(a, b)      _mm256_and_si256(a, b)
+    #define VECT_ANDNOT(a, b)   _mm256_andnot_si256(a, b)
+    #define VECT_OR(a, b)       _mm256_or_si256(a, b)
+#elif _LV_BLEND_SIMD_SSE2
+    #define VECT_SIZE           16
+    #define VECT(op)            _mm_##op
+    #define VECT_LOAD(p)        _mm_loadu_si128((const __m128i *)(p))
+    #define VECT_STORE(p, v)    _mm_storeu_si128((__m128i *)(p), v)
+    #define VECT_ZERO()         _mm_setzero_si128()
+    #define VECT_AND(a, b)      _mm_and_si128(a, b)
+    #define VECT_ANDNOT(a, b)   _mm_andnot_si128(a, b)
+    #define VECT_OR(a, b)       _mm_or_si128(a, b)
+#else
+    #define VECT_SIZE           16
+#endif
+
+/*Number of pixels processed at once*/
+#define BATCH                   (VECT_SIZE / (LV_COLOR_SIZE / 8))
+
+/*Number of pixels whose mix ratio is calculated at once. Must be a multiple of `BATCH`*/
+#define CHUNK                   64
+
+/*`LV_MATH_UDIV255(x)` is `(x * 0x8081) >> 23`.
+ *The vectors keep only the upper 16 bits of the product so shift it by 7 more.*/
+#define UDIV255_MUL             0x8081
+#define UDIV255_SHIFT           7
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*How the mix ratio of the pixels is calculated. Follows the scalar functions of `lv_draw_blend.c`*/
+typedef enum {
+    MIX_RULE_OPA,           /*No mask, `opa` on every pixel*/
+    MIX_RULE_MASK,          /*Only the mask matters (`opa > LV_OPA_MAX`)*/
+    MIX_RULE_MASK_OPA_FILL, /*Mask and opacity like in `fill_normal`*/
+    MIX_RULE_MASK_OPA_MAP,  /*Mask and opacity like in `map_normal`*/
+    MIX_RULE_BLEND,         /*Optional mask and opacity like in `fill_blended` and `map_blended`*/
+} mix_rule_t;
+
+typedef enum {
+    MIX_RES_SKIP,           /*The pixels remain unchanged*/
+    MIX_RES_COPY,           /*The source pixels can be simply copied*/
+    MIX_RES_MIX,            /*The pixels need to be mixed*/
+} mix_res_t;
+
+#if _LV_BLEND_SIMD_AVX2
+typedef __m256i vect_t;
+#elif _LV_BLEND_SIMD_SSE2
+typedef __m128i vect_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void blend_line(lv_color_t * dest, const lv_color_t * src, bool src_inc, lv_opa_t opa,
+                       const lv_opa_t * mask, int32_t len, mix_rule_t rule, lv_blend_mode_t mode);
+static void blend_chunk(lv_color_t * dest, const lv_color_t * src, bool src_inc, const uint8_t * mix,
+                        const uint8_t * force, int32_t len, lv_blend_mode_t mode);
+static inline mix_rule_t get_rule(lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode, bool fill);
+static inline void get_mix(uint8_t * mix, uint8_t * force, const lv_opa_t * mask, lv_opa_t opa, mix_rule_t rule);
+static inline mix_res_t get_batch_res(const uint8_t * mix, const uint8_t * force);
+static inline void copy_batch(lv_color_t * dest, const lv_color_t * src);
+static inline void mix_batch(lv_color_t * dest, const lv_color_t * src, const uint8_t * mix, const uint8_t * force);
+#if LV_USE_BLEND_MODES
+static inline void blend_batch(lv_color_t * out, const lv_color_t * fg, const lv_color_t * bg, lv_blend_mode_t mode);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Fill a line with a color. The result is the same as the one of `fill_normal` and `fill_blended`.
+ * @param dest pointer to the first pixel to fill
+ * @param color fill color
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask line with `len` elements or NULL if the line is fully covered
+ * @param len number of pixels to fill
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_simd_fill(lv_color_t * dest, lv_color_t color, lv_opa_t opa,
+                                               const lv_opa_t * mask, int32_t len, lv_blend_mode_t mode)
+{
+    lv_color_t color_batch[BATCH];
+    uint32_t i;
+    for(i = 0; i < BATCH; i++) color_batch[i] = color;
+
+    blend_line(dest, color_batch, false, opa, mask, len, get_rule(opa, mask, mode, true), mode);
+}
+
+/**
+ * Copy a line of pixels. The result is the same as the one of `map_normal` and `map_blended`.
+ * @param dest pointer to the first pixel to draw
+ * @param src pointer to the first pixel to copy
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask line with `len` elements or NULL if the line is fully covered
+ * @param len number of pixels to copy
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_simd_map(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa,
+                                              const lv_opa_t * mask, int32_t len, lv_blend_mode_t mode)
+{
+    blend_line(dest, src, true, opa, mask, len, get_rule(opa, mask, mode, false), mode);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Blend a line chunk by chunk.
+ * @param dest pointer to the first pixel to draw
+ * @param src the source pixels. `BATCH` pixels if `src_inc == false`
+ * @param src_inc true: step `src` with the pixels; false: use the same `BATCH` pixels everywhere
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask line with `len` elements or NULL
+ * @param len number of pixels
+ * @param rule mix rule from `get_rule`
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+static void blend_line(lv_color_t * dest, const lv_color_t * src, bool src_inc, lv_opa_t opa,
+                       const lv_opa_t * mask, int32_t len, mix_rule_t rule, lv_blend_mode_t mode)
+{
+    uint8_t mix[CHUNK];
+    uint8_t force[CHUNK];
+    int32_t x;
+
+    /*Without mask every chunk is mixed the same way*/
+    if(mask == NULL) get_mix(mix, force, NULL, opa, rule);
+
+    for(x = 0; x < len; x += CHUNK) {
+        int32_t n = LV_MATH_MIN(CHUNK, len - x);
+        if(mask) {
+            /*Pad the last mask chunk with transparent pixels*/
+            lv_opa_t mask_pad[CHUNK];
+            const lv_opa_t * mask_chunk = mask + x;
+            if(n < CHUNK) {
+                int32_t i;
+                for(i = 0; i < CHUNK; i++) mask_pad[i] = i < n ? mask_chunk[i] : LV_OPA_TRANSP;
+                mask_chunk = mask_pad;
+            }
+            get_mix(mix, force, mask_chunk, opa, rule);
+        }
+
+        blend_chunk(dest + x, src_inc ? src + x : src, src_inc, mix, force, n, mode);
+    }
+}
+
+/**
+ * Blend at most `CHUNK` pixels batch by batch. The last, partial batch is processed in a temporary buffer.
+ * @param dest pointer to the first pixel to draw
+ * @param src the source pixels. `BATCH` pixels if `src_inc == false`
+ * @param src_inc true: step `src` with the pixels; false: use the same `BATCH` pixels everywhere
+ * @param mix mix ratios from `get_mix`
+ * @param force alpha flags from `get_mix`
+ * @param len number of pixels
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+static void blend_chunk(lv_color_t * dest, const lv_color_t * src, bool src_inc, const uint8_t * mix,
+                        const uint8_t * force, int32_t len, lv_blend_mode_t mode)
+{
+#if LV_USE_BLEND_MODES
+    lv_color_t fg[BATCH];
+#else
+    LV_UNUSED(mode);
+#endif
+    int32_t x;
+    for(x = 0; x + (int32_t)BATCH <= len; x += BATCH) {
+        mix_res_t res = get_batch_res(mix + x, force + x);
+        if(res == MIX_RES_SKIP) continue;
+
+        const lv_color_t * s = src_inc ? src + x : src;
+#if LV_USE_BLEND_MODES
+        if(mode != LV_BLEND_MODE_NORMAL) {
+            blend_batch(fg, s, dest + x, mode);
+            s = fg;
+        }
+#endif
+        if(res == MIX_RES_COPY) copy_batch(dest + x, s);
+        else mix_batch(dest + x, s, mix + x, force + x);
+    }
+
+    if(x >= len) return;
+
+    /*Handle the remaining pixels in a padded batch. Only the first `n` pixels are written back.*/
+    lv_color_t dest_pad[BATCH];
+    lv_color_t src_pad[BATCH];
+    int32_t n = len - x;
+    int32_t i;
+    for(i = 0; i < (int32_t)BATCH; i++) {
+        dest_pad[i].full = i < n ? dest[x + i].full : 0;
+        src_pad[i].full = i < n ? (src_inc ? src[x + i].full : src[i].full) : 0;
+    }
+
+    const lv_color_t * s = src_pad;
+#if LV_USE_BLEND_MODES
+    if(mode != LV_BLEND_MODE_NORMAL) {
+        blend_batch(fg, s, dest_pad, mode);
+        s = fg;
+    }
+#endif
+    mix_batch(dest_pad, s, mix + x, force + x);
+
+    for(i = 0; i < n; i++) dest[x + i] = dest_pad[i];
+}
+
+/**
+ * Tell how the mix ratio should be calculated to get the same result as the scalar functions.
+ * @param opa overall opacity
+ * @param mask the mask line or NULL
+ * @param mode blend mode
+ * @param fill true: called by `_lv_blend_simd_fill`; false: called by `_lv_blend_simd_map`
+ * @return the mix rule
+ */
+static inline mix_rule_t get_rule(lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode, bool fill)
+{
+    if(mode != LV_BLEND_MODE_NORMAL) return MIX_RULE_BLEND;
+    if(mask == NULL) return MIX_RULE_OPA;
+    if(opa > LV_OPA_MAX) return MIX_RULE_MASK;
+    return fill ? MIX_RULE_MASK_OPA_FILL : MIX_RULE_MASK_OPA_MAP;
+}
+
+/**
+ * Calculate the mix ratio of a chunk and mark the pixels where the scalar code would use `lv_color_mix`.
+ * (`lv_color_mix` sets the alpha channel to 0xFF.)
+ * @param mix store the mix ratios here
+ * @param force store 0xFF here where `lv_color_mix` is used, else 0
+ * @param mask `CHUNK` mask values or NULL
+ * @param opa overall opacity
+ * @param rule mix rule from `get_rule`
+ */
+static inline void get_mix(uint8_t * mix, uint8_t * force, const lv_opa_t * mask, lv_opa_t opa, mix_rule_t rule)
+{
+    uint32_t i;
+
+    /*Keep the loops simple so that the compiler can vectorize them too*/
+    switch(rule) {
+        case MIX_RULE_OPA:
+            for(i = 0; i < CHUNK; i++) mix[i] = opa > LV_OPA_MAX ? LV_OPA_COVER : opa;
+            for(i = 0; i < CHUNK; i++) force[i] = (mix[i] != LV_OPA_TRANSP && mix[i] != LV_OPA_COVER) ? 0xFF : 0x00;
+            break;
+        case MIX_RULE_MASK:
+            for(i = 0; i < CHUNK; i++) mix[i] = mask[i];
+            for(i = 0; i < CHUNK; i++) force[i] = (mix[i] != LV_OPA_TRANSP && mix[i] != LV_OPA_COVER) ? 0xFF : 0x00;
+            break;
+        case MIX_RULE_MASK_OPA_FILL:
+            for(i = 0; i < CHUNK; i++) mix[i] = mask[i] == LV_OPA_COVER ? opa : (uint16_t)((uint16_t)mask[i] * opa) >> 8;
+            for(i = 0; i < CHUNK; i++) force[i] = mask[i] ? 0xFF : 0x00;
+            break;
+        case MIX_RULE_MASK_OPA_MAP:
+            for(i = 0; i < CHUNK; i++) mix[i] = mask[i] >= LV_OPA_MAX ? opa : (uint16_t)((uint16_t)mask[i] * opa) >> 8;
+            for(i = 0; i < CHUNK; i++) force[i] = mask[i] ? 0xFF : 0x00;
+            break;
+        default:
+            if(mask) {
+                for(i = 0; i < CHUNK; i++) mix[i] = mask[i] >= LV_OPA_MAX ? opa : (uint16_t)((uint16_t)mask[i] * opa) >> 8;
+            }
+            else {
+                for(i = 0; i < CHUNK; i++) mix[i] = opa;
+            }
+            for(i = 0; i < CHUNK; i++) mix[i] = mix[i] <= LV_OPA_MIN ? LV_OPA_TRANSP : mix[i];
+            for(i = 0; i < CHUNK; i++) force[i] = (mix[i] != LV_OPA_TRANSP && mix[i] != LV_OPA_COVER) ? 0xFF : 0x00;
+            break;
+    }
+}
+
+/**
+ * Tell what to do with a batch.
+ * @param mix mix ratios of the batch
+ * @param force alpha flags of the batch
+ * @return MIX_RES_SKIP, MIX_RES_COPY or MIX_RES_MIX
+ */
+static inline mix_res_t get_batch_res(const uint8_t * mix, const uint8_t * force)
+{
+    uint8_t mix_and = 0xFF;
+    uint8_t mix_or = 0x00;
+    uint8_t force_or = 0x00;
+    uint32_t i;
+    for(i = 0; i < BATCH; i++) {
+        mix_and &= mix[i];
+        mix_or |= mix[i];
+        force_or |= force[i];
+    }
+
+    if(force_or == 0x00) {
+        if(mix_or == LV_OPA_TRANSP) return MIX_RES_SKIP;
+        if(mix_and == LV_OPA_COVER) return MIX_RES_COPY;
+    }
+
+    return MIX_RES_MIX;
+}
+
+#if _LV_BLEND_SIMD_AVX2 || _LV_BLEND_SIMD_SSE2
+
+/**
+ * `LV_MATH_UDIV255(s * m + d * (255 - m) + LV_COLOR_MIX_ROUND_OFS)` on 16 bit lanes
+ */
+static inline vect_t mix_vect(vect_t s, vect_t d, vect_t m)
+{
+    vect_t x = VECT(add_epi16)(VECT(mullo_epi16)(s, m),
+                               VECT(mullo_epi16)(d, VECT(sub_epi16)(VECT(set1_epi16)(255), m)));
+    x = VECT(add_epi16)(x, VECT(set1_epi16)(LV_COLOR_MIX_ROUND_OFS));
+    x = VECT(mulhi_epu16)(x, VECT(set1_epi16)((int16_t)UDIV255_MUL));
+    return VECT(srli_epi16)(x, UDIV255_SHIFT);
+}
+
+#if LV_COLOR_DEPTH == 32
+/**
+ * Load one byte per pixel and repeat it on the 4 channels of the pixels
+ */
+static inline vect_t load_px_bytes(const uint8_t * v)
+{
+#if _LV_BLEND_SIMD_AVX2
+    __m128i b = _mm_loadl_epi64((const __m128i *)v);
+    b = _mm_unpacklo_epi8(b, b);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(b, b)), _mm_unpackhi_epi16(b, b), 1);
+#else
+    uint32_t v32 = (uint32_t)v[0] | ((uint32_t)v[1] << 8) | ((uint32_t)v[2] << 16) | ((uint32_t)v[3] << 24);
+    __m128i b = _mm_cvtsi32_si128((int)v32);
+    b = _mm_unpacklo_epi8(b, b);
+    return _mm_unpacklo_epi16(b, b);
+#endif
+}
+#else
+/**
+ * Load one byte per pixel to 16 bit lanes
+ */
+static inline vect_t load_px_bytes(const uint8_t * v)
+{
+#if _LV_BLEND_SIMD_AVX2
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)v));
+#else
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)v), _mm_setzero_si128());
+#endif
+}
+#endif
+
+static inline void copy_batch(lv_color_t * dest, const lv_color_t * src)
+{
+    VECT_STORE(dest, VECT_LOAD(src));
+}
+
+static inline void mix_batch(lv_color_t * dest, const lv_color_t * src, const uint8_t * mix, const uint8_t * force)
+{
+    vect_t s = VECT_LOAD(src);
+    vect_t d = VECT_LOAD(dest);
+    vect_t m = load_px_bytes(mix);
+    vect_t res;
+
+#if LV_COLOR_DEPTH == 32
+    /*The channels are bytes, mix them on 16 bit lanes*/
+    vect_t zero = VECT_ZERO();
+    vect_t lo = mix_vect(VECT(unpacklo_epi8)(s, zero), VECT(unpacklo_epi8)(d, zero), VECT(unpacklo_epi8)(m, zero));
+    vect_t hi = mix_vect(VECT(unpackhi_epi8)(s, zero), VECT(unpackhi_epi8)(d, zero), VECT(unpackhi_epi8)(m, zero));
+    res = VECT(packus_epi16)(lo, hi);
+
+    /*Set the alpha channel to 0xFF like `lv_color_mix` does*/
+    vect_t a = VECT(slli_epi32)(VECT(set1_epi32)(0xFF), 24);
+    res = VECT_OR(res, VECT_AND(load_px_bytes(force), a));
+#else
+    LV_UNUSED(force); /*No alpha channel*/
+
+    vect_t mask5 = VECT(set1_epi16)(0x1F);
+    vect_t mask6 = VECT(set1_epi16)(0x3F);
+    vect_t r = mix_vect(VECT(srli_epi16)(s, 11), VECT(srli_epi16)(d, 11), m);
+    vect_t g = mix_vect(VECT_AND(VECT(srli_epi16)(s, 5), mask6), VECT_AND(VECT(srli_epi16)(d, 5), mask6), m);
+    vect_t b = mix_vect(VECT_AND(s, mask5), VECT_AND(d, mask5), m);
+    res = VECT_OR(VECT_OR(VECT(slli_epi16)(r, 11), VECT(slli_epi16)(g, 5)), b);
+#endif
+
+    VECT_STORE(dest, res);
+}
+
+#if LV_USE_BLEND_MODES
+static inline void blend_batch(lv_color_t * out, const lv_color_t * fg, const lv_color_t * bg, lv_blend_mode_t mode)
+{
+    vect_t f = VECT_LOAD(fg);
+    vect_t b = VECT_LOAD(bg);
+    vect_t res;
+
+#if LV_COLOR_DEPTH == 32
+    if(mode == LV_BLEND_MODE_ADDITIVE) res = VECT(adds_epu8)(b, f);
+    else res = VECT(subs_epu8)(b, f);
+
+    /*Keep the alpha channel of the foreground*/
+    vect_t a = VECT(slli_epi32)(VECT(set1_epi32)(0xFF), 24);
+    res = VECT_OR(VECT_ANDNOT(a, res), VECT_AND(f, a));
+#else
+    vect_t mask5 = VECT(set1_epi16)(0x1F);
+    vect_t mask6 = VECT(set1_epi16)(0x3F);
+    vect_t fr = VECT(srli_epi16)(f, 11);
+    vect_t br = VECT(srli_epi16)(b, 11);
+    vect_t fg6 = VECT_AND(VECT(srli_epi16)(f, 5), mask6);
+    vect_t bg6 = VECT_AND(VECT(srli_epi16)(b, 5), mask6);
+    vect_t fb = VECT_AND(f, mask5);
+    vect_t bb = VECT_AND(b, mask5);
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        fr = VECT(min_epi16)(VECT(add_epi16)(fr, br), mask5);
+        fg6 = VECT(min_epi16)(VECT(add_epi16)(fg6, bg6), mask6);
+        fb = VECT(min_epi16)(VECT(add_epi16)(fb, bb), mask5);
+    }
+    else {
+        fr = VECT(subs_epu16)(br, fr);
+        fg6 = VECT(subs_epu16)(bg6, fg6);
+        fb = VECT(subs_epu16)(bb, fb);
+    }
+    res = VECT_OR(VECT_OR(VECT(slli_epi16)(fr, 11), VECT(slli_epi16)(fg6, 5)), fb);
+#endif
+
+    VECT_STORE(out, res);
+}
+#endif /*LV_USE_BLEND_MODES*/
+
+#elif _LV_BLEND_SIMD_NEON
+
+/**
+ * `LV_MATH_UDIV255(x)` on 16 bit lanes
+ */
+static inline uint16x8_t udiv255(uint16x8_t x)
+{
+    uint16x4_t k = vdup_n_u16(UDIV255_MUL);
+    uint16x8_t hi = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(x), k), 16),
+                                 vshrn_n_u32(vmull_u16(vget_high_u16(x), k), 16));
+    return vshrq_n_u16(hi, UDIV255_SHIFT);
+}
+
+static inline void copy_batch(lv_color_t * dest, const lv_color_t * src)
+{
+    vst1q_u8((uint8_t *)dest, vld1q_u8((const uint8_t *)src));
+}
+
+#if LV_COLOR_DEPTH == 32
+/**
+ * `LV_MATH_UDIV255(s * m + d * (255 - m) + LV_COLOR_MIX_ROUND_OFS)` on 8 bytes
+ */
+static inline uint8x8_t mix_vect(uint8x8_t s, uint8x8_t d, uint8x8_t m)
+{
+    uint16x8_t x = vmull_u8(s, m);
+    x = vmlal_u8(x, d, vsub_u8(vdup_n_u8(255), m));
+    x = vaddq_u16(x, vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS));
+    return vmovn_u16(udiv255(x));
+}
+
+/**
+ * Load one byte per pixel and repeat it on the 4 channels of the pixels
+ */
+static inline uint8x16_t load_px_bytes(const uint8_t * v)
+{
+    static const uint8_t idx[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+    uint64_t v64 = (uint64_t)v[0] | ((uint64_t)v[1] << 8) | ((uint64_t)v[2] << 16) | ((uint64_t)v[3] << 24);
+    uint8x8_t b = vcreate_u8(v64);
+    return vcombine_u8(vtbl1_u8(b, vld1_u8(idx)), vtbl1_u8(b, vld1_u8(idx + 8)));
+}
+
+static inline void mix_batch(lv_color_t * dest, const lv_color_t * src, const uint8_t * mix, const uint8_t * force)
+{
+    uint8x16_t s = vld1q_u8((const uint8_t *)src);
+    uint8x16_t d = vld1q_u8((const uint8_t *)dest);
+    uint8x16_t m = load_px_bytes(mix);
+    uint8x16_t res = vcombine_u8(mix_vect(vget_low_u8(s), vget_low_u8(d), vget_low_u8(m)),
+                                 mix_vect(vget_high_u8(s), vget_high_u8(d), vget_high_u8(m)));
+
+    /*Set the alpha channel to 0xFF like `lv_color_mix` does*/
+    uint8x16_t a = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+    res = vorrq_u8(res, vandq_u8(load_px_bytes(force), a));
+    vst1q_u8((uint8_t *)dest, res);
+}
+
+#if LV_USE_BLEND_MODES
+static inline void blend_batch(lv_color_t * out, const lv_color_t * fg, const lv_color_t * bg, lv_blend_mode_t mode)
+{
+    uint8x16_t f = vld1q_u8((const uint8_t *)fg);
+    uint8x16_t b = vld1q_u8((const uint8_t *)bg);
+    uint8x16_t res;
+    if(mode == LV_BLEND_MODE_ADDITIVE) res = vqaddq_u8(b, f);
+    else res = vqsubq_u8(b, f);
+
+    /*Keep the alpha channel of the foreground*/
+    uint8x16_t a = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+    vst1q_u8((uint8_t *)out, vbslq_u8(a, f, res));
+}
+#endif /*LV_USE_BLEND_MODES*/
+
+#else /*LV_COLOR_DEPTH == 16*/
+/**
+ * `LV_MATH_UDIV255(s * m + d * (255 - m) + LV_COLOR_MIX_ROUND_OFS)` on 16 bit lanes
+ */
+static inline uint16x8_t mix_vect(uint16x8_t s, uint16x8_t d, uint16x8_t m)
+{
+    uint16x8_t x = vmulq_u16(s, m);
+    x = vmlaq_u16(x, d, vsubq_u16(vdupq_n_u16(255), m));
+    x = vaddq_u16(x, vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS));
+    return udiv255(x);
+}
+
+static inline void mix_batch(lv_color_t * dest, const lv_color_t * src, const uint8_t * mix, const uint8_t * force)
+{
+    LV_UNUSED(force); /*No alpha channel*/
+
+    uint16x8_t s = vld1q_u16((const uint16_t *)src);
+    uint16x8_t d = vld1q_u16((const uint16_t *)dest);
+    uint16x8_t m = vmovl_u8(vld1_u8(mix));
+    uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    uint16x8_t mask6 = vdupq_n_u16(0x3F);
+
+    uint16x8_t r = mix_vect(vshrq_n_u16(s, 11), vshrq_n_u16(d, 11), m);
+    uint16x8_t g = mix_vect(vandq_u16(vshrq_n_u16(s, 5), mask6), vandq_u16(vshrq_n_u16(d, 5), mask6), m);
+    uint16x8_t b = mix_vect(vandq_u16(s, mask5), vandq_u16(d, mask5), m);
+    vst1q_u16((uint16_t *)dest, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+}
+
+#if LV_USE_BLEND_MODES
+static inline void blend_batch(lv_color_t * out, const lv_color_t * fg, const lv_color_t * bg, lv_blend_mode_t mode)
+{
+    uint16x8_t f = vld1q_u16((const uint16_t *)fg);
+    uint16x8_t b = vld1q_u16((const uint16_t *)bg);
+    uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t fr = vshrq_n_u16(f, 11);
+    uint16x8_t br = vshrq_n_u16(b, 11);
+    uint16x8_t fg6 = vandq_u16(vshrq_n_u16(f, 5), mask6);
+    uint16x8_t bg6 = vandq_u16(vshrq_n_u16(b, 5), mask6);
+    uint16x8_t fb = vandq_u16(f, mask5);
+    uint16x8_t bb = vandq_u16(b, mask5);
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        fr = vminq_u16(vaddq_u16(fr, br), mask5);
+        fg6 = vminq_u16(vaddq_u16(fg6, bg6), mask6);
+        fb = vminq_u16(vaddq_u16(fb, bb), mask5);
+    }
+    else {
+        fr = vqsubq_u16(br, fr);
+        fg6 = vqsubq_u16(bg6, fg6);
+        fb = vqsubq_u16(bb, fb);
+    }
+    vst1q_u16((uint16_t *)out, vorrq_u16(vorrq_u16(vshlq_n_u16(fr, 11), vshlq_n_u16(fg6, 5)), fb));
+}
+#endif /*LV_USE_BLEND_MODES*/
+
+#endif /*LV_COLOR_DEPTH*/
+
+#endif /*_LV_BLEND_SIMD_NEON*/
+
+#endif /*_LV_BLEND_SIMD*/
@@ -0,0 +1,91 @@
+/**
+ * @file lv_draw_blend_simd.h
+ *
+ */
+
+#ifndef LV_DRAW_BLEND_SIMD_H
+#define LV_DRAW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Select the vector instruction set. Only the color formats with a simple channel layout are handled.
+ *With any other configuration the scalar blending functions are used.*/
+#if LV_USE_BLEND_SIMD && LV_COLOR_SCREEN_TRANSP == 0 && \
+    (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0))
+#  if defined(__AVX2__)
+#    define _LV_BLEND_SIMD_AVX2     1
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define _LV_BLEND_SIMD_SSE2     1
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define _LV_BLEND_SIMD_NEON     1
+#  endif
+#endif
+
+#ifndef _LV_BLEND_SIMD_AVX2
+#  define _LV_BLEND_SIMD_AVX2       0
+#endif
+#ifndef _LV_BLEND_SIMD_SSE2
+#  define _LV_BLEND_SIMD_SSE2       0
+#endif
+#ifndef _LV_BLEND_SIMD_NEON
+#  define _LV_BLEND_SIMD_NEON       0
+#endif
+
+/*1: the vectorized blending functions are available*/
+#define _LV_BLEND_SIMD  (_LV_BLEND_SIMD_AVX2 || _LV_BLEND_SIMD_SSE2 || _LV_BLEND_SIMD_NEON)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if _LV_BLEND_SIMD
+
+/**
+ * Fill a line with a color. The result is the same as the one of `fill_normal` and `fill_blended`.
+ * @param dest pointer to the first pixel to fill
+ * @param color fill color
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask line with `len` elements or NULL if the line is fully covered
+ * @param len number of pixels to fill
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_simd_fill(lv_color_t * dest, lv_color_t color, lv_opa_t opa,
+                                               const lv_opa_t * mask, int32_t len, lv_blend_mode_t mode);
+
+/**
+ * Copy a line of pixels. The result is the same as the one of `map_normal` and `map_blended`.
+ * @param dest pointer to the first pixel to draw
+ * @param src pointer to the first pixel to copy
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask line with `len` elements or NULL if the line is fully covered
+ * @param len number of pixels to copy
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_simd_map(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa,
+                                              const lv_opa_t * mask, int32_t len, lv_blend_mode_t mode);
+
+#endif /*_LV_BLEND_SIMD*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BLEND_SIMD_H*/
@@ -22,6 +22,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Max. number of pixels to read at once from the images which are not available as a whole*/
+#define IMG_READ_AREA_MAX_PX    (LV_HOR_RES_MAX * 2)
 
 /**********************
  *      TYPEDEFS
@@ -39,8 +41,12 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                               const lv_draw_img_dsc_t * draw_dsc,
                                               bool chroma_key, bool alpha_byte);
 
+#if LV_IMG_CACHE_RUNS
+LV_ATTRIBUTE_FAST_MEM static void lv_draw_runs(const lv_area_t * map_area, const lv_area_t * clip_area,
+                                               const lv_img_runs_t * runs, const lv_draw_img_dsc_t * draw_dsc);
+#endif
+
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg);
-static void draw_cleanup(lv_img_cache_entry_t * cache);
 
 /**********************
  *  STATIC VARIABLES
@@ -270,58 +276,77 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
         union_ok = _lv_area_intersect(&mask_com, clip_area, &map_area_rot);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            _lv_img_cache_release(cdsc, false);
             return LV_RES_OK;
         }
 
-        lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
+#if LV_IMG_CACHE_RUNS
+        /*Draw the runs of the ARGB images if they are not transformed or masked*/
+        if(cdsc->runs && lv_draw_mask_get_cnt() == 0 && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE &&
+           draw_dsc->recolor_opa == LV_OPA_TRANSP) {
+            lv_draw_runs(coords, &mask_com, cdsc->runs, draw_dsc);
+        }
+        else
+#endif
+        {
+            lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
+        }
     }
-    /* The whole uncompressed image is not available. Try to read it line-by-line*/
+    /* The whole uncompressed image is not available. Try to read it block-by-block*/
     else {
         lv_area_t mask_com; /*Common area of mask and coords*/
         bool union_ok;
         union_ok = _lv_area_intersect(&mask_com, clip_area, coords);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
         if(union_ok == false) {
-            draw_cleanup(cdsc);
+            _lv_img_cache_release(cdsc, false);
             return LV_RES_OK;
         }
 
         int32_t width = lv_area_get_width(&mask_com);
 
-        uint8_t  * buf = _lv_mem_buf_get(lv_area_get_width(&mask_com) *
+        /*Read more lines at once to let the decoder read larger blocks.
+         *The transformations are applied on the drawn area so keep line-by-line for them.*/
+        int32_t rows = 1;
+        if(draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE) {
+            rows = LV_MATH_MAX(1, IMG_READ_AREA_MAX_PX / width);
+            rows = LV_MATH_MIN(rows, lv_area_get_height(&mask_com));
+        }
+
+        uint8_t  * buf = _lv_mem_buf_get(width * rows *
                                          LV_IMG_PX_SIZE_ALPHA_BYTE);  /*+1 because of the possible alpha byte*/
 
-        lv_area_t line;
-        lv_area_copy(&line, &mask_com);
-        lv_area_set_height(&line, 1);
-        int32_t x = mask_com.x1 - coords->x1;
-        int32_t y = mask_com.y1 - coords->y1;
-        int32_t row;
+        lv_area_t block;
+        lv_area_copy(&block, &mask_com);
         lv_res_t read_res;
-        for(row = mask_com.y1; row <= mask_com.y2; row++) {
-            lv_area_t mask_line;
-            union_ok = _lv_area_intersect(&mask_line, clip_area, &line);
-            if(union_ok == false) continue;
-
-            read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
+        while(block.y1 <= mask_com.y2) {
+            block.y2 = LV_MATH_MIN(block.y1 + rows - 1, mask_com.y2);
+
+            /*The area to read relative to the image*/
+            lv_area_t read_area;
+            read_area.x1 = block.x1 - coords->x1;
+            read_area.y1 = block.y1 - coords->y1;
+            read_area.x2 = block.x2 - coords->x1;
+            read_area.y2 = block.y2 - coords->y1;
+
+            /*The decoder's file position and readahead buffer are shared by the workers drawing the same image*/
+            _LV_WORKER_LOCK();
+            read_res = lv_img_decoder_read_area(&cdsc->dec_dsc, &read_area, buf);
+            _LV_WORKER_UNLOCK();
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 _lv_mem_buf_release(buf);
-                draw_cleanup(cdsc);
+                _lv_img_cache_release(cdsc, true);
                 return LV_RES_INV;
             }
 
-            lv_draw_map(&line, &mask_line, buf, draw_dsc, chroma_keyed, alpha_byte);
-            line.y1++;
-            line.y2++;
-            y++;
+            lv_draw_map(&block, &block, buf, draw_dsc, chroma_keyed, alpha_byte);
+            block.y1 = block.y2 + 1;
         }
         _lv_mem_buf_release(buf);
     }
 
-    draw_cleanup(cdsc);
+    _lv_img_cache_release(cdsc, false);
     return LV_RES_OK;
 }
 
@@ -528,27 +553,23 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
 #if LV_USE_IMG_TRANSFORM
                 int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
 #endif
-                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
-
 #if LV_USE_IMG_TRANSFORM
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                if(transform) {
+                    /*Transform the whole line at once*/
+                    _lv_img_buf_transform_line(&trans_dsc, rot_x, rot_y + y, draw_area_w, &map2[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            if(mask_buf[px_i + x] == LV_OPA_TRANSP) continue;
+                            map2[px_i + x] = lv_color_mix_premult(recolor_premult, map2[px_i + x], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                /*No transform*/
+                else
 #endif
-                    {
+                {
+                    for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
                         if(alpha_byte) {
                             lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
                             mask_buf[px_i] = px_opa;
@@ -582,13 +603,13 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                 continue;
                             }
                         }
-                    }
 
-                    if(draw_dsc->recolor_opa != 0) {
-                        c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
-                    }
+                        if(draw_dsc->recolor_opa != 0) {
+                            c = lv_color_mix_premult(recolor_premult, c, recolor_opa_inv);
+                        }
 
-                    map2[px_i].full = c.full;
+                        map2[px_i].full = c.full;
+                    }
                 }
 
                 /*Apply the masks if any*/
@@ -639,6 +660,80 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
     }
 }
 
+#if LV_IMG_CACHE_RUNS
+/**
+ * Draw an image converted to runs by the image cache.
+ * The opaque runs are blended without mask (i.e. copied), the transparent runs are skipped
+ * and only the mixed runs are blended with their alpha bytes.
+ * @param map_area coordinates of the image
+ * @param clip_area the image will drawn only on this area
+ * @param runs pointer to the runs of the image
+ * @param draw_dsc pointer to an initialized `lv_draw_img_dsc_t` variable
+ */
+LV_ATTRIBUTE_FAST_MEM static void lv_draw_runs(const lv_area_t * map_area, const lv_area_t * clip_area,
+                                               const lv_img_runs_t * runs, const lv_draw_img_dsc_t * draw_dsc)
+{
+    lv_opa_t * mask_buf = _lv_mem_buf_get(lv_area_get_width(clip_area));
+
+    /*The opaque runs with the same start and end in consecutive rows are blended at once*/
+    lv_area_t cover_area;
+    bool cover_pending = false;
+
+    lv_area_t run_area;
+    int32_t y;
+    for(y = clip_area->y1; y <= clip_area->y2; y++) {
+        int32_t row = y - map_area->y1;
+        const uint16_t * run = &runs->runs[runs->row_runs[row]];
+        const uint16_t * run_end = &runs->runs[runs->row_runs[row + 1]];
+        const lv_opa_t * alpha = &runs->alpha[runs->row_alpha[row]];
+
+        run_area.y1 = y;
+        run_area.y2 = y;
+
+        int32_t x = map_area->x1;
+        for(; run < run_end && x <= clip_area->x2; run++) {
+            int32_t len = *run & LV_IMG_RUN_LEN_MASK;
+            uint16_t type = *run >> LV_IMG_RUN_TYPE_SHIFT;
+
+            run_area.x1 = LV_MATH_MAX(x, clip_area->x1);
+            run_area.x2 = LV_MATH_MIN(x + len - 1, clip_area->x2);
+            if(run_area.x1 <= run_area.x2) {
+                if(type == LV_IMG_RUN_COVER) {
+                    if(cover_pending && cover_area.x1 == run_area.x1 && cover_area.x2 == run_area.x2 &&
+                       cover_area.y2 == y - 1) {
+                        cover_area.y2 = y;
+                    }
+                    else {
+                        if(cover_pending) {
+                            _lv_blend_map(&cover_area, map_area, runs->map, NULL, LV_DRAW_MASK_RES_FULL_COVER,
+                                          draw_dsc->opa, draw_dsc->blend_mode);
+                        }
+                        lv_area_copy(&cover_area, &run_area);
+                        cover_pending = true;
+                    }
+                }
+                else if(type == LV_IMG_RUN_MIXED) {
+                    /*Copy the alpha bytes because the blending might modify the mask*/
+                    _lv_memcpy(mask_buf, &alpha[run_area.x1 - x], lv_area_get_width(&run_area));
+                    _lv_blend_map(&run_area, map_area, runs->map, mask_buf, LV_DRAW_MASK_RES_CHANGED,
+                                  draw_dsc->opa, draw_dsc->blend_mode);
+                }
+            }
+
+            if(type == LV_IMG_RUN_MIXED) alpha += len;
+            x += len;
+        }
+    }
+
+    if(cover_pending) {
+        _lv_blend_map(&cover_area, map_area, runs->map, NULL, LV_DRAW_MASK_RES_FULL_COVER,
+                      draw_dsc->opa, draw_dsc->blend_mode);
+    }
+
+    _lv_mem_buf_release(mask_buf);
+}
+#endif
+
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg)
 {
     lv_draw_rect_dsc_t rect_dsc;
@@ -651,12 +746,3 @@ static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, co
     lv_draw_label(coords, clip_area, &label_dsc, msg, NULL);
 }
 
-static void draw_cleanup(lv_img_cache_entry_t * cache)
-{
-    /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
-#endif
-}
@@ -12,6 +12,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -124,14 +125,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     /*No need to waste processor time if string is empty*/
     if(txt[0] == '\0')  return;
 
+#if LV_USE_TILE_RENDER
+    /*The tiles of the same label would update the hint concurrently so only the first worker uses it*/
+    if(_LV_WORKER_ID != 0) hint = NULL;
+#endif
+
     lv_area_t clipped_area;
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+    /*Use the line index only if it was created with the same parameters*/
+    const lv_txt_lines_t * lines = dsc->lines;
+    if(lines && !_lv_txt_lines_is_valid(lines, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+        lines = NULL;
+    }
+
     if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(lines) {
+        w = lines->w;
+    }
     else {
         /*If EXAPND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -143,6 +158,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     int32_t line_height_font = lv_font_get_line_height(font);
     int32_t line_height = line_height_font + dsc->line_space;
 
+    /*The visible lines are found by dividing with the line height*/
+    if(line_height <= 0) lines = NULL;
+
     /*Init variables for the first line*/
     int32_t line_width = 0;
     lv_point_t pos;
@@ -156,8 +174,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
+    uint32_t line_id        = 0;
     int32_t last_line_start = -1;
 
+    /*The line index makes the hint needless*/
+    if(lines) hint = NULL;
+
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
@@ -173,7 +196,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(lines) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < mask->y1) {
+            line_id = (mask->y1 - line_height_font - pos.y + line_height - 1) / line_height;
+            if(line_id >= lines->line_cnt) return;
+            pos.y += line_id * line_height;
+        }
+        if(lines->line_cnt == 0) return;
+
+        line_start = lines->lines[line_id].start;
+        line_end = _lv_txt_lines_get_end(lines, line_id);
+    }
+    else {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    }
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < mask->y1) {
@@ -194,14 +231,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_id].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines->lines[line_id].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -355,21 +394,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(lines) {
+            line_id++;
+            if(line_id >= lines->line_cnt) break;
+            line_end = _lv_txt_lines_get_end(lines, line_id);
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_id].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines->lines[line_id].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -433,11 +479,31 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
         return;
     }
 
+#if LV_USE_TILE_RENDER
+    /*The bitmap might be in a buffer shared by the workers (e.g. decompressed glyphs)
+     *so copy it to the worker's own buffer and draw the copy without locking*/
+    uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+    uint32_t map_size = ((uint32_t)g.box_w * g.box_h * bpp + 7) >> 3;
+    uint8_t * map_copy = _lv_mem_buf_get(map_size);
+
+    _LV_WORKER_LOCK();
     const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
+    if(map_p) _lv_memcpy(map_copy, map_p, map_size);
+    _LV_WORKER_UNLOCK();
+
     if(map_p == NULL) {
+        _lv_mem_buf_release(map_copy);
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
     }
+    map_p = map_copy;
+#else
+    const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
+    if(map_p == NULL) {
+        LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
+        return;
+    }
+#endif
 
     if(font_p->subpx) {
         draw_letter_subpx(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
@@ -445,6 +511,10 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
     else {
         draw_letter_normal(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
     }
+
+#if LV_USE_TILE_RENDER
+    _lv_mem_buf_release(map_copy);
+#endif
 }
 
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
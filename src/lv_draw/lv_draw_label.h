@@ -42,6 +42,7 @@ typedef struct {
     lv_txt_flag_t flag;
     lv_text_decor_t decor;
     lv_blend_mode_t blend_mode;
+    const lv_txt_lines_t * lines; /**< Line index of the text to skip measuring it (optional)*/
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
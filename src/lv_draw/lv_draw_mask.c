@@ -11,15 +11,41 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_TILE_RENDER
+    #define MASK_LIST   LV_GC_ROOT(_lv_draw_mask_list[_LV_WORKER_ID])
+#else
+    #define MASK_LIST   LV_GC_ROOT(_lv_draw_mask_list)
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*The parts of a line which are visible and fully covered by the masks*/
+typedef struct {
+    lv_coord_t x1;          /*First visible pixel*/
+    lv_coord_t x2;          /*Last visible pixel*/
+    lv_coord_t cover_x1;    /*First fully covered pixel*/
+    lv_coord_t cover_x2;    /*Last fully covered pixel. `cover_x1 > cover_x2` if there is no such pixel.*/
+} mask_span_t;
+
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+/*A cached quarter circle in `_lv_draw_mask_radius_cache_ll`. The most recently used is the head.*/
+typedef struct _lv_draw_mask_radius_circle_t {
+    lv_opa_t * opa;         /*`radius * radius` opacity values of the top left corner, from the top row*/
+    uint16_t * opa_start;   /*Index of the first not transparent pixel in the rows*/
+    uint16_t * opa_end;     /*Index after the last not fully covered pixel in the rows*/
+    lv_coord_t radius;
+    uint32_t used_cnt;      /*Number of added masks using the circle. Only the unused circles can be dropped.*/
+} _lv_draw_mask_radius_circle_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -46,12 +72,38 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_
                                                                 lv_coord_t len,
                                                                 lv_draw_mask_line_param_t * p);
 
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_circle_apply(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                    lv_coord_t abs_y, lv_coord_t len,
+                                                                    const lv_draw_mask_radius_param_t * p);
+static void radius_circle_attach(void * param);
+static void radius_circle_detach(void * param);
+static _lv_draw_mask_radius_circle_t * radius_circle_create(lv_coord_t radius);
+static void radius_circle_drop(_lv_draw_mask_radius_circle_t * circle);
+static inline uint32_t radius_circle_mem_size(lv_coord_t radius);
+#endif
+
+LV_ATTRIBUTE_FAST_MEM static bool get_span(const lv_draw_mask_common_dsc_t * dsc, lv_coord_t abs_y, mask_span_t * span);
+LV_ATTRIBUTE_FAST_MEM static void radius_span(const lv_draw_mask_radius_param_t * p, lv_coord_t abs_y, mask_span_t * span);
+LV_ATTRIBUTE_FAST_MEM static bool line_span(const lv_draw_mask_line_param_t * p, lv_coord_t abs_y, mask_span_t * span);
+LV_ATTRIBUTE_FAST_MEM static void fade_span(const lv_draw_mask_fade_param_t * p, lv_coord_t abs_y, mask_span_t * span);
+LV_ATTRIBUTE_FAST_MEM static inline void span_visible_and(mask_span_t * span, int32_t x1, int32_t x2);
+LV_ATTRIBUTE_FAST_MEM static inline void span_cover_and(mask_span_t * span, int32_t x1, int32_t x2);
+LV_ATTRIBUTE_FAST_MEM static inline void span_cover_remove(mask_span_t * span, int32_t x1, int32_t x2);
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_res_t * ref, uint32_t x);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    static uint32_t circle_cache_entry_cnt;
+    static uint32_t circle_cache_mem_size;
+    static uint32_t circle_cache_hit_cnt;
+    static uint32_t circle_cache_miss_cnt;
+    static uint32_t circle_cache_evict_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -72,7 +124,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(MASK_LIST[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -80,8 +132,12 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    MASK_LIST[i].param = param;
+    MASK_LIST[i].custom_id = custom_id;
+
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    radius_circle_attach(param);
+#endif
 
     return i;
 }
@@ -99,22 +155,83 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
  */
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len)
+{
+    return lv_draw_mask_apply_span(mask_buf, abs_x, abs_y, len, NULL, NULL);
+}
+
+/**
+ * Apply the added buffers on a line and tell which part of the line is fully covered by every mask.
+ * `mask_buf` keeps its initial values in the covered part so it can be drawn without mask.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param cover_start store the index of the first fully covered pixel here (can be NULL)
+ * @param cover_len store the number of fully covered pixels here. 0 if there are none. (can be NULL)
+ * @return the same as `lv_draw_mask_apply()`
+ */
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_span(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len,
+                                                                 lv_coord_t * cover_start, lv_coord_t * cover_len)
 {
     bool changed = false;
+    bool known = true;
     lv_draw_mask_common_dsc_t * dsc;
+    mask_span_t span;
+    span.x1 = abs_x;
+    span.x2 = abs_x + len - 1;
+    span.cover_x1 = span.x1;
+    span.cover_x2 = span.x2;
+
+    if(cover_start) *cover_start = 0;
+    if(cover_len) *cover_len = 0;
+
+    _lv_draw_mask_saved_t * m = MASK_LIST;
+
+    LV_PROFILER_BEGIN(prof_mask);
+
+    /*Combine the visible and covered parts of the masks*/
+    while(m->param) {
+        if(get_span(m->param, abs_y, &span) == false) {
+            known = false;
+            break;
+        }
+        if(span.x1 > span.x2) {
+            LV_PROFILER_ACC(prof_mask, LV_PROFILER_PHASE_MASK);
+            return LV_DRAW_MASK_RES_TRANSP;
+        }
+        m++;
+    }
+
+    if(known && span.cover_x1 <= span.cover_x2) {
+        if(span.cover_x1 == abs_x && span.cover_x2 == abs_x + len - 1) {
+            LV_PROFILER_ACC(prof_mask, LV_PROFILER_PHASE_MASK);
+            return LV_DRAW_MASK_RES_FULL_COVER;
+        }
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+        if(cover_start) *cover_start = span.cover_x1 - abs_x;
+        if(cover_len) *cover_len = span.cover_x2 - span.cover_x1 + 1;
+    }
 
+    /* The masks' results depend on where the line starts (e.g. on sloped lines)
+     * so always apply them on the whole line. They don't touch the covered part anyway.*/
+    m = MASK_LIST;
     while(m->param) {
         dsc = m->param;
         lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
         res = dsc->cb(mask_buf, abs_x, abs_y, len, (void *)m->param);
-        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        if(res == LV_DRAW_MASK_RES_TRANSP) {
+            if(cover_len) *cover_len = 0;
+            LV_PROFILER_ACC(prof_mask, LV_PROFILER_PHASE_MASK);
+            return LV_DRAW_MASK_RES_TRANSP;
+        }
         else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
 
         m++;
     }
 
+    LV_PROFILER_ACC(prof_mask, LV_PROFILER_PHASE_MASK);
+
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
@@ -129,9 +246,12 @@ void * lv_draw_mask_remove_id(int16_t id)
     void * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        p = MASK_LIST[id].param;
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+        radius_circle_detach(p);
+#endif
+        MASK_LIST[id].param = NULL;
+        MASK_LIST[id].custom_id = NULL;
     }
 
     return p;
@@ -148,10 +268,13 @@ void * lv_draw_mask_remove_custom(void * custom_id)
     void * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).param = NULL;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = NULL;
+        if(MASK_LIST[i].custom_id == custom_id) {
+            p = MASK_LIST[i].param;
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+            radius_circle_detach(p);
+#endif
+            MASK_LIST[i].param = NULL;
+            MASK_LIST[i].custom_id = NULL;
         }
     }
     return p;
@@ -166,7 +289,7 @@ LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(MASK_LIST[i].param) cnt++;
     }
     return cnt;
 }
@@ -376,6 +499,9 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->y_prev = INT32_MIN;
     param->y_prev_x.f = 0;
     param->y_prev_x.i = 0;
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    param->circle = NULL;
+#endif
 }
 
 /**
@@ -414,6 +540,57 @@ void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * c
     param->dsc.type = LV_DRAW_MASK_TYPE_MAP;
 }
 
+/**
+ * Initialize the rounded corner cache
+ */
+void _lv_draw_mask_radius_cache_init(void)
+{
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    _lv_ll_init(&LV_GC_ROOT(_lv_draw_mask_radius_cache_ll), sizeof(_lv_draw_mask_radius_circle_t));
+    circle_cache_entry_cnt = 0;
+    circle_cache_mem_size = 0;
+    circle_cache_hit_cnt = 0;
+    circle_cache_miss_cnt = 0;
+    circle_cache_evict_cnt = 0;
+#endif
+}
+
+/**
+ * Free the cached circles which are not used by an added radius mask. The statistics are kept.
+ */
+void lv_draw_mask_radius_cache_clean(void)
+{
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_draw_mask_radius_cache_ll);
+    _lv_draw_mask_radius_circle_t * circle = _lv_ll_get_head(ll);
+    while(circle) {
+        _lv_draw_mask_radius_circle_t * circle_next = _lv_ll_get_next(ll, circle);
+        if(circle->used_cnt == 0) radius_circle_drop(circle);
+        circle = circle_next;
+    }
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
+/**
+ * Get the statistics of the rounded corner cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_draw_mask_radius_cache_get_stat(lv_draw_mask_radius_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_draw_mask_radius_cache_stat_t));
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    stat->hit_cnt = circle_cache_hit_cnt;
+    stat->miss_cnt = circle_cache_miss_cnt;
+    stat->evict_cnt = circle_cache_evict_cnt;
+    stat->entry_cnt = circle_cache_entry_cnt;
+    stat->mem_size = circle_cache_mem_size;
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -924,6 +1101,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
         return LV_DRAW_MASK_RES_CHANGED;
     }
 
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    /*Only the corners remained. Copy them from the cached circle.*/
+    if(p->circle) return radius_circle_apply(mask_buf, abs_x, abs_y, len, p);
+#endif
+
     int32_t k = rect.x1 - abs_x; /*First relevant coordinate on the of the mask*/
     int32_t w = lv_area_get_width(&rect);
     int32_t h = lv_area_get_height(&rect);
@@ -1203,6 +1385,360 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+/**
+ * Apply the corner rows of a radius mask using its cached circle.
+ * The result is the same as the calculated corners' in `lv_draw_mask_radius()`.
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_circle_apply(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                    lv_coord_t abs_y, lv_coord_t len,
+                                                                    const lv_draw_mask_radius_param_t * p)
+{
+    const _lv_draw_mask_radius_circle_t * circle = p->circle;
+    const lv_area_t * rect = &p->cfg.rect;
+    int32_t radius = circle->radius;
+    int32_t w = lv_area_get_width(rect);
+    int32_t y = abs_y - rect->y1;
+
+    /*The bottom corners are the mirrored top corners*/
+    if(y >= radius) y = lv_area_get_height(rect) - 1 - y;
+
+    const lv_opa_t * opa = &circle->opa[y * radius];
+    int32_t start = circle->opa_start[y];
+    int32_t end = circle->opa_end[y];
+
+    /*Index of the rectangle's first pixel in `mask_buf`. The right corner is mirrored from `k + w - 1`*/
+    int32_t k = rect->x1 - abs_x;
+    int32_t x;
+    int32_t i;
+
+    if(p->cfg.outer == 0) {
+        /*Clear the transparent parts*/
+        int32_t first = k + start;
+        int32_t last = k + w - 1 - start;
+        if(first >= len || last < 0) return LV_DRAW_MASK_RES_TRANSP;
+        if(first > 0) _lv_memset_00(mask_buf, first);
+        if(last < len - 1) _lv_memset_00(&mask_buf[last + 1], len - 1 - last);
+
+        for(x = start; x < end; x++) {
+            i = k + x;
+            if(i >= 0 && i < len) mask_buf[i] = mask_mix(mask_buf[i], opa[x]);
+            i = k + w - 1 - x;
+            if(i >= 0 && i < len) mask_buf[i] = mask_mix(mask_buf[i], opa[x]);
+        }
+    }
+    else {
+        /*Clear the covered middle*/
+        int32_t first = LV_MATH_MAX(k + end, 0);
+        int32_t last = LV_MATH_MIN(k + w - 1 - end, len - 1);
+        if(first <= last) _lv_memset_00(&mask_buf[first], last - first + 1);
+
+        for(x = start; x < end; x++) {
+            i = k + x;
+            if(i >= 0 && i < len) mask_buf[i] = mask_mix(mask_buf[i], 255 - opa[x]);
+            i = k + w - 1 - x;
+            if(i >= 0 && i < len) mask_buf[i] = mask_mix(mask_buf[i], 255 - opa[x]);
+        }
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Get the cached circle of a radius mask when it's added. Calculate and cache it if it's not cached yet.
+ * @param param pointer to a mask parameter. Nothing happens if it's not a radius mask.
+ */
+static void radius_circle_attach(void * param)
+{
+    lv_draw_mask_radius_param_t * p = param;
+    if(p->dsc.cb != (lv_draw_mask_xcb_t)lv_draw_mask_radius) return;
+
+    p->circle = NULL;
+    lv_coord_t radius = p->cfg.radius;
+    if(radius <= 0) return;
+
+    LV_PROFILER_BEGIN(prof_cache);
+    _LV_WORKER_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_draw_mask_radius_cache_ll);
+    _lv_draw_mask_radius_circle_t * circle;
+    _LV_LL_READ(*ll, circle) {
+        if(circle->radius == radius) break;
+    }
+
+    if(circle) {
+        circle_cache_hit_cnt++;
+        _lv_draw_mask_radius_circle_t * head = _lv_ll_get_head(ll);
+        if(circle != head) _lv_ll_move_before(ll, circle, head);
+        LV_PROFILER_END(prof_cache, LV_PROFILER_PHASE_CACHE, "radius_cache_hit");
+    }
+    else {
+        circle_cache_miss_cnt++;
+        circle = radius_circle_create(radius);
+        LV_PROFILER_END(prof_cache, LV_PROFILER_PHASE_CACHE, "radius_cache_miss");
+    }
+
+    if(circle) {
+        circle->used_cnt++;
+        p->circle = circle;
+    }
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Release the cached circle of a radius mask when it's removed
+ * @param param pointer to a mask parameter (can be NULL). Nothing happens if it's not a radius mask.
+ */
+static void radius_circle_detach(void * param)
+{
+    lv_draw_mask_radius_param_t * p = param;
+    if(p == NULL || p->dsc.cb != (lv_draw_mask_xcb_t)lv_draw_mask_radius) return;
+    if(p->circle == NULL) return;
+
+    _LV_WORKER_LOCK();
+    p->circle->used_cnt--;
+    p->circle = NULL;
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Calculate a quarter circle and add it to the cache.
+ * Drop the least recently used, unused circles to stay in the limit.
+ * @param radius radius of the circle
+ * @return the new circle or NULL if it doesn't fit into the cache
+ */
+static _lv_draw_mask_radius_circle_t * radius_circle_create(lv_coord_t radius)
+{
+    uint32_t mem_size = radius_circle_mem_size(radius);
+    if(mem_size > LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE) return NULL;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_draw_mask_radius_cache_ll);
+    _lv_draw_mask_radius_circle_t * circle = _lv_ll_get_tail(ll);
+    while(circle && circle_cache_mem_size + mem_size > LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE) {
+        _lv_draw_mask_radius_circle_t * circle_prev = _lv_ll_get_prev(ll, circle);
+        if(circle->used_cnt == 0) {
+            radius_circle_drop(circle);
+            circle_cache_evict_cnt++;
+        }
+        circle = circle_prev;
+    }
+    if(circle_cache_mem_size + mem_size > LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE) return NULL;
+
+    /*It's not an error if there is no memory for the cache*/
+    uint8_t * buf = lv_mem_alloc(mem_size);
+    if(buf == NULL) return NULL;
+
+    circle = _lv_ll_ins_head(ll);
+    if(circle == NULL) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+
+    circle->opa_start = (uint16_t *)buf;
+    circle->opa_end = circle->opa_start + radius;
+    circle->opa = (lv_opa_t *)(circle->opa_end + radius);
+    circle->radius = radius;
+    circle->used_cnt = 0;
+
+    /*Calculate the top left corner of a `2 * radius` large rectangle with the normal algorithm*/
+    lv_draw_mask_radius_param_t param;
+    lv_area_t rect;
+    lv_area_set(&rect, 0, 0, 2 * radius - 1, 2 * radius - 1);
+    lv_draw_mask_radius_init(&param, &rect, radius, false);
+
+    lv_coord_t y;
+    for(y = 0; y < radius; y++) {
+        lv_opa_t * opa = &circle->opa[y * radius];
+        _lv_memset_ff(opa, radius);
+        lv_draw_mask_res_t res = lv_draw_mask_radius(opa, 0, y, radius, &param);
+        if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(opa, radius);
+
+        int32_t start = 0;
+        while(start < radius && opa[start] == LV_OPA_TRANSP) start++;
+        int32_t end = radius;
+        while(end > start && opa[end - 1] == LV_OPA_COVER) end--;
+        circle->opa_start[y] = start;
+        circle->opa_end[y] = end;
+    }
+
+    circle_cache_entry_cnt++;
+    circle_cache_mem_size += mem_size;
+
+    return circle;
+}
+
+/**
+ * Remove a circle from the cache and free its memory
+ * @param circle pointer to a cached circle
+ */
+static void radius_circle_drop(_lv_draw_mask_radius_circle_t * circle)
+{
+    circle_cache_entry_cnt--;
+    circle_cache_mem_size -= radius_circle_mem_size(circle->radius);
+    lv_mem_free(circle->opa_start);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_draw_mask_radius_cache_ll), circle);
+    lv_mem_free(circle);
+}
+
+/**
+ * Get the memory needed for a cached circle
+ * @param radius radius of the circle
+ * @return the size in bytes
+ */
+static inline uint32_t radius_circle_mem_size(lv_coord_t radius)
+{
+    /*The opacity values, the start and end indices of the rows and the linked list node (with its prev/next pointers)*/
+    return (uint32_t)radius * radius + (uint32_t)radius * 2 * sizeof(uint16_t) +
+           sizeof(_lv_draw_mask_radius_circle_t) + 2 * sizeof(void *);
+}
+#endif /*LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE*/
+
+/**
+ * Narrow the visible and covered part of a line with a mask.
+ * The result is conservative: the pixels out of the covered part might be covered too.
+ * @param dsc pointer to a mask parameter
+ * @param abs_y absolute Y coordinate of the line
+ * @param span the visible and covered parts of the line so far
+ * @return false: the covered part of the mask is unknown (e.g. sloped lines, angle and custom masks)
+ */
+LV_ATTRIBUTE_FAST_MEM static bool get_span(const lv_draw_mask_common_dsc_t * dsc, lv_coord_t abs_y, mask_span_t * span)
+{
+    if(dsc->cb == (lv_draw_mask_xcb_t)lv_draw_mask_radius) {
+        radius_span((const lv_draw_mask_radius_param_t *)dsc, abs_y, span);
+    }
+    else if(dsc->cb == (lv_draw_mask_xcb_t)lv_draw_mask_line) {
+        return line_span((const lv_draw_mask_line_param_t *)dsc, abs_y, span);
+    }
+    else if(dsc->cb == (lv_draw_mask_xcb_t)lv_draw_mask_fade) {
+        fade_span((const lv_draw_mask_fade_param_t *)dsc, abs_y, span);
+    }
+    else if(dsc->cb == (lv_draw_mask_xcb_t)lv_draw_mask_map) {
+        const lv_draw_mask_map_param_t * p = (const lv_draw_mask_map_param_t *)dsc;
+        if(abs_y >= p->cfg.coords.y1 && abs_y <= p->cfg.coords.y2) {
+            span_cover_remove(span, p->cfg.coords.x1, p->cfg.coords.x2);
+        }
+    }
+    else {
+        /*Angle and custom masks*/
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the visible and covered part of a line with a radius mask.
+ */
+LV_ATTRIBUTE_FAST_MEM static void radius_span(const lv_draw_mask_radius_param_t * p, lv_coord_t abs_y, mask_span_t * span)
+{
+    const lv_area_t * rect = &p->cfg.rect;
+    if(abs_y < rect->y1 || abs_y > rect->y2) {
+        if(p->cfg.outer == 0) span->x2 = span->x1 - 1;   /*Out of the rectangle: transparent*/
+        return;                                          /*Outer mask: fully covered*/
+    }
+
+    int32_t radius = p->cfg.radius;
+    int32_t h = lv_area_get_height(rect);
+    int32_t y_rel = abs_y - rect->y1;
+    bool corner = y_rel < radius || y_rel > h - radius - 1;
+
+    if(p->cfg.outer) {
+        /*The anti-aliased pixels of the corners might be mixed 1 px out of the rectangle*/
+        if(corner) span_cover_remove(span, rect->x1 - 1, rect->x2 + 1);
+        else span_cover_remove(span, rect->x1, rect->x2);
+        return;
+    }
+
+    span_visible_and(span, rect->x1, rect->x2);
+
+    /* Not in the corners every pixel of the rectangle is covered.
+     * In the corners don't calculate the circle, just consider the middle part covered.*/
+    if(corner) span_cover_and(span, rect->x1 + radius, rect->x2 - radius);
+    else span_cover_and(span, rect->x1, rect->x2);
+}
+
+/**
+ * Get the visible and covered part of a line with a line mask.
+ * @return false: it's a sloped line, only the horizontal and vertical lines are handled
+ */
+LV_ATTRIBUTE_FAST_MEM static bool line_span(const lv_draw_mask_line_param_t * p, lv_coord_t abs_y, mask_span_t * span)
+{
+    if(p->steep != 0) return false;
+
+    /*The same conditions as in `lv_draw_mask_line()`*/
+    int32_t y_rel = abs_y - p->origo.y;
+    if(p->flat) {
+        if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_LEFT || p->cfg.side == LV_DRAW_MASK_LINE_SIDE_RIGHT) return true;
+        if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_TOP && y_rel + 1 < 0) return true;
+        if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_BOTTOM && y_rel > 0) return true;
+        span->x2 = span->x1 - 1;
+    }
+    else {
+        if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_LEFT) {
+            span_visible_and(span, LV_COORD_MIN, p->origo.x - 1);
+        }
+        else if(p->cfg.side == LV_DRAW_MASK_LINE_SIDE_RIGHT) {
+            span_visible_and(span, p->origo.x, LV_COORD_MAX);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the visible and covered part of a line with a fade mask.
+ */
+LV_ATTRIBUTE_FAST_MEM static void fade_span(const lv_draw_mask_fade_param_t * p, lv_coord_t abs_y, mask_span_t * span)
+{
+    if(abs_y < p->cfg.coords.y1 || abs_y > p->cfg.coords.y2) return;
+
+    /*The same opacity as in `lv_draw_mask_fade()`*/
+    lv_opa_t opa_act;
+    if(abs_y <= p->cfg.y_top) opa_act = p->cfg.opa_top;
+    else if(abs_y >= p->cfg.y_bottom) opa_act = p->cfg.opa_bottom;
+    else {
+        int16_t opa_diff = p->cfg.opa_bottom - p->cfg.opa_top;
+        int32_t y_diff = p->cfg.y_bottom - p->cfg.y_top + 1;
+        opa_act = (int32_t)((int32_t)(abs_y - p->cfg.y_top) * opa_diff) / y_diff;
+        opa_act += p->cfg.opa_top;
+    }
+
+    if(opa_act >= LV_OPA_MAX) return;
+
+    span_cover_remove(span, p->cfg.coords.x1, p->cfg.coords.x2);
+}
+
+/**
+ * Keep only the `x1..x2` part of the visible (and covered) pixels
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void span_visible_and(mask_span_t * span, int32_t x1, int32_t x2)
+{
+    if(span->x1 < x1) span->x1 = x1;
+    if(span->x2 > x2) span->x2 = x2;
+    span_cover_and(span, span->x1, span->x2);
+}
+
+/**
+ * Keep only the `x1..x2` part of the covered pixels
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void span_cover_and(mask_span_t * span, int32_t x1, int32_t x2)
+{
+    if(span->cover_x1 < x1) span->cover_x1 = x1;
+    if(span->cover_x2 > x2) span->cover_x2 = x2;
+}
+
+/**
+ * Remove the `x1..x2` part from the covered pixels. If the rest is split the longer part is kept.
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void span_cover_remove(mask_span_t * span, int32_t x1, int32_t x2)
+{
+    if(x2 < span->cover_x1 || x1 > span->cover_x2) return;
+
+    int32_t left_len = x1 - span->cover_x1;
+    int32_t right_len = span->cover_x2 - x2;
+    if(left_len >= right_len) span->cover_x2 = x1 - 1;
+    else span->cover_x1 = x2 + 1;
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
     if(mask_new >= LV_OPA_MAX) return mask_act;
@@ -134,6 +134,10 @@ typedef struct {
     int32_t y_prev;
     lv_sqrt_res_t y_prev_x;
 
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    /*The cached quarter circle while the mask is added. NULL if not cached.*/
+    struct _lv_draw_mask_radius_circle_t * circle;
+#endif
 } lv_draw_mask_radius_param_t;
 
 typedef struct {
@@ -165,7 +169,20 @@ typedef struct {
     void * custom_id;
 } _lv_draw_mask_saved_t;
 
+#if LV_USE_TILE_RENDER
+typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[LV_TILE_RENDER_WORKER_NUM][_LV_MASK_MAX_NUM];
+#else
 typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[_LV_MASK_MAX_NUM];
+#endif
+
+/** Statistics of the rounded corner cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of added radius masks which found their circle in the cache*/
+    uint32_t miss_cnt;      /**< Number of added radius masks whose circle was calculated*/
+    uint32_t evict_cnt;     /**< Number of circles dropped to stay in the limit*/
+    uint32_t entry_cnt;     /**< Number of cached circles*/
+    uint32_t mem_size;      /**< Memory used by the cached circles [bytes]*/
+} lv_draw_mask_radius_cache_stat_t;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -195,6 +212,21 @@ int16_t lv_draw_mask_add(void * param, void * custom_id);
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len);
 
+/**
+ * Apply the added buffers on a line and tell which part of the line is fully covered by every mask.
+ * `mask_buf` keeps its initial values in the covered part so it can be drawn without mask.
+ * @param mask_buf store the result mask here. Has to be `len` byte long. Should be initialized with `0xFF`.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param cover_start store the index of the first fully covered pixel here (can be NULL)
+ * @param cover_len store the number of fully covered pixels here. 0 if there are none. (can be NULL)
+ * @return the same as `lv_draw_mask_apply()`
+ */
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_span(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len,
+                                                                 lv_coord_t * cover_start, lv_coord_t * cover_len);
+
 //! @endcond
 
 /**
@@ -291,6 +323,22 @@ void lv_draw_mask_fade_init(lv_draw_mask_fade_param_t * param, const lv_area_t *
  */
 void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * coords, const lv_opa_t * map);
 
+/**
+ * Initialize the rounded corner cache
+ */
+void _lv_draw_mask_radius_cache_init(void);
+
+/**
+ * Free the cached circles which are not used by an added radius mask. The statistics are kept.
+ */
+void lv_draw_mask_radius_cache_clean(void);
+
+/**
+ * Get the statistics of the rounded corner cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_draw_mask_radius_cache_get_stat(lv_draw_mask_radius_cache_stat_t * stat);
+
 /**********************
  *      MACROS
  **********************/
@@ -11,6 +11,7 @@
 #include "lv_draw_mask.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_txt_ap.h"
+#include "../lv_misc/lv_gc.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
 
@@ -24,6 +25,15 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/*A cached shadow corner in `_lv_shadow_cache_ll`. The most recently used is the head.*/
+typedef struct {
+    lv_opa_t * buf;     /*`size * size` opacity values*/
+    lv_coord_t sw;      /*Shadow width*/
+    lv_coord_t r;       /*Radius of the shadow*/
+    uint32_t size;      /*Corner size (`sw + r`)*/
+} shadow_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -42,6 +52,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+    static shadow_cache_entry_t * shadow_cache_find(lv_coord_t sw, lv_coord_t r);
+    static void shadow_cache_add(lv_coord_t sw, lv_coord_t r, const lv_opa_t * sh_buf, uint32_t size);
+    static void shadow_cache_drop(shadow_cache_entry_t * entry);
+#endif
 #endif
 
 #if LV_USE_PATTERN
@@ -59,9 +74,11 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static uint32_t sh_cache_entry_cnt;
+    static uint32_t sh_cache_mem_size;
+    static uint32_t sh_cache_hit_cnt;
+    static uint32_t sh_cache_miss_cnt;
+    static uint32_t sh_cache_evict_cnt;
 #endif
 
 /**********************
@@ -72,6 +89,56 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+/**
+ * Initialize the shadow cache
+ */
+void _lv_draw_shadow_cache_init(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    _lv_ll_init(&LV_GC_ROOT(_lv_shadow_cache_ll), sizeof(shadow_cache_entry_t));
+    sh_cache_entry_cnt = 0;
+    sh_cache_mem_size = 0;
+    sh_cache_hit_cnt = 0;
+    sh_cache_miss_cnt = 0;
+    sh_cache_evict_cnt = 0;
+#endif
+}
+
+/**
+ * Free all the cached shadows. The statistics are kept.
+ */
+void lv_draw_shadow_cache_clean(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    _LV_WORKER_LOCK();
+    shadow_cache_entry_t * entry = _lv_ll_get_head(&LV_GC_ROOT(_lv_shadow_cache_ll));
+    while(entry) {
+        shadow_cache_entry_t * entry_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_shadow_cache_ll), entry);
+        shadow_cache_drop(entry);
+        entry = entry_next;
+    }
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_draw_shadow_cache_stat_t));
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    _LV_WORKER_LOCK();
+    stat->hit_cnt = sh_cache_hit_cnt;
+    stat->miss_cnt = sh_cache_miss_cnt;
+    stat->evict_cnt = sh_cache_evict_cnt;
+    stat->entry_cnt = sh_cache_entry_cnt;
+    stat->mem_size = sh_cache_mem_size;
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc)
 {
     _lv_memset_00(dsc, sizeof(lv_draw_rect_dsc_t));
@@ -217,6 +284,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     else if(grad_dir == LV_GRAD_DIR_HOR) simple_mode = false;
 
     int16_t mask_rout_id = LV_MASK_ID_INV;
+    lv_draw_mask_radius_param_t mask_rout_param;
 
     int32_t coords_w = lv_area_get_width(&coords_bg);
     int32_t coords_h = lv_area_get_height(&coords_bg);
@@ -234,7 +302,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     }
     /*More complex case: there is a radius, gradient or other mask.*/
     else {
-        lv_draw_mask_radius_param_t mask_rout_param;
         if(rout > 0) {
             lv_draw_mask_radius_init(&mask_rout_param, &coords_bg, rout, false);
             mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
@@ -261,6 +328,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
         lv_opa_t opa2;
 
+        /*The part of the line which is not affected by the masks*/
+        lv_coord_t cover_start = 0;
+        lv_coord_t cover_len = 0;
+        lv_coord_t mask_x0 = vdb->area.x1 + draw_area.x1;
+
         lv_area_t fill_area;
         fill_area.x1 = coords_bg.x1;
         fill_area.x2 = coords_bg.x2;
@@ -270,6 +342,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
             int32_t y = h + vdb->area.y1;
 
             opa2 = opa;
+            cover_len = 0;
 
             /*In not corner areas apply the mask only if required*/
             if(y > coords_bg.y1 + rout + 1 &&
@@ -277,13 +350,15 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
                 mask_res = LV_DRAW_MASK_RES_FULL_COVER;
                 if(simple_mode == false) {
                     _lv_memset(mask_buf, opa, draw_area_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                    mask_res = lv_draw_mask_apply_span(mask_buf, mask_x0, vdb->area.y1 + h, draw_area_w,
+                                                       &cover_start, &cover_len);
                 }
             }
             /*In corner areas apply the mask anyway*/
             else {
                 _lv_memset(mask_buf, opa, draw_area_w);
-                mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+                mask_res = lv_draw_mask_apply_span(mask_buf, mask_x0, vdb->area.y1 + h, draw_area_w,
+                                                   &cover_start, &cover_len);
             }
 
             /*If mask will taken into account its base opacity was already set by memset above*/
@@ -330,6 +405,36 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
                                grad_color, mask_buf + mask_ofs, mask_res, opa2, dsc->bg_blend_mode);
 
             }
+            /* If only the edges of the line are masked (e.g. by the parent's rounded corner)
+             * draw the covered middle without mask*/
+            else if(mask_res == LV_DRAW_MASK_RES_CHANGED && cover_len > SPLIT_LIMIT &&
+                    grad_dir != LV_GRAD_DIR_HOR && (grad_dir == LV_GRAD_DIR_VER || other_mask_cnt != 0 || !split)) {
+                lv_area_t fill_area2;
+                fill_area2.y1 = fill_area.y1;
+                fill_area2.y2 = fill_area.y2;
+
+                /*Left part*/
+                if(cover_start > 0) {
+                    fill_area2.x1 = coords_bg.x1;
+                    fill_area2.x2 = mask_x0 + cover_start - 1;
+                    _lv_blend_fill(clip, &fill_area2,
+                                   grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                }
+
+                /*Center part*/
+                fill_area2.x1 = mask_x0 + cover_start;
+                fill_area2.x2 = mask_x0 + cover_start + cover_len - 1;
+                _lv_blend_fill(clip, &fill_area2,
+                               grad_color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, dsc->bg_blend_mode);
+
+                /*Right part*/
+                if(cover_start + cover_len < draw_area_w) {
+                    fill_area2.x1 = mask_x0 + cover_start + cover_len;
+                    fill_area2.x2 = coords_bg.x2;
+                    _lv_blend_fill(clip, &fill_area2,
+                                   grad_color, mask_buf + cover_start + cover_len, mask_res, opa2, dsc->bg_blend_mode);
+                }
+            }
             else {
                 if(grad_dir == LV_GRAD_DIR_HOR) {
                     _lv_blend_map(clip, &fill_area, grad_map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
@@ -591,23 +696,26 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    _LV_WORKER_LOCK();
+    shadow_cache_entry_t * sh_cache_entry = shadow_cache_find(sw, r_sh);
+    if(sh_cache_entry) {
         /*Use the cache if available*/
+        sh_cache_hit_cnt++;
         sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        _lv_memcpy(sh_buf, sh_cache_entry->buf, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation */
+        sh_cache_miss_cnt++;
         sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
+        /*Cache the corner if it's not too large*/
+        if(corner_size < LV_SHADOW_CACHE_SIZE) {
+            shadow_cache_add(sw, r_sh, sh_buf, corner_size);
         }
     }
+    _LV_WORKER_UNLOCK();
 #else
     sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
     shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
@@ -1157,6 +1265,81 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
     _lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_SHADOW_CACHE_SIZE
+/**
+ * Find a cached shadow corner and make it the most recently used
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @return the cache entry or NULL if not found
+ */
+static shadow_cache_entry_t * shadow_cache_find(lv_coord_t sw, lv_coord_t r)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_shadow_cache_ll);
+    shadow_cache_entry_t * entry;
+    _LV_LL_READ(*ll, entry) {
+        if(entry->sw == sw && entry->r == r) {
+            shadow_cache_entry_t * head = _lv_ll_get_head(ll);
+            if(entry != head) _lv_ll_move_before(ll, entry, head);
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a shadow corner to the cache. Drop the least recently used corners to stay in the limits.
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @param sh_buf the calculated corner
+ * @param size size of the corner (`sw + r`)
+ */
+static void shadow_cache_add(lv_coord_t sw, lv_coord_t r, const lv_opa_t * sh_buf, uint32_t size)
+{
+    uint32_t mem_size = size * size;
+    if(mem_size > LV_SHADOW_CACHE_MEM_SIZE) return;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_shadow_cache_ll);
+    while(sh_cache_entry_cnt >= LV_SHADOW_CACHE_ENTRY_CNT || sh_cache_mem_size + mem_size > LV_SHADOW_CACHE_MEM_SIZE) {
+        shadow_cache_entry_t * tail = _lv_ll_get_tail(ll);
+        if(tail == NULL) break;
+        shadow_cache_drop(tail);
+        sh_cache_evict_cnt++;
+    }
+
+    /*It's not an error if there is no memory for the cache*/
+    lv_opa_t * buf = lv_mem_alloc(mem_size);
+    if(buf == NULL) return;
+
+    shadow_cache_entry_t * entry = _lv_ll_ins_head(ll);
+    if(entry == NULL) {
+        lv_mem_free(buf);
+        return;
+    }
+
+    _lv_memcpy(buf, sh_buf, mem_size);
+    entry->buf = buf;
+    entry->sw = sw;
+    entry->r = r;
+    entry->size = size;
+    sh_cache_entry_cnt++;
+    sh_cache_mem_size += mem_size;
+}
+
+/**
+ * Remove a shadow corner from the cache and free its memory
+ * @param entry pointer to a cache entry
+ */
+static void shadow_cache_drop(shadow_cache_entry_t * entry)
+{
+    sh_cache_entry_cnt--;
+    sh_cache_mem_size -= entry->size * entry->size;
+    lv_mem_free(entry->buf);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_shadow_cache_ll), entry);
+    lv_mem_free(entry);
+}
+#endif /*LV_SHADOW_CACHE_SIZE*/
+
 #endif
 
 #if LV_USE_OUTLINE
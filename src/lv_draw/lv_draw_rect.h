@@ -81,10 +81,35 @@ typedef struct {
     lv_blend_mode_t value_blend_mode;
 } lv_draw_rect_dsc_t;
 
+/** Statistics of the shadow cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of shadows taken from the cache*/
+    uint32_t miss_cnt;      /**< Number of shadows calculated*/
+    uint32_t evict_cnt;     /**< Number of shadows dropped to stay in the limits*/
+    uint32_t entry_cnt;     /**< Number of cached shadows*/
+    uint32_t mem_size;      /**< Memory used by the cached shadows [bytes]*/
+} lv_draw_shadow_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the shadow cache
+ */
+void _lv_draw_shadow_cache_init(void);
+
+/**
+ * Free all the cached shadows. The statistics are kept.
+ */
+void lv_draw_shadow_cache_clean(void);
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc);
 
 //! @endcond
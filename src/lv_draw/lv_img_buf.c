@@ -25,6 +25,13 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_IMG_TRANSFORM
+static inline void transform_get_src(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t * xs, int32_t * ys);
+static int32_t transform_search(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t first, int32_t last,
+                                bool hor, bool inc, int32_t limit);
+static bool transform_clip_line(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t len,
+                                int32_t * start, int32_t * end);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -676,7 +683,279 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Transform a horizontal line of pixels.
+ * The source coordinates are calculated only for the first pixel and stepped for the others
+ * and only the part of the line which falls onto the source image is read.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel (as in `_lv_img_buf_transform`)
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param color_buf store the colors here (the pixels out of the image are not written)
+ * @param opa_buf store the opacities here (`LV_OPA_TRANSP` for the pixels out of the image)
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    int32_t start;
+    int32_t end;
+    if(transform_clip_line(dsc, x, y, len, &start, &end) == false) {
+        _lv_memset_00(opa_buf, len);
+        return;
+    }
+
+    _lv_memset_00(opa_buf, start);
+    _lv_memset_00(&opa_buf[end], len - end);
+
+    /*Step the source coordinates on the visible part of the line.
+     *The products are stepped exactly so the result is the same as with `_lv_img_buf_transform`*/
+    int32_t * xs_buf = _lv_mem_buf_get((end - start) * sizeof(int32_t));
+    int32_t * ys_buf = _lv_mem_buf_get((end - start) * sizeof(int32_t));
+    int32_t xt = x + start - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+    int32_t i;
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        int32_t xs_acc = dsc->tmp.cosma * xt - dsc->tmp.sinma * yt;
+        int32_t ys_acc = dsc->tmp.sinma * xt + dsc->tmp.cosma * yt;
+        for(i = 0; i < end - start; i++) {
+            xs_buf[i] = (xs_acc >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
+            ys_buf[i] = (ys_acc >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
+            xs_acc += dsc->tmp.cosma;
+            ys_acc += dsc->tmp.sinma;
+        }
+    }
+    else {
+        uint32_t xt_acc = (uint32_t)xt * dsc->tmp.zoom_inv;
+        int32_t yt_zoom = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        if(dsc->cfg.angle == 0) {
+            for(i = 0; i < end - start; i++) {
+                xs_buf[i] = ((int32_t)xt_acc >> _LV_ZOOM_INV_UPSCALE) + dsc->tmp.pivot_x_256;
+                ys_buf[i] = yt_zoom + dsc->tmp.pivot_y_256;
+                xt_acc += dsc->tmp.zoom_inv;
+            }
+        }
+        else {
+            int32_t sin_yt = dsc->tmp.sinma * yt_zoom;
+            int32_t cos_yt = dsc->tmp.cosma * yt_zoom;
+            for(i = 0; i < end - start; i++) {
+                int32_t xt_zoom = (int32_t)xt_acc >> _LV_ZOOM_INV_UPSCALE;
+                xs_buf[i] = ((dsc->tmp.cosma * xt_zoom - sin_yt) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_x_256;
+                ys_buf[i] = ((dsc->tmp.sinma * xt_zoom + cos_yt) >> _LV_TRANSFORM_TRIGO_SHIFT) + dsc->tmp.pivot_y_256;
+                xt_acc += dsc->tmp.zoom_inv;
+            }
+        }
+    }
+
+    /*Read the source pixels with a loop specialized to the color format.
+     *Keep the often used fields in local variables as the buffers might alias `dsc`*/
+    const uint8_t * src_u8 = (const uint8_t *)dsc->cfg.src;
+    uint32_t src_w = dsc->cfg.src_w;
+    bool antialias = dsc->cfg.antialias;
+    bool chroma_keyed = dsc->tmp.chroma_keyed ? true : false;
+    lv_color_t chroma_key = LV_COLOR_TRANSP;
+    lv_color_t * color_p = &color_buf[start];
+    lv_opa_t * opa_p = &opa_buf[start];
+    int32_t px_num = end - start;
+    if(dsc->tmp.native_color && dsc->tmp.has_alpha == 0) {
+        const uint8_t px_size = LV_COLOR_SIZE >> 3;
+        for(i = 0; i < px_num; i++) {
+            int32_t xs_int = xs_buf[i] >> 8;
+            int32_t ys_int = ys_buf[i] >> 8;
+            uint32_t pxi = (src_w * ys_int + xs_int) * px_size;
+            lv_color_t c;
+            _lv_memcpy_small(&c, &src_u8[pxi], px_size);
+            if(chroma_keyed && c.full == chroma_key.full) {
+                opa_p[i] = LV_OPA_TRANSP;
+                continue;
+            }
+
+            if(antialias == false) {
+                color_p[i] = c;
+                opa_p[i] = LV_OPA_COVER;
+                continue;
+            }
+
+            dsc->res.color = c;
+            dsc->tmp.xs = xs_buf[i];
+            dsc->tmp.ys = ys_buf[i];
+            dsc->tmp.xs_int = xs_int;
+            dsc->tmp.ys_int = ys_int;
+            dsc->tmp.pxi = pxi;
+            dsc->tmp.px_size = px_size;
+            bool ret = _lv_img_buf_transform_anti_alias(dsc);
+            color_p[i] = dsc->res.color;
+            opa_p[i] = ret ? dsc->res.opa : LV_OPA_TRANSP;
+        }
+    }
+    else if(dsc->tmp.native_color) {
+        /*Only the color bytes are read so the last byte of the 32 bit colors is kept from the previous pixel.
+         *Only `LV_IMG_CF_TRUE_COLOR_ALPHA` comes here and it's never chroma keyed*/
+        const uint8_t px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+        lv_color_t c = dsc->res.color;
+        for(i = 0; i < px_num; i++) {
+            int32_t xs_int = xs_buf[i] >> 8;
+            int32_t ys_int = ys_buf[i] >> 8;
+            uint32_t pxi = (src_w * ys_int + xs_int) * px_size;
+            _lv_memcpy_small(&c, &src_u8[pxi], px_size - 1);
+            if(antialias == false) {
+                color_p[i] = c;
+                opa_p[i] = src_u8[pxi + px_size - 1];
+                continue;
+            }
+
+            dsc->res.color = c;
+            dsc->res.opa = src_u8[pxi + px_size - 1];
+            dsc->tmp.xs = xs_buf[i];
+            dsc->tmp.ys = ys_buf[i];
+            dsc->tmp.xs_int = xs_int;
+            dsc->tmp.ys_int = ys_int;
+            dsc->tmp.pxi = pxi;
+            dsc->tmp.px_size = px_size;
+            bool ret = _lv_img_buf_transform_anti_alias(dsc);
+            c = dsc->res.color;
+            color_p[i] = c;
+            opa_p[i] = ret ? dsc->res.opa : LV_OPA_TRANSP;
+        }
+        dsc->res.color = c;
+    }
+    else {
+        /*Indexed and alpha only images*/
+        for(i = 0; i < px_num; i++) {
+            int32_t xs_int = xs_buf[i] >> 8;
+            int32_t ys_int = ys_buf[i] >> 8;
+            dsc->res.color = lv_img_buf_get_px_color(&dsc->tmp.img_dsc, xs_int, ys_int, dsc->cfg.color);
+            dsc->res.opa = lv_img_buf_get_px_alpha(&dsc->tmp.img_dsc, xs_int, ys_int);
+            if(chroma_keyed && dsc->res.color.full == chroma_key.full) {
+                opa_p[i] = LV_OPA_TRANSP;
+                continue;
+            }
+
+            bool ret = true;
+            if(antialias) {
+                dsc->tmp.xs = xs_buf[i];
+                dsc->tmp.ys = ys_buf[i];
+                dsc->tmp.xs_int = xs_int;
+                dsc->tmp.ys_int = ys_int;
+                ret = _lv_img_buf_transform_anti_alias(dsc);
+            }
+            color_p[i] = dsc->res.color;
+            opa_p[i] = ret ? dsc->res.opa : LV_OPA_TRANSP;
+        }
+    }
+
+    _lv_mem_buf_release(ys_buf);
+    _lv_mem_buf_release(xs_buf);
+}
 #endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Get the source coordinates of a pixel in 1/256 units in the same way as `_lv_img_buf_transform`
+ * @param dsc pointer to the transformation descriptor
+ * @param x the x coordinate of the pixel
+ * @param y the y coordinate of the pixel
+ * @param xs store the source x coordinate here
+ * @param ys store the source y coordinate here
+ */
+static inline void transform_get_src(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t * xs, int32_t * ys)
+{
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
+    }
+    else if(dsc->cfg.angle == 0) {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = xt + dsc->tmp.pivot_x_256;
+        *ys = yt + dsc->tmp.pivot_y_256;
+    }
+    else {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_y_256;
+    }
+}
+
+/**
+ * Find the first pixel of a line whose source pixel reached a limit.
+ * The source coordinates change monotonously along the line so binary search can be used.
+ * @param dsc pointer to the transformation descriptor
+ * @param x the x coordinate of the first pixel of the line
+ * @param y the y coordinate of the line
+ * @param first index of the first pixel to check
+ * @param last index after the last pixel to check
+ * @param hor true: check the source x coordinate; false: check the source y coordinate
+ * @param inc true: the source coordinate increases along the line; false: it decreases
+ * @param limit a source coordinate (in pixels)
+ * @return index of the first pixel at or above `limit` if `inc` is true or below `limit` if `inc` is false;
+ *         `last` if there is no such pixel
+ */
+static int32_t transform_search(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t first, int32_t last,
+                                bool hor, bool inc, int32_t limit)
+{
+    while(first < last) {
+        int32_t mid = first + ((last - first) >> 1);
+        int32_t xs;
+        int32_t ys;
+        transform_get_src(dsc, x + mid, y, &xs, &ys);
+        int32_t v = (hor ? xs : ys) >> 8;
+        bool reached = inc ? v >= limit : v < limit;
+        if(reached) last = mid;
+        else first = mid + 1;
+    }
+
+    return first;
+}
+
+/**
+ * Get the part of a line whose source pixels are on the source image
+ * @param dsc pointer to the transformation descriptor
+ * @param x the x coordinate of the first pixel of the line
+ * @param y the y coordinate of the line
+ * @param len length of the line
+ * @param start store the index of the first pixel on the image here
+ * @param end store the index after the last pixel on the image here
+ * @return true: a part of the line is on the image; false: the whole line is out of the image
+ */
+static bool transform_clip_line(const lv_img_transform_dsc_t * dsc, int32_t x, int32_t y, int32_t len,
+                                int32_t * start, int32_t * end)
+{
+    if(len <= 0) return false;
+
+    int32_t xs_first;
+    int32_t ys_first;
+    int32_t xs_last;
+    int32_t ys_last;
+    transform_get_src(dsc, x, y, &xs_first, &ys_first);
+    transform_get_src(dsc, x + len - 1, y, &xs_last, &ys_last);
+
+    /*Clip by the source x and y coordinate one after the other*/
+    *start = 0;
+    *end = len;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        bool hor = i == 0 ? true : false;
+        bool inc = hor ? xs_first <= xs_last : ys_first <= ys_last;
+        int32_t max = hor ? dsc->cfg.src_w : dsc->cfg.src_h;
+        if(inc) {
+            *start = transform_search(dsc, x, y, *start, *end, hor, true, 0);
+            *end = transform_search(dsc, x, y, *start, *end, hor, true, max);
+        }
+        else {
+            *start = transform_search(dsc, x, y, *start, *end, hor, false, max);
+            *end = transform_search(dsc, x, y, *start, *end, hor, false, 0);
+        }
+        if(*start >= *end) return false;
+    }
+
+    return true;
+}
+#endif
@@ -278,6 +278,20 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc);
  */
 bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc);
 
+/**
+ * Transform a horizontal line of pixels.
+ * The source coordinates are calculated only for the first pixel and stepped for the others
+ * and only the part of the line which falls onto the source image is read.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel (as in `_lv_img_buf_transform`)
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param color_buf store the colors here (the pixels out of the image are not written)
+ * @param opa_buf store the opacities here (`LV_OPA_TRANSP` for the pixels out of the image)
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * color_buf, lv_opa_t * opa_buf);
+
 /**
  * Get which color and opa would come to a pixel if it were rotated
  * @param dsc a descriptor initialized by `lv_img_buf_rotate_init`
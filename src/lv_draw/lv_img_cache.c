@@ -12,6 +12,7 @@
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -26,6 +27,10 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*The transparent and opaque runs shorter than this are stored as mixed runs
+ *because blending them separately would be slower*/
+#define LV_IMG_RUN_MIN_LEN  8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,19 +38,36 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_img_cache_entry_t * cache_open(const void * src, lv_color_t color);
+static lv_img_cache_entry_t * temp_open(const void * src, lv_color_t color);
+static lv_res_t entry_decoder_open(lv_img_cache_entry_t * entry, const void * src, lv_color_t color);
 #if LV_IMG_CACHE_DEF_SIZE
 static bool lv_img_cache_match(const void * src1, const void * src2);
+static uint32_t get_hash(const void * src, lv_color_t color);
+static void cache_link(uint16_t id);
+static void cache_drop(uint16_t id);
+static inline int32_t get_life(const lv_img_cache_entry_t * entry);
+static inline bool entry_is_pinned(const lv_img_cache_entry_t * entry);
+#if LV_IMG_CACHE_RUNS
+static void runs_create(lv_img_cache_entry_t * entry);
+static uint32_t get_row_runs(const uint8_t * px, uint32_t w, uint16_t * runs, uint32_t * mixed_cnt);
 #endif
-
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    static lv_img_cache_entry_t cache_temp;
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_img_cache_entry_t cache_temp[_LV_WORKER_NUM];    /*The images opened without caching by each worker*/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * buckets;      /*Index + 1 of the first entry in every hash bucket. Stored after the entries*/
+    static uint16_t bucket_cnt;     /*Power of 2*/
+    static uint32_t aging_cnt;      /*Incremented on every open instead of decrementing every life*/
+    static uint32_t cache_mem_size;
+    static uint32_t cache_used_cnt;
+    static uint32_t cache_hit_cnt;
+    static uint32_t cache_miss_cnt;
+    static uint32_t cache_evict_cnt;
 #endif
 
 /**********************
@@ -66,81 +88,45 @@ static bool lv_img_cache_match(const void * src1, const void * src2);
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 {
-    /*Is the image cached?*/
-    lv_img_cache_entry_t * cached_src = NULL;
-
-#if LV_IMG_CACHE_DEF_SIZE
-    if(entry_cnt == 0) {
-        LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
-        return NULL;
-    }
-
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
-    }
+    /*The entries are shared by the workers rendering the tiles*/
+    _LV_WORKER_LOCK();
+    lv_img_cache_entry_t * cached_src = cache_open(src, color);
+#if LV_USE_TILE_RENDER && LV_IMG_CACHE_DEF_SIZE
+    if(cached_src) cached_src->pin_cnt++;
+#endif
+    _LV_WORKER_UNLOCK();
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    return cached_src;
+}
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+/**
+ * Tell that an entry returned by `_lv_img_cache_open` is not used anymore.
+ * The images which are not cached (e.g. `LV_IMG_CACHE_DEF_SIZE == 0`) are closed here.
+ * @param entry pointer to the entry
+ * @param drop true: close the image too (e.g. because it couldn't be read) if no one else uses it
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry, bool drop)
+{
+    /*The temporary entries are used by only one worker*/
+    if(entry >= cache_temp && entry < cache_temp + _LV_WORKER_NUM) {
+        lv_img_decoder_close(&entry->dec_dsc);
+        _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+        return;
     }
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+#if LV_IMG_CACHE_DEF_SIZE
+    _LV_WORKER_LOCK();
+#if LV_USE_TILE_RENDER
+    if(entry->pin_cnt > 0) entry->pin_cnt--;
+    if(entry->pin_cnt > 0) drop = false;
+#endif
+    if(drop) {
+        cache_drop((uint16_t)(entry - LV_GC_ROOT(_lv_img_cache_array)));
     }
+    _LV_WORKER_UNLOCK();
 #else
-    cached_src = &cache_temp;
+    LV_UNUSED(drop);
 #endif
-    /*Open the image and measure the time to open*/
-    uint32_t t_start  = lv_tick_get();
-    lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
-    if(open_res == LV_RES_INV) {
-        LV_LOG_WARN("Image draw cannot open the image resource");
-        _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
-        return NULL;
-    }
-
-    cached_src->life = 0;
-
-    /*If `time_to_open` was not set in the open function set it here*/
-    if(cached_src->dec_dsc.time_to_open == 0) {
-        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
-    }
-
-    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
-
-    return cached_src;
 }
 
 /**
@@ -161,17 +147,29 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    /*Use at least as many hash buckets as entries*/
+    uint32_t new_bucket_cnt = 1;
+    while(new_bucket_cnt < new_entry_cnt) new_bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The hash buckets are stored after the entries*/
+    uint32_t entries_size = sizeof(lv_img_cache_entry_t) * new_entry_cnt;
+    uint32_t alloc_size = entries_size + sizeof(uint16_t) * new_bucket_cnt;
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(alloc_size);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
+        bucket_cnt = 0;
+        buckets = NULL;
         return;
     }
     entry_cnt = new_entry_cnt;
+    bucket_cnt = new_bucket_cnt;
+    buckets = (uint16_t *)((uint8_t *)LV_GC_ROOT(_lv_img_cache_array) + entries_size);
 
     /*Clean the cache*/
-    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), alloc_size);
+    cache_mem_size = 0;
+    cache_used_cnt = 0;
 #endif
 }
 
@@ -187,14 +185,47 @@ void lv_img_cache_invalidate_src(const void * src)
 
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) continue;
         if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
-
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+            cache_drop(i);
         }
     }
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+/**
+ * Get the statistics of the image cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_img_cache_stat_t));
+#if LV_IMG_CACHE_DEF_SIZE
+    stat->hit_cnt = cache_hit_cnt;
+    stat->miss_cnt = cache_miss_cnt;
+    stat->evict_cnt = cache_evict_cnt;
+    stat->entry_cnt = cache_used_cnt;
+    stat->mem_size = cache_mem_size;
+#endif
+}
+
+/**
+ * Get an entry of the cache, e.g. to check its `hit_cnt`, `mem_size` or `dec_dsc.time_to_open`
+ * @param id index of the entry. 0 .. cache size - 1
+ * @return pointer to the entry or NULL if `id` is too large or the entry is unused
+ */
+const lv_img_cache_entry_t * lv_img_cache_get_entry(uint16_t id)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(id >= entry_cnt) return NULL;
+
+    lv_img_cache_entry_t * entry = &LV_GC_ROOT(_lv_img_cache_array)[id];
+    return entry->dec_dsc.src ? entry : NULL;
+#else
+    LV_UNUSED(id);
+    return NULL;
 #endif
 }
 
@@ -202,6 +233,173 @@ void lv_img_cache_invalidate_src(const void * src)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Find an image in the cache or open and cache it. Called with the worker lock held.
+ * @param src source of the image
+ * @param color color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return pointer to the entry or NULL if the image can't be opened
+ */
+static lv_img_cache_entry_t * cache_open(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Is the image cached?*/
+    lv_img_cache_entry_t * cached_src = NULL;
+
+    if(entry_cnt == 0) {
+        LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
+        return NULL;
+    }
+
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    /*Make the entries older*/
+    aging_cnt += LV_IMG_CACHE_AGING;
+
+    uint32_t hash = get_hash(src, color);
+    uint16_t id = buckets[hash & (bucket_cnt - 1)];
+    while(id != 0) {
+        lv_img_cache_entry_t * entry = &cache[id - 1];
+        if(entry->hash == hash && color.full == entry->dec_dsc.color.full &&
+           lv_img_cache_match(src, entry->dec_dsc.src)) {
+            /* If opened increment its life.
+             * Image difficult to open should live longer to keep avoid frequent their recaching.
+             * Therefore increase `life` with `time_to_open`*/
+            cached_src = entry;
+            int32_t life = get_life(cached_src) + cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+            if(life > LV_IMG_CACHE_LIFE_LIMIT) life = LV_IMG_CACHE_LIFE_LIMIT;
+            cached_src->life = (int32_t)(aging_cnt + (uint32_t)life);
+            cached_src->hit_cnt++;
+            cache_hit_cnt++;
+            LV_LOG_TRACE("image draw: image found in the cache");
+            break;
+        }
+        id = entry->hash_next;
+    }
+
+    /*The image is not cached then cache it now*/
+    if(cached_src) return cached_src;
+
+    cache_miss_cnt++;
+
+    /*Find an entry to reuse. Select an empty entry or the entry with the least life*/
+    uint16_t i;
+    int32_t reuse_id = -1;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) {
+            reuse_id = i;
+            break;
+        }
+        if(entry_is_pinned(&cache[i])) continue;
+        if(reuse_id < 0 || get_life(&cache[i]) < get_life(&cache[reuse_id])) reuse_id = i;
+    }
+
+    /*All entries are being drawn by the other workers so open the image only for this draw*/
+    if(reuse_id < 0) {
+        LV_LOG_INFO("image draw: all entries are in use, open the image without caching");
+        return temp_open(src, color);
+    }
+
+    cached_src = &cache[reuse_id];
+
+    /*Close the decoder to reuse if it was opened (has a valid source)*/
+    if(cached_src->dec_dsc.src) {
+        cache_drop((uint16_t)reuse_id);
+        cache_evict_cnt++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+    else {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+    }
+
+    if(entry_decoder_open(cached_src, src, color) != LV_RES_OK) return NULL;
+
+    cached_src->life = (int32_t)aging_cnt;
+    cached_src->hash = hash;
+    cached_src->hit_cnt = 0;
+
+    /*Count only the images decoded into the RAM (not the variables and mapped files used directly)*/
+    cached_src->mem_size = 0;
+    const uint8_t * img_data = cached_src->dec_dsc.img_data;
+    bool user_data = lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE && img_data == ((const lv_img_dsc_t *)src)->data;
+    if(img_data && !cached_src->dec_dsc.img_data_mapped && !user_data) {
+        cached_src->mem_size = lv_img_buf_get_img_size(cached_src->dec_dsc.header.w, cached_src->dec_dsc.header.h,
+                                                       cached_src->dec_dsc.header.cf);
+    }
+
+#if LV_IMG_CACHE_RUNS
+    /*The pixels of the variables can be changed any time (e.g. by a canvas) and the runs would be a stale copy*/
+    if(!user_data) {
+        runs_create(cached_src);
+        if(cached_src->runs) cached_src->mem_size += cached_src->runs->size;
+    }
+#endif
+
+    cache_link((uint16_t)reuse_id);
+
+#if LV_IMG_CACHE_MEM_SIZE
+    /*Close the images with the least life until the decoded images fit into the limit*/
+    while(cache_mem_size > LV_IMG_CACHE_MEM_SIZE) {
+        int32_t drop_id = -1;
+        for(i = 0; i < entry_cnt; i++) {
+            if(i == reuse_id || cache[i].dec_dsc.src == NULL || cache[i].mem_size == 0) continue;
+            if(entry_is_pinned(&cache[i])) continue;
+            if(drop_id < 0 || get_life(&cache[i]) < get_life(&cache[drop_id])) drop_id = i;
+        }
+        if(drop_id < 0) break;
+
+        cache_drop((uint16_t)drop_id);
+        cache_evict_cnt++;
+        LV_LOG_INFO("image draw: close an image to stay in LV_IMG_CACHE_MEM_SIZE");
+    }
+#endif
+
+    return cached_src;
+#else
+    return temp_open(src, color);
+#endif
+}
+
+/**
+ * Open an image into the temporary entry of the calling worker. It's closed by `_lv_img_cache_release`.
+ * @param src source of the image
+ * @param color color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return pointer to the entry or NULL if the image can't be opened
+ */
+static lv_img_cache_entry_t * temp_open(const void * src, lv_color_t color)
+{
+    lv_img_cache_entry_t * entry = &cache_temp[_LV_WORKER_ID];
+    if(entry_decoder_open(entry, src, color) != LV_RES_OK) return NULL;
+
+    return entry;
+}
+
+/**
+ * Open an image in an entry with the decoders and measure the time to open
+ * @param entry pointer to an empty entry
+ * @param src source of the image
+ * @param color color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: opened; LV_RES_INV: the image can't be opened (the entry is cleared)
+ */
+static lv_res_t entry_decoder_open(lv_img_cache_entry_t * entry, const void * src, lv_color_t color)
+{
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(&entry->dec_dsc, src, color);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+        return LV_RES_INV;
+    }
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(entry->dec_dsc.time_to_open == 0) {
+        entry->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
+
+    if(entry->dec_dsc.time_to_open == 0) entry->dec_dsc.time_to_open = 1;
+
+    return LV_RES_OK;
+}
+
 #if LV_IMG_CACHE_DEF_SIZE
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
@@ -214,4 +412,238 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Get the hash of an image source. Variables are hashed by their address and files by their path.
+ * @param src source of the image
+ * @param color color of the image
+ * @return the hash
+ */
+static uint32_t get_hash(const void * src, lv_color_t color)
+{
+    uint32_t h;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        h = (uint32_t)((lv_uintptr_t)src >> 2);
+    }
+    else {
+        /*FNV-1a*/
+        const char * s = src;
+        h = 2166136261u;
+        while(*s) {
+            h = (h ^ (uint8_t) * s) * 16777619u;
+            s++;
+        }
+    }
+
+    h ^= (uint32_t)color.full * 2654435761u;
+    return h ^ (h >> 16);
+}
+
+/**
+ * Add an opened entry to its hash bucket and to the used memory
+ * @param id index of the entry
+ */
+static void cache_link(uint16_t id)
+{
+    lv_img_cache_entry_t * entry = &LV_GC_ROOT(_lv_img_cache_array)[id];
+    uint16_t * head = &buckets[entry->hash & (bucket_cnt - 1)];
+    entry->hash_next = *head;
+    *head = id + 1;
+
+    cache_mem_size += entry->mem_size;
+    cache_used_cnt++;
+}
+
+/**
+ * Close an opened entry, remove it from its hash bucket and clear it
+ * @param id index of the entry
+ */
+static void cache_drop(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * entry = &cache[id];
+
+    uint16_t * p = &buckets[entry->hash & (bucket_cnt - 1)];
+    while(*p != 0 && *p != id + 1) p = &cache[*p - 1].hash_next;
+    if(*p != 0) {
+        *p = entry->hash_next;
+        cache_mem_size -= entry->mem_size;
+        cache_used_cnt--;
+    }
+
+#if LV_IMG_CACHE_RUNS
+    if(entry->runs) lv_mem_free(entry->runs);
+#endif
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+}
+
+/**
+ * Get the real life of an entry
+ * @param entry pointer to an entry
+ * @return the life of the entry. Smaller means it should be reused earlier.
+ */
+static inline int32_t get_life(const lv_img_cache_entry_t * entry)
+{
+    return (int32_t)((uint32_t)entry->life - aging_cnt);
+}
+
+static inline bool entry_is_pinned(const lv_img_cache_entry_t * entry)
+{
+#if LV_USE_TILE_RENDER
+    return entry->pin_cnt > 0;
+#else
+    LV_UNUSED(entry);
+    return false;
+#endif
+}
+
+#if LV_IMG_CACHE_RUNS
+/**
+ * Convert an opened `LV_IMG_CF_TRUE_COLOR_ALPHA` image to `lv_img_runs_t` and store it in `entry->runs`.
+ * Other images and the images without `img_data` are left as they are.
+ * @param entry pointer to an opened entry
+ */
+static void runs_create(lv_img_cache_entry_t * entry)
+{
+    const uint8_t * img_data = entry->dec_dsc.img_data;
+    if(entry->dec_dsc.header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA || img_data == NULL) return;
+
+    uint32_t w = entry->dec_dsc.header.w;
+    uint32_t h = entry->dec_dsc.header.h;
+    if(w == 0 || h == 0) return;
+
+    uint16_t * row_buf = _lv_mem_buf_get(w * sizeof(uint16_t));
+    if(row_buf == NULL) return;
+
+    /*Count the runs and the mixed pixels first to allocate the exact size*/
+    uint32_t run_cnt = 0;
+    uint32_t alpha_cnt = 0;
+    uint32_t mixed_cnt;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        run_cnt += get_row_runs(&img_data[y * w * LV_IMG_PX_SIZE_ALPHA_BYTE], w, row_buf, &mixed_cnt);
+        alpha_cnt += mixed_cnt;
+    }
+    _lv_mem_buf_release(row_buf);
+
+    /*Store everything in one allocation: the descriptor, the map, the row indices, the runs and the alpha bytes*/
+    uint32_t map_size = (w * h * sizeof(lv_color_t) + 3) & ~0x3U;
+    uint32_t size = sizeof(lv_img_runs_t) + map_size + (2 * h + 1) * sizeof(uint32_t) +
+                    run_cnt * sizeof(uint16_t) + alpha_cnt;
+    lv_img_runs_t * runs = lv_mem_alloc(size);
+    if(runs == NULL) {
+        LV_LOG_WARN("lv_img_cache: not enough memory to convert the image to runs");
+        return;
+    }
+
+    uint8_t * p = (uint8_t *)runs + sizeof(lv_img_runs_t);
+    lv_color_t * map = (lv_color_t *)p;
+    p += map_size;
+    uint32_t * row_runs = (uint32_t *)p;
+    p += (h + 1) * sizeof(uint32_t);
+    uint32_t * row_alpha = (uint32_t *)p;
+    p += h * sizeof(uint32_t);
+    uint16_t * run_p = (uint16_t *)p;
+    p += run_cnt * sizeof(uint16_t);
+    lv_opa_t * alpha = p;
+
+    uint32_t run_i = 0;
+    uint32_t alpha_i = 0;
+    for(y = 0; y < h; y++) {
+        const uint8_t * px = &img_data[y * w * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        lv_color_t * map_row = &map[y * w];
+        row_runs[y] = run_i;
+        row_alpha[y] = alpha_i;
+
+        uint32_t cnt = get_row_runs(px, w, &run_p[run_i], &mixed_cnt);
+
+        /*Copy the colors and the alpha bytes of the mixed runs*/
+        uint32_t x = 0;
+        uint32_t i;
+        for(i = 0; i < cnt; i++) {
+            uint32_t type = run_p[run_i + i] >> LV_IMG_RUN_TYPE_SHIFT;
+            uint32_t x_end = x + (run_p[run_i + i] & LV_IMG_RUN_LEN_MASK);
+            for(; x < x_end; x++, px += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+                if(type == LV_IMG_RUN_TRANSP) {
+                    map_row[x].full = 0;
+                    continue;
+                }
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+                map_row[x].full = px[0];
+#elif LV_COLOR_DEPTH == 16
+                map_row[x].full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+                map_row[x].full = px[0] + (px[1] << 8) + (px[2] << 16);
+                map_row[x].ch.alpha = 0xFF;
+#endif
+                if(type == LV_IMG_RUN_MIXED) alpha[alpha_i++] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            }
+        }
+        run_i += cnt;
+    }
+    row_runs[h] = run_i;
+
+    runs->map = map;
+    runs->row_runs = row_runs;
+    runs->row_alpha = row_alpha;
+    runs->runs = run_p;
+    runs->alpha = alpha;
+    runs->size = size;
+
+    entry->runs = runs;
+}
+
+/**
+ * Get the runs of a row of a `LV_IMG_CF_TRUE_COLOR_ALPHA` image.
+ * The too short transparent and opaque runs are merged into the mixed runs.
+ * @param px pointer to the first pixel of the row
+ * @param w width of the image
+ * @param runs store the runs here (`w` items at most)
+ * @param mixed_cnt store the number of pixels in the mixed runs here
+ * @return number of runs
+ */
+static uint32_t get_row_runs(const uint8_t * px, uint32_t w, uint16_t * runs, uint32_t * mixed_cnt)
+{
+    uint32_t run_cnt = 0;
+    uint32_t x = 0;
+    *mixed_cnt = 0;
+    while(x < w) {
+        lv_opa_t opa = px[x * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        uint32_t type = opa == LV_OPA_TRANSP ? LV_IMG_RUN_TRANSP : (opa == LV_OPA_COVER ? LV_IMG_RUN_COVER : LV_IMG_RUN_MIXED);
+
+        uint32_t len = 1;
+        while(x + len < w && px[(x + len) * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] == opa &&
+              type != LV_IMG_RUN_MIXED) {
+            len++;
+        }
+        /*Collect the mixed pixels until a transparent or opaque pixel*/
+        if(type == LV_IMG_RUN_MIXED) {
+            while(x + len < w) {
+                opa = px[(x + len) * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                if(opa == LV_OPA_TRANSP || opa == LV_OPA_COVER) break;
+                len++;
+            }
+        }
+        else if(len < LV_IMG_RUN_MIN_LEN) {
+            type = LV_IMG_RUN_MIXED;
+        }
+
+        x += len;
+        if(type == LV_IMG_RUN_MIXED) *mixed_cnt += len;
+
+        /*Join the runs with the same type*/
+        if(run_cnt > 0 && (uint32_t)(runs[run_cnt - 1] >> LV_IMG_RUN_TYPE_SHIFT) == type) {
+            runs[run_cnt - 1] += len;
+        }
+        else {
+            runs[run_cnt] = (uint16_t)((type << LV_IMG_RUN_TYPE_SHIFT) | len);
+            run_cnt++;
+        }
+    }
+
+    return run_cnt;
+}
+#endif
 #endif
@@ -18,11 +18,34 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_IMG_CACHE_RUNS
+/*Types of the runs in `lv_img_runs_t`. Stored in the upper 2 bits of the runs*/
+#define LV_IMG_RUN_TRANSP   0   /*Fully transparent pixels*/
+#define LV_IMG_RUN_COVER    1   /*Fully opaque pixels*/
+#define LV_IMG_RUN_MIXED    2   /*Pixels with any opacity*/
+#define LV_IMG_RUN_TYPE_SHIFT  14
+#define LV_IMG_RUN_LEN_MASK    0x3FFF
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_IMG_CACHE_RUNS
+/**
+ * A `LV_IMG_CF_TRUE_COLOR_ALPHA` image converted by the cache to a color map and runs of
+ * transparent, opaque and mixed pixels in every row. The alpha bytes are stored only for the mixed runs.
+ */
+typedef struct {
+    const lv_color_t * map;         /**< Color of the pixels (w * h)*/
+    const uint32_t * row_runs;      /**< Index of the first run of the rows in `runs` (h + 1 items)*/
+    const uint32_t * row_alpha;     /**< Index of the first alpha byte of the rows in `alpha` (h items)*/
+    const uint16_t * runs;          /**< Length and `LV_IMG_RUN_...` type of the runs*/
+    const lv_opa_t * alpha;         /**< Alpha of the pixels in the mixed runs*/
+    uint32_t size;                  /**< Size of the allocated memory*/
+} lv_img_runs_t;
+#endif
+
 /**
  * When loading images from the network it can take a long time to download and decode the image.
  *
@@ -32,11 +55,32 @@ typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
     /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
+     * All lifes are decremented by one in every ::lv_img_cache_open.
+     * (Stored relative to a global counter to not touch all entries)
+     * The entry with the least life is reused */
     int32_t life;
+
+    uint32_t hash;          /**< Hash of the source and the color to find the entry quickly*/
+    uint32_t mem_size;      /**< Memory used by the decoded image. 0 if the image is not decoded into the RAM*/
+    uint32_t hit_cnt;       /**< Number of times the image was found in the cache*/
+    uint16_t hash_next;     /**< Index + 1 of the next entry with the same hash bucket. 0: last entry*/
+#if LV_IMG_CACHE_RUNS
+    lv_img_runs_t * runs;   /**< The image as runs if it's a `LV_IMG_CF_TRUE_COLOR_ALPHA` image. Else NULL*/
+#endif
+#if LV_USE_TILE_RENDER
+    uint8_t pin_cnt;        /**< Number of workers drawing the image. The pinned entries are not closed or reused*/
+#endif
 } lv_img_cache_entry_t;
 
+/** Statistics of the image cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of images found in the cache*/
+    uint32_t miss_cnt;      /**< Number of images opened*/
+    uint32_t evict_cnt;     /**< Number of images closed to reuse their entry or to stay in `LV_IMG_CACHE_MEM_SIZE`*/
+    uint32_t entry_cnt;     /**< Number of cached images*/
+    uint32_t mem_size;      /**< Memory used by the decoded images [bytes]*/
+} lv_img_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,6 +95,14 @@ typedef struct {
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
 
+/**
+ * Tell that an entry returned by `_lv_img_cache_open` is not used anymore.
+ * The images which are not cached (e.g. `LV_IMG_CACHE_DEF_SIZE == 0`) are closed here.
+ * @param entry pointer to the entry
+ * @param drop true: close the image too (e.g. because it couldn't be read) if no one else uses it
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry, bool drop);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -66,6 +118,19 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Get the statistics of the image cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat);
+
+/**
+ * Get an entry of the cache, e.g. to check its `hit_cnt`, `mem_size` or `dec_dsc.time_to_open`
+ * @param id index of the entry. 0 .. cache size - 1
+ * @return pointer to the entry or NULL if `id` is too large or the entry is unused
+ */
+const lv_img_cache_entry_t * lv_img_cache_get_entry(uint16_t id);
+
 /**********************
  *      MACROS
  **********************/
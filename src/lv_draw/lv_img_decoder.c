@@ -24,6 +24,12 @@
 typedef struct {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t f;
+    const uint8_t * map;    /*The image data (after the header) if the file is mapped*/
+#if LV_IMG_DECODER_READAHEAD_SIZE
+    uint8_t * ra_buf;   /*The bytes read ahead from the file*/
+    uint32_t ra_pos;    /*File position of the first byte of `ra_buf`*/
+    uint32_t ra_len;    /*Number of valid bytes in `ra_buf`*/
+#endif
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
@@ -38,6 +44,10 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static const uint8_t * lv_img_decoder_built_in_get_data(lv_img_decoder_dsc_t * dsc);
+#if LV_USE_FILESYSTEM
+static lv_res_t lv_img_decoder_built_in_file_read(lv_img_decoder_dsc_t * dsc, uint32_t pos, uint8_t * buf, uint32_t btr);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -151,6 +161,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 
         dsc->error_msg = NULL;
         dsc->img_data  = NULL;
+        dsc->img_data_mapped = 0;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
     }
@@ -178,6 +189,31 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Read a rectangle from an opened image.
+ * Uses the decoder's `read_area_cb` if set, else reads the lines of the rectangle one by one.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the rectangle to read relative to the image's top left corner
+ * @param buf store the data here line by line
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf)
+{
+    if(dsc->decoder->read_area_cb) return dsc->decoder->read_area_cb(dsc->decoder, dsc, area, buf);
+
+    /*Fall back to reading the lines*/
+    lv_coord_t w = lv_area_get_width(area);
+    uint32_t line_size = w * (lv_img_cf_has_alpha(dsc->header.cf) ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE / 8);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_read_line(dsc, area->x1, y, w, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -250,6 +286,16 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
     decoder->read_line_cb = read_line_cb;
 }
 
+/**
+ * Set a callback to read a decoded rectangle of an image
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read a rectangle of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb)
+{
+    decoder->read_area_cb = read_area_cb;
+}
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -352,6 +398,23 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         _lv_memcpy_small(&user_data->f, &f, sizeof(f));
+
+        /*Use the image data directly from the memory if the file can be mapped and it's large enough*/
+        const void * map = NULL;
+        uint32_t map_size = 0;
+        user_data->map = NULL;
+        if(lv_fs_map(&user_data->f, &map, &map_size) == LV_FS_RES_OK &&
+           map_size >= sizeof(lv_img_header_t) + lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf)) {
+            user_data->map = (const uint8_t *)map + sizeof(lv_img_header_t);
+        }
+
+#if LV_IMG_DECODER_READAHEAD_SIZE
+        /*Without buffer the lines are read one by one*/
+        if(user_data->map == NULL && user_data->ra_buf == NULL) {
+            user_data->ra_buf = lv_mem_alloc(LV_IMG_DECODER_READAHEAD_SIZE);
+        }
+        user_data->ra_len = 0;
+#endif
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -374,7 +437,15 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
-            /*If it's a file it need to be read line by line later*/
+#if LV_USE_FILESYSTEM
+            /*A mapped file can be used as a variable*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            if(user_data->map) {
+                dsc->img_data = user_data->map;
+                dsc->img_data_mapped = 1;
+            }
+#endif
+            /*Else it need to be read line by line later*/
             return LV_RES_OK;
         }
     }
@@ -407,7 +478,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_INV;
         }
 
-        if(dsc->src_type == LV_IMG_SRC_FILE) {
+        const uint8_t * data = lv_img_decoder_built_in_get_data(dsc);
+        if(data == NULL) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
             lv_fs_seek(&user_data->f, 4); /*Skip the header*/
@@ -424,8 +496,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 #endif
         }
         else {
-            /*The palette begins in the beginning of the image data. Just point to it.*/
-            lv_color32_t * palette_p = (lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
+            /*The palette begins in the beginning of the image data (of a variable or mapped file). Just point to it.*/
+            const lv_color32_t * palette_p = (const lv_color32_t *)data;
 
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
@@ -518,6 +590,9 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #if LV_USE_FILESYSTEM
         if(dsc->src_type == LV_IMG_SRC_FILE)
             lv_fs_close(&user_data->f);
+#if LV_IMG_DECODER_READAHEAD_SIZE
+        if(user_data->ra_buf) lv_mem_free(user_data->ra_buf);
+#endif
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
@@ -535,26 +610,12 @@ static lv_res_t lv_img_decoder_built_in_line_true_color(lv_img_decoder_dsc_t * d
                                                         lv_coord_t len, uint8_t * buf)
 {
 #if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    lv_fs_res_t res;
     uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
 
     uint32_t pos = ((y * dsc->header.w + x) * px_size) >> 3;
     pos += 4; /*Skip the header*/
-    res = lv_fs_seek(&user_data->f, pos);
-    if(res != LV_FS_RES_OK) {
-        LV_LOG_WARN("Built-in image decoder seek failed");
-        return LV_RES_INV;
-    }
     uint32_t btr = len * (px_size >> 3);
-    uint32_t br  = 0;
-    res = lv_fs_read(&user_data->f, buf, btr, &br);
-    if(res != LV_FS_RES_OK || btr != br) {
-        LV_LOG_WARN("Built-in image decoder read failed");
-        return LV_RES_INV;
-    }
-
-    return LV_RES_OK;
+    return lv_img_decoder_built_in_file_read(dsc, pos, buf, btr);
 #else
     LV_UNUSED(dsc);
     LV_UNUSED(x);
@@ -626,22 +687,24 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
             break;
     }
 
+    const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
 #if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if (fs_buf == NULL) return LV_RES_INV;
+    uint8_t * fs_buf = NULL;
 #endif
-
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-
-        data_tmp = img_dsc->data + ofs;
+    if(data_tmp) {
+        data_tmp += ofs;
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
+        fs_buf = _lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
+
+        /*Read only the bytes of the pixels to not read after the end of the file*/
+        uint32_t btr = (((x + len - 1) * px_size) >> 3) - ((x * px_size) >> 3) + 1;
+        if(lv_img_decoder_built_in_file_read(dsc, ofs + 4, fs_buf, btr) != LV_RES_OK) { /*+4 to skip the header*/
+            _lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
         data_tmp = fs_buf;
 #else
         LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
@@ -663,7 +726,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 #else
@@ -711,19 +774,24 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
 
+    const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
 #if LV_USE_FILESYSTEM
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if (fs_buf == NULL) return LV_RES_INV;
+    uint8_t * fs_buf = NULL;
 #endif
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-        data_tmp                     = img_dsc->data + ofs;
+    if(data_tmp) {
+        data_tmp += ofs;
     }
     else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
+        fs_buf = _lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
+
+        /*Read only the bytes of the pixels to not read after the end of the file*/
+        uint32_t btr = (((x + len - 1) * px_size) >> 3) - ((x * px_size) >> 3) + 1;
+        if(lv_img_decoder_built_in_file_read(dsc, ofs + 4, fs_buf, btr) != LV_RES_OK) { /*+4 to skip the header*/
+            _lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
         data_tmp = fs_buf;
 #else
         LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
@@ -757,7 +825,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
         }
     }
 #if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
 #endif
     return LV_RES_OK;
 #else
@@ -765,3 +833,74 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+/**
+ * Get the data of an image (after the header) if it's available in the memory
+ * @param dsc pointer to decoder descriptor
+ * @return pointer to the data of a variable or a mapped file, NULL if it's not in the memory
+ */
+static const uint8_t * lv_img_decoder_built_in_get_data(lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        return img_dsc->data;
+    }
+
+#if LV_USE_FILESYSTEM
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(dsc->src_type == LV_IMG_SRC_FILE && user_data) return user_data->map;
+#endif
+
+    return NULL;
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * Read bytes from an opened image file.
+ * With `LV_IMG_DECODER_READAHEAD_SIZE` a whole buffer is read and the next reads are served from it if possible.
+ * @param dsc pointer to decoder descriptor
+ * @param pos position in the file
+ * @param buf store the bytes here
+ * @param btr number of bytes to read
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t lv_img_decoder_built_in_file_read(lv_img_decoder_dsc_t * dsc, uint32_t pos, uint8_t * buf, uint32_t btr)
+{
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    lv_fs_res_t res;
+    uint32_t br = 0;
+
+#if LV_IMG_DECODER_READAHEAD_SIZE
+    if(user_data->ra_buf && btr <= LV_IMG_DECODER_READAHEAD_SIZE) {
+        if(pos < user_data->ra_pos || pos + btr > user_data->ra_pos + user_data->ra_len) {
+            user_data->ra_len = 0;
+            res = lv_fs_seek(&user_data->f, pos);
+            if(res == LV_FS_RES_OK) res = lv_fs_read(&user_data->f, user_data->ra_buf, LV_IMG_DECODER_READAHEAD_SIZE, &br);
+            if(res != LV_FS_RES_OK || br < btr) {
+                LV_LOG_WARN("Built-in image decoder read failed");
+                return LV_RES_INV;
+            }
+            user_data->ra_pos = pos;
+            user_data->ra_len = br;
+        }
+
+        _lv_memcpy(buf, &user_data->ra_buf[pos - user_data->ra_pos], btr);
+        return LV_RES_OK;
+    }
+#endif
+
+    res = lv_fs_seek(&user_data->f, pos);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder seek failed");
+        return LV_RES_INV;
+    }
+
+    res = lv_fs_read(&user_data->f, buf, btr, &br);
+    if(res != LV_FS_RES_OK || btr != br) {
+        LV_LOG_WARN("Built-in image decoder read failed");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+#endif
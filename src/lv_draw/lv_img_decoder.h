@@ -77,6 +77,18 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder * decoder, st
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder * decoder, struct _lv_img_decoder_dsc * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode a rectangle of pixels and store them in `buf` line by line.
+ * Optional. If not set the lines of the rectangle are read with `read_line` one by one.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the rectangle to decode relative to the image's top left corner
+ * @param buf a buffer to store the decoded pixels (`lv_area_get_size(area)` pixels)
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_read_area_f_t)(struct _lv_img_decoder * decoder, struct _lv_img_decoder_dsc * dsc,
+                                                 const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -88,6 +100,7 @@ typedef struct _lv_img_decoder {
     lv_img_decoder_info_f_t info_cb;
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
+    lv_img_decoder_read_area_f_t read_area_cb;
     lv_img_decoder_close_f_t close_cb;
 
 #if LV_USE_USER_DATA
@@ -116,6 +129,10 @@ typedef struct _lv_img_decoder_dsc {
      *  MUST be set in `open` function*/
     const uint8_t * img_data;
 
+    /** 1: `img_data` is not decoded into the RAM, but e.g. it's in a mapped file.
+     *  Such images are not counted in `LV_IMG_CACHE_MEM_SIZE`. Can be set in `open` function*/
+    uint8_t img_data_mapped : 1;
+
     /** How much time did it take to open the image. [ms]
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
@@ -175,6 +192,16 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Read a rectangle from an opened image.
+ * Uses the decoder's `read_area_cb` if set, else reads the lines of the rectangle one by one.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the rectangle to read relative to the image's top left corner
+ * @param buf store the data here line by line
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -214,6 +241,13 @@ void lv_img_decoder_set_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_open_
  */
 void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_line_f_t read_line_cb);
 
+/**
+ * Set a callback to read a decoded rectangle of an image
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read a rectangle of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb);
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -10,22 +10,47 @@
 #include "lv_font.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define GLYPH_CACHE_HASH_SIZE   64  /*Number of hash buckets (power of 2)*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+/*A cached glyph in `_lv_font_glyph_cache_ll`. The most recently used is the head.*/
+typedef struct _glyph_cache_entry_t {
+    const lv_font_t * font;
+    uint32_t letter;
+    uint8_t * buf;                          /*The bitmap of the glyph*/
+    uint32_t size;                          /*Size of `buf` in bytes*/
+    struct _glyph_cache_entry_t * hash_next; /*Next entry in the same hash bucket*/
+} glyph_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    static inline uint32_t glyph_cache_hash(const lv_font_t * font, uint32_t letter);
+    static void glyph_cache_drop(glyph_cache_entry_t * entry);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    static glyph_cache_entry_t * glyph_cache_buckets[GLYPH_CACHE_HASH_SIZE];
+    static uint32_t glyph_cache_entry_cnt;
+    static uint32_t glyph_cache_mem_size;
+    static uint32_t glyph_cache_hit_cnt;
+    static uint32_t glyph_cache_miss_cnt;
+    static uint32_t glyph_cache_evict_cnt;
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -61,7 +86,15 @@ const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t lett
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
                            uint32_t letter_next)
 {
+#if LV_USE_TILE_RENDER
+    /*The fonts can cache the last looked up glyph so the workers can't search concurrently*/
+    _LV_WORKER_LOCK();
+    bool ret = font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    _LV_WORKER_UNLOCK();
+    return ret;
+#else
     return font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+#endif
 }
 
 /**
@@ -80,6 +113,208 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
     else return 0;
 }
 
+/**
+ * Initialize the glyph cache
+ */
+void _lv_font_glyph_cache_init(void)
+{
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    _lv_ll_init(&LV_GC_ROOT(_lv_font_glyph_cache_ll), sizeof(glyph_cache_entry_t));
+    _lv_memset_00(glyph_cache_buckets, sizeof(glyph_cache_buckets));
+    glyph_cache_entry_cnt = 0;
+    glyph_cache_mem_size = 0;
+    glyph_cache_hit_cnt = 0;
+    glyph_cache_miss_cnt = 0;
+    glyph_cache_evict_cnt = 0;
+#endif
+}
+
+/**
+ * Get a cached glyph bitmap and make it the most recently used.
+ * The bitmap remains valid until a new glyph is added to the cache.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @return pointer to the cached bitmap or NULL if not cached (or the cache is disabled)
+ */
+const uint8_t * lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter)
+{
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    glyph_cache_entry_t * entry = glyph_cache_buckets[glyph_cache_hash(font, letter)];
+    while(entry) {
+        if(entry->font == font && entry->letter == letter) break;
+        entry = entry->hash_next;
+    }
+
+    const uint8_t * buf = NULL;
+    if(entry) {
+        lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+        glyph_cache_entry_t * head = _lv_ll_get_head(ll);
+        if(entry != head) _lv_ll_move_before(ll, entry, head);
+        glyph_cache_hit_cnt++;
+        buf = entry->buf;
+    }
+    else {
+        glyph_cache_miss_cnt++;
+    }
+    _LV_WORKER_UNLOCK();
+    return buf;
+#else
+    LV_UNUSED(font);
+    LV_UNUSED(letter);
+    return NULL;
+#endif
+}
+
+/**
+ * Allocate a cache entry for a glyph bitmap. The caller should write the bitmap into the returned buffer.
+ * The least recently used glyphs are dropped to stay in `LV_FONT_GLYPH_CACHE_MEM_SIZE`.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @param size size of the bitmap in bytes
+ * @return a buffer with `size` bytes or NULL if the glyph can't be cached
+ */
+uint8_t * lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, uint32_t size)
+{
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    if(size == 0 || size > LV_FONT_GLYPH_CACHE_MEM_SIZE) return NULL;
+
+    _LV_WORKER_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    while(glyph_cache_mem_size + size > LV_FONT_GLYPH_CACHE_MEM_SIZE) {
+        glyph_cache_entry_t * tail = _lv_ll_get_tail(ll);
+        if(tail == NULL) break;
+        glyph_cache_drop(tail);
+        glyph_cache_evict_cnt++;
+    }
+
+    /*If the heap is full drop more glyphs. It's not an error if there is no memory for the cache.*/
+    uint8_t * buf = lv_mem_alloc(size);
+    while(buf == NULL) {
+        glyph_cache_entry_t * tail = _lv_ll_get_tail(ll);
+        if(tail == NULL) {
+            _LV_WORKER_UNLOCK();
+            return NULL;
+        }
+        glyph_cache_drop(tail);
+        glyph_cache_evict_cnt++;
+        buf = lv_mem_alloc(size);
+    }
+
+    glyph_cache_entry_t * entry = _lv_ll_ins_head(ll);
+    if(entry == NULL) {
+        lv_mem_free(buf);
+        _LV_WORKER_UNLOCK();
+        return NULL;
+    }
+
+    uint32_t h = glyph_cache_hash(font, letter);
+    entry->font = font;
+    entry->letter = letter;
+    entry->buf = buf;
+    entry->size = size;
+    entry->hash_next = glyph_cache_buckets[h];
+    glyph_cache_buckets[h] = entry;
+    glyph_cache_entry_cnt++;
+    glyph_cache_mem_size += size;
+    _LV_WORKER_UNLOCK();
+    return buf;
+#else
+    LV_UNUSED(font);
+    LV_UNUSED(letter);
+    LV_UNUSED(size);
+    return NULL;
+#endif
+}
+
+/**
+ * Drop the cached glyphs of a font. Should be called before freeing a font.
+ * @param font pointer to a font
+ */
+void lv_font_glyph_cache_drop_font(const lv_font_t * font)
+{
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    glyph_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        glyph_cache_entry_t * entry_next = _lv_ll_get_next(ll, entry);
+        if(entry->font == font) glyph_cache_drop(entry);
+        entry = entry_next;
+    }
+    _LV_WORKER_UNLOCK();
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+/**
+ * Free all the cached glyphs. The statistics are kept.
+ */
+void lv_font_glyph_cache_clean(void)
+{
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_font_glyph_cache_ll);
+    glyph_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        glyph_cache_entry_t * entry_next = _lv_ll_get_next(ll, entry);
+        glyph_cache_drop(entry);
+        entry = entry_next;
+    }
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_font_glyph_cache_get_stat(lv_font_glyph_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_font_glyph_cache_stat_t));
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    _LV_WORKER_LOCK();
+    stat->hit_cnt = glyph_cache_hit_cnt;
+    stat->miss_cnt = glyph_cache_miss_cnt;
+    stat->evict_cnt = glyph_cache_evict_cnt;
+    stat->entry_cnt = glyph_cache_entry_cnt;
+    stat->mem_size = glyph_cache_mem_size;
+    _LV_WORKER_UNLOCK();
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+/**
+ * Get the hash bucket of a glyph
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @return index of the bucket in `glyph_cache_buckets`
+ */
+static inline uint32_t glyph_cache_hash(const lv_font_t * font, uint32_t letter)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)font >> 3) ^ (letter * 2654435761u);
+    return (h ^ (h >> 16)) & (GLYPH_CACHE_HASH_SIZE - 1);
+}
+
+/**
+ * Remove a glyph from the cache and free its memory
+ * @param entry pointer to a cache entry
+ */
+static void glyph_cache_drop(glyph_cache_entry_t * entry)
+{
+    glyph_cache_entry_t ** p = &glyph_cache_buckets[glyph_cache_hash(entry->font, entry->letter)];
+    while(*p != entry) p = &(*p)->hash_next;
+    *p = entry->hash_next;
+
+    glyph_cache_entry_cnt--;
+    glyph_cache_mem_size -= entry->size;
+    lv_mem_free(entry->buf);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_font_glyph_cache_ll), entry);
+    lv_mem_free(entry);
+}
+#endif /*LV_FONT_GLYPH_CACHE_MEM_SIZE*/
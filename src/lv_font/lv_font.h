@@ -76,6 +76,15 @@ typedef struct _lv_font_struct {
 
 } lv_font_t;
 
+/** Statistics of the glyph cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs taken from the cache*/
+    uint32_t miss_cnt;      /**< Number of glyphs not found in the cache*/
+    uint32_t evict_cnt;     /**< Number of glyphs dropped to stay in the limit*/
+    uint32_t entry_cnt;     /**< Number of cached glyphs*/
+    uint32_t mem_size;      /**< Memory used by the cached bitmaps [bytes]*/
+} lv_font_glyph_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -108,6 +117,47 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
  */
 uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next);
 
+/**
+ * Initialize the glyph cache
+ */
+void _lv_font_glyph_cache_init(void);
+
+/**
+ * Get a cached glyph bitmap and make it the most recently used.
+ * The bitmap remains valid until a new glyph is added to the cache.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @return pointer to the cached bitmap or NULL if not cached (or the cache is disabled)
+ */
+const uint8_t * lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Allocate a cache entry for a glyph bitmap. The caller should write the bitmap into the returned buffer.
+ * The least recently used glyphs are dropped to stay in `LV_FONT_GLYPH_CACHE_MEM_SIZE`.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @param size size of the bitmap in bytes
+ * @return a buffer with `size` bytes or NULL if the glyph can't be cached
+ */
+uint8_t * lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, uint32_t size);
+
+/**
+ * Drop the cached glyphs of a font. Should be called before freeing a font.
+ * @param font pointer to a font
+ */
+void lv_font_glyph_cache_drop_font(const lv_font_t * font);
+
+/**
+ * Free all the cached glyphs. The statistics are kept.
+ */
+void lv_font_glyph_cache_clean(void);
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stat store the statistics here. All fields are 0 if the cache is disabled.
+ */
+void lv_font_glyph_cache_get_stat(lv_font_glyph_cache_stat_t * stat);
+
 /**
  * Get the line height of a font. All characters fit into this height
  * @param font_p pointer to a font
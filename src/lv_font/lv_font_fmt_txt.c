@@ -32,6 +32,7 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static const lv_font_fmt_txt_glyph_dsc_t * get_glyph(const lv_font_t * font, uint32_t gid, const uint8_t ** bitmap);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -81,13 +82,35 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     if(unicode_letter == '\t') unicode_letter = ' ';
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+    /*Decompressed and loaded glyphs might be cached. Look them up before searching the glyph ID*/
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN || fdsc->glyph_dsc == NULL) {
+        const uint8_t * cached = lv_font_glyph_cache_get(font, unicode_letter);
+        if(cached) return cached;
+    }
+#endif
+
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const uint8_t * bitmap;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = get_glyph(font, gid, &bitmap);
+    if(gdsc == NULL) return NULL;
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+        /*A loaded bitmap is valid only until the next glyph is loaded so keep a copy in the cache*/
+        if(fdsc->glyph_dsc == NULL) {
+            uint32_t size = ((uint32_t)gdsc->box_w * gdsc->box_h * fdsc->bpp + 7) >> 3;
+            uint8_t * cache_buf = lv_font_glyph_cache_add(font, unicode_letter, size);
+            if(cache_buf) {
+                _lv_memcpy(cache_buf, bitmap, size);
+                return cache_buf;
+            }
+        }
+#endif
+        return bitmap;
     }
     /*Handle compressed bitmap*/
     else {
@@ -112,15 +135,33 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+        /*Decompress directly into the cache if the glyph fits*/
+        uint8_t * cache_buf = lv_font_glyph_cache_add(font, unicode_letter, buf_size);
+        if(cache_buf) {
+            decompress(bitmap, cache_buf, gdsc->box_w, gdsc->box_h,
+                       (uint8_t)fdsc->bpp, prefilter);
+            return cache_buf;
+        }
+#endif
+
         if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+            /*The cached glyphs might use the memory*/
+            if(tmp == NULL) {
+                lv_font_glyph_cache_clean();
+                tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+            }
+#endif
             LV_ASSERT_MEM(tmp);
             if(tmp == NULL) return NULL;
             LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
         }
 
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(bitmap, LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
         return LV_GC_ROOT(_lv_font_decompr_buf);
 #else /* !LV_USE_FONT_COMPRESSED */
@@ -161,7 +202,8 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     }
 
     /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = get_glyph(font, gid, NULL);
+    if(gdsc == NULL) return false;
 
     int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
 
@@ -255,6 +297,27 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+/**
+ * Get the descriptor and optionally the bitmap of a glyph. Load them on demand if required.
+ * @param font pointer to font
+ * @param gid ID of the glyph
+ * @param bitmap store the pointer to the (maybe compressed) bitmap here. Can be NULL.
+ * @return the descriptor of the glyph or NULL on error
+ */
+static const lv_font_fmt_txt_glyph_dsc_t * get_glyph(const lv_font_t * font, uint32_t gid, const uint8_t ** bitmap)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+
+    if(fdsc->glyph_dsc == NULL) {
+        if(fdsc->load_glyph_cb == NULL) return NULL;
+        return fdsc->load_glyph_cb(font, gid, bitmap);
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    if(bitmap) *bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+    return gdsc;
+}
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
@@ -190,6 +190,12 @@ typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
+    /* Used if `glyph_dsc` is NULL to load the descriptor of a glyph on demand (e.g. from a file).
+     * If `bitmap` is not NULL the (maybe compressed) bitmap of the glyph is also loaded and saved there.
+     * The returned data is valid until the next call. Return NULL on error.*/
+    const lv_font_fmt_txt_glyph_dsc_t * (*load_glyph_cb)(const struct _lv_font_struct * font, uint32_t glyph_id,
+                                                         const uint8_t ** bitmap);
+
 } lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -21,6 +21,7 @@
  **********************/
 typedef struct {
     lv_fs_file_t * fp;
+    const uint8_t * mem;    /*Read from here instead of `fp` if not NULL (mapped file)*/
     int8_t bit_pos;
     uint8_t byte_value;
 } bit_iterator_t;
@@ -62,11 +63,48 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*The glyph descriptor cache of a lazily loaded font*/
+typedef struct {
+    uint32_t gid;                       /*0: unused slot*/
+    lv_font_fmt_txt_glyph_dsc_t dsc;
+} lazy_glyph_dsc_t;
+
+/* `font->dsc` of the loaded fonts*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t fmt;          /*Must be the first member. `glyph_dsc` and `glyph_bitmap` are NULL if lazy*/
+    uint8_t keep_open : 1;              /*1: it's a `lazy_font_dsc_t` which keeps the file open until `lv_font_free`*/
+} loaded_font_dsc_t;
+
+/* `font->dsc` of the fonts which keep the file open:
+ * - lazily loaded fonts: the glyphs are read from the open (or mapped) file on demand
+ * - mapped fonts: `glyph_bitmap` points into the mapped file*/
+typedef struct {
+    loaded_font_dsc_t loaded;           /*Must be the first member*/
+    lv_fs_file_t file;
+    const uint8_t * map;                /*The content of the file if it's mapped*/
+    uint32_t map_size;
+    font_header_bin_t header;
+    uint32_t glyph_start;               /*Start of the "glyf" table in the file*/
+    uint32_t glyph_length;              /*Length of the "glyf" table*/
+    uint32_t * glyph_offset;            /*Offset of the glyphs in the "glyf" table ("loca" table)*/
+    uint32_t loca_count;
+    uint8_t * bitmap_buf;               /*The last loaded bitmap*/
+    uint32_t bitmap_buf_size;
+    lazy_glyph_dsc_t dsc_cache[LV_FONT_LOADER_LAZY_DSC_CNT];
+} lazy_font_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bit_iterator_t init_bit_iterator_mem(const uint8_t * mem);
+static lv_font_t * load_font(const char * font_name, bool lazy);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy, const uint8_t * map, uint32_t map_size);
+static bool read_glyph_dsc(bit_iterator_t * bit_it, const font_header_bin_t * header,
+                           lv_font_fmt_txt_glyph_dsc_t * gdsc);
+static bool read_glyph_bitmap(bit_iterator_t * bit_it, const font_header_bin_t * header, uint8_t * bmp, int bmp_size);
+static const lv_font_fmt_txt_glyph_dsc_t * lazy_load_glyph(const lv_font_t * font, uint32_t gid,
+                                                           const uint8_t ** bitmap);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -81,38 +119,27 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  **********************/
 
 /**
- * Loads a `lv_font_t` object from a binary font file
+ * Loads a `lv_font_t` object from a binary font file.
+ * If the file can be mapped (see `lv_fs_map()`) the glyphs are read from the memory and
+ * if the bitmaps are byte aligned in the file they are used from there. In this case the file is kept open until `lv_font_free`.
  * @param font_name filename where the font file is located
  * @return a pointer to the font or NULL in case of error
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    bool success = false;
-
-    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
-    memset(font, 0, sizeof(lv_font_t));
-
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-
-    if(res == LV_FS_RES_OK) {
-        success = lvgl_load_font(&file, font);
-
-        if(!success) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
-
-        lv_fs_close(&file);
-    }
+    return load_font(font_name, false);
+}
 
-    return font;
+/**
+ * Loads a `lv_font_t` object from a binary font file but read only the header, the character maps,
+ * the glyph offsets and the kerning data. The file is kept open and the glyph descriptors and bitmaps are
+ * read when they are used. Enable `LV_FONT_GLYPH_CACHE_MEM_SIZE` to not read the bitmaps again on every redraw.
+ * @param font_name filename where the font file is located
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name)
+{
+    return load_font(font_name, true);
 }
 
 /**
@@ -122,10 +149,29 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_font_glyph_cache_drop_font(font);
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
         if(NULL != dsc) {
 
+            if(((loaded_font_dsc_t *) dsc)->keep_open) {
+                lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) dsc;
+
+                if(NULL != lazy_dsc->file.file_d)
+                    lv_fs_close(&lazy_dsc->file);
+
+                if(NULL != lazy_dsc->glyph_offset)
+                    lv_mem_free(lazy_dsc->glyph_offset);
+
+                if(NULL != lazy_dsc->bitmap_buf)
+                    lv_mem_free(lazy_dsc->bitmap_buf);
+
+                /*The bitmaps are in the mapped file*/
+                if(NULL != lazy_dsc->map)
+                    dsc->glyph_bitmap = NULL;
+            }
+
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
                     (lv_font_fmt_txt_kern_pair_t *) dsc->kern_dsc;
@@ -187,10 +233,63 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_font_t * load_font(const char * font_name, bool lazy)
+{
+    bool success = false;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    memset(font, 0, sizeof(lv_font_t));
+
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+
+    if(res == LV_FS_RES_OK) {
+        /*Read the mapped content of the file if the driver supports it*/
+        const void * map = NULL;
+        uint32_t map_size = 0;
+        lv_fs_map(&file, &map, &map_size);
+
+        success = lvgl_load_font(&file, font, lazy, map, map_size);
+
+        /*The lazily loaded and mapped fonts keep the file open until `lv_font_free`*/
+        bool keep_open = success && ((loaded_font_dsc_t *)font->dsc)->keep_open;
+
+        if(!success) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+
+        if(!keep_open) lv_fs_close(&file);
+    }
+    else {
+        lv_mem_free(font);
+        font = NULL;
+    }
+
+    return font;
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
     it.fp = fp;
+    it.mem = NULL;
+    it.bit_pos = -1;
+    it.byte_value = 0;
+    return it;
+}
+
+static bit_iterator_t init_bit_iterator_mem(const uint8_t * mem)
+{
+    bit_iterator_t it;
+    it.fp = NULL;
+    it.mem = mem;
     it.bit_pos = -1;
     it.byte_value = 0;
     return it;
@@ -205,9 +304,15 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
 
         if(it->bit_pos < 0) {
             it->bit_pos = 7;
-            *res = lv_fs_read(it->fp, &(it->byte_value), 1, NULL);
-            if(*res != LV_FS_RES_OK) {
-                return 0;
+            if(it->mem) {
+                it->byte_value = *it->mem;
+                it->mem++;
+            }
+            else {
+                *res = lv_fs_read(it->fp, &(it->byte_value), 1, NULL);
+                if(*res != LV_FS_RES_OK) {
+                    return 0;
+                }
             }
         }
         int8_t bit = (it->byte_value & 0x80) ? 1 : 0;
@@ -340,14 +445,127 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
     return success ? cmaps_length : -1;
 }
 
+/*
+ * Read the descriptor of a glyph. The iterator should be at the start of the glyph.
+ */
+static bool read_glyph_dsc(bit_iterator_t * bit_it, const font_header_bin_t * header,
+                           lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    lv_fs_res_t res;
+
+    if(header->advance_width_bits == 0) {
+        gdsc->adv_w = header->default_advance_width;
+    }
+    else {
+        gdsc->adv_w = read_bits(bit_it, header->advance_width_bits, &res);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+
+    if(header->advance_width_format == 0) {
+        gdsc->adv_w *= 16;
+    }
+
+    gdsc->ofs_x = read_bits_signed(bit_it, header->xy_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->ofs_y = read_bits_signed(bit_it, header->xy_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->box_w = read_bits(bit_it, header->wh_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    gdsc->box_h = read_bits(bit_it, header->wh_bits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Read the bitmap of a glyph. The iterator should be right after the glyph descriptor.
+ */
+static bool read_glyph_bitmap(bit_iterator_t * bit_it, const font_header_bin_t * header, uint8_t * bmp, int bmp_size)
+{
+    lv_fs_res_t res;
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+
+    if(nbits % 8 == 0) {  /* Fast path */
+        if(bit_it->mem) {
+            _lv_memcpy(bmp, bit_it->mem, bmp_size);
+        }
+        else if(lv_fs_read(bit_it->fp, bmp, bmp_size, NULL) != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+    else {
+        for(int k = 0; k < bmp_size - 1; ++k) {
+            bmp[k] = read_bits(bit_it, 8, &res);
+            if(res != LV_FS_RES_OK) {
+                return false;
+            }
+        }
+        /*The last bits are the MSBs of the last byte*/
+        bmp[bmp_size - 1] = read_bits(bit_it, 8 - nbits % 8, &res) << (nbits % 8);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Get the size of a glyph's bitmap in the "glyf" table.
+ */
+static int get_glyph_bitmap_size(const uint32_t * glyph_offset, uint32_t i, uint32_t loca_count,
+                                 uint32_t glyph_length, const font_header_bin_t * header)
+{
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
+    return next_offset - glyph_offset[i] - nbits / 8;
+}
+
+/*
+ * Get the start of a glyph in the mapped "glyf" table. NULL if the glyph would be out of the table.
+ */
+static const uint8_t * get_glyph_mem(const uint8_t * glyf, const uint32_t * glyph_offset, uint32_t i,
+                                     uint32_t loca_count, uint32_t glyph_length)
+{
+    uint32_t next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : glyph_length;
+    if(glyph_offset[i] > next_offset || next_offset > glyph_length) return NULL;
+
+    return glyf + glyph_offset[i];
+}
+
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header,
+                          const uint8_t * map, uint32_t map_size)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
         return -1;
     }
 
+    /*Read the mapped table if it's really in the file*/
+    const uint8_t * glyf = NULL;
+    if(map && start <= map_size && (uint32_t)glyph_length <= map_size - start) glyf = map + start;
+
+    /*Use the bitmaps from the mapped file if they are byte aligned and can be indexed*/
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    bool bitmap_mapped = glyf && nbits % 8 == 0;
+#if LV_FONT_FMT_TXT_LARGE == 0
+    if(glyph_length >= (1 << 20)) bitmap_mapped = false;
+#endif
+
     lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)
                                               lv_mem_alloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
 
@@ -360,50 +578,26 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     for(unsigned int i = 0; i < loca_count; ++i) {
         lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
 
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i]);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
-        bit_iterator_t bit_it = init_bit_iterator(fp);
-
-        if(header->advance_width_bits == 0) {
-            gdsc->adv_w = header->default_advance_width;
+        bit_iterator_t bit_it;
+        if(glyf) {
+            const uint8_t * mem = get_glyph_mem(glyf, glyph_offset, i, loca_count, glyph_length);
+            if(mem == NULL) return -1;
+            bit_it = init_bit_iterator_mem(mem);
         }
         else {
-            gdsc->adv_w = read_bits(&bit_it, header->advance_width_bits, &res);
+            lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i]);
             if(res != LV_FS_RES_OK) {
                 return -1;
             }
-        }
-
-        if(header->advance_width_format == 0) {
-            gdsc->adv_w *= 16;
-        }
-
-        gdsc->ofs_x = read_bits_signed(&bit_it, header->xy_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
-        gdsc->ofs_y = read_bits_signed(&bit_it, header->xy_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
 
-        gdsc->box_w = read_bits(&bit_it, header->wh_bits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
+            bit_it = init_bit_iterator(fp);
         }
 
-        gdsc->box_h = read_bits(&bit_it, header->wh_bits, &res);
-        if(res != LV_FS_RES_OK) {
+        if(!read_glyph_dsc(&bit_it, header, gdsc)) {
             return -1;
         }
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+        int bmp_size = get_glyph_bitmap_size(glyph_offset, i, loca_count, glyph_length, header);
 
         if(i == 0) {
             gdsc->adv_w = 0;
@@ -413,12 +607,27 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
+        if(bitmap_mapped) {
+            gdsc->bitmap_index = glyph_offset[i] + nbits / 8;
+            continue;
+        }
+
         gdsc->bitmap_index = cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(bitmap_mapped) {
+        /*Keep the file open as the lazily loaded fonts do. See `lv_font_free`*/
+        lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) font_dsc;
+        lazy_dsc->map = map;
+        lazy_dsc->map_size = map_size;
+        lazy_dsc->loaded.keep_open = 1;
+        font_dsc->glyph_bitmap = glyf;
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *) lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -426,13 +635,18 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     cur_bmp_size = 0;
 
     for(unsigned int i = 1; i < loca_count; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i]);
-        if(res != LV_FS_RES_OK) {
-            return -1;
+        lv_fs_res_t res;
+        bit_iterator_t bit_it;
+        if(glyf) {
+            bit_it = init_bit_iterator_mem(glyf + glyph_offset[i]);
+        }
+        else {
+            res = lv_fs_seek(fp, start + glyph_offset[i]);
+            if(res != LV_FS_RES_OK) {
+                return -1;
+            }
+            bit_it = init_bit_iterator(fp);
         }
-        bit_iterator_t bit_it = init_bit_iterator(fp);
-
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
 
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
@@ -443,25 +657,10 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             continue;
         }
 
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+        int bmp_size = get_glyph_bitmap_size(glyph_offset, i, loca_count, glyph_length, header);
 
-        if(nbits % 8 == 0) {  /* Fast path */
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
-        }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
+        if(!read_glyph_bitmap(&bit_it, header, &glyph_bmp[cur_bmp_size], bmp_size)) {
+            return -1;
         }
 
         cur_bmp_size += bmp_size;
@@ -469,6 +668,86 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     return glyph_length;
 }
 
+/*
+ * `load_glyph_cb` of the lazily loaded fonts.
+ * Read the descriptor (and the bitmap) of a glyph from the file.
+ * The descriptors are cached in a small direct mapped cache.
+ */
+static const lv_font_fmt_txt_glyph_dsc_t * lazy_load_glyph(const lv_font_t * font, uint32_t gid,
+                                                           const uint8_t ** bitmap)
+{
+    lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) font->dsc;
+    if(gid == 0 || gid >= lazy_dsc->loca_count) return NULL;
+
+    lazy_glyph_dsc_t * slot = &lazy_dsc->dsc_cache[gid % LV_FONT_LOADER_LAZY_DSC_CNT];
+    bool dsc_cached = slot->gid == gid;
+    if(dsc_cached && bitmap == NULL) return &slot->dsc;
+
+    bit_iterator_t bit_it;
+    if(lazy_dsc->map) {
+        const uint8_t * mem = get_glyph_mem(lazy_dsc->map + lazy_dsc->glyph_start, lazy_dsc->glyph_offset, gid,
+                                            lazy_dsc->loca_count, lazy_dsc->glyph_length);
+        if(mem == NULL) return NULL;
+        bit_it = init_bit_iterator_mem(mem);
+    }
+    else {
+        lv_fs_file_t * fp = &lazy_dsc->file;
+        if(lv_fs_seek(fp, lazy_dsc->glyph_start + lazy_dsc->glyph_offset[gid]) != LV_FS_RES_OK) {
+            return NULL;
+        }
+
+        bit_it = init_bit_iterator(fp);
+    }
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    memset(&gdsc, 0, sizeof(gdsc));
+    if(!read_glyph_dsc(&bit_it, &lazy_dsc->header, &gdsc)) {
+        return NULL;
+    }
+
+    if(!dsc_cached) {
+        slot->gid = gid;
+        slot->dsc = gdsc;
+    }
+
+    if(bitmap) {
+        *bitmap = NULL;
+        if(gdsc.box_w * gdsc.box_h == 0) return &slot->dsc;
+
+        int bmp_size = get_glyph_bitmap_size(lazy_dsc->glyph_offset, gid, lazy_dsc->loca_count,
+                                             lazy_dsc->glyph_length, &lazy_dsc->header);
+        if(bmp_size <= 0) return NULL;
+
+        /*Byte aligned bitmaps can be used from the mapped file*/
+        int nbits = lazy_dsc->header.advance_width_bits + 2 * lazy_dsc->header.xy_bits + 2 * lazy_dsc->header.wh_bits;
+        if(bit_it.mem && nbits % 8 == 0) {
+            *bitmap = bit_it.mem;
+            return &slot->dsc;
+        }
+
+        if(lazy_dsc->bitmap_buf_size < (uint32_t)bmp_size) {
+            uint8_t * tmp = lv_mem_realloc(lazy_dsc->bitmap_buf, bmp_size);
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE
+            /*The cached glyphs might use the memory*/
+            if(tmp == NULL) {
+                lv_font_glyph_cache_clean();
+                tmp = lv_mem_realloc(lazy_dsc->bitmap_buf, bmp_size);
+            }
+#endif
+            LV_ASSERT_MEM(tmp);
+            if(tmp == NULL) return NULL;
+            lazy_dsc->bitmap_buf = tmp;
+            lazy_dsc->bitmap_buf_size = bmp_size;
+        }
+
+        if(!read_glyph_bitmap(&bit_it, &lazy_dsc->header, lazy_dsc->bitmap_buf, bmp_size)) {
+            return NULL;
+        }
+        *bitmap = lazy_dsc->bitmap_buf;
+    }
+
+    return &slot->dsc;
+}
+
 /*
  * Loads a `lv_font_t` from a binary file, given a `lv_fs_file_t`.
  *
@@ -481,14 +760,19 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy, const uint8_t * map, uint32_t map_size)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    /*A mapped font might keep the file open too*/
+    uint32_t dsc_size = (lazy || map) ? sizeof(lazy_font_dsc_t) : sizeof(loaded_font_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *) lv_mem_alloc(dsc_size);
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
+    if(lazy) {
+        font_dsc->load_glyph_cb = lazy_load_glyph;
+        ((loaded_font_dsc_t *) font_dsc)->keep_open = 1;
+    }
 
     /* header */
     int32_t header_length = read_label(fp, 0, "head");
@@ -562,10 +846,24 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /* glyph */
     uint32_t glyph_start = loca_start + loca_length;
-    int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
-
-    lv_mem_free(glyph_offset);
+    int32_t glyph_length;
+    if(lazy) {
+        /*Keep the glyph offsets to read the glyphs on demand*/
+        lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) font_dsc;
+        lazy_dsc->glyph_offset = glyph_offset;
+        lazy_dsc->loca_count = loca_count;
+        glyph_length = read_label(fp, glyph_start, "glyf");
+
+        /*Read the glyphs from the memory if the whole table is mapped*/
+        if(map && glyph_length >= 0 && glyph_start <= map_size && (uint32_t)glyph_length <= map_size - glyph_start) {
+            lazy_dsc->map = map;
+            lazy_dsc->map_size = map_size;
+        }
+    }
+    else {
+        glyph_length = load_glyph(fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, map, map_size);
+        lv_mem_free(glyph_offset);
+    }
 
     if(glyph_length < 0) {
         return false;
@@ -575,14 +873,26 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
         font_dsc->kern_dsc = NULL;
         font_dsc->kern_classes = 0;
         font_dsc->kern_scale = 0;
-        return true;
     }
+    else {
+        uint32_t kern_start = glyph_start + glyph_length;
 
-    uint32_t kern_start = glyph_start + glyph_length;
+        int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+        if(kern_length < 0) {
+            return false;
+        }
+    }
 
-    int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+    if(((loaded_font_dsc_t *) font_dsc)->keep_open) {
+        /*Set the file only on success to not close it twice on error*/
+        lazy_font_dsc_t * lazy_dsc = (lazy_font_dsc_t *) font_dsc;
+        lazy_dsc->header = font_header;
+        lazy_dsc->glyph_start = glyph_start;
+        lazy_dsc->glyph_length = glyph_length;
+        lazy_dsc->file = *fp;
+    }
 
-    return kern_length >= 0;
+    return true;
 }
 
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start)
@@ -76,6 +76,10 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->gpu_fill_cb  = NULL;
 #endif
 
+#if LV_USE_TILE_RENDER
+    driver->render_tiles_cb = NULL;
+#endif
+
 #if LV_USE_USER_DATA
     driver->user_data = NULL;
 #endif
@@ -126,6 +126,13 @@ typedef struct _disp_drv_t {
     /** OPTIONAL: called to wait while the gpu is working */
     void (*gpu_wait_cb)(struct _disp_drv_t * disp_drv);
 
+#if LV_USE_TILE_RENDER
+    /** OPTIONAL: Render `tile_cnt` tiles in parallel. Call `lv_refr_tile(i)` on the worker with `LV_TILE_RENDER_WORKER_ID == i`
+     * for every `i < tile_cnt` and return only when all of them are finished.
+     * If not set the area is rendered at once without splitting it into tiles.*/
+    void (*render_tiles_cb)(struct _disp_drv_t * disp_drv, uint32_t tile_cnt);
+#endif
+
 #if LV_USE_GPU
 
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
@@ -27,6 +27,21 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_ANIM_BATCH
+enum {
+    BATCH_TODO_NONE,    /*The animation is delayed*/
+    BATCH_TODO_APPLY,   /*Apply the calculated value*/
+    BATCH_TODO_STEP,    /*`start_cb` needs to be called first, so handle it later*/
+    BATCH_TODO_ORDERED, /*Temporary mark while the order of the path groups is built*/
+};
+typedef uint8_t batch_todo_t;
+
+typedef struct {
+    lv_anim_t * anim;   /*NULL if deleted*/
+    int32_t value;
+    batch_todo_t todo;
+} batch_item_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -34,6 +49,17 @@
 static void anim_task(lv_task_t * param);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
+static void anim_step(lv_anim_t * a, uint32_t elaps);
+static void anim_apply(lv_anim_t * a, int32_t new_value);
+static int32_t anim_get_value(lv_anim_t * a);
+static void anim_free(lv_anim_t * a);
+#if LV_USE_ANIM_BATCH
+    static void batch_task(uint32_t elaps);
+    static bool batch_add(lv_anim_t * a);
+    static void batch_compact(void);
+    static void batch_order_build(void);
+    static inline uint32_t * batch_get_order(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -43,6 +69,14 @@ static bool anim_list_changed;
 static bool anim_run_round;
 static lv_task_t * _lv_anim_task;
 const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
+#if LV_USE_ANIM_BATCH
+    static uint32_t batch_cnt;
+    static uint32_t batch_size;
+    static uint32_t batch_hole_cnt;
+    static bool batch_grouped;      /*All animations have the same path so the order of the items can be used*/
+    static bool batch_order_valid;  /*The indices grouped by path (stored after the items) are up to date*/
+    static bool batch_running;
+#endif
 
 /**********************
  *      MACROS
@@ -58,6 +92,14 @@ const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
 void _lv_anim_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+#if LV_USE_ANIM_BATCH
+    LV_GC_ROOT(_lv_anim_batch) = NULL;
+    batch_cnt = 0;
+    batch_size = 0;
+    batch_hole_cnt = 0;
+    batch_grouped = true;
+    batch_order_valid = true;
+#endif
     _lv_anim_task = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_ANIM_TASK_PRIO, NULL);
     anim_mark_list_change(); /*Turn off the animation task*/
     anim_list_changed = false; /*The list has not actually changed*/
@@ -106,6 +148,14 @@ void lv_anim_start(lv_anim_t * a)
     a->run_round = anim_run_round;
     _lv_memcpy(new_anim, a, sizeof(lv_anim_t));
 
+#if LV_USE_ANIM_BATCH
+    if(batch_add(new_anim) == false) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), new_anim);
+        lv_mem_free(new_anim);
+        return;
+    }
+#endif
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start);
@@ -127,17 +177,27 @@ void lv_anim_start(lv_anim_t * a)
  */
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+    bool del = false;
+#if LV_USE_ANIM_BATCH
+    uint32_t i;
+    for(i = 0; i < batch_cnt; i++) {
+        lv_anim_t * a = ((batch_item_t *)LV_GC_ROOT(_lv_anim_batch))[i].anim;
+        if(a && a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+            anim_free(a);
+            anim_mark_list_change();
+            del = true;
+        }
+    }
+#else
     lv_anim_t * a;
     lv_anim_t * a_next;
-    bool del = false;
     a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
     while(a != NULL) {
         /*'a' might be deleted, so get the next object while 'a' is valid*/
         a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
 
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-            lv_mem_free(a);
+            anim_free(a);
             anim_mark_list_change(); /*Read by `anim_task`. It need to know if a delete occurred in
                                          the linked list*/
             del = true;
@@ -145,6 +205,7 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
         a = a_next;
     }
+#endif
 
     return del;
 }
@@ -158,12 +219,22 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
+#if LV_USE_ANIM_BATCH
+    uint32_t i;
+    for(i = 0; i < batch_cnt; i++) {
+        lv_anim_t * a = ((batch_item_t *)LV_GC_ROOT(_lv_anim_batch))[i].anim;
+        if(a && a->var == var && a->exec_cb == exec_cb) {
+            return a;
+        }
+    }
+#else
     lv_anim_t * a;
     _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) {
         if(a->var == var && a->exec_cb == exec_cb) {
             return a;
         }
     }
+#endif
 
     return NULL;
 }
@@ -174,11 +245,15 @@ lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 uint16_t lv_anim_count_running(void)
 {
+#if LV_USE_ANIM_BATCH
+    return batch_cnt - batch_hole_cnt;
+#else
     uint16_t cnt = 0;
     lv_anim_t * a;
     _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) cnt++;
 
     return cnt;
+#endif
 }
 
 /**
@@ -411,9 +486,19 @@ static void anim_task(lv_task_t * param)
 
     uint32_t elaps = lv_tick_elaps(last_task_run);
 
+#if LV_USE_ANIM_BATCH
+    /*An animation callback might refresh the display. Don't step the animations again then.*/
+    if(batch_running) return;
+#endif
+
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
 
+#if LV_USE_ANIM_BATCH
+    batch_running = true;
+    batch_task(elaps);
+    batch_running = false;
+#else
     lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
 
     while(a != NULL) {
@@ -425,31 +510,7 @@ static void anim_task(lv_task_t * param)
 
         if(a->run_round != anim_run_round) {
             a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(a->act_time <= 0 && new_act_time >= 0) {
-                if(a->start_cb) a->start_cb(a);
-            }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                if(a->path.cb) new_value = a->path.cb(&a->path, a);
-                else new_value = lv_anim_path_linear(&a->path, a);
-
-                if(new_value != a->current) {
-                    a->current = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
-            }
+            anim_step(a, elaps);
         }
 
         /* If the linked list changed due to anim. delete then it's not safe to continue
@@ -459,10 +520,74 @@ static void anim_task(lv_task_t * param)
         else
             a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
+#endif
 
     last_task_run = lv_tick_get();
 }
 
+/**
+ * Advance an animation and apply its new value
+ * @param a pointer to an animation
+ * @param elaps the time elapsed since the last step
+ */
+static void anim_step(lv_anim_t * a, uint32_t elaps)
+{
+    /*The animation will run now for the first time. Call `start_cb`*/
+    int32_t new_act_time = a->act_time + elaps;
+    if(a->act_time <= 0 && new_act_time >= 0) {
+        if(a->start_cb) a->start_cb(a);
+    }
+    a->act_time += elaps;
+    if(a->act_time >= 0) {
+        if(a->act_time > a->time) a->act_time = a->time;
+        anim_apply(a, anim_get_value(a));
+    }
+}
+
+/**
+ * Apply the new value of an animation and handle its end
+ * @param a pointer to an animation
+ * @param new_value the value calculated from the path
+ */
+static void anim_apply(lv_anim_t * a, int32_t new_value)
+{
+    if(new_value != a->current) {
+        a->current = new_value;
+        /*Apply the calculated value*/
+        if(a->exec_cb) a->exec_cb(a->var, new_value);
+    }
+
+    /*If the time is elapsed the animation is ready*/
+    if(a->act_time >= a->time) {
+        anim_ready_handler(a);
+    }
+}
+
+/**
+ * Calculate the current value of an animation from its path
+ * @param a pointer to an animation
+ * @return the current value
+ */
+static int32_t anim_get_value(lv_anim_t * a)
+{
+    if(a->path.cb) return a->path.cb(&a->path, a);
+    else return lv_anim_path_linear(&a->path, a);
+}
+
+/**
+ * Remove an animation from the running animations and free it
+ * @param a pointer to an animation
+ */
+static void anim_free(lv_anim_t * a)
+{
+#if LV_USE_ANIM_BATCH
+    ((batch_item_t *)LV_GC_ROOT(_lv_anim_batch))[a->batch_id].anim = NULL;
+    batch_hole_cnt++;
+#endif
+    _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+    lv_mem_free(a);
+}
+
 /**
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
@@ -484,8 +609,7 @@ static void anim_ready_handler(lv_anim_t * a)
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
         lv_anim_t a_tmp;
         _lv_memcpy(&a_tmp, a, sizeof(lv_anim_t));
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        lv_mem_free(a);
+        anim_free(a);
         /*Flag that the list has changed */
         anim_mark_list_change();
 
@@ -520,4 +644,172 @@ static void anim_mark_list_change(void)
     else
         lv_task_set_prio(_lv_anim_task, LV_ANIM_TASK_PRIO);
 }
+
+#if LV_USE_ANIM_BATCH
+
+/**
+ * Step all the running animations.
+ * First the new values are calculated in a tight loop (grouped by the path functions)
+ * and the callbacks are called only after that in the order of the linked list.
+ * @param elaps the time elapsed since the last step
+ */
+static void batch_task(uint32_t elaps)
+{
+    batch_compact();
+
+    /*The animations started by the callbacks are added after `cnt` and will run only in the next round.*/
+    uint32_t cnt = batch_cnt;
+    batch_item_t * items = LV_GC_ROOT(_lv_anim_batch);
+    const uint32_t * order = batch_grouped ? NULL : batch_get_order();
+    uint32_t k;
+    for(k = 0; k < cnt; k++) {
+        uint32_t i = order ? order[k] : k;
+        lv_anim_t * a = items[i].anim;
+        a->run_round = anim_run_round;
+
+        int32_t new_act_time = a->act_time + elaps;
+        if(a->act_time <= 0 && new_act_time >= 0 && a->start_cb) {
+            items[i].todo = BATCH_TODO_STEP;
+            continue;
+        }
+
+        a->act_time = new_act_time;
+        if(a->act_time < 0) {
+            items[i].todo = BATCH_TODO_NONE;
+            continue;
+        }
+
+        if(a->act_time > a->time) a->act_time = a->time;
+        items[i].value = anim_get_value(a);
+        items[i].todo = BATCH_TODO_APPLY;
+    }
+
+    /* The callbacks might start or delete animations so always read the items again.
+     * Go backward to handle the newer animations first like in the linked list.*/
+    uint32_t i = cnt;
+    while(i > 0) {
+        i--;
+        batch_item_t * item = &((batch_item_t *)LV_GC_ROOT(_lv_anim_batch))[i];
+        if(item->anim == NULL) continue;
+
+        if(item->todo == BATCH_TODO_APPLY) anim_apply(item->anim, item->value);
+        else if(item->todo == BATCH_TODO_STEP) anim_step(item->anim, elaps);
+    }
+}
+
+/**
+ * Add a new animation to the end of the batch
+ * @param a pointer to the new animation
+ * @return false: out of memory
+ */
+static bool batch_add(lv_anim_t * a)
+{
+    if(batch_cnt == batch_size) {
+        /*The order of the path groups is stored after the items*/
+        uint32_t new_size = batch_size ? batch_size * 2 : 8;
+        batch_item_t * items = lv_mem_realloc(LV_GC_ROOT(_lv_anim_batch),
+                                              new_size * (sizeof(batch_item_t) + sizeof(uint32_t)));
+        LV_ASSERT_MEM(items);
+        if(items == NULL) return false;
+        LV_GC_ROOT(_lv_anim_batch) = items;
+        batch_size = new_size;
+    }
+
+    batch_item_t * items = LV_GC_ROOT(_lv_anim_batch);
+    if(batch_cnt > 0) {
+        lv_anim_t * prev = items[batch_cnt - 1].anim;
+        if(prev == NULL || prev->path.cb != a->path.cb) batch_grouped = false;
+    }
+
+    items[batch_cnt].anim = a;
+    items[batch_cnt].todo = BATCH_TODO_NONE;
+    a->batch_id = batch_cnt;
+    batch_cnt++;
+    batch_order_valid = false;
+
+    return true;
+}
+
+/**
+ * Remove the deleted animations from the batch keeping the order of the others
+ * and group their indices by the path functions if needed
+ */
+static void batch_compact(void)
+{
+    batch_item_t * items = LV_GC_ROOT(_lv_anim_batch);
+    uint32_t i;
+    if(batch_hole_cnt) {
+        uint32_t cnt = 0;
+        for(i = 0; i < batch_cnt; i++) {
+            if(items[i].anim == NULL) continue;
+            items[cnt] = items[i];
+            items[cnt].anim->batch_id = cnt;
+            cnt++;
+        }
+        batch_cnt = cnt;
+        batch_hole_cnt = 0;
+        batch_order_valid = false;
+
+        if(batch_cnt == 0) {
+            lv_mem_free(LV_GC_ROOT(_lv_anim_batch));
+            LV_GC_ROOT(_lv_anim_batch) = NULL;
+            batch_size = 0;
+            batch_grouped = true;
+            batch_order_valid = true;
+            return;
+        }
+
+        /*Maybe only one path remained*/
+        if(batch_grouped == false) {
+            batch_grouped = true;
+            for(i = 1; i < batch_cnt; i++) {
+                if(items[i].anim->path.cb != items[0].anim->path.cb) {
+                    batch_grouped = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if(batch_grouped == false && batch_order_valid == false) batch_order_build();
+}
+
+/**
+ * Save the indices of the items grouped by their path functions.
+ * The groups follow each other in the order of their first item and keep the order of the items.
+ * There are only a few different paths so it's fast.
+ */
+static void batch_order_build(void)
+{
+    batch_item_t * items = LV_GC_ROOT(_lv_anim_batch);
+    uint32_t * order = batch_get_order();
+    uint32_t cnt = 0;
+    uint32_t first;
+    uint32_t i;
+    for(i = 0; i < batch_cnt; i++) items[i].todo = BATCH_TODO_NONE;
+
+    for(first = 0; first < batch_cnt; first++) {
+        if(items[first].todo == BATCH_TODO_ORDERED) continue;
+        lv_anim_path_cb_t path_cb = items[first].anim->path.cb;
+        for(i = first; i < batch_cnt; i++) {
+            if(items[i].todo != BATCH_TODO_ORDERED && items[i].anim->path.cb == path_cb) {
+                items[i].todo = BATCH_TODO_ORDERED;
+                order[cnt++] = i;
+            }
+        }
+    }
+
+    batch_order_valid = true;
+}
+
+/**
+ * Get the indices of the items grouped by their path functions
+ * @return pointer to `batch_size` indices stored after the items
+ */
+static inline uint32_t * batch_get_order(void)
+{
+    return (uint32_t *)((batch_item_t *)LV_GC_ROOT(_lv_anim_batch) + batch_size);
+}
+
+#endif /*LV_USE_ANIM_BATCH*/
 #endif
@@ -96,6 +96,9 @@ typedef struct _lv_anim_t {
     uint8_t playback_now : 1; /**< Play back is in progress*/
     uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint32_t time_orig;
+#if LV_USE_ANIM_BATCH
+    uint32_t batch_id;        /**< Index of the animation in the batch of the running animations*/
+#endif
 } lv_anim_t;
 
 /**********************
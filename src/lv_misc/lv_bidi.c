@@ -56,12 +56,16 @@ static uint32_t get_txt_len(const char * txt, uint32_t max_len);
  **********************/
 static const uint8_t bracket_left[] = {"<({["};
 static const uint8_t bracket_right[] = {">)}]"};
-static bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
-static uint8_t br_stack_p;
+
+/*The workers rendering the tiles process their texts at the same time so every worker has its own stack*/
+static bracket_stack_t br_stack_workers[_LV_WORKER_NUM][LV_BIDI_BRACKLET_DEPTH];
+static uint8_t br_stack_p_workers[_LV_WORKER_NUM];
 
 /**********************
  *      MACROS
  **********************/
+#define br_stack    br_stack_workers[_LV_WORKER_ID]
+#define br_stack_p  br_stack_p_workers[_LV_WORKER_ID]
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -313,6 +313,33 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get the whole content of a file in memory (e.g. memory mapped) to read it without copying.
+ * The memory is valid until the file is closed and mustn't be written.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf store the pointer to the content of the file here
+ * @param size store the size of the file here. NULL if unused.
+ * @return LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't map the files or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size)
+{
+    if(buf == NULL) return LV_FS_RES_INV_PARAM;
+    *buf = NULL;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    uint32_t size_tmp = 0;
+    lv_fs_res_t res = file_p->drv->map_cb(file_p->drv, file_p->file_d, buf, &size_tmp);
+    if(res != LV_FS_RES_OK) *buf = NULL;
+    if(size) *size = size_tmp;
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
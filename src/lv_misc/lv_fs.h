@@ -78,6 +78,10 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
+    /*Optional. Make the whole content of an opened file readable from memory.
+     *The memory should be valid until `close_cb` and shouldn't be written.*/
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+
     lv_fs_res_t (*dir_open_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
@@ -211,6 +215,16 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get the whole content of a file in memory (e.g. memory mapped) to read it without copying.
+ * The memory is valid until the file is closed and mustn't be written.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf store the pointer to the content of the file here
+ * @param size store the size of the file here. NULL if unused.
+ * @return LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't map the files or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size);
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -0,0 +1,478 @@
+/**
+ * @file lv_fs_pack.c
+ * The header and the entries of the archive are little endian and they are read into the structures as they are
+ * (like the fonts in `lv_font_loader.c`), so the archives can be used only on little endian CPUs.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_pack.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_PACK
+
+#include <string.h>
+#include "lv_debug.h"
+#include "lv_gc.h"
+#include "lv_ll.h"
+#include "lv_log.h"
+#include "lv_math.h"
+#include "lv_mem.h"
+
+#if defined(LV_GC_INCLUDE)
+    #include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PACK_VERSION        1
+#define PACK_COMPR_NONE     0
+#define PACK_COMPR_RLE      1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Header at the beginning of the archive. See `scripts/lv_pack.py`*/
+typedef struct {
+    char magic[4];              /*"LVPK"*/
+    uint16_t version;
+    uint16_t align;             /*The files are aligned to this many bytes*/
+    uint32_t entry_cnt;
+    uint32_t bucket_cnt;        /*Number of hash buckets (power of 2)*/
+    uint32_t buckets_ofs;       /*Index + 1 of the first entry in every bucket (u32)*/
+    uint32_t entries_ofs;       /*Array of `pack_entry_t`*/
+    uint32_t names_ofs;         /*The paths*/
+    uint32_t reserved;
+} pack_header_t;
+
+/*A file in the archive*/
+typedef struct {
+    uint32_t hash;              /*FNV-1a hash of the path*/
+    uint32_t next;              /*Index + 1 of the next entry in the same bucket*/
+    uint32_t name_ofs;
+    uint16_t name_len;
+    uint8_t compr;              /*PACK_COMPR_...*/
+    uint8_t reserved;
+    uint32_t data_ofs;
+    uint32_t size;              /*Size of the stored data*/
+    uint32_t raw_size;          /*Size of the file (after decompression)*/
+} pack_entry_t;
+
+/*A mounted archive in `_lv_fs_pack_ll`*/
+typedef struct {
+    lv_fs_file_t file;          /*The opened archive*/
+    const uint8_t * map;        /*The content of the archive if it's mapped*/
+    uint32_t size;              /*Size of the archive or UINT32_MAX if unknown*/
+    uint32_t file_pos;          /*Read position in the archive to skip the needless seeks*/
+    pack_header_t header;
+    char letter;
+} pack_t;
+
+/*An opened file of an archive*/
+typedef struct {
+    pack_t * pack;
+    uint8_t * buf;              /*The decompressed content of a compressed file*/
+    uint32_t ofs;               /*Start of the file in the archive*/
+    uint32_t size;
+    uint32_t pos;
+} pack_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static pack_t * get_pack(lv_fs_drv_t * drv);
+static lv_fs_res_t pack_read_at(pack_t * pack, uint32_t ofs, void * buf, uint32_t btr);
+static lv_fs_res_t find_entry(pack_t * pack, const char * path, pack_entry_t * entry);
+static bool rle_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size);
+static lv_fs_res_t pack_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t pack_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t pack_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t pack_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t pack_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t pack_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t pack_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the archive drivers. Called by `lv_init()`.
+ */
+void _lv_fs_pack_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_fs_pack_ll), sizeof(pack_t));
+}
+
+/**
+ * Register a read only drive which serves the files of an archive created by `scripts/lv_pack.py`.
+ * The archive is opened once (with an already registered driver) and kept open.
+ * The files are looked up by the hash of their path. If the archive can be mapped (see `lv_fs_map()`)
+ * the files are read from the memory and they can be mapped too.
+ * The compressed files are decompressed into the RAM when they are opened.
+ * @param letter letter of the new drive. E.g. 'A' to open "A:images/icon.bin"
+ * @param path path of the archive with its driver letter. E.g. "P:assets.lvpk"
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_pack_mount(char letter, const char * path)
+{
+    if(lv_fs_get_drv(letter) != NULL) {
+        LV_LOG_WARN("lv_fs_pack_mount: the letter is already used");
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    pack_t * pack = _lv_ll_ins_head(&LV_GC_ROOT(_lv_fs_pack_ll));
+    LV_ASSERT_MEM(pack);
+    if(pack == NULL) return LV_FS_RES_OUT_OF_MEM;
+
+    _lv_memset_00(pack, sizeof(pack_t));
+    pack->letter = letter;
+
+    lv_fs_res_t res = lv_fs_open(&pack->file, path, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("lv_fs_pack_mount: can't open the archive");
+        _lv_ll_remove(&LV_GC_ROOT(_lv_fs_pack_ll), pack);
+        lv_mem_free(pack);
+        return res;
+    }
+
+    /*Read everything from the memory if the archive can be mapped*/
+    const void * map = NULL;
+    uint32_t size = 0;
+    if(lv_fs_map(&pack->file, &map, &size) == LV_FS_RES_OK) {
+        pack->map = map;
+        pack->size = size;
+    }
+    else if(lv_fs_size(&pack->file, &size) == LV_FS_RES_OK) {
+        pack->size = size;
+    }
+    else {
+        pack->size = UINT32_MAX;
+    }
+
+    pack_header_t * header = &pack->header;
+    res = pack_read_at(pack, 0, header, sizeof(pack_header_t));
+    if(res == LV_FS_RES_OK) {
+        if(memcmp(header->magic, "LVPK", 4) != 0 || header->version != PACK_VERSION ||
+           header->bucket_cnt == 0 || (header->bucket_cnt & (header->bucket_cnt - 1)) != 0) {
+            LV_LOG_WARN("lv_fs_pack_mount: invalid archive");
+            res = LV_FS_RES_FS_ERR;
+        }
+    }
+
+    if(res != LV_FS_RES_OK) {
+        lv_fs_close(&pack->file);
+        _lv_ll_remove(&LV_GC_ROOT(_lv_fs_pack_ll), pack);
+        lv_mem_free(pack);
+        return res;
+    }
+
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = letter;
+    drv.file_size = sizeof(pack_file_t);
+    drv.open_cb = pack_open;
+    drv.close_cb = pack_close;
+    drv.read_cb = pack_read;
+    drv.seek_cb = pack_seek;
+    drv.tell_cb = pack_tell;
+    drv.size_cb = pack_size;
+    drv.map_cb = pack_map;
+
+    lv_fs_drv_register(&drv);
+
+    return LV_FS_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the archive of a drive
+ * @param drv pointer to a driver registered by `lv_fs_pack_mount`
+ * @return the archive
+ */
+static pack_t * get_pack(lv_fs_drv_t * drv)
+{
+    pack_t * pack;
+    _LV_LL_READ(LV_GC_ROOT(_lv_fs_pack_ll), pack) {
+        if(pack->letter == drv->letter) return pack;
+    }
+
+    return NULL;
+}
+
+/**
+ * Read from an archive. Copy from the memory if it's mapped.
+ * @param pack pointer to an archive
+ * @param ofs position in the archive
+ * @param buf store the bytes here
+ * @param btr number of bytes to read
+ * @return LV_FS_RES_OK: all the bytes are read; other: error
+ */
+static lv_fs_res_t pack_read_at(pack_t * pack, uint32_t ofs, void * buf, uint32_t btr)
+{
+    if(ofs > pack->size || btr > pack->size - ofs) return LV_FS_RES_FS_ERR;
+
+    if(pack->map) {
+        _lv_memcpy(buf, pack->map + ofs, btr);
+        return LV_FS_RES_OK;
+    }
+
+    lv_fs_res_t res;
+    if(pack->file_pos != ofs) {
+        res = lv_fs_seek(&pack->file, ofs);
+        if(res != LV_FS_RES_OK) {
+            pack->file_pos = UINT32_MAX;
+            return res;
+        }
+    }
+
+    uint32_t br = 0;
+    res = lv_fs_read(&pack->file, buf, btr, &br);
+    if(res != LV_FS_RES_OK || br != btr) {
+        pack->file_pos = UINT32_MAX;
+        return res != LV_FS_RES_OK ? res : LV_FS_RES_FS_ERR;
+    }
+
+    pack->file_pos = ofs + btr;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Look up a file in the hash index of an archive
+ * @param pack pointer to an archive
+ * @param path path of the file in the archive
+ * @param entry store the entry of the file here
+ * @return LV_FS_RES_OK: found; LV_FS_RES_NOT_EX: not found; other: error
+ */
+static lv_fs_res_t find_entry(pack_t * pack, const char * path, pack_entry_t * entry)
+{
+    /*The same FNV-1a hash as in `scripts/lv_pack.py`*/
+    uint32_t hash = 2166136261u;
+    uint32_t len = 0;
+    while(path[len] != '\0') {
+        hash = (hash ^ (uint8_t)path[len]) * 16777619u;
+        len++;
+    }
+
+    const pack_header_t * header = &pack->header;
+    uint32_t id;
+    lv_fs_res_t res = pack_read_at(pack, header->buckets_ofs + (hash & (header->bucket_cnt - 1)) * sizeof(uint32_t),
+                                   &id, sizeof(id));
+    if(res != LV_FS_RES_OK) return res;
+
+    /*Limit the steps to not loop forever in a broken archive*/
+    uint32_t step;
+    for(step = 0; id != 0 && step < header->entry_cnt; step++) {
+        if(id > header->entry_cnt) return LV_FS_RES_FS_ERR;
+
+        res = pack_read_at(pack, header->entries_ofs + (id - 1) * sizeof(pack_entry_t), entry, sizeof(pack_entry_t));
+        if(res != LV_FS_RES_OK) return res;
+
+        if(entry->hash == hash && entry->name_len == len) {
+            /*Compare the path too*/
+            if(pack->map) {
+                if(entry->name_ofs > pack->size || len > pack->size - entry->name_ofs) return LV_FS_RES_FS_ERR;
+                if(memcmp(pack->map + entry->name_ofs, path, len) == 0) return LV_FS_RES_OK;
+            }
+            else {
+                char name_buf[32];
+                uint32_t i;
+                for(i = 0; i < len; i += sizeof(name_buf)) {
+                    uint32_t cmp_len = LV_MATH_MIN(len - i, sizeof(name_buf));
+                    res = pack_read_at(pack, entry->name_ofs + i, name_buf, cmp_len);
+                    if(res != LV_FS_RES_OK) return res;
+                    if(memcmp(name_buf, &path[i], cmp_len) != 0) break;
+                }
+                if(i >= len) return LV_FS_RES_OK;
+            }
+        }
+
+        id = entry->next;
+    }
+
+    return LV_FS_RES_NOT_EX;
+}
+
+/**
+ * Decompress the RLE data of a file. See `scripts/lv_pack.py`
+ * @param in the compressed data
+ * @param in_size size of the compressed data
+ * @param out store the decompressed data here
+ * @param out_size size of the decompressed data
+ * @return true: exactly `out_size` bytes are decompressed; false: invalid data
+ */
+static bool rle_decompress(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size)
+{
+    const uint8_t * in_end = in + in_size;
+    uint32_t out_pos = 0;
+    while(in < in_end) {
+        uint8_t c = in[0];
+        if(c < 128) {
+            uint32_t len = c + 1;
+            if(len > (uint32_t)(in_end - in - 1) || len > out_size - out_pos) return false;
+            _lv_memcpy(&out[out_pos], &in[1], len);
+            in += len + 1;
+            out_pos += len;
+        }
+        else {
+            uint32_t len = c - 125;
+            if(in + 1 >= in_end || len > out_size - out_pos) return false;
+            _lv_memset(&out[out_pos], in[1], len);
+            in += 2;
+            out_pos += len;
+        }
+    }
+
+    return out_pos == out_size;
+}
+
+static lv_fs_res_t pack_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    if(mode != LV_FS_MODE_RD) return LV_FS_RES_DENIED;
+
+    pack_t * pack = get_pack(drv);
+    if(pack == NULL) return LV_FS_RES_NOT_EX;
+
+    pack_entry_t entry;
+    lv_fs_res_t res = find_entry(pack, path, &entry);
+    if(res != LV_FS_RES_OK) return res;
+
+    if(entry.data_ofs > pack->size || entry.size > pack->size - entry.data_ofs) return LV_FS_RES_FS_ERR;
+
+    pack_file_t * f = file_p;
+    f->pack = pack;
+    f->buf = NULL;
+    f->ofs = entry.data_ofs;
+    f->size = entry.raw_size;
+    f->pos = 0;
+
+    if(entry.compr == PACK_COMPR_NONE) {
+        if(entry.size != entry.raw_size) return LV_FS_RES_FS_ERR;
+        return LV_FS_RES_OK;
+    }
+
+    if(entry.compr != PACK_COMPR_RLE) {
+        LV_LOG_WARN("lv_fs_pack: unknown compression");
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    /*Decompress the whole file into the RAM*/
+    f->buf = lv_mem_alloc(entry.raw_size ? entry.raw_size : 1);
+    LV_ASSERT_MEM(f->buf);
+    if(f->buf == NULL) return LV_FS_RES_OUT_OF_MEM;
+
+    const uint8_t * in = NULL;
+    uint8_t * in_buf = NULL;
+    if(pack->map) {
+        in = pack->map + entry.data_ofs;
+    }
+    else {
+        in_buf = lv_mem_alloc(entry.size ? entry.size : 1);
+        LV_ASSERT_MEM(in_buf);
+        if(in_buf) res = pack_read_at(pack, entry.data_ofs, in_buf, entry.size);
+        else res = LV_FS_RES_OUT_OF_MEM;
+        in = in_buf;
+    }
+
+    if(res == LV_FS_RES_OK && !rle_decompress(in, entry.size, f->buf, entry.raw_size)) {
+        LV_LOG_WARN("lv_fs_pack: invalid compressed data");
+        res = LV_FS_RES_FS_ERR;
+    }
+
+    if(in_buf) lv_mem_free(in_buf);
+
+    if(res != LV_FS_RES_OK) {
+        lv_mem_free(f->buf);
+        f->buf = NULL;
+    }
+
+    return res;
+}
+
+static lv_fs_res_t pack_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    if(f->buf) lv_mem_free(f->buf);
+    f->buf = NULL;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t pack_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    btr = LV_MATH_MIN(btr, f->size - f->pos);
+
+    lv_fs_res_t res = LV_FS_RES_OK;
+    if(f->buf) _lv_memcpy(buf, &f->buf[f->pos], btr);
+    else if(btr) res = pack_read_at(f->pack, f->ofs + f->pos, buf, btr);
+
+    if(res != LV_FS_RES_OK) btr = 0;
+    f->pos += btr;
+    *br = btr;
+
+    return res;
+}
+
+static lv_fs_res_t pack_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    if(pos > f->size) return LV_FS_RES_INV_PARAM;
+
+    f->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t pack_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t pack_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    *size_p = f->size;
+    return LV_FS_RES_OK;
+}
+
+/*The decompressed and the mapped files are already in the memory*/
+static lv_fs_res_t pack_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    pack_file_t * f = file_p;
+    if(f->buf) *buf_p = f->buf;
+    else if(f->pack->map) *buf_p = f->pack->map + f->ofs;
+    else return LV_FS_RES_NOT_IMP;
+
+    *size_p = f->size;
+    return LV_FS_RES_OK;
+}
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_PACK*/
@@ -0,0 +1,61 @@
+/**
+ * @file lv_fs_pack.h
+ * Read only file system driver serving the files of a packed archive (see `scripts/lv_pack.py`).
+ */
+
+#ifndef LV_FS_PACK_H
+#define LV_FS_PACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_PACK
+
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the archive drivers. Called by `lv_init()`.
+ */
+void _lv_fs_pack_init(void);
+
+/**
+ * Register a read only drive which serves the files of an archive created by `scripts/lv_pack.py`.
+ * The archive is opened once (with an already registered driver) and kept open.
+ * The files are looked up by the hash of their path. If the archive can be mapped (see `lv_fs_map()`)
+ * the files are read from the memory and they can be mapped too.
+ * The compressed files are decompressed into the RAM when they are opened.
+ * @param letter letter of the new drive. E.g. 'A' to open "A:images/icon.bin"
+ * @param path path of the archive with its driver letter. E.g. "P:assets.lvpk"
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_pack_mount(char letter, const char * path);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_PACK*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FS_PACK_H*/
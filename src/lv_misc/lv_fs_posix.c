@@ -0,0 +1,320 @@
+/**
+ * @file lv_fs_posix.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_posix.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include "lv_debug.h"
+#include "lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    int fd;
+    void * map;         /*The mapped content of the file or NULL*/
+    size_t map_size;
+} posix_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool get_path(char * buf, const char * path);
+static lv_fs_res_t posix_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t posix_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t posix_remove(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t posix_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t posix_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t posix_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t posix_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t posix_trunc(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t posix_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t posix_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname);
+static lv_fs_res_t posix_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+static lv_fs_res_t posix_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path);
+static lv_fs_res_t posix_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn);
+static lv_fs_res_t posix_dir_close(lv_fs_drv_t * drv, void * rddir_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a file system driver with `LV_FS_POSIX_LETTER` which uses the POSIX `open`, `read` etc. functions.
+ * The paths are relative to `LV_FS_POSIX_PATH`. The opened files can be mapped into the memory with `lv_fs_map()`.
+ * Called by `lv_init()`.
+ */
+void _lv_fs_posix_init(void)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = LV_FS_POSIX_LETTER;
+    drv.file_size = sizeof(posix_file_t);
+    drv.rddir_size = sizeof(DIR *);
+    drv.open_cb = posix_open;
+    drv.close_cb = posix_close;
+    drv.remove_cb = posix_remove;
+    drv.read_cb = posix_read;
+    drv.write_cb = posix_write;
+    drv.seek_cb = posix_seek;
+    drv.tell_cb = posix_tell;
+    drv.trunc_cb = posix_trunc;
+    drv.size_cb = posix_size;
+    drv.rename_cb = posix_rename;
+    drv.map_cb = posix_map;
+    drv.dir_open_cb = posix_dir_open;
+    drv.dir_read_cb = posix_dir_read;
+    drv.dir_close_cb = posix_dir_close;
+
+    lv_fs_drv_register(&drv);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Prefix a path with `LV_FS_POSIX_PATH`
+ * @param buf store the result here (`LV_FS_MAX_PATH_LENGTH` bytes)
+ * @param path the path without driver letter
+ * @return true: ok; false: the path is too long
+ */
+static bool get_path(char * buf, const char * path)
+{
+    int len = snprintf(buf, LV_FS_MAX_PATH_LENGTH, "%s%s", LV_FS_POSIX_PATH, path);
+    if(len < 0 || len >= LV_FS_MAX_PATH_LENGTH) {
+        LV_LOG_WARN("lv_fs_posix: too long path");
+        return false;
+    }
+
+    return true;
+}
+
+static lv_fs_res_t posix_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    (void) drv;     /*Unused*/
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!get_path(buf, path)) return LV_FS_RES_INV_PARAM;
+
+    int flags = 0;
+    if(mode == LV_FS_MODE_WR) flags = O_WRONLY | O_CREAT | O_TRUNC;
+    else if(mode == LV_FS_MODE_RD) flags = O_RDONLY;
+    else if(mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) flags = O_RDWR | O_CREAT;
+    else return LV_FS_RES_INV_PARAM;
+
+    int fd = open(buf, flags, 0666);
+    if(fd < 0) return LV_FS_RES_NOT_EX;
+
+    posix_file_t * f = file_p;
+    f->fd = fd;
+    f->map = NULL;
+    f->map_size = 0;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    if(f->map) munmap(f->map, f->map_size);
+    f->map = NULL;
+
+    return close(f->fd) == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+static lv_fs_res_t posix_remove(lv_fs_drv_t * drv, const char * path)
+{
+    (void) drv;     /*Unused*/
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!get_path(buf, path)) return LV_FS_RES_INV_PARAM;
+
+    return unlink(buf) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t posix_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    ssize_t res = read(f->fd, buf, btr);
+    if(res < 0) {
+        *br = 0;
+        return LV_FS_RES_HW_ERR;
+    }
+
+    *br = (uint32_t) res;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    ssize_t res = write(f->fd, buf, btw);
+    if(res < 0) {
+        *bw = 0;
+        return LV_FS_RES_HW_ERR;
+    }
+
+    *bw = (uint32_t) res;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    return lseek(f->fd, pos, SEEK_SET) < 0 ? LV_FS_RES_HW_ERR : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    off_t pos = lseek(f->fd, 0, SEEK_CUR);
+    if(pos < 0) return LV_FS_RES_HW_ERR;
+
+    *pos_p = (uint32_t) pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_trunc(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    off_t pos = lseek(f->fd, 0, SEEK_CUR);
+    if(pos < 0 || ftruncate(f->fd, pos) != 0) return LV_FS_RES_HW_ERR;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    struct stat st;
+    if(fstat(f->fd, &st) != 0) return LV_FS_RES_HW_ERR;
+
+    *size_p = (uint32_t) st.st_size;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname)
+{
+    (void) drv;     /*Unused*/
+
+    char old_buf[LV_FS_MAX_PATH_LENGTH];
+    char new_buf[LV_FS_MAX_PATH_LENGTH];
+    if(!get_path(old_buf, oldname) || !get_path(new_buf, newname)) return LV_FS_RES_INV_PARAM;
+
+    return rename(old_buf, new_buf) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+/*Map the whole file read only. It's unmapped in `posix_close`*/
+static lv_fs_res_t posix_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+
+    posix_file_t * f = file_p;
+    if(f->map == NULL) {
+        struct stat st;
+        if(fstat(f->fd, &st) != 0) return LV_FS_RES_HW_ERR;
+        if(st.st_size == 0 || (uint64_t)st.st_size > UINT32_MAX) return LV_FS_RES_NOT_IMP;
+
+        void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, f->fd, 0);
+        if(map == MAP_FAILED) return LV_FS_RES_NOT_IMP;
+
+        f->map = map;
+        f->map_size = st.st_size;
+    }
+
+    *buf_p = f->map;
+    *size_p = (uint32_t) f->map_size;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path)
+{
+    (void) drv;     /*Unused*/
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    if(!get_path(buf, path)) return LV_FS_RES_INV_PARAM;
+
+    DIR * dir = opendir(buf);
+    if(dir == NULL) return LV_FS_RES_NOT_EX;
+
+    *((DIR **)rddir_p) = dir;
+    return LV_FS_RES_OK;
+}
+
+/*The name of the directories begins with '/'. `fn` is "" if there are no more entries.*/
+static lv_fs_res_t posix_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn)
+{
+    (void) drv;     /*Unused*/
+
+    DIR * dir = *((DIR **)rddir_p);
+    struct dirent * entry;
+    do {
+        entry = readdir(dir);
+        if(entry == NULL) {
+            fn[0] = '\0';
+            return LV_FS_RES_OK;
+        }
+    } while(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0);
+
+    /*Truncate the too long names*/
+    size_t i = 0;
+    if(entry->d_type == DT_DIR) fn[i++] = '/';
+    size_t len = strlen(entry->d_name);
+    if(len > LV_FS_MAX_FN_LENGTH - 1 - i) len = LV_FS_MAX_FN_LENGTH - 1 - i;
+    memcpy(&fn[i], entry->d_name, len);
+    fn[i + len] = '\0';
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t posix_dir_close(lv_fs_drv_t * drv, void * rddir_p)
+{
+    (void) drv;     /*Unused*/
+
+    DIR * dir = *((DIR **)rddir_p);
+    return closedir(dir) == 0 ? LV_FS_RES_OK : LV_FS_RES_HW_ERR;
+}
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_POSIX*/
@@ -0,0 +1,51 @@
+/**
+ * @file lv_fs_posix.h
+ * File system driver for POSIX systems with memory mapping.
+ */
+
+#ifndef LV_FS_POSIX_H
+#define LV_FS_POSIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register a file system driver with `LV_FS_POSIX_LETTER` which uses the POSIX `open`, `read` etc. functions.
+ * The paths are relative to `LV_FS_POSIX_PATH`. The opened files can be mapped into the memory with `lv_fs_map()`.
+ * Called by `lv_init()`.
+ */
+void _lv_fs_posix_init(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_POSIX*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FS_POSIX_H*/
@@ -29,14 +29,19 @@ extern "C" {
     f(lv_ll_t, _lv_task_ll)  /*Linked list to store the lv_tasks*/ \
     f(lv_ll_t, _lv_disp_ll)  /*Linked list of screens*/            \
     f(lv_ll_t, _lv_indev_ll) /*Linked list of input device*/       \
+    f(lv_ll_t, _lv_indev_search_index_ll)                          \
     f(lv_ll_t, _lv_drv_ll)                                         \
     f(lv_ll_t, _lv_file_ll)                                        \
+    f(lv_ll_t, _lv_fs_pack_ll)                                     \
     f(lv_ll_t, _lv_anim_ll)                                        \
+    f(void *, _lv_anim_batch)                                      \
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
+    f(void *, _lv_obj_trans_inv)                                   \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
     f(lv_task_t*, _lv_task_act)                                    \
+    f(_lv_task_heap_arr_t, _lv_task_heap)                          \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
     f(void * , _lv_theme_material_styles)                          \
@@ -44,6 +49,9 @@ extern "C" {
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
     f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(lv_ll_t, _lv_shadow_cache_ll)                                \
+    f(lv_ll_t, _lv_font_glyph_cache_ll)                            \
+    f(lv_ll_t, _lv_draw_mask_radius_cache_ll)                      \
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -25,6 +25,10 @@
     #define LV_MEM_ADD_JUNK 0
 #endif
 
+#ifndef LV_MEM_TLSF
+    #define LV_MEM_TLSF 0
+#endif
+
 #ifndef LV_MEM_FULL_DEFRAG_CNT
     #define LV_MEM_FULL_DEFRAG_CNT 16
 #endif
@@ -45,7 +49,12 @@
 typedef union {
     struct {
         MEM_UNIT used : 1;    /* 1: if the entry is used*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+        MEM_UNIT prev_free : 1; /* 1: if the previous entry is free (its size is stored in its last 4 bytes)*/
+        MEM_UNIT d_size : 30; /* Size of the data*/
+#else
         MEM_UNIT d_size : 31; /* Size of the data*/
+#endif
     } s;
     MEM_UNIT header; /* The header (used + d_size)*/
 } lv_mem_header_t;
@@ -57,6 +66,22 @@ typedef struct {
 
 #endif /* LV_ENABLE_GC */
 
+#if LV_MEM_BUF_ARENA_SIZE
+/*Stored before every buffer of the arena. Its size (8 bytes) keeps the buffers aligned.*/
+typedef struct {
+    uint32_t prev;  /*Offset of the previous buffer's header or `MEM_BUF_ARENA_NONE`*/
+    uint32_t used;
+} mem_buf_arena_header_t;
+
+typedef struct {
+    MEM_UNIT buf[LV_MEM_BUF_ARENA_SIZE / sizeof(MEM_UNIT)];
+    uint32_t top;   /*Offset of the first free byte*/
+    uint32_t last;  /*Offset of the last buffer's header or `MEM_BUF_ARENA_NONE`*/
+    uint32_t max_used;
+    uint32_t fallback_cnt;
+} mem_buf_arena_t;
+#endif
+
 #ifdef LV_ARCH_64
     #define ALIGN_MASK 0x7
 #else
@@ -65,13 +90,65 @@ typedef struct {
 
 #define MEM_BUF_SMALL_SIZE 16
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /* Two-level segregated fit: the first level splits the sizes by power of 2,
+     * the second level splits every power of 2 range into `TLSF_SL_CNT` linear ranges.
+     * Sizes below `TLSF_SMALL_SIZE` have one list per aligned size. */
+    #ifdef LV_ARCH_64
+        #define TLSF_ALIGN_LOG2 3
+    #else
+        #define TLSF_ALIGN_LOG2 2
+    #endif
+    #define TLSF_SL_LOG2    3
+    #define TLSF_SL_CNT     (1 << TLSF_SL_LOG2)
+    #define TLSF_FL_SHIFT   (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+    #define TLSF_FL_CNT     (31 - TLSF_FL_SHIFT)  /*`d_size` has 30 bits*/
+    #define TLSF_SMALL_SIZE (1 << TLSF_FL_SHIFT)
+    /*A free entry stores the next and previous free entries and its size as a footer*/
+    #define TLSF_MIN_SIZE   ((3 * sizeof(uint32_t) + ALIGN_MASK) & (~ALIGN_MASK))
+    #define TLSF_NULL       0xFFFFFFFF
+    /*The free list links are offsets in `work_mem`*/
+    #define TLSF_LINKS(e)   ((uint32_t *)&(e)->first_data)
+    #define TLSF_OFS(e)     ((uint32_t)((uint8_t *)(e) - work_mem))
+    #define TLSF_ENT(ofs)   ((lv_mem_ent_t *)&work_mem[ofs])
+#endif
+
+#if LV_USE_TILE_RENDER
+    #define MEM_BUF(i)  LV_GC_ROOT(_lv_mem_buf[_LV_WORKER_ID][i])
+#else
+    #define MEM_BUF(i)  LV_GC_ROOT(_lv_mem_buf[i])
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    #define MEM_BUF_ARENA       (mem_buf_arenas[_LV_WORKER_ID])
+    #define MEM_BUF_ARENA_NONE  0xFFFFFFFF
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
-    static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
+#if LV_MEM_TLSF
+    static void tlsf_init(void);
+    static void * tlsf_alloc(size_t size);
+    static void tlsf_free(lv_mem_ent_t * e);
+    static void tlsf_insert(lv_mem_ent_t * e);
+    static void tlsf_remove(lv_mem_ent_t * e);
+    static lv_mem_ent_t * tlsf_find(uint32_t fl, uint32_t sl);
+    static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl);
+    static inline uint32_t tlsf_clz(uint32_t x);
+    static inline uint32_t tlsf_ctz(uint32_t x);
+#else
+    static void * ent_alloc(lv_mem_ent_t * e, size_t size);
+#endif
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    static void * mem_buf_arena_get(uint32_t size);
+    static bool mem_buf_arena_release(void * p);
+    static void mem_buf_arena_reset(mem_buf_arena_t * arena);
 #endif
 
 /**********************
@@ -83,16 +160,35 @@ typedef struct {
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_MEM_BUF_ARENA_SIZE
+    static mem_buf_arena_t mem_buf_arenas[_LV_WORKER_NUM];
+#endif
+
 #if LV_MEM_CUSTOM == 0
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    static uint32_t tlsf_fl_bitmap;                         /*Bit `fl` is set if `tlsf_sl_bitmap[fl]` is not 0*/
+    static uint32_t tlsf_sl_bitmap[TLSF_FL_CNT];            /*Bit `sl` is set if the list `[fl][sl]` is not empty*/
+    static uint32_t tlsf_heads[TLSF_FL_CNT][TLSF_SL_CNT];   /*The first free entry in every list*/
+    static uint32_t tlsf_free_cnt;
+    static uint32_t tlsf_free_size;
+    static uint32_t tlsf_used_cnt;
+#endif
+
+#if LV_USE_TILE_RENDER
+static uint8_t mem_buf_small_data[_LV_WORKER_NUM][2][MEM_BUF_SMALL_SIZE];
+static lv_mem_buf_t mem_buf_small_workers[_LV_WORKER_NUM][2];
+#define mem_buf_small mem_buf_small_workers[_LV_WORKER_ID]
+#else
 static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
 static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
 
 static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_SIZE, .used = 0},
     {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
 };
+#endif
 
 /**********************
  *      MACROS
@@ -123,11 +219,34 @@ void _lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
+#if LV_MEM_TLSF
+    tlsf_init();
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
+
+#if LV_USE_TILE_RENDER
+    uint32_t w;
+    for(w = 0; w < _LV_WORKER_NUM; w++) {
+        mem_buf_small_workers[w][0].p = mem_buf_small_data[w][0];
+        mem_buf_small_workers[w][0].size = MEM_BUF_SMALL_SIZE;
+        mem_buf_small_workers[w][1].p = mem_buf_small_data[w][1];
+        mem_buf_small_workers[w][1].size = MEM_BUF_SMALL_SIZE;
+    }
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    uint32_t a;
+    for(a = 0; a < _LV_WORKER_NUM; a++) {
+        mem_buf_arena_reset(&mem_buf_arenas[a]);
+        mem_buf_arenas[a].max_used = 0;
+        mem_buf_arenas[a].fallback_cnt = 0;
+    }
+#endif
 }
 
 /**
@@ -136,7 +255,9 @@ void _lv_mem_init(void)
  */
 void _lv_mem_deinit(void)
 {
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    tlsf_init();
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
@@ -161,6 +282,11 @@ void * lv_mem_alloc(size_t size)
 
 #if LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
+    _LV_WORKER_LOCK();
+
+#if LV_MEM_TLSF
+    alloc = tlsf_alloc(size);
+#else
     lv_mem_ent_t * e = NULL;
 
     /* Search for a appropriate entry*/
@@ -174,6 +300,16 @@ void * lv_mem_alloc(size_t size)
         }
         /* End if there is not next entry OR the alloc. is successful*/
     } while(e != NULL && alloc == NULL);
+#endif
+
+    /* just a safety check, should always be true */
+    if(alloc != NULL && (uintptr_t) alloc > (uintptr_t) work_mem) {
+        if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
+            mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
+        }
+    }
+
+    _LV_WORKER_UNLOCK();
 
 #else
     /*Use custom, user defined malloc function*/
@@ -198,16 +334,6 @@ void * lv_mem_alloc(size_t size)
     if(alloc == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
     }
-    else {
-#if LV_MEM_CUSTOM == 0
-        /* just a safety check, should always be true */
-        if((uintptr_t) alloc > (uintptr_t) work_mem) {
-            if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
-                mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
-            }
-        }
-#endif
-    }
 
     return alloc;
 }
@@ -225,6 +351,10 @@ void lv_mem_free(const void * data)
     _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
 #endif
 
+#if LV_MEM_CUSTOM == 0
+    _LV_WORKER_LOCK();
+#endif
+
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
@@ -232,7 +362,10 @@ void lv_mem_free(const void * data)
 #endif
 
 #if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
+#if LV_MEM_TLSF
+    /*The adjacent free entries are always joined*/
+    tlsf_free(e);
+#elif LV_MEM_AUTO_DEFRAG
     static uint16_t full_defrag_cnt = 0;
     full_defrag_cnt++;
     if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
@@ -256,6 +389,7 @@ void lv_mem_free(const void * data)
 
     }
 #endif /*LV_MEM_AUTO_DEFRAG*/
+    _LV_WORKER_UNLOCK();
 #else /*Use custom, user defined free function*/
 #if LV_ENABLE_GC == 0
     LV_MEM_CUSTOM_FREE(e);
@@ -295,7 +429,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+        _LV_WORKER_LOCK();
         ent_trunc(e, new_size);
+        _LV_WORKER_UNLOCK();
         return &e->first_data;
     }
 #endif
@@ -334,7 +470,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+    /*With TLSF the free entries are joined on free so there is nothing to do*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -377,6 +514,9 @@ lv_res_t lv_mem_test(void)
 {
 #if LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e;
+#if LV_MEM_TLSF
+    bool prev_free = false;
+#endif
     e = ent_get_next(NULL);
     while(e) {
         if(e->header.s.d_size > LV_MEM_SIZE) {
@@ -386,6 +526,12 @@ lv_res_t lv_mem_test(void)
         if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
             return LV_RES_INV;
         }
+#if LV_MEM_TLSF
+        /*The free entries are always joined and the next entry knows about them*/
+        if(e->header.s.prev_free != prev_free) return LV_RES_INV;
+        if(prev_free && e->header.s.used == 0) return LV_RES_INV;
+        prev_free = e->header.s.used == 0;
+#endif
         e = ent_get_next(e);
     }
 #endif
@@ -402,8 +548,27 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     /*Init the data*/
     _lv_memset(mon_p, 0, sizeof(lv_mem_monitor_t));
 #if LV_MEM_CUSTOM == 0
+    _LV_WORKER_LOCK();
+#if LV_MEM_TLSF
+    mon_p->free_cnt = tlsf_free_cnt;
+    mon_p->free_size = tlsf_free_size;
+    mon_p->used_cnt = tlsf_used_cnt;
+
+    /*The biggest free entry is in the highest non-empty list*/
+    if(tlsf_fl_bitmap) {
+        uint32_t fl = 31 - tlsf_clz(tlsf_fl_bitmap);
+        uint32_t sl = 31 - tlsf_clz(tlsf_sl_bitmap[fl]);
+        uint32_t ofs = tlsf_heads[fl][sl];
+        while(ofs != TLSF_NULL) {
+            lv_mem_ent_t * e = TLSF_ENT(ofs);
+            if(e->header.s.d_size > mon_p->free_biggest_size) {
+                mon_p->free_biggest_size = e->header.s.d_size;
+            }
+            ofs = TLSF_LINKS(e)[0];
+        }
+    }
+#else
     lv_mem_ent_t * e;
-
     e = ent_get_next(NULL);
 
     while(e != NULL) {
@@ -420,6 +585,8 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
         e = ent_get_next(e);
     }
+#endif
+    _LV_WORKER_UNLOCK();
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->max_used = mem_max_size;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -479,42 +646,48 @@ void * _lv_mem_buf_get(uint32_t size)
         }
     }
 
+#if LV_MEM_BUF_ARENA_SIZE
+    /*Then take it from the arena if there is enough space*/
+    void * arena_buf = mem_buf_arena_get(size);
+    if(arena_buf) return arena_buf;
+#endif
+
     /*Try to find a free buffer with suitable size */
     int8_t i_guess = -1;
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(_lv_mem_buf[i]).p;
+        if(MEM_BUF(i).used == 0 && MEM_BUF(i).size >= size) {
+            if(MEM_BUF(i).size == size) {
+                MEM_BUF(i).used = 1;
+                return MEM_BUF(i).p;
             }
             else if(i_guess < 0) {
                 i_guess = i;
             }
             /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
+            else if(MEM_BUF(i).size < MEM_BUF(i_guess).size) {
                 i_guess = i;
             }
         }
     }
 
     if(i_guess >= 0) {
-        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
-        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
+        MEM_BUF(i_guess).used = 1;
+        return MEM_BUF(i_guess).p;
     }
 
     /*Reallocate a free buffer*/
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
+        if(MEM_BUF(i).used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
+            void * buf = lv_mem_realloc(MEM_BUF(i).p, size);
             if(buf == NULL) {
                 LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
                 return NULL;
             }
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
-            return LV_GC_ROOT(_lv_mem_buf[i]).p;
+            MEM_BUF(i).used = 1;
+            MEM_BUF(i).size = size;
+            MEM_BUF(i).p    = buf;
+            return MEM_BUF(i).p;
         }
     }
 
@@ -538,9 +711,13 @@ void _lv_mem_buf_release(void * p)
         }
     }
 
+#if LV_MEM_BUF_ARENA_SIZE
+    if(mem_buf_arena_release(p)) return;
+#endif
+
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+        if(MEM_BUF(i).p == p) {
+            MEM_BUF(i).used = 0;
             return;
         }
     }
@@ -554,18 +731,97 @@ void _lv_mem_buf_release(void * p)
 void _lv_mem_buf_free_all(void)
 {
     uint8_t i;
+#if LV_USE_TILE_RENDER
+    /*It's called between the frames when the workers are idle so free their buffers too*/
+    uint32_t w;
+    for(w = 0; w < _LV_WORKER_NUM; w++) {
+        for(i = 0; i < 2; i++) {
+            mem_buf_small_workers[w][i].used = 0;
+        }
+
+        for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+            if(LV_GC_ROOT(_lv_mem_buf[w][i]).p) {
+                lv_mem_free(LV_GC_ROOT(_lv_mem_buf[w][i]).p);
+                LV_GC_ROOT(_lv_mem_buf[w][i]).p = NULL;
+                LV_GC_ROOT(_lv_mem_buf[w][i]).used = 0;
+                LV_GC_ROOT(_lv_mem_buf[w][i]).size = 0;
+            }
+        }
+    }
+#else
     for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
         mem_buf_small[i].used = 0;
     }
 
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
-            LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
+        if(MEM_BUF(i).p) {
+            lv_mem_free(MEM_BUF(i).p);
+            MEM_BUF(i).p = NULL;
+            MEM_BUF(i).used = 0;
+            MEM_BUF(i).size = 0;
         }
     }
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    uint32_t a;
+    for(a = 0; a < _LV_WORKER_NUM; a++) {
+        mem_buf_arena_reset(&mem_buf_arenas[a]);
+    }
+#endif
+}
+
+/**
+ * Get the current position of the temporary buffer arena
+ * @return a mark to pass to `_lv_mem_buf_arena_rewind()`
+ */
+uint32_t _lv_mem_buf_arena_get_mark(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+    return MEM_BUF_ARENA.top;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Release all the temporary buffers of the arena taken after a mark
+ * @param mark a mark from `_lv_mem_buf_arena_get_mark()`
+ */
+void _lv_mem_buf_arena_rewind(uint32_t mark)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+    mem_buf_arena_t * arena = &MEM_BUF_ARENA;
+    uint8_t * buf8 = (uint8_t *)arena->buf;
+    while(arena->last != MEM_BUF_ARENA_NONE && arena->last >= mark) {
+        mem_buf_arena_header_t * header = (mem_buf_arena_header_t *)&buf8[arena->last];
+        if(header->used) {
+            LV_LOG_WARN("_lv_mem_buf_arena_rewind: a buffer was not released");
+        }
+        arena->top = arena->last;
+        arena->last = header->prev;
+    }
+#else
+    LV_UNUSED(mark);
+#endif
+}
+
+/**
+ * Get the statistics of the temporary buffer arena
+ * @param stat store the statistics here. All fields are 0 if the arena is disabled.
+ */
+void lv_mem_buf_arena_get_stat(lv_mem_buf_arena_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_mem_buf_arena_stat_t));
+#if LV_MEM_BUF_ARENA_SIZE
+    uint32_t a;
+    stat->total_size = sizeof(mem_buf_arenas[0].buf);
+    for(a = 0; a < _LV_WORKER_NUM; a++) {
+        stat->used = LV_MATH_MAX(stat->used, mem_buf_arenas[a].top);
+        stat->max_used = LV_MATH_MAX(stat->max_used, mem_buf_arenas[a].max_used);
+        stat->fallback_cnt += mem_buf_arenas[a].fallback_cnt;
+    }
+#endif
 }
 
 #if LV_MEMCPY_MEMSET_STD == 0
@@ -757,6 +1013,71 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Take a buffer from the calling worker's arena
+ * @param size the required size
+ * @return pointer to the buffer or NULL if the arena is full
+ */
+static void * mem_buf_arena_get(uint32_t size)
+{
+    mem_buf_arena_t * arena = &MEM_BUF_ARENA;
+
+    /*Round the size up to ALIGN_MASK*/
+    size = (size + ALIGN_MASK) & (~ALIGN_MASK);
+    if(size > sizeof(arena->buf) - sizeof(mem_buf_arena_header_t) ||
+       arena->top + sizeof(mem_buf_arena_header_t) + size > sizeof(arena->buf)) {
+        arena->fallback_cnt++;
+        return NULL;
+    }
+
+    uint8_t * buf8 = (uint8_t *)arena->buf;
+    mem_buf_arena_header_t * header = (mem_buf_arena_header_t *)&buf8[arena->top];
+    header->prev = arena->last;
+    header->used = 1;
+    arena->last = arena->top;
+    arena->top += sizeof(mem_buf_arena_header_t) + size;
+    if(arena->top > arena->max_used) arena->max_used = arena->top;
+
+    return header + 1;
+}
+
+/**
+ * Release a buffer of the calling worker's arena.
+ * The arena is rewound over the released buffers at its top.
+ * @param p pointer to a buffer
+ * @return true: `p` was in the arena; false: `p` is not in the arena
+ */
+static bool mem_buf_arena_release(void * p)
+{
+    mem_buf_arena_t * arena = &MEM_BUF_ARENA;
+    uint8_t * buf8 = (uint8_t *)arena->buf;
+    if((uint8_t *)p < buf8 || (uint8_t *)p >= buf8 + sizeof(arena->buf)) return false;
+
+    mem_buf_arena_header_t * header = (mem_buf_arena_header_t *)p - 1;
+    header->used = 0;
+
+    while(arena->last != MEM_BUF_ARENA_NONE) {
+        header = (mem_buf_arena_header_t *)&buf8[arena->last];
+        if(header->used) break;
+        arena->top = arena->last;
+        arena->last = header->prev;
+    }
+
+    return true;
+}
+
+/**
+ * Release all the buffers of an arena
+ * @param arena pointer to an arena
+ */
+static void mem_buf_arena_reset(mem_buf_arena_t * arena)
+{
+    arena->top = 0;
+    arena->last = MEM_BUF_ARENA_NONE;
+}
+#endif /*LV_MEM_BUF_ARENA_SIZE*/
+
 #if LV_MEM_CUSTOM == 0
 /**
  * Give the next entry after 'act_e'
@@ -780,6 +1101,7 @@ static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
     return next_e;
 }
 
+#if LV_MEM_TLSF == 0
 /**
  * Try to do the real allocation with a given size
  * @param e try to allocate to this entry
@@ -829,4 +1151,270 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
     }
 }
 
+#else /*LV_MEM_TLSF*/
+
+/**
+ * Truncate the data of entry to the given size and free the rest
+ * @param e Pointer to an entry
+ * @param size new size in bytes
+ */
+static void ent_trunc(lv_mem_ent_t * e, size_t size)
+{
+    /*Round the size up to ALIGN_MASK*/
+    size = (size + ALIGN_MASK) & (~ALIGN_MASK);
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+
+    /*Keep the remaining part in the entry if it's too small to be a free entry*/
+    if(e->header.s.d_size < size + sizeof(lv_mem_header_t) + TLSF_MIN_SIZE) return;
+
+    lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size);
+    rest->header.s.used = 1;
+    rest->header.s.prev_free = 0;
+    rest->header.s.d_size = (uint32_t)e->header.s.d_size - size - sizeof(lv_mem_header_t);
+    e->header.s.d_size = (uint32_t)size;
+
+    tlsf_used_cnt++;
+    tlsf_free(rest);
+}
+
+/**
+ * Reset the heap to one free entry
+ */
+static void tlsf_init(void)
+{
+    tlsf_fl_bitmap = 0;
+    _lv_memset_00(tlsf_sl_bitmap, sizeof(tlsf_sl_bitmap));
+    _lv_memset_ff(tlsf_heads, sizeof(tlsf_heads));
+    tlsf_free_cnt = 0;
+    tlsf_free_size = 0;
+    tlsf_used_cnt = 0;
+
+    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
+    full->header.s.prev_free = 0;
+    /*The total mem size reduced by the first header*/
+    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+    tlsf_insert(full);
+}
+
+/**
+ * Allocate an entry from the free lists in constant time
+ * @param size size of the new memory in bytes (already aligned)
+ * @return pointer to the allocated memory or NULL if there is no large enough free entry
+ */
+static void * tlsf_alloc(size_t size)
+{
+    if(size > LV_MEM_SIZE) return NULL;
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+
+    /*Round up the size to the next list's lower bound so any entry of the found list is large enough*/
+    uint32_t size_up = (uint32_t)size;
+    if(size_up >= TLSF_SMALL_SIZE) size_up += (1UL << (31 - tlsf_clz(size_up) - TLSF_SL_LOG2)) - 1;
+
+    uint32_t fl;
+    uint32_t sl;
+    lv_mem_ent_t * e = NULL;
+    tlsf_mapping(size_up, &fl, &sl);
+    if(fl < TLSF_FL_CNT) e = tlsf_find(fl, sl);
+
+    if(e == NULL) {
+        /*Only the list of `size` might have a large enough entry. Check it to not waste the last bytes of the heap.*/
+        tlsf_mapping((uint32_t)size, &fl, &sl);
+        uint32_t ofs = tlsf_heads[fl][sl];
+        while(ofs != TLSF_NULL) {
+            lv_mem_ent_t * e_act = TLSF_ENT(ofs);
+            if(e_act->header.s.d_size >= size) {
+                e = e_act;
+                break;
+            }
+            ofs = TLSF_LINKS(e_act)[0];
+        }
+
+        if(e == NULL) return NULL;
+    }
+
+    tlsf_remove(e);
+
+    /*Give back the remaining part if it's large enough for a free entry*/
+    if(e->header.s.d_size >= size + sizeof(lv_mem_header_t) + TLSF_MIN_SIZE) {
+        lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size);
+        rest->header.s.prev_free = 0;
+        rest->header.s.d_size = (uint32_t)e->header.s.d_size - size - sizeof(lv_mem_header_t);
+        e->header.s.d_size = (uint32_t)size;
+        tlsf_insert(rest);
+    }
+    else {
+        lv_mem_ent_t * next = ent_get_next(e);
+        if(next) next->header.s.prev_free = 0;
+    }
+
+    e->header.s.used = 1;
+    tlsf_used_cnt++;
+
+    return &e->first_data;
+}
+
+/**
+ * Free an entry and join it with the adjacent free entries
+ * @param e pointer to a used entry
+ */
+static void tlsf_free(lv_mem_ent_t * e)
+{
+    tlsf_used_cnt--;
+
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next && next->header.s.used == 0) {
+        tlsf_remove(next);
+        e->header.s.d_size += next->header.s.d_size + sizeof(lv_mem_header_t);
+    }
+
+    if(e->header.s.prev_free) {
+        /*The previous free entry's size is stored in its last 4 bytes*/
+        uint32_t prev_size = *((uint32_t *)e - 1);
+        lv_mem_ent_t * prev = (lv_mem_ent_t *)((uint8_t *)e - prev_size - sizeof(lv_mem_header_t));
+        tlsf_remove(prev);
+        prev->header.s.d_size += e->header.s.d_size + sizeof(lv_mem_header_t);
+        e = prev;
+    }
+
+    tlsf_insert(e);
+}
+
+/**
+ * Add a free entry to the head of its list
+ * @param e pointer to an entry
+ */
+static void tlsf_insert(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    uint32_t d_size = e->header.s.d_size;
+    tlsf_mapping(d_size, &fl, &sl);
+
+    uint32_t * links = TLSF_LINKS(e);
+    links[0] = tlsf_heads[fl][sl];
+    links[1] = TLSF_NULL;
+    if(links[0] != TLSF_NULL) TLSF_LINKS(TLSF_ENT(links[0]))[1] = TLSF_OFS(e);
+    tlsf_heads[fl][sl] = TLSF_OFS(e);
+    tlsf_fl_bitmap |= 1UL << fl;
+    tlsf_sl_bitmap[fl] |= 1UL << sl;
+
+    /*Save the size in the last 4 bytes to let the next entry find this one*/
+    uint8_t * e8 = (uint8_t *)e;
+    *(uint32_t *)(e8 + sizeof(lv_mem_header_t) + d_size - sizeof(uint32_t)) = d_size;
+    e->header.s.used = 0;
+
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next) next->header.s.prev_free = 1;
+
+    tlsf_free_cnt++;
+    tlsf_free_size += d_size;
+}
+
+/**
+ * Remove a free entry from its list
+ * @param e pointer to a free entry
+ */
+static void tlsf_remove(lv_mem_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    uint32_t * links = TLSF_LINKS(e);
+    if(links[0] != TLSF_NULL) TLSF_LINKS(TLSF_ENT(links[0]))[1] = links[1];
+    if(links[1] != TLSF_NULL) {
+        TLSF_LINKS(TLSF_ENT(links[1]))[0] = links[0];
+    }
+    else {
+        tlsf_heads[fl][sl] = links[0];
+        if(links[0] == TLSF_NULL) {
+            tlsf_sl_bitmap[fl] &= ~(1UL << sl);
+            if(tlsf_sl_bitmap[fl] == 0) tlsf_fl_bitmap &= ~(1UL << fl);
+        }
+    }
+
+    tlsf_free_cnt--;
+    tlsf_free_size -= e->header.s.d_size;
+}
+
+/**
+ * Find a non-empty list from `[fl][sl]` upwards using the bitmaps
+ * @param fl first level index
+ * @param sl second level index
+ * @return the first entry of the found list or NULL if there is no such list
+ */
+static lv_mem_ent_t * tlsf_find(uint32_t fl, uint32_t sl)
+{
+    uint32_t sl_map = tlsf_sl_bitmap[fl] & (0xFFFFFFFFUL << sl);
+    if(sl_map == 0) {
+        uint32_t fl_map = tlsf_fl_bitmap & (0xFFFFFFFFUL << (fl + 1));
+        if(fl_map == 0) return NULL;
+
+        fl = tlsf_ctz(fl_map);
+        sl_map = tlsf_sl_bitmap[fl];
+    }
+
+    sl = tlsf_ctz(sl_map);
+    return TLSF_ENT(tlsf_heads[fl][sl]);
+}
+
+/**
+ * Get the list of a size
+ * @param size size of an entry's data
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size >> TLSF_ALIGN_LOG2;
+    }
+    else {
+        uint32_t msb = 31 - tlsf_clz(size);
+        *fl = msb - TLSF_FL_SHIFT + 1;
+        *sl = (size >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_CNT;
+    }
+}
+
+/**
+ * Count the leading zero bits
+ * @param x a non-zero value
+ * @return number of zero bits above the most significant 1
+ */
+static inline uint32_t tlsf_clz(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clz(x);
+#else
+    uint32_t n = 0;
+    while((x & 0x80000000UL) == 0) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * Count the trailing zero bits
+ * @param x a non-zero value
+ * @return number of zero bits below the least significant 1
+ */
+static inline uint32_t tlsf_ctz(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(x);
+#else
+    uint32_t n = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+#endif /*LV_MEM_TLSF*/
+
 #endif
@@ -24,6 +24,10 @@ extern "C" {
 #include <string.h>
 #endif
 
+#if LV_USE_TILE_RENDER
+#include LV_TILE_RENDER_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -32,6 +36,19 @@ extern "C" {
 #define LV_MEM_BUF_MAX_NUM    16
 #endif
 
+/*The draw-time scratch state (temporary buffers, masks) is kept separately for every rendering worker*/
+#if LV_USE_TILE_RENDER
+#define _LV_WORKER_NUM          LV_TILE_RENDER_WORKER_NUM
+#define _LV_WORKER_ID           (LV_TILE_RENDER_WORKER_ID)
+#define _LV_WORKER_LOCK()       LV_TILE_RENDER_LOCK
+#define _LV_WORKER_UNLOCK()     LV_TILE_RENDER_UNLOCK
+#else
+#define _LV_WORKER_NUM          1
+#define _LV_WORKER_ID           0
+#define _LV_WORKER_LOCK()       ((void)0)
+#define _LV_WORKER_UNLOCK()     ((void)0)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -50,13 +67,28 @@ typedef struct {
     uint8_t frag_pct; /**< Amount of fragmentation */
 } lv_mem_monitor_t;
 
+/**
+ * Information about the arena of the temporary buffers.
+ * With `LV_USE_TILE_RENDER` the largest value of the workers' arenas is used.
+ */
+typedef struct {
+    uint32_t total_size;   /**< Size of the arena */
+    uint32_t used;         /**< Currently used bytes */
+    uint32_t max_used;     /**< The high-water mark of the used bytes */
+    uint32_t fallback_cnt; /**< Number of buffers allocated from the heap because the arena was full */
+} lv_mem_buf_arena_stat_t;
+
 typedef struct {
     void * p;
     uint16_t size;
     uint8_t used    : 1;
 } lv_mem_buf_t;
 
+#if LV_USE_TILE_RENDER
+typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_TILE_RENDER_WORKER_NUM][LV_MEM_BUF_MAX_NUM];
+#else
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
+#endif
 extern lv_mem_buf_arr_t _lv_mem_buf;
 
 /**********************
@@ -138,6 +170,24 @@ void _lv_mem_buf_release(void * p);
  */
 void _lv_mem_buf_free_all(void);
 
+/**
+ * Get the current position of the temporary buffer arena
+ * @return a mark to pass to `_lv_mem_buf_arena_rewind()`
+ */
+uint32_t _lv_mem_buf_arena_get_mark(void);
+
+/**
+ * Release all the temporary buffers of the arena taken after a mark
+ * @param mark a mark from `_lv_mem_buf_arena_get_mark()`
+ */
+void _lv_mem_buf_arena_rewind(uint32_t mark);
+
+/**
+ * Get the statistics of the temporary buffer arena
+ * @param stat store the statistics here. All fields are 0 if the arena is disabled.
+ */
+void lv_mem_buf_arena_get_stat(lv_mem_buf_arena_stat_t * stat);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -1,6 +1,8 @@
 CSRCS += lv_area.c
 CSRCS += lv_task.c
 CSRCS += lv_fs.c
+CSRCS += lv_fs_posix.c
+CSRCS += lv_fs_pack.c
 CSRCS += lv_anim.c
 CSRCS += lv_mem.c
 CSRCS += lv_ll.c
@@ -15,6 +17,7 @@ CSRCS += lv_async.c
 CSRCS += lv_printf.c
 CSRCS += lv_bidi.c
 CSRCS += lv_debug.c
+CSRCS += lv_profiler.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_misc
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_misc
@@ -0,0 +1,274 @@
+/**
+ * @file lv_profiler.c
+ * Record the time spent in the phases of the refreshing.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+#if LV_USE_PROFILER
+
+#include "lv_mem.h"
+#include "lv_printf.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void add_event(lv_profiler_phase_t phase, const char * name, uint32_t start, uint32_t dur, uint32_t worker);
+static const lv_profiler_event_t * get_event(uint32_t id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_profiler_event_t events[LV_PROFILER_EVENT_CNT];
+static uint32_t event_next;     /*Index of the next event to write*/
+static uint32_t event_cnt;
+static uint32_t frame_act;      /*ID of the current or last frame*/
+static uint32_t frame_last;     /*ID of the last finished frame*/
+static uint32_t frame_start;
+static bool frame_running;
+static uint32_t acc[_LV_WORKER_NUM][_LV_PROFILER_PHASE_NUM];
+
+static const char * phase_names[_LV_PROFILER_PHASE_NUM] = {
+    "frame", "join", "refr_obj", "design", "blend", "mask", "flush", "cache"
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start a new frame. Called when a display starts to refresh.
+ */
+void _lv_profiler_frame_begin(void)
+{
+    frame_act++;
+    frame_start = (uint32_t)(LV_PROFILER_TIME_GET);
+    frame_running = true;
+    _lv_memset_00(acc, sizeof(acc));
+}
+
+/**
+ * Finish the current frame and record its length and the summed up blend and mask times
+ */
+void _lv_profiler_frame_end(void)
+{
+    if(!frame_running) return;
+
+    uint32_t end = (uint32_t)(LV_PROFILER_TIME_GET);
+    _lv_profiler_add(LV_PROFILER_PHASE_FRAME, "frame", frame_start, end);
+
+    /*The summed up phases are shown as they were at the beginning of the frame*/
+    lv_profiler_phase_t phase;
+    for(phase = LV_PROFILER_PHASE_BLEND; phase <= LV_PROFILER_PHASE_MASK; phase++) {
+        uint32_t w;
+        for(w = 0; w < _LV_WORKER_NUM; w++) {
+            if(acc[w][phase]) add_event(phase, phase_names[phase], frame_start, acc[w][phase], w);
+        }
+    }
+
+    frame_running = false;
+    frame_last = frame_act;
+}
+
+/**
+ * Record an event in the ring buffer. The oldest events are overwritten.
+ * @param phase the phase of the event
+ * @param name name of the event. Should be a constant string.
+ * @param start start time of the event
+ * @param end end time of the event
+ */
+void _lv_profiler_add(lv_profiler_phase_t phase, const char * name, uint32_t start, uint32_t end)
+{
+    add_event(phase, name ? name : phase_names[phase], start, end - start, _LV_WORKER_ID);
+}
+
+/**
+ * Add time to a phase which is summed up in the frame (e.g. blending)
+ * @param phase the phase
+ * @param start start time of the measured part
+ * @param end end time of the measured part
+ */
+void _lv_profiler_acc(lv_profiler_phase_t phase, uint32_t start, uint32_t end)
+{
+    /*Every worker has its own counters so no locking is required*/
+    acc[_LV_WORKER_ID][phase] += end - start;
+}
+
+/**
+ * Get the number of the recorded events
+ * @return number of events in the ring buffer
+ */
+uint32_t lv_profiler_get_event_cnt(void)
+{
+    return event_cnt;
+}
+
+/**
+ * Get a recorded event
+ * @param id index of the event. 0: the oldest
+ * @param event store the event here
+ * @return true: `event` is filled; false: `id` is out of range
+ */
+bool lv_profiler_get_event(uint32_t id, lv_profiler_event_t * event)
+{
+    _LV_WORKER_LOCK();
+    const lv_profiler_event_t * e = get_event(id);
+    if(e) *event = *e;
+    _LV_WORKER_UNLOCK();
+
+    return e != NULL;
+}
+
+/**
+ * Get the ID of the last finished frame
+ * @return the frame ID (0: no frame was finished yet)
+ */
+uint32_t lv_profiler_get_last_frame(void)
+{
+    return frame_last;
+}
+
+/**
+ * Sum the durations of the recorded events of a frame
+ * @param frame ID of a frame or `LV_PROFILER_FRAME_LAST`
+ * @param phase the phase to sum up
+ * @param name sum only the events with this name (e.g. "lv_btn") or NULL to sum all
+ * @return the summed up time
+ */
+uint32_t lv_profiler_get_sum(uint32_t frame, lv_profiler_phase_t phase, const char * name)
+{
+    if(frame == LV_PROFILER_FRAME_LAST) frame = frame_last;
+
+    uint32_t sum = 0;
+    uint32_t i;
+    _LV_WORKER_LOCK();
+    for(i = 0; i < event_cnt; i++) {
+        const lv_profiler_event_t * e = get_event(i);
+        if(e->frame != frame || e->phase != phase) continue;
+        if(name && strcmp(name, e->name) != 0) continue;
+        sum += e->dur;
+    }
+    _LV_WORKER_UNLOCK();
+
+    return sum;
+}
+
+/**
+ * Count the recorded events of a frame (e.g. the cache hits)
+ * @param frame ID of a frame or `LV_PROFILER_FRAME_LAST`
+ * @param phase the phase of the events
+ * @param name count only the events with this name (e.g. "radius_cache_hit") or NULL to count all
+ * @return number of events
+ */
+uint32_t lv_profiler_get_cnt(uint32_t frame, lv_profiler_phase_t phase, const char * name)
+{
+    if(frame == LV_PROFILER_FRAME_LAST) frame = frame_last;
+
+    uint32_t cnt = 0;
+    uint32_t i;
+    _LV_WORKER_LOCK();
+    for(i = 0; i < event_cnt; i++) {
+        const lv_profiler_event_t * e = get_event(i);
+        if(e->frame != frame || e->phase != phase) continue;
+        if(name && strcmp(name, e->name) != 0) continue;
+        cnt++;
+    }
+    _LV_WORKER_UNLOCK();
+
+    return cnt;
+}
+
+/**
+ * Remove all the recorded events
+ */
+void lv_profiler_clear(void)
+{
+    _LV_WORKER_LOCK();
+    event_next = 0;
+    event_cnt = 0;
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Write the recorded events in Chrome trace-event JSON format (can be opened in `chrome://tracing`)
+ * @param write_cb called with the consecutive parts of the JSON
+ * @param user_data passed to `write_cb`
+ */
+void lv_profiler_dump_trace(lv_profiler_write_cb_t write_cb, void * user_data)
+{
+    char buf[192];
+    uint32_t i;
+
+    write_cb("{\"traceEvents\":[\n", user_data);
+
+    _LV_WORKER_LOCK();
+    for(i = 0; i < event_cnt; i++) {
+        const lv_profiler_event_t * e = get_event(i);
+        lv_snprintf(buf, sizeof(buf),
+                    "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":0,\"tid\":%u,"
+                    "\"args\":{\"frame\":%u}}\n",
+                    i == 0 ? "" : ",", e->name, phase_names[e->phase], (unsigned int)e->start, (unsigned int)e->dur,
+                    (unsigned int)e->worker, (unsigned int)e->frame);
+        write_cb(buf, user_data);
+    }
+    _LV_WORKER_UNLOCK();
+
+    write_cb("],\"displayTimeUnit\":\"ms\"}\n", user_data);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Write an event into the ring buffer
+ * @param phase the phase of the event
+ * @param name name of the event
+ * @param start start time of the event
+ * @param dur duration of the event
+ * @param worker ID of the worker which recorded the event
+ */
+static void add_event(lv_profiler_phase_t phase, const char * name, uint32_t start, uint32_t dur, uint32_t worker)
+{
+    _LV_WORKER_LOCK();
+    lv_profiler_event_t * e = &events[event_next];
+    e->name = name;
+    e->start = start;
+    e->dur = dur;
+    e->frame = frame_act;
+    e->phase = phase;
+    e->worker = (uint8_t)worker;
+    event_next = (event_next + 1) % LV_PROFILER_EVENT_CNT;
+    if(event_cnt < LV_PROFILER_EVENT_CNT) event_cnt++;
+    _LV_WORKER_UNLOCK();
+}
+
+/**
+ * Get an event from the ring buffer
+ * @param id index of the event. 0: the oldest
+ * @return pointer to the event or NULL if `id` is out of range
+ */
+static const lv_profiler_event_t * get_event(uint32_t id)
+{
+    if(id >= event_cnt) return NULL;
+
+    uint32_t first = (event_next + LV_PROFILER_EVENT_CNT - event_cnt) % LV_PROFILER_EVENT_CNT;
+    return &events[(first + id) % LV_PROFILER_EVENT_CNT];
+}
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,171 @@
+/**
+ * @file lv_profiler.h
+ * Record the time spent in the phases of the refreshing.
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_PROFILER
+#include "../lv_hal/lv_hal_tick.h"
+#include LV_PROFILER_TIME_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Use the ID of the last finished frame in `lv_profiler_get_sum()`*/
+#define LV_PROFILER_FRAME_LAST  0xFFFFFFFF
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The measured phases of the refreshing*/
+enum {
+    LV_PROFILER_PHASE_FRAME,    /**< A whole refresh of a display*/
+    LV_PROFILER_PHASE_JOIN,     /**< Joining the invalidated areas*/
+    LV_PROFILER_PHASE_REFR_OBJ, /**< Drawing an object and its children (`lv_refr_obj_and_children`)*/
+    LV_PROFILER_PHASE_DESIGN,   /**< A design callback. The name is the type of the object.*/
+    LV_PROFILER_PHASE_BLEND,    /**< Blending in the frame (summed up)*/
+    LV_PROFILER_PHASE_MASK,     /**< Applying the masks in the frame (summed up)*/
+    LV_PROFILER_PHASE_FLUSH,    /**< Calling the `flush_cb`*/
+    LV_PROFILER_PHASE_CACHE,    /**< Looking up a cache. The name tells the cache and whether it was a hit or a miss.*/
+    _LV_PROFILER_PHASE_NUM
+};
+typedef uint8_t lv_profiler_phase_t;
+
+/** A recorded event. The times are in `LV_PROFILER_TIME_GET` units (microseconds)*/
+typedef struct {
+    const char * name;   /**< Name of the event (e.g. the object type)*/
+    uint32_t start;      /**< Start time*/
+    uint32_t dur;        /**< Duration*/
+    uint32_t frame;      /**< ID of the frame*/
+    lv_profiler_phase_t phase;
+    uint8_t worker;      /**< The rendering worker's ID (0 without `LV_USE_TILE_RENDER`)*/
+} lv_profiler_event_t;
+
+/** Called with the consecutive parts of the trace JSON*/
+typedef void (*lv_profiler_write_cb_t)(const char * str, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_USE_PROFILER
+
+/**
+ * Start a new frame. Called when a display starts to refresh.
+ */
+void _lv_profiler_frame_begin(void);
+
+/**
+ * Finish the current frame and record its length and the summed up blend and mask times
+ */
+void _lv_profiler_frame_end(void);
+
+/**
+ * Record an event in the ring buffer. The oldest events are overwritten.
+ * @param phase the phase of the event
+ * @param name name of the event. Should be a constant string.
+ * @param start start time of the event
+ * @param end end time of the event
+ */
+void _lv_profiler_add(lv_profiler_phase_t phase, const char * name, uint32_t start, uint32_t end);
+
+/**
+ * Add time to a phase which is summed up in the frame (e.g. blending)
+ * @param phase the phase
+ * @param start start time of the measured part
+ * @param end end time of the measured part
+ */
+void _lv_profiler_acc(lv_profiler_phase_t phase, uint32_t start, uint32_t end);
+
+/**
+ * Get the number of the recorded events
+ * @return number of events in the ring buffer
+ */
+uint32_t lv_profiler_get_event_cnt(void);
+
+/**
+ * Get a recorded event
+ * @param id index of the event. 0: the oldest
+ * @param event store the event here
+ * @return true: `event` is filled; false: `id` is out of range
+ */
+bool lv_profiler_get_event(uint32_t id, lv_profiler_event_t * event);
+
+/**
+ * Get the ID of the last finished frame
+ * @return the frame ID (0: no frame was finished yet)
+ */
+uint32_t lv_profiler_get_last_frame(void);
+
+/**
+ * Sum the durations of the recorded events of a frame
+ * @param frame ID of a frame or `LV_PROFILER_FRAME_LAST`
+ * @param phase the phase to sum up
+ * @param name sum only the events with this name (e.g. "lv_btn") or NULL to sum all
+ * @return the summed up time
+ */
+uint32_t lv_profiler_get_sum(uint32_t frame, lv_profiler_phase_t phase, const char * name);
+
+/**
+ * Count the recorded events of a frame (e.g. the cache hits)
+ * @param frame ID of a frame or `LV_PROFILER_FRAME_LAST`
+ * @param phase the phase of the events
+ * @param name count only the events with this name (e.g. "radius_cache_hit") or NULL to count all
+ * @return number of events
+ */
+uint32_t lv_profiler_get_cnt(uint32_t frame, lv_profiler_phase_t phase, const char * name);
+
+/**
+ * Remove all the recorded events
+ */
+void lv_profiler_clear(void);
+
+/**
+ * Write the recorded events in Chrome trace-event JSON format (can be opened in `chrome://tracing`)
+ * @param write_cb called with the consecutive parts of the JSON
+ * @param user_data passed to `write_cb`
+ */
+void lv_profiler_dump_trace(lv_profiler_write_cb_t write_cb, void * user_data);
+
+#endif /*LV_USE_PROFILER*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#if LV_USE_PROFILER
+#define LV_PROFILER_BEGIN(var)              uint32_t var = (uint32_t)(LV_PROFILER_TIME_GET)
+#define LV_PROFILER_END(var, phase, name)   _lv_profiler_add(phase, name, var, (uint32_t)(LV_PROFILER_TIME_GET))
+#define LV_PROFILER_ACC(var, phase)         _lv_profiler_acc(phase, var, (uint32_t)(LV_PROFILER_TIME_GET))
+#define LV_PROFILER_FRAME_BEGIN()           _lv_profiler_frame_begin()
+#define LV_PROFILER_FRAME_END()             _lv_profiler_frame_end()
+#else
+#define LV_PROFILER_BEGIN(var)
+#define LV_PROFILER_END(var, phase, name)   ((void)0)
+#define LV_PROFILER_ACC(var, phase)         ((void)0)
+#define LV_PROFILER_FRAME_BEGIN()           ((void)0)
+#define LV_PROFILER_FRAME_END()             ((void)0)
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROFILER_H*/
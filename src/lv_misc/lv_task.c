@@ -19,6 +19,7 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PRIO LV_TASK_PRIO_MID
 #define DEF_PERIOD 500
+#define HEAP_GROW_STEP 8
 
 /**********************
  *      TYPEDEFS
@@ -29,6 +30,17 @@
  **********************/
 static bool lv_task_exec(lv_task_t * task);
 static uint32_t lv_task_time_remaining(lv_task_t * task);
+#if LV_USE_TASK_HEAP
+    static uint32_t heap_handler(void);
+    static bool heap_reserve(lv_task_prio_t prio);
+    static bool heap_ins(lv_task_t * task, bool ran);
+    static bool heap_remove(lv_task_t * task);
+    static void heap_update(lv_task_t * task);
+    static void heap_restore(void);
+    static void heap_sift_up(_lv_task_heap_t * h, uint16_t id);
+    static void heap_sift_down(_lv_task_heap_t * h, uint16_t id);
+    static void heap_place(_lv_task_heap_t * h, lv_task_t * task, uint16_t id);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -53,6 +65,9 @@ static bool task_created;
 void _lv_task_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_task_ll), sizeof(lv_task_t));
+#if LV_USE_TASK_HEAP
+    _lv_memset_00(LV_GC_ROOT(_lv_task_heap), sizeof(LV_GC_ROOT(_lv_task_heap)));
+#endif
 
     /*Initially enable the lv_task handling*/
     lv_task_enable(true);
@@ -81,6 +96,9 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
 
     uint32_t handler_start = lv_tick_get();
 
+#if LV_USE_TASK_HEAP
+    uint32_t time_till_next = heap_handler();
+#else
     /* Run all task from the highest to the lowest priority
      * If a lower priority task is executed check task again from the highest priority
      * but on the priority of executed tasks don't run tasks before the executed*/
@@ -165,6 +183,7 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
 
         next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), next); /*Find the next task*/
     }
+#endif
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -244,6 +263,14 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
 
     new_task->user_data = user_data;
 
+#if LV_USE_TASK_HEAP
+    if(heap_ins(new_task, false) == false) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_task_ll), new_task);
+        lv_mem_free(new_task);
+        return NULL;
+    }
+#endif
+
     task_created = true;
 
     return new_task;
@@ -265,6 +292,10 @@ void lv_task_set_cb(lv_task_t * task, lv_task_cb_t task_cb)
  */
 void lv_task_del(lv_task_t * task)
 {
+#if LV_USE_TASK_HEAP
+    heap_remove(task);
+#endif
+
     _lv_ll_remove(&LV_GC_ROOT(_lv_task_ll), task);
     task_list_changed = true;
 
@@ -282,6 +313,14 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 {
     if(task->prio == prio) return;
 
+#if LV_USE_TASK_HEAP
+    /*Make room in the new heap first to keep the task scheduled with the old priority if there is no memory*/
+    if(heap_reserve(prio) == false) {
+        LV_LOG_WARN("lv_task_set_prio: out of memory, the priority is not changed");
+        return;
+    }
+#endif
+
     /*Find the tasks with new priority*/
     lv_task_t * i;
     _LV_LL_READ(LV_GC_ROOT(_lv_task_ll), i) {
@@ -297,7 +336,14 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
     }
     task_list_changed = true;
 
+#if LV_USE_TASK_HEAP
+    /*A task which already ran in this `lv_task_handler()` call shouldn't run again*/
+    bool ran = heap_remove(task);
+    task->prio = prio;
+    heap_ins(task, ran);
+#else
     task->prio = prio;
+#endif
 }
 
 /**
@@ -308,6 +354,9 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 void lv_task_set_period(lv_task_t * task, uint32_t period)
 {
     task->period = period;
+#if LV_USE_TASK_HEAP
+    heap_update(task);
+#endif
 }
 
 /**
@@ -317,6 +366,9 @@ void lv_task_set_period(lv_task_t * task, uint32_t period)
 void lv_task_ready(lv_task_t * task)
 {
     task->last_run = lv_tick_get() - task->period - 1;
+#if LV_USE_TASK_HEAP
+    heap_update(task);
+#endif
 }
 
 /**
@@ -337,6 +389,9 @@ void lv_task_set_repeat_count(lv_task_t * task, int32_t repeat_count)
 void lv_task_reset(lv_task_t * task)
 {
     task->last_run = lv_tick_get();
+#if LV_USE_TASK_HEAP
+    heap_update(task);
+#endif
 }
 
 /**
@@ -413,3 +468,227 @@ static uint32_t lv_task_time_remaining(lv_task_t * task)
         return 0;
     return task->period - elp;
 }
+
+#if LV_USE_TASK_HEAP
+
+/**
+ * Run the ready tasks using the heaps of the priorities.
+ * Always the first ready task of the highest priority runs and it's moved after the heap part
+ * so every task runs at most once in a `lv_task_handler()` call.
+ * @return the time till the next task needs to run
+ */
+static uint32_t heap_handler(void)
+{
+    _lv_task_heap_t * heaps = LV_GC_ROOT(_lv_task_heap);
+
+    while(1) {
+        int32_t p;
+        for(p = LV_TASK_PRIO_HIGHEST; p > LV_TASK_PRIO_OFF; p--) {
+            if(heaps[p].act > 0 && lv_task_time_remaining(heaps[p].tasks[0]) == 0) break;
+        }
+        if(p == LV_TASK_PRIO_OFF) break;
+
+        /*Move the task to the ran tasks by swapping it with the last task of the heap*/
+        _lv_task_heap_t * h = &heaps[p];
+        lv_task_t * task = h->tasks[0];
+        h->act--;
+        heap_place(h, h->tasks[h->act], 0);
+        heap_place(h, task, h->act);
+        heap_sift_down(h, 0);
+
+        task_deleted = false;
+        LV_GC_ROOT(_lv_task_act) = task;
+        lv_task_exec(task);
+    }
+
+    LV_GC_ROOT(_lv_task_act) = NULL;
+    heap_restore();
+
+    uint32_t time_till_next = LV_NO_TASK_READY;
+    int32_t p;
+    for(p = LV_TASK_PRIO_HIGHEST; p > LV_TASK_PRIO_OFF; p--) {
+        if(heaps[p].cnt == 0) continue;
+        uint32_t delay = lv_task_time_remaining(heaps[p].tasks[0]);
+        if(delay < time_till_next) time_till_next = delay;
+    }
+
+    return time_till_next;
+}
+
+/**
+ * Make sure there is room for one more task in the heap of a priority
+ * @param prio the priority
+ * @return false: out of memory
+ */
+static bool heap_reserve(lv_task_prio_t prio)
+{
+    if(prio == LV_TASK_PRIO_OFF) return true;
+
+    _lv_task_heap_t * h = &LV_GC_ROOT(_lv_task_heap)[prio];
+    if(h->cnt < h->size) return true;
+
+    lv_task_t ** tasks = lv_mem_realloc(h->tasks, (h->size + HEAP_GROW_STEP) * sizeof(lv_task_t *));
+    LV_ASSERT_MEM(tasks);
+    if(tasks == NULL) return false;
+    h->tasks = tasks;
+    h->size += HEAP_GROW_STEP;
+
+    return true;
+}
+
+/**
+ * Add a task to the heap of its priority
+ * @param task pointer to a task
+ * @param ran true: add it to the tasks which already ran in this `lv_task_handler()` call
+ * @return false: out of memory
+ */
+static bool heap_ins(lv_task_t * task, bool ran)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return true;
+
+    if(heap_reserve(task->prio) == false) return false;
+
+    _lv_task_heap_t * h = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    if(ran) {
+        heap_place(h, task, h->cnt);
+        h->cnt++;
+    }
+    else {
+        /*Make room in the heap by moving the first ran task to the end*/
+        if(h->act < h->cnt) heap_place(h, h->tasks[h->act], h->cnt);
+        heap_place(h, task, h->act);
+        h->cnt++;
+        h->act++;
+        heap_sift_up(h, task->heap_id);
+    }
+
+    return true;
+}
+
+/**
+ * Remove a task from the heap of its priority
+ * @param task pointer to a task
+ * @return true: the task already ran in this `lv_task_handler()` call
+ */
+static bool heap_remove(lv_task_t * task)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return false;
+
+    _lv_task_heap_t * h = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    uint16_t id = task->heap_id;
+    bool ran = id >= h->act;
+
+    if(ran == false) {
+        /*Fill the hole with the last task of the heap, then the heap's last place with the last ran task*/
+        h->act--;
+        if(id != h->act) {
+            lv_task_t * moved = h->tasks[h->act];
+            heap_place(h, moved, id);
+            heap_sift_up(h, id);
+            heap_sift_down(h, moved->heap_id);
+        }
+        id = h->act;
+    }
+
+    h->cnt--;
+    if(id != h->cnt) heap_place(h, h->tasks[h->cnt], id);
+
+    if(h->cnt == 0) {
+        lv_mem_free(h->tasks);
+        h->tasks = NULL;
+        h->size = 0;
+    }
+
+    return ran;
+}
+
+/**
+ * Move a task to its new place in the heap after its period or last run has changed
+ * @param task pointer to a task
+ */
+static void heap_update(lv_task_t * task)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return;
+
+    _lv_task_heap_t * h = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    if(task->heap_id >= h->act) return; /*It will be sorted when the ran tasks are added back*/
+
+    heap_sift_up(h, task->heap_id);
+    heap_sift_down(h, task->heap_id);
+}
+
+/**
+ * Add the tasks which ran in this `lv_task_handler()` call back to the heaps
+ */
+static void heap_restore(void)
+{
+    int32_t p;
+    for(p = LV_TASK_PRIO_HIGHEST; p > LV_TASK_PRIO_OFF; p--) {
+        _lv_task_heap_t * h = &LV_GC_ROOT(_lv_task_heap)[p];
+        while(h->act < h->cnt) {
+            h->act++;
+            heap_sift_up(h, h->act - 1);
+        }
+    }
+}
+
+/**
+ * Move a task towards the top of the heap while it needs to run earlier than its parent
+ * @param h pointer to a heap
+ * @param id index of the task
+ */
+static void heap_sift_up(_lv_task_heap_t * h, uint16_t id)
+{
+    lv_task_t * task = h->tasks[id];
+    uint32_t rem = lv_task_time_remaining(task);
+    while(id > 0) {
+        uint16_t parent = (id - 1) / 2;
+        if(lv_task_time_remaining(h->tasks[parent]) <= rem) break;
+        heap_place(h, h->tasks[parent], id);
+        id = parent;
+    }
+    heap_place(h, task, id);
+}
+
+/**
+ * Move a task towards the bottom of the heap while a child needs to run earlier
+ * @param h pointer to a heap
+ * @param id index of the task
+ */
+static void heap_sift_down(_lv_task_heap_t * h, uint16_t id)
+{
+    lv_task_t * task = h->tasks[id];
+    uint32_t rem = lv_task_time_remaining(task);
+    while(1) {
+        uint32_t child = 2 * (uint32_t)id + 1;
+        if(child >= h->act) break;
+
+        uint32_t child_rem = lv_task_time_remaining(h->tasks[child]);
+        if(child + 1 < h->act) {
+            uint32_t right_rem = lv_task_time_remaining(h->tasks[child + 1]);
+            if(right_rem < child_rem) {
+                child++;
+                child_rem = right_rem;
+            }
+        }
+        if(rem <= child_rem) break;
+
+        heap_place(h, h->tasks[child], id);
+        id = child;
+    }
+    heap_place(h, task, id);
+}
+
+/**
+ * Store a task in the given place of the heap
+ * @param h pointer to a heap
+ * @param task pointer to a task
+ * @param id index where the task should be stored
+ */
+static void heap_place(_lv_task_heap_t * h, lv_task_t * task, uint16_t id)
+{
+    h->tasks[id] = task;
+    task->heap_id = id;
+}
+
+#endif /*LV_USE_TASK_HEAP*/
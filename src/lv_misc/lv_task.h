@@ -66,8 +66,23 @@ typedef struct _lv_task_t {
 
     int32_t repeat_count; /**< 1: Task times;  -1 : infinity;  0 : stop ;  n>0: residual times */
     uint8_t prio : 3; /**< Task priority */
+#if LV_USE_TASK_HEAP
+    uint16_t heap_id; /**< Index of the task in the heap of its priority */
+#endif
 } lv_task_t;
 
+/**
+ * The tasks of a priority ordered by their next run (used with `LV_USE_TASK_HEAP`)
+ */
+typedef struct {
+    lv_task_t ** tasks;
+    uint16_t cnt;   /**< Number of tasks */
+    uint16_t act;   /**< The first `act` tasks are a min-heap, the others already ran in this `lv_task_handler()` call */
+    uint16_t size;  /**< Allocated size of `tasks` */
+} _lv_task_heap_t;
+
+typedef _lv_task_heap_t _lv_task_heap_arr_t[_LV_TASK_PRIO_NUM];
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
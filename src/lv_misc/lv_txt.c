@@ -12,12 +12,16 @@
 #include "lv_math.h"
 #include "lv_log.h"
 #include "lv_debug.h"
+#include "lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+/*Only these flags have effect on the line breaks and widths*/
+#define LINES_FLAG_MASK (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -524,6 +528,159 @@ char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap)
     return text;
 }
 
+/**
+ * Initialize a line index
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_init(lv_txt_lines_t * lines)
+{
+    _lv_memset_00(lines, sizeof(lv_txt_lines_t));
+}
+
+/**
+ * Check if a line index can be used for a text with the given parameters
+ * @param lines pointer to a line index
+ * @param font pointer to the font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line index is valid for these parameters
+ */
+bool _lv_txt_lines_is_valid(const lv_txt_lines_t * lines, const lv_font_t * font, lv_coord_t letter_space,
+                            lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    /*The max. width has no effect on the line breaks in these cases*/
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    return lines->valid && lines->font == font && lines->letter_space == letter_space &&
+           lines->max_w == max_width && lines->flag == (flag & LINES_FLAG_MASK);
+}
+
+/**
+ * Rebuild a line index if it's not valid for the given parameters
+ * @param lines pointer to a line index
+ * @param txt a '\0' terminated string
+ * @param font pointer to the font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line index is valid; false: out of memory
+ */
+bool _lv_txt_lines_update(lv_txt_lines_t * lines, const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(_lv_txt_lines_is_valid(lines, font, letter_space, max_width, flag)) return true;
+
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+    flag &= LINES_FLAG_MASK;
+
+    lines->valid = 0;
+    lines->line_cnt = 0;
+    lines->w = 0;
+
+    uint32_t line_start = 0;
+    while(txt[line_start] != '\0') {
+        if(lines->line_cnt >= lines->line_cap) {
+            uint32_t new_cap = lines->line_cap ? lines->line_cap * 2 : 8;
+            lv_txt_line_t * new_lines = lv_mem_realloc(lines->lines, new_cap * sizeof(lv_txt_line_t));
+            LV_ASSERT_MEM(new_lines);
+            if(new_lines == NULL) return false;
+            lines->lines = new_lines;
+            lines->line_cap = new_cap;
+        }
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, flag);
+        lv_txt_line_t * line = &lines->lines[lines->line_cnt];
+        line->start = line_start;
+        line->w = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        lines->w = LV_MATH_MAX(lines->w, line->w);
+        lines->line_cnt++;
+
+        line_start = line_end;
+    }
+
+    lines->end = line_start;
+    lines->font = font;
+    lines->letter_space = letter_space;
+    lines->max_w = max_width;
+    lines->flag = flag;
+    lines->valid = 1;
+
+    return true;
+}
+
+/**
+ * Get the size of a text from its line index. Gives the same result as `_lv_txt_get_size()`.
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param lines pointer to a valid line index
+ * @param txt the text of the line index
+ * @param line_space line space of the text
+ */
+void _lv_txt_lines_get_size(lv_point_t * size_res, const lv_txt_lines_t * lines, const char * txt,
+                            lv_coord_t line_space)
+{
+    int32_t letter_height = lv_font_get_line_height(lines->font);
+    int32_t h = (int32_t)lines->line_cnt * (letter_height + line_space);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((lines->end != 0) && (txt[lines->end - 1] == '\n' || txt[lines->end - 1] == '\r')) {
+        h += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(h == 0) h = letter_height;
+    else h -= line_space;
+
+    if(h > (int32_t)LV_MAX_OF(lv_coord_t)) {
+        LV_LOG_WARN("_lv_txt_lines_get_size: integer overflow while calculating text height");
+        h = (int32_t)LV_MAX_OF(lv_coord_t);
+    }
+
+    size_res->x = lines->w;
+    size_res->y = (lv_coord_t)h;
+}
+
+/**
+ * Mark a line index invalid. Should be called when the text changes.
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_invalidate(lv_txt_lines_t * lines)
+{
+    lines->valid = 0;
+}
+
+/**
+ * Free the memory of a line index
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_free(lv_txt_lines_t * lines)
+{
+    lv_mem_free(lines->lines);
+    _lv_txt_lines_init(lines);
+}
+
+/**
+ * Find the line which contains a byte position
+ * @param lines pointer to a valid line index
+ * @param byte_id a byte index in the text
+ * @return index of the line (0 if the text is empty)
+ */
+uint32_t _lv_txt_lines_find(const lv_txt_lines_t * lines, uint32_t byte_id)
+{
+    if(lines->line_cnt == 0) return 0;
+
+    /*Binary search for the last line starting before `byte_id`*/
+    uint32_t min = 0;
+    uint32_t max = lines->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(lines->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -56,6 +56,32 @@ enum {
 };
 typedef uint8_t lv_txt_cmd_state_t;
 
+/** A line in `lv_txt_lines_t`*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    lv_coord_t w;       /**< Width of the line*/
+} lv_txt_line_t;
+
+/**
+ * Index of the line breaks of a text.
+ * The lines can be found by index or byte position without measuring the text again.
+ * The `y` coordinate of the lines is `line_id * (line_height + line_space)`.
+ * Valid while the text, the font, the letter space, the max. width and the `RECOLOR`, `EXPAND`, `FIT` flags are the same.
+ * (With `EXPAND` or `FIT` the max. width is ignored.)
+ */
+typedef struct {
+    lv_txt_line_t * lines;  /**< The lines (allocated)*/
+    uint32_t line_cnt;
+    uint32_t line_cap;      /**< Number of allocated lines*/
+    uint32_t end;           /**< Byte index of the end of the last line*/
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_w;
+    lv_coord_t w;           /**< Width of the longest line*/
+    lv_txt_flag_t flag;
+    uint8_t valid : 1;
+} lv_txt_lines_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -135,6 +161,78 @@ void _lv_txt_cut(char * txt, uint32_t pos, uint32_t len);
  */
 char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap);
 
+/**
+ * Initialize a line index
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_init(lv_txt_lines_t * lines);
+
+/**
+ * Check if a line index can be used for a text with the given parameters
+ * @param lines pointer to a line index
+ * @param font pointer to the font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line index is valid for these parameters
+ */
+bool _lv_txt_lines_is_valid(const lv_txt_lines_t * lines, const lv_font_t * font, lv_coord_t letter_space,
+                            lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Rebuild a line index if it's not valid for the given parameters
+ * @param lines pointer to a line index
+ * @param txt a '\0' terminated string
+ * @param font pointer to the font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max width of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line index is valid; false: out of memory
+ */
+bool _lv_txt_lines_update(lv_txt_lines_t * lines, const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                          lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Get the size of a text from its line index. Gives the same result as `_lv_txt_get_size()`.
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param lines pointer to a valid line index
+ * @param txt the text of the line index
+ * @param line_space line space of the text
+ */
+void _lv_txt_lines_get_size(lv_point_t * size_res, const lv_txt_lines_t * lines, const char * txt,
+                            lv_coord_t line_space);
+
+/**
+ * Mark a line index invalid. Should be called when the text changes.
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_invalidate(lv_txt_lines_t * lines);
+
+/**
+ * Free the memory of a line index
+ * @param lines pointer to a line index
+ */
+void _lv_txt_lines_free(lv_txt_lines_t * lines);
+
+/**
+ * Find the line which contains a byte position
+ * @param lines pointer to a valid line index
+ * @param byte_id a byte index in the text
+ * @return index of the line (0 if the text is empty)
+ */
+uint32_t _lv_txt_lines_find(const lv_txt_lines_t * lines, uint32_t byte_id);
+
+/**
+ * Get the byte index of the end of a line (the start of the next line)
+ * @param lines pointer to a valid line index
+ * @param line_id index of a line
+ * @return the byte index after the last character of the line
+ */
+static inline uint32_t _lv_txt_lines_get_end(const lv_txt_lines_t * lines, uint32_t line_id)
+{
+    return line_id + 1 < lines->line_cnt ? lines->lines[line_id + 1].start : lines->end;
+}
+
 /***************************************************************
  *  GLOBAL FUNCTION POINTERS FOR CHARACTER ENCODING INTERFACE
  ***************************************************************/
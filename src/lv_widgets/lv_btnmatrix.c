@@ -628,14 +628,24 @@ lv_label_align_t lv_btnmatrix_get_align(const lv_obj_t * btnm)
 static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * clip_area, lv_design_mode_t mode)
 {
     if(mode == LV_DESIGN_COVER_CHK) {
-        return ancestor_design_f(btnm, clip_area, mode);
+        /*An other worker might be drawing the buttons in a changed state*/
+        _LV_WORKER_LOCK();
+        lv_design_res_t res = ancestor_design_f(btnm, clip_area, mode);
+        _LV_WORKER_UNLOCK();
+        return res;
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*The state of the button matrix is changed temporarily to get the styles of the buttons.
+         *Don't let the other workers rendering the tiles see it.*/
+        _LV_WORKER_LOCK();
         ancestor_design_f(btnm, clip_area, mode);
 
         lv_btnmatrix_ext_t * ext         = lv_obj_get_ext_attr(btnm);
-        if(ext->btn_cnt == 0) return LV_DESIGN_RES_OK;
+        if(ext->btn_cnt == 0) {
+            _LV_WORKER_UNLOCK();
+            return LV_DESIGN_RES_OK;
+        }
         lv_area_t area_btnm;
         lv_obj_get_coords(btnm, &area_btnm);
 
@@ -824,9 +834,12 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
 #if LV_USE_ARABIC_PERSIAN_CHARS
         _lv_mem_buf_release(txt_ap);
 #endif
+        _LV_WORKER_UNLOCK();
     }
     else if(mode == LV_DESIGN_DRAW_POST) {
+        _LV_WORKER_LOCK();
         ancestor_design_f(btnm, clip_area, mode);
+        _LV_WORKER_UNLOCK();
     }
     return LV_DESIGN_RES_OK;
 }
@@ -410,20 +410,29 @@ static lv_design_res_t lv_calendar_design(lv_obj_t * calendar, const lv_area_t *
 {
     /*Return false if the object is not covers the mask_p area*/
     if(mode == LV_DESIGN_COVER_CHK) {
-        return ancestor_design(calendar, clip_area, mode);
+        /*An other worker might be drawing the dates in a changed state*/
+        _LV_WORKER_LOCK();
+        lv_design_res_t res = ancestor_design(calendar, clip_area, mode);
+        _LV_WORKER_UNLOCK();
+        return res;
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*The state of the calendar is changed temporarily to get the styles of the dates.
+         *Don't let the other workers rendering the tiles see it.*/
+        _LV_WORKER_LOCK();
         ancestor_design(calendar, clip_area, mode);
 
         draw_header(calendar, clip_area);
         draw_day_names(calendar, clip_area);
         draw_dates(calendar, clip_area);
-
+        _LV_WORKER_UNLOCK();
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
+        _LV_WORKER_LOCK();
         ancestor_design(calendar, clip_area, mode);
+        _LV_WORKER_UNLOCK();
     }
 
     return LV_DESIGN_RES_OK;
@@ -830,10 +830,16 @@ static lv_design_res_t lv_dropdown_page_design(lv_obj_t * page, const lv_area_t
 {
     /*Return false if the object is not covers the mask_p area*/
     if(mode == LV_DESIGN_COVER_CHK) {
-        return ancestor_page_design(page, clip_area, mode);
+        /*An other worker might be drawing the boxes in a changed state*/
+        _LV_WORKER_LOCK();
+        lv_design_res_t res = ancestor_page_design(page, clip_area, mode);
+        _LV_WORKER_UNLOCK();
+        return res;
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*The boxes change the state of the page temporarily. Draw the page on one worker at a time.*/
+        _LV_WORKER_LOCK();
         ancestor_page_design(page, clip_area, mode);
 
         lv_dropdown_page_ext_t * page_ext = lv_obj_get_ext_attr(page);
@@ -855,9 +861,11 @@ static lv_design_res_t lv_dropdown_page_design(lv_obj_t * page, const lv_area_t
                 draw_box(ddlist, &clip_area_core, ext->sel_opt_id, LV_STATE_DEFAULT);
             }
         }
+        _LV_WORKER_UNLOCK();
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
+        _LV_WORKER_LOCK();
         /*Draw the scrollbar in the ancestor page design function*/
         ancestor_page_design(page, clip_area, mode);
 
@@ -881,6 +889,7 @@ static lv_design_res_t lv_dropdown_page_design(lv_obj_t * page, const lv_area_t
                 draw_box_label(ddlist, &clip_area_core, ext->sel_opt_id, LV_STATE_DEFAULT);
             }
         }
+        _LV_WORKER_UNLOCK();
     }
 
     return LV_DESIGN_RES_OK;
@@ -53,6 +53,10 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+#if LV_LABEL_LINE_CACHE
+    static const lv_txt_lines_t * get_lines(const lv_obj_t * label, const lv_font_t * font, lv_coord_t letter_space,
+                                            lv_coord_t max_w, lv_txt_flag_t flag);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -112,6 +116,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_lines_init(&ext->lines);
+#endif
+
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -146,6 +154,9 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
             LV_ASSERT_MEM(ext->text);
             if(ext->text == NULL) return NULL;
             _lv_memcpy(ext->text, copy_ext->text, _lv_mem_get_size(copy_ext->text));
+#if LV_LABEL_LINE_CACHE
+            _lv_txt_lines_invalidate(&ext->lines);
+#endif
         }
 
         if(copy_ext->dot_tmp_alloc && copy_ext->dot.tmp_ptr) {
@@ -568,14 +579,27 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter */;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LINE_CACHE
+    const lv_txt_lines_t * lines = get_lines(label, font, letter_space, max_w, flag);
+    if(lines) {
+        /*Find the line of the index letter in the line index*/
+        uint32_t line_id = _lv_txt_lines_find(lines, byte_id);
+        line_start = lines->lines[line_id].start;
+        new_line_start = _lv_txt_lines_get_end(lines, line_id);
+        y = (lv_coord_t)(line_id * (letter_height + line_space));
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter */;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -675,22 +699,50 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
     if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+#if LV_LABEL_LINE_CACHE
+    const lv_txt_lines_t * lines = NULL;
+    if(letter_height + line_space > 0) lines = get_lines(label, font, letter_space, max_w, flag);
+    if(lines) {
+        /*Calculate the line under the point*/
+        lv_coord_t line_h = letter_height + line_space;
+        uint32_t line_id = 0;
+        if(pos.y > letter_height) line_id = (pos.y - letter_height + line_h - 1) / line_h;
+
+        if(line_id < lines->line_cnt) {
+            line_start = lines->lines[line_id].start;
+            new_line_start = _lv_txt_lines_get_end(lines, line_id);
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
             /* Include the NULL terminator in the last line */
             uint32_t tmp = new_line_start;
             uint32_t letter;
             letter = _lv_txt_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
         }
-        y += letter_height + line_space;
+        else {
+            line_start = lines->end;
+            new_line_start = lines->end;
+        }
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /* Include the NULL terminator in the last line */
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = _lv_txt_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
 #if LV_USE_BIDI
@@ -836,14 +888,36 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+#if LV_LABEL_LINE_CACHE
+    const lv_txt_lines_t * lines = NULL;
+    if(letter_height + line_space > 0) lines = get_lines(label, font, letter_space, max_w, flag);
+    if(lines) {
+        /*Calculate the line under the point*/
+        lv_coord_t line_h = letter_height + line_space;
+        uint32_t line_id = 0;
+        if(pos->y > letter_height) line_id = (pos->y - letter_height + line_h - 1) / line_h;
+
+        if(line_id < lines->line_cnt) {
+            line_start = lines->lines[line_id].start;
+            new_line_start = _lv_txt_lines_get_end(lines, line_id);
+        }
+        else {
+            line_start = lines->end;
+            new_line_start = lines->end;
+        }
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -998,6 +1072,9 @@ void lv_label_refr_text(lv_obj_t * label)
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_LABEL_LINE_CACHE
+    _lv_txt_lines_invalidate(&ext->lines);
+#endif
 
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
@@ -1012,7 +1089,13 @@ void lv_label_refr_text(lv_obj_t * label)
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
+#if LV_LABEL_LINE_CACHE
+    const lv_txt_lines_t * lines = get_lines(label, font, letter_space, max_w, flag);
+    if(lines) _lv_txt_lines_get_size(&size, lines, ext->text, line_space);
+    else _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#else
     _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1204,6 +1287,9 @@ void lv_label_refr_text(lv_obj_t * label)
                 }
                 ext->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 ext->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LINE_CACHE
+                _lv_txt_lines_invalidate(&ext->lines);
+#endif
             }
         }
     }
@@ -1305,6 +1391,11 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         lv_draw_label_hint_t * hint = NULL;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+        label_draw_dsc.lines = get_lines(label, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                         lv_area_get_width(&txt_coords), flag);
+#endif
+
         lv_draw_label(&txt_coords, &txt_clip, &label_draw_dsc, ext->text, hint);
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
@@ -1364,6 +1455,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LINE_CACHE
+        _lv_txt_lines_free(&ext->lines);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1507,4 +1601,29 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+#if LV_LABEL_LINE_CACHE
+/**
+ * Get the line index of a label's text. Rebuild it if the font, the width or the flags have changed.
+ * @param label pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the text area
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return pointer to the line index or NULL if it couldn't be created
+ */
+static const lv_txt_lines_t * get_lines(const lv_obj_t * label, const lv_font_t * font, lv_coord_t letter_space,
+                                        lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->text == NULL) return NULL;
+
+    /*The tiles of the same label can be drawn in parallel*/
+    _LV_WORKER_LOCK();
+    bool ok = _lv_txt_lines_update(&ext->lines, ext->text, font, letter_space, max_w, flag);
+    _LV_WORKER_UNLOCK();
+
+    return ok ? &ext->lines : NULL;
+}
+#endif
+
 #endif
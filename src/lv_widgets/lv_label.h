@@ -84,6 +84,10 @@ typedef struct {
     lv_draw_label_hint_t hint; /*Used to buffer info about large text*/
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_txt_lines_t lines; /*Line breaks of the text*/
+#endif
+
 #if LV_LABEL_TEXT_SEL
     uint32_t sel_start;
     uint32_t sel_end;
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+
+# Build and run the rendering and animation benchmarks (lv_bench/lv_bench.c).
+# The results are written as JSON lines. If a baseline is given the scenes
+# which got slower than the threshold are reported and the script fails.
+#
+# Usage: ./bench.py [--frames N] [--out results.json] [--baseline old.json] [--threshold 10]
+
+import argparse
+import json
+import os
+import subprocess
+
+lvgldirname = os.path.abspath('..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_BENCH"'
+optimization = '"-O3 -g0"'
+
+bench_config = {
+  "LV_DPI":130,
+  "LV_HOR_RES_MAX":800,
+  "LV_VER_RES_MAX":480,
+  "LV_COLOR_DEPTH":32,
+  "LV_USE_ANIMATION":1,
+  "LV_USE_SHADOW":1,
+  "LV_USE_IMG_TRANSFORM":1,
+  "LV_USE_LOG":0,
+  "LV_USE_ASSERT_NULL":0,
+  "LV_USE_ASSERT_MEM":0,
+  "LV_USE_ASSERT_OBJ":0,
+  "LV_USE_ASSERT_STYLE":0,
+}
+
+def build(defines):
+  d_all = base_defines[:-1] + " "
+
+  for d in defines:
+    d_all += " -D" + d + "=" + str(defines[d])
+
+  d_all += '"'
+  cmd = "make -j8 bench BIN=bench.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+
+  os.system("make clean LVGL_DIR_NAME=" + lvgldirname)
+  os.system("rm -f ./bench.bin")
+  ret = os.system(cmd)
+  if(ret != 0):
+    print("BUILD ERROR! (error code " + str(ret) + ")")
+    exit(1)
+
+def run(frames):
+  out = subprocess.run(["./bench.bin", str(frames)], stdout=subprocess.PIPE, check=True).stdout.decode()
+  return [json.loads(line) for line in out.splitlines() if line.startswith("{")]
+
+def load(path):
+  with open(path) as f:
+    return {r["scene"]: r for r in (json.loads(line) for line in f if line.strip())}
+
+parser = argparse.ArgumentParser(description="Run the rendering benchmarks")
+parser.add_argument("--frames", type=int, default=30, help="measured frames per scene")
+parser.add_argument("--out", default="bench_results.json", help="write the results here")
+parser.add_argument("--baseline", help="compare with the results of an earlier run")
+parser.add_argument("--threshold", type=float, default=10, help="allowed slowdown in percent")
+args = parser.parse_args()
+
+build(bench_config)
+results = run(args.frames)
+
+with open(args.out, "w") as f:
+  for r in results:
+    f.write(json.dumps(r) + "\n")
+
+print("---------------------------")
+print("%-12s %10s %10s %10s %12s %10s %10s" % ("scene", "avg [us]", "min [us]", "max [us]", "alloc [B]", "alloc cnt",
+                                               "anims/ms"))
+for r in results:
+  print("%-12s %10d %10d %10d %12d %10d %10s" % (r["scene"], r["time_avg_us"], r["time_min_us"], r["time_max_us"],
+                                                r["alloc_bytes"], r["alloc_cnt"], r.get("anims_per_ms", "-")))
+
+if args.baseline:
+  baseline = load(args.baseline)
+  failed = False
+  for r in results:
+    b = baseline.get(r["scene"])
+    if b is None or b["time_avg_us"] == 0:
+      continue
+    diff = (r["time_avg_us"] - b["time_avg_us"]) * 100.0 / b["time_avg_us"]
+    if diff > args.threshold:
+      print("REGRESSION: %s is %.1f%% slower (%d us -> %d us)" % (r["scene"], diff, b["time_avg_us"], r["time_avg_us"]))
+      failed = True
+  if failed:
+    exit(1)
+
+print("---------------------------")
+print("Finished")
+print("---------------------------")
@@ -9,7 +9,7 @@ lvgldirname = '"' + lvgldirname + '"'
 base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
 optimization = '"-O3 -g0"'
 
-def build(name, defines):
+def build(name, defines, cflags = ""):
   global base_defines, optimization
 
   print("=============================")
@@ -22,7 +22,7 @@ def build(name, defines):
     d_all += " -D" + d + "=" + str(defines[d])
 
   d_all += '"'
-  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization[:-1] + " " + cflags + '"'
 
   print("---------------------------")
   print("Clean")
@@ -49,6 +49,10 @@ def build(name, defines):
   print("Finished")
   print("---------------------------")
 
+# The archives of the test fonts for `lv_fs_pack_mount()`
+os.system("python3 ../scripts/lv_pack.py . -o lv_test_fonts.lvpk --ext fnt")
+os.system("python3 ../scripts/lv_pack.py . -o lv_test_fonts_rle.lvpk --ext fnt --compress")
+
 minimal_monochrome = {
   "LV_DPI":40,
   "LV_MEM_SIZE":4*1024,
@@ -131,6 +135,7 @@ minimal_monochrome = {
 all_obj_minimal_features = {
   "LV_DPI":60,
   "LV_MEM_SIZE":12*1024,
+  "LV_MEM_TLSF":1,
   "LV_HOR_RES_MAX":320,
   "LV_VER_RES_MAX":240,
   "LV_COLOR_DEPTH":8,
@@ -207,6 +212,21 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_BUF_ARENA_SIZE":16*1024,
+  "LV_LABEL_LINE_CACHE":1,
+  "LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE":4*1024,
+  "LV_SHADOW_CACHE_SIZE":32,
+  "LV_SHADOW_CACHE_ENTRY_CNT":4,
+  "LV_FONT_GLYPH_CACHE_MEM_SIZE":2*1024,
+  "LV_USE_STYLE_FLAT_CACHE":1,
+  "LV_USE_STYLE_INDEX":1,
+  "LV_USE_TASK_HEAP":1,
+  "LV_USE_INDEV_SEARCH_INDEX":1,
+  "LV_USE_REFR_OCCLUSION":1,
+  "LV_USE_REFR_AREA_MERGE":1,
+  "LV_USE_ANIM_BATCH":1,
+  "LV_USE_TILE_RENDER":1,
+  "LV_TILE_RENDER_WORKER_NUM":2,
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -296,10 +316,23 @@ advanced_features = {
   "LV_ANTIALIAS":1,
   "LV_GPU":1,
   "LV_USE_FILESYSTEM":1,
+  "LV_USE_FS_POSIX":1,
+  "LV_USE_FS_PACK":1,
+  "LV_USE_PROFILER":1,
+  "LV_USE_TILE_RENDER":1,
+  "LV_TILE_RENDER_WORKER_NUM":4,
+  "LV_SHADOW_CACHE_SIZE":64,
+  "LV_FONT_GLYPH_CACHE_MEM_SIZE":16*1024,
+  "LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE":8*1024,
+  "LV_USE_INDEV_SEARCH_INDEX":1,
+  "LV_USE_REFR_AREA_MERGE":1,
   "LV_USE_IMG_TRANSFORM":1,
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_IMG_CACHE_MEM_SIZE":256*1024,
+  "LV_IMG_DECODER_READAHEAD_SIZE":4096,
+  "LV_IMG_CACHE_RUNS":1,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,
   "LV_USE_THEME_EMPTY":1,
@@ -369,7 +402,22 @@ advanced_features = {
   "LV_USE_WIN":1
 }
 
+#The SIMD blending is used only without LV_COLOR_SCREEN_TRANSP
+simd_blending = dict(advanced_features)
+simd_blending["LV_USE_BLEND_SIMD"] = 1
+simd_blending["LV_COLOR_SCREEN_TRANSP"] = 0
+
+def cpu_has(flag):
+  try:
+    with open("/proc/cpuinfo") as f:
+      return (" " + flag + " ") in f.read()
+  except OSError:
+    return False
+
 build("Minimal monochrome", minimal_monochrome)
 build("All objects, minimal features", all_obj_minimal_features)
 build("All objects, all common features", all_obj_all_features)
 build("All objects, with advanced features", advanced_features)
+build("All objects, with SIMD blending", simd_blending)
+if cpu_has("avx2"):
+  build("All objects, with AVX2 blending", simd_blending, "-mavx2")
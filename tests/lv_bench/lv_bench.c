@@ -0,0 +1,534 @@
+/**
+ * @file lv_bench.c
+ * Render scripted scenes and measure the time and the allocations per frame.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+
+#if LV_BUILD_BENCH
+#include "lv_bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CHART_POINT_CNT 10000
+#define IMG_SIZE        100
+#define ANIM_OBJ_CNT    500
+#define ANIM_VAR_CNT    2000
+#define ANIM_STEP_PER_FRAME 10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    void (*create_cb)(lv_obj_t * scr);
+    void (*frame_cb)(uint32_t frame);   /*Change the scene before rendering a frame (can be NULL)*/
+} scene_dsc_t;
+
+typedef struct {
+    const char * name;
+    void (*create_cb)(lv_obj_t * scr);
+    void (*restart_cb)(void);   /*Start the animations again when all are ready*/
+} anim_scene_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void run_scene(const scene_dsc_t * scene, uint32_t frame_cnt);
+static uint32_t time_us(void);
+static void rects_create(lv_obj_t * scr);
+static void labels_create(lv_obj_t * scr);
+static void imgs_create(lv_obj_t * scr);
+static void imgs_frame(uint32_t frame);
+static void chart_create(lv_obj_t * scr);
+static void page_create(lv_obj_t * scr);
+static void page_frame(uint32_t frame);
+static void cards_create(lv_obj_t * scr);
+static void cards_frame(uint32_t frame);
+#if LV_USE_ANIMATION
+static void run_anim_scene(const anim_scene_dsc_t * scene, uint32_t frame_cnt);
+static void trans_create(lv_obj_t * scr);
+static void trans_restart(void);
+static void vars_create(lv_obj_t * scr);
+static void vars_restart(void);
+static void var_anim_cb(void * var, lv_anim_value_t v);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t alloc_bytes;
+static uint32_t alloc_cnt;
+
+static lv_obj_t * imgs[6];
+static lv_obj_t * page;
+static lv_obj_t * cards[4];
+
+static lv_color_t img_map[IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE / sizeof(lv_color_t) + 1];
+static lv_img_dsc_t img_dsc;
+static lv_coord_t chart_points[CHART_POINT_CNT];
+
+#if LV_USE_ANIMATION
+static lv_obj_t * trans_objs[ANIM_OBJ_CNT];
+static lv_style_t trans_style;
+static int32_t anim_vars[ANIM_VAR_CNT];
+#endif
+
+static const char * long_txt =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et "
+    "dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex "
+    "ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat "
+    "nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit "
+    "anim id est laborum.";
+
+static const scene_dsc_t scenes[] = {
+    {"rects", rects_create, NULL},
+    {"labels", labels_create, NULL},
+    {"imgs", imgs_create, imgs_frame},
+    {"chart", chart_create, NULL},
+    {"page_scroll", page_create, page_frame},
+    {"cards", cards_create, cards_frame},
+};
+
+#if LV_USE_ANIMATION
+static const anim_scene_dsc_t anim_scenes[] = {
+    {"anim_trans", trans_create, trans_restart},
+    {"anim_vars", vars_create, vars_restart},
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Render all the benchmark scenes and print the results as JSON lines to `stdout`
+ * @param frame_cnt number of measured frames per scene
+ */
+void lv_bench(uint32_t frame_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        run_scene(&scenes[i], frame_cnt);
+    }
+
+#if LV_USE_ANIMATION
+    for(i = 0; i < sizeof(anim_scenes) / sizeof(anim_scenes[0]); i++) {
+        run_anim_scene(&anim_scenes[i], frame_cnt);
+    }
+#endif
+}
+
+/**
+ * Counting wrapper for `malloc`. Used as `LV_MEM_CUSTOM_ALLOC`.
+ */
+void * lv_bench_malloc(size_t size)
+{
+    alloc_bytes += size;
+    alloc_cnt++;
+    return malloc(size);
+}
+
+/**
+ * Wrapper for `free`. Used as `LV_MEM_CUSTOM_FREE`.
+ */
+void lv_bench_free(void * p)
+{
+    free(p);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create a scene on a new screen, render it `frame_cnt` times and print the result
+ * @param scene the scene to render
+ * @param frame_cnt number of measured frames
+ */
+static void run_scene(const scene_dsc_t * scene, uint32_t frame_cnt)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_disp_load_scr(scr);
+    scene->create_cb(scr);
+
+    /*The first frame fills the caches and the temporary buffers*/
+    lv_refr_now(NULL);
+
+    uint32_t t_sum = 0;
+    uint32_t t_min = UINT32_MAX;
+    uint32_t t_max = 0;
+    uint32_t frame_alloc_bytes = 0;
+    uint32_t frame_alloc_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        if(scene->frame_cb) scene->frame_cb(i);
+        lv_obj_invalidate(scr);
+
+        alloc_bytes = 0;
+        alloc_cnt = 0;
+        uint32_t t_start = time_us();
+        lv_refr_now(NULL);
+        uint32_t t = time_us() - t_start;
+
+        t_sum += t;
+        if(t < t_min) t_min = t;
+        if(t > t_max) t_max = t;
+        frame_alloc_bytes += alloc_bytes;
+        frame_alloc_cnt += alloc_cnt;
+    }
+
+    printf("{\"scene\":\"%s\",\"frames\":%u,\"time_avg_us\":%u,\"time_min_us\":%u,\"time_max_us\":%u,"
+           "\"alloc_bytes\":%u,\"alloc_cnt\":%u}\n",
+           scene->name, (unsigned int)frame_cnt, (unsigned int)(t_sum / frame_cnt), (unsigned int)t_min,
+           (unsigned int)t_max, (unsigned int)(frame_alloc_bytes / frame_cnt), (unsigned int)(frame_alloc_cnt / frame_cnt));
+    fflush(stdout);
+
+    lv_disp_load_scr(lv_obj_create(NULL, NULL));
+    lv_obj_del(scr);
+}
+
+#if LV_USE_ANIMATION
+/**
+ * Create an animated scene and measure the steps of the animations.
+ * The invalidated areas are measured too but not rendered.
+ * @param scene the scene to animate
+ * @param frame_cnt the scene is stepped `frame_cnt * ANIM_STEP_PER_FRAME` times
+ */
+static void run_anim_scene(const anim_scene_dsc_t * scene, uint32_t frame_cnt)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_disp_load_scr(scr);
+    scene->create_cb(scr);
+    lv_refr_now(NULL);
+
+    uint32_t step_cnt = frame_cnt * ANIM_STEP_PER_FRAME;
+    uint32_t t_sum = 0;
+    uint32_t t_min = UINT32_MAX;
+    uint32_t t_max = 0;
+    uint32_t step_alloc_bytes = 0;
+    uint32_t step_alloc_cnt = 0;
+    uint64_t anim_sum = 0;
+    uint32_t i;
+    for(i = 0; i < step_cnt; i++) {
+        if(lv_anim_count_running() == 0) scene->restart_cb();
+
+        /*Move the animations by 1 ms in every step*/
+        lv_tick_inc(1);
+
+        anim_sum += lv_anim_count_running();
+        alloc_bytes = 0;
+        alloc_cnt = 0;
+        uint32_t t_start = time_us();
+        lv_anim_refr_now();
+#if LV_USE_ANIM_BATCH
+        _lv_obj_trans_inv_flush();
+#endif
+        uint32_t t = time_us() - t_start;
+
+        /*Forget the invalidated areas instead of rendering them*/
+        _lv_inv_area(lv_disp_get_default(), NULL);
+
+        t_sum += t;
+        if(t < t_min) t_min = t;
+        if(t > t_max) t_max = t;
+        step_alloc_bytes += alloc_bytes;
+        step_alloc_cnt += alloc_cnt;
+    }
+
+    printf("{\"scene\":\"%s\",\"frames\":%u,\"time_avg_us\":%u,\"time_min_us\":%u,\"time_max_us\":%u,"
+           "\"alloc_bytes\":%u,\"alloc_cnt\":%u,\"anims_per_ms\":%u}\n",
+           scene->name, (unsigned int)step_cnt, (unsigned int)(t_sum / step_cnt), (unsigned int)t_min,
+           (unsigned int)t_max, (unsigned int)(step_alloc_bytes / step_cnt), (unsigned int)(step_alloc_cnt / step_cnt),
+           (unsigned int)(t_sum ? anim_sum * 1000 / t_sum : 0));
+    fflush(stdout);
+
+    lv_disp_load_scr(lv_obj_create(NULL, NULL));
+    lv_obj_del(scr);
+}
+#endif
+
+/**
+ * Get a monotonic time stamp
+ * @return the time in microseconds
+ */
+static uint32_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * Many rectangles with radius, border and shadow
+ */
+static void rects_create(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr) / 8;
+    lv_coord_t h = lv_obj_get_height(scr) / 6;
+    uint32_t i;
+    for(i = 0; i < 48; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_size(obj, w - 20, h - 20);
+        lv_obj_set_pos(obj, (i % 8) * w + 10, (i / 8) * h + 10);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 5 + (i % 4) * 5);
+        lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(0x102030 * (i % 5 + 1)));
+        lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 2);
+        lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10 + (i % 3) * 5);
+        lv_obj_set_style_local_shadow_spread(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i % 2);
+    }
+}
+
+/**
+ * Long labels wrapped into multiple lines
+ */
+static void labels_create(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr) / 2;
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * label = lv_label_create(scr, NULL);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+        lv_obj_set_width(label, w - 20);
+        lv_label_set_text(label, long_txt);
+        lv_obj_set_pos(label, (i % 2) * w + 10, (i / 2) * (lv_obj_get_height(scr) / 2) + 10);
+    }
+}
+
+/**
+ * Rotated and zoomed ARGB images
+ */
+static void imgs_create(lv_obj_t * scr)
+{
+    /*Draw a gradient with transparent corners into the image*/
+    uint8_t * buf = (uint8_t *)img_map;
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < IMG_SIZE; y++) {
+        for(x = 0; x < IMG_SIZE; x++) {
+            lv_color_t c = lv_color_make(x * 255 / IMG_SIZE, y * 255 / IMG_SIZE, 0x80);
+            uint8_t * px = &buf[(y * IMG_SIZE + x) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            _lv_memcpy_small(px, &c, sizeof(lv_color_t));
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (x + y) < IMG_SIZE / 4 ? LV_OPA_TRANSP : LV_OPA_COVER;
+        }
+    }
+
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.header.w = IMG_SIZE;
+    img_dsc.header.h = IMG_SIZE;
+    img_dsc.data_size = IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    img_dsc.data = buf;
+
+    lv_coord_t w = lv_obj_get_width(scr) / 3;
+    lv_coord_t h = lv_obj_get_height(scr) / 2;
+    uint32_t i;
+    for(i = 0; i < sizeof(imgs) / sizeof(imgs[0]); i++) {
+        imgs[i] = lv_img_create(scr, NULL);
+        lv_img_set_src(imgs[i], &img_dsc);
+        lv_obj_set_pos(imgs[i], (i % 3) * w + (w - IMG_SIZE) / 2, (i / 3) * h + (h - IMG_SIZE) / 2);
+    }
+}
+
+/**
+ * Rotate and zoom the images a little more in every frame
+ */
+static void imgs_frame(uint32_t frame)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(imgs) / sizeof(imgs[0]); i++) {
+#if LV_USE_IMG_TRANSFORM
+        lv_img_set_angle(imgs[i], (frame * 70 + i * 300) % 3600);
+        lv_img_set_zoom(imgs[i], LV_IMG_ZOOM_NONE / 2 + ((frame * 16 + i * 40) % LV_IMG_ZOOM_NONE));
+#else
+        LV_UNUSED(frame);
+#endif
+    }
+}
+
+/**
+ * A line chart with many points
+ */
+static void chart_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < CHART_POINT_CNT; i++) {
+        chart_points[i] = (lv_coord_t)(50 + ((i * 37) % 41) - ((i * 13) % 29));
+    }
+
+    lv_obj_t * chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, lv_obj_get_width(scr) - 20, lv_obj_get_height(scr) - 20);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_y_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_chart_set_point_count(chart, CHART_POINT_CNT);
+    lv_obj_set_style_local_size(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+    lv_chart_set_points(chart, ser, chart_points);
+}
+
+/**
+ * A page with many children
+ */
+static void page_create(lv_obj_t * scr)
+{
+    page = lv_page_create(scr, NULL);
+    lv_obj_set_size(page, lv_obj_get_width(scr) - 20, lv_obj_get_height(scr) - 20);
+    lv_obj_align(page, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_page_set_scrl_layout(page, LV_LAYOUT_COLUMN_MID);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_t * btn = lv_btn_create(page, NULL);
+        lv_obj_set_size(btn, lv_obj_get_width(scr) / 2, 50);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+    }
+}
+
+/**
+ * Scroll the page up and down
+ */
+static void page_frame(uint32_t frame)
+{
+    lv_obj_t * scrl = lv_page_get_scrollable(page);
+    lv_coord_t max_scroll = lv_obj_get_height(scrl) - lv_obj_get_height(page);
+    lv_coord_t y = (lv_coord_t)((frame * 37) % (max_scroll > 0 ? max_scroll : 1));
+    lv_obj_set_y(scrl, -y);
+}
+
+/**
+ * Opaque cards with labels stacked on each other
+ */
+static void cards_create(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+    uint32_t i;
+    for(i = 0; i < sizeof(cards) / sizeof(cards[0]); i++) {
+        cards[i] = lv_obj_create(scr, NULL);
+        lv_obj_set_size(cards[i], w - 40, h - 40);
+        lv_obj_set_pos(cards[i], 10 + i * 6, 10 + i * 6);
+        lv_obj_set_style_local_radius(cards[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 8);
+        lv_obj_set_style_local_bg_color(cards[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_hex(0x203040 * (i + 1)));
+        lv_obj_set_style_local_shadow_width(cards[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+
+        lv_obj_t * label = lv_label_create(cards[i], NULL);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+        lv_obj_set_width(label, w - 60);
+        lv_label_set_text(label, long_txt);
+        lv_obj_set_pos(label, 10, 10);
+    }
+}
+
+/**
+ * Invalidate the cards as if their content changed
+ */
+static void cards_frame(uint32_t frame)
+{
+    lv_obj_invalidate(cards[frame % (sizeof(cards) / sizeof(cards[0]))]);
+}
+
+#if LV_USE_ANIMATION
+/**
+ * Many objects with transitions of their colors and radius between the default and the checked state
+ */
+static void trans_create(lv_obj_t * scr)
+{
+    static lv_style_property_t trans_props[] = {LV_STYLE_BG_COLOR, LV_STYLE_BORDER_COLOR, LV_STYLE_RADIUS, 0};
+    static lv_anim_path_t path;
+    lv_anim_path_init(&path);
+    lv_anim_path_set_cb(&path, lv_anim_path_ease_in_out);
+
+    lv_style_init(&trans_style);
+    lv_style_set_transition_prop_1(&trans_style, LV_STATE_DEFAULT, trans_props[0]);
+    lv_style_set_transition_prop_2(&trans_style, LV_STATE_DEFAULT, trans_props[1]);
+    lv_style_set_transition_prop_3(&trans_style, LV_STATE_DEFAULT, trans_props[2]);
+    lv_style_set_transition_time(&trans_style, LV_STATE_DEFAULT, 300);
+    lv_style_set_transition_path(&trans_style, LV_STATE_DEFAULT, &path);
+    lv_style_set_border_width(&trans_style, LV_STATE_DEFAULT, 1);
+    lv_style_set_bg_color(&trans_style, LV_STATE_CHECKED, LV_COLOR_RED);
+    lv_style_set_border_color(&trans_style, LV_STATE_CHECKED, LV_COLOR_BLUE);
+    lv_style_set_radius(&trans_style, LV_STATE_CHECKED, 8);
+
+    lv_coord_t w = lv_obj_get_width(scr) / 25;
+    lv_coord_t h = lv_obj_get_height(scr) / 20;
+    uint32_t i;
+    for(i = 0; i < ANIM_OBJ_CNT; i++) {
+        trans_objs[i] = lv_obj_create(scr, NULL);
+        lv_obj_add_style(trans_objs[i], LV_OBJ_PART_MAIN, &trans_style);
+        lv_obj_set_size(trans_objs[i], w - 2, h - 2);
+        lv_obj_set_pos(trans_objs[i], (i % 25) * w, (i / 25) * h);
+    }
+}
+
+/**
+ * Toggle the checked state of the objects to start the transitions again
+ */
+static void trans_restart(void)
+{
+    uint32_t i;
+    for(i = 0; i < ANIM_OBJ_CNT; i++) {
+        if(lv_obj_get_state(trans_objs[i], LV_OBJ_PART_MAIN) & LV_STATE_CHECKED) {
+            lv_obj_clear_state(trans_objs[i], LV_STATE_CHECKED);
+        }
+        else {
+            lv_obj_add_state(trans_objs[i], LV_STATE_CHECKED);
+        }
+    }
+}
+
+/**
+ * Many animations on plain variables with different paths
+ */
+static void vars_create(lv_obj_t * scr)
+{
+    LV_UNUSED(scr);
+    vars_restart();
+}
+
+/**
+ * Start the animations of the variables
+ */
+static void vars_restart(void)
+{
+    static const lv_anim_path_cb_t path_cbs[] = {lv_anim_path_linear, lv_anim_path_ease_in_out,
+                                                 lv_anim_path_overshoot, lv_anim_path_bounce
+                                                };
+    static lv_anim_path_t paths[sizeof(path_cbs) / sizeof(path_cbs[0])];
+
+    uint32_t i;
+    for(i = 0; i < ANIM_VAR_CNT; i++) {
+        lv_anim_path_t * path = &paths[i % (sizeof(paths) / sizeof(paths[0]))];
+        lv_anim_path_init(path);
+        lv_anim_path_set_cb(path, path_cbs[i % (sizeof(paths) / sizeof(paths[0]))]);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &anim_vars[i]);
+        lv_anim_set_exec_cb(&a, var_anim_cb);
+        lv_anim_set_values(&a, 0, 1000 + i);
+        lv_anim_set_time(&a, 200 + (i % 7) * 50);
+        lv_anim_set_path(&a, path);
+        lv_anim_start(&a);
+    }
+}
+
+static void var_anim_cb(void * var, lv_anim_value_t v)
+{
+    *((int32_t *)var) = v;
+}
+#endif
+
+#endif /*LV_BUILD_BENCH*/
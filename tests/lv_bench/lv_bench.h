@@ -0,0 +1,55 @@
+/**
+ * @file lv_bench.h
+ *
+ */
+
+#ifndef LV_BENCH_H
+#define LV_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Render all the benchmark scenes and print the results as JSON lines to `stdout`
+ * @param frame_cnt number of measured frames per scene
+ */
+void lv_bench(uint32_t frame_cnt);
+
+/**
+ * Counting wrapper for `malloc`. Used as `LV_MEM_CUSTOM_ALLOC`.
+ */
+void * lv_bench_malloc(size_t size);
+
+/**
+ * Wrapper for `free`. Used as `LV_MEM_CUSTOM_FREE`.
+ */
+void lv_bench_free(void * p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_BENCH_H*/
@@ -18,6 +18,14 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#ifdef LV_BUILD_BENCH
+/*Count the allocations of the benchmarks*/
+#define LV_MEM_CUSTOM           1
+#define LV_MEM_CUSTOM_INCLUDE   "lv_bench/lv_bench.h"
+#define LV_MEM_CUSTOM_ALLOC     lv_bench_malloc
+#define LV_MEM_CUSTOM_FREE      lv_bench_free
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -25,6 +33,20 @@ extern "C" {
 uint32_t custom_tick_get(void);
 #define LV_TICK_CUSTOM_SYS_TIME_EXPR custom_tick_get()
 
+/*Measure the profiled phases in microseconds, not only in milliseconds*/
+uint32_t custom_time_us(void);
+#define LV_PROFILER_TIME_GET        (custom_time_us())
+
+#if defined(LV_USE_TILE_RENDER) && LV_USE_TILE_RENDER
+/*The tiles are rendered on POSIX threads (see lv_test_main.c)*/
+uint32_t lv_test_worker_id(void);
+void lv_test_worker_lock(void);
+void lv_test_worker_unlock(void);
+#define LV_TILE_RENDER_WORKER_ID    (lv_test_worker_id())
+#define LV_TILE_RENDER_LOCK         (lv_test_worker_lock())
+#define LV_TILE_RENDER_UNLOCK       (lv_test_worker_unlock())
+#endif
+
 typedef int16_t lv_coord_t;
 typedef void * lv_disp_drv_user_data_t;             /*Type of user data in the display driver*/
 typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the input device driver*/
@@ -0,0 +1,219 @@
+/**
+ * @file lv_test_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_anim.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_ANIM_NUM   3
+#define TEST_LOG_SIZE   64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_ANIMATION
+static void callback_order(bool start);
+static void del_restart_in_cb(void);
+static void anim_start(uint32_t id, lv_anim_path_cb_t path_cb, uint16_t repeat_cnt, bool start,
+                       lv_anim_ready_cb_t ready);
+static bool anim_exists(uint32_t id);
+static void log_event(void * var, char event);
+static void exec_cb(void * var, lv_anim_value_t v);
+static void start_cb(lv_anim_t * a);
+static void ready_cb(lv_anim_t * a);
+static void del_restart_cb(lv_anim_t * a);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_ANIMATION
+static int32_t vars[TEST_ANIM_NUM];
+static char run_log[TEST_LOG_SIZE];
+static uint32_t log_len;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_anim(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_anim tests");
+    lv_test_print("===================");
+
+#if LV_USE_ANIMATION
+    callback_order(false);
+    callback_order(true);
+    del_restart_in_cb();
+#else
+    lv_test_print("SKIP: animation test because it requires LV_USE_ANIMATION 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_ANIMATION
+
+/**
+ * Start A, B and C with mixed paths. The newer animations should run first like in the linked list,
+ * also if the values are calculated grouped by the paths (`LV_USE_ANIM_BATCH`).
+ * The animations last 0 ms so they are ready in the first round regardless of the elapsed time.
+ * @param start true: set `start_cb` too
+ */
+static void callback_order(bool start)
+{
+    lv_test_print("");
+    if(start) {
+        lv_test_print("Order of the callbacks with start_cb:");
+        lv_test_print("-------------------------------------");
+    }
+    else {
+        lv_test_print("Order of the callbacks:");
+        lv_test_print("-----------------------");
+    }
+
+    anim_start(0, lv_anim_path_linear, 1, start, ready_cb);
+    anim_start(1, lv_anim_path_ease_in, 1, start, ready_cb);
+    anim_start(2, lv_anim_path_linear, 1, start, ready_cb);
+
+    log_len = 0;
+    run_log[0] = '\0';
+    lv_anim_refr_now();
+
+    lv_test_assert_str_eq(start ? "CsCeCrBsBeBrAsAeAr" : "CeCrBeBrAeAr", run_log, "the newer animations run first");
+
+    uint32_t i;
+    for(i = 0; i < TEST_ANIM_NUM; i++) {
+        lv_test_assert_true(anim_exists(i) == false, "the ready animation is deleted");
+    }
+}
+
+/**
+ * B's `ready_cb` deletes A which didn't run yet and C which already ran, then restarts B.
+ * A shouldn't run and the new B should run only in the next round.
+ */
+static void del_restart_in_cb(void)
+{
+    lv_test_print("");
+    lv_test_print("Delete and restart animations in a callback:");
+    lv_test_print("--------------------------------------------");
+
+    anim_start(0, lv_anim_path_linear, 1, false, ready_cb);
+    anim_start(1, lv_anim_path_ease_in, 1, false, del_restart_cb);
+    anim_start(2, lv_anim_path_linear, 2, false, ready_cb);
+
+    log_len = 0;
+    run_log[0] = '\0';
+    lv_anim_refr_now();
+
+    lv_test_assert_str_eq("CeBeBr", run_log, "the deleted animation didn't run");
+    lv_test_assert_true(anim_exists(0) == false, "the not started animation is deleted");
+    lv_test_assert_true(anim_exists(1), "the animation is restarted");
+    lv_test_assert_true(anim_exists(2) == false, "the started animation is deleted");
+
+    log_len = 0;
+    run_log[0] = '\0';
+    lv_anim_refr_now();
+
+    lv_test_assert_str_eq("BeBr", run_log, "the restarted animation runs in the next round");
+    lv_test_assert_true(anim_exists(1) == false, "the restarted animation is ready");
+}
+
+/**
+ * Start a 0 ms long animation on a test variable
+ * @param id index of the variable. Logged as 'A' + id
+ * @param path_cb path of the animation
+ * @param repeat_cnt number of repeats
+ * @param start true: set `start_cb`
+ * @param ready the ready callback
+ */
+static void anim_start(uint32_t id, lv_anim_path_cb_t path_cb, uint16_t repeat_cnt, bool start,
+                       lv_anim_ready_cb_t ready)
+{
+    lv_anim_path_t path;
+    lv_anim_path_init(&path);
+    lv_anim_path_set_cb(&path, path_cb);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &vars[id]);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_path(&a, &path);
+    lv_anim_set_time(&a, 0);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_repeat_count(&a, repeat_cnt);
+    if(start) lv_anim_set_start_cb(&a, start_cb);
+    lv_anim_set_ready_cb(&a, ready);
+    a.early_apply = 0;  /*Log only the steps, not the start value*/
+    lv_anim_start(&a);
+}
+
+static bool anim_exists(uint32_t id)
+{
+    return lv_anim_get(&vars[id], exec_cb) != NULL;
+}
+
+/**
+ * Add the name of an animation and an event to the log
+ * @param var the animated test variable
+ * @param event 's': started, 'e': executed, 'r': ready
+ */
+static void log_event(void * var, char event)
+{
+    if(log_len + 2 >= TEST_LOG_SIZE) return;
+
+    run_log[log_len++] = (char)('A' + ((int32_t *)var - vars));
+    run_log[log_len++] = event;
+    run_log[log_len] = '\0';
+}
+
+static void exec_cb(void * var, lv_anim_value_t v)
+{
+    LV_UNUSED(v);
+    log_event(var, 'e');
+}
+
+static void start_cb(lv_anim_t * a)
+{
+    log_event(a->var, 's');
+}
+
+static void ready_cb(lv_anim_t * a)
+{
+    log_event(a->var, 'r');
+}
+
+static void del_restart_cb(lv_anim_t * a)
+{
+    ready_cb(a);
+    lv_anim_del(&vars[0], NULL);
+    lv_anim_del(&vars[2], NULL);
+    anim_start(1, lv_anim_path_ease_in, 1, false, ready_cb);
+}
+
+#endif
+
+#endif
@@ -13,6 +13,18 @@
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_font_cache.h"
+#include "lv_test_profiler.h"
+#include "lv_test_draw_mask.h"
+#include "lv_test_draw_rect.h"
+#include "lv_test_task.h"
+#include "lv_test_anim.h"
+#include "lv_test_indev.h"
+#include "lv_test_refr.h"
+#include "lv_test_img_buf.h"
+#include "lv_test_img_decoder.h"
+#include "lv_test_img_cache.h"
+#include "lv_test_fs.h"
 
 /*********************
  *      DEFINES
@@ -48,6 +60,18 @@ void lv_test_core(void)
     lv_test_obj();
     lv_test_style();
     lv_test_font_loader();
+    lv_test_font_cache();
+    lv_test_profiler();
+    lv_test_draw_mask();
+    lv_test_draw_rect();
+    lv_test_task();
+    lv_test_anim();
+    lv_test_indev();
+    lv_test_refr();
+    lv_test_img_buf();
+    lv_test_img_decoder();
+    lv_test_img_cache();
+    lv_test_fs();
 }
 
 /**********************
@@ -0,0 +1,221 @@
+/**
+ * @file lv_test_draw_mask.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_draw_mask.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_ITERATIONS     300     /*Number of random mask configurations*/
+#define TEST_MASK_MAX       3       /*Max. number of masks in a configuration*/
+#define TEST_AREA_SIZE      100     /*The masks are in a `TEST_AREA_SIZE` sized square*/
+#define TEST_LINE_MAX       120
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef union {
+    lv_draw_mask_common_dsc_t dsc;
+    lv_draw_mask_line_param_t line;
+    lv_draw_mask_angle_param_t angle;
+    lv_draw_mask_radius_param_t radius;
+    lv_draw_mask_fade_param_t fade;
+    lv_draw_mask_map_param_t map;
+} test_mask_param_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void span_same_as_per_mask(void);
+static void add_random_mask(test_mask_param_t * param);
+static lv_draw_mask_res_t apply_per_mask(test_mask_param_t * params, uint32_t cnt, lv_opa_t * mask_buf,
+                                         lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len);
+static void fill_result(lv_opa_t * mask_buf, lv_draw_mask_res_t res, lv_coord_t len);
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_seed;
+static lv_opa_t map_buf[TEST_AREA_SIZE * TEST_AREA_SIZE];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_mask(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_mask tests");
+    lv_test_print("========================");
+
+    span_same_as_per_mask();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Apply random masks with `lv_draw_mask_apply_span()` and with the masks' callbacks one by one
+ * and compare the results. The fixed seed makes the test deterministic.
+ */
+static void span_same_as_per_mask(void)
+{
+    lv_test_print("");
+    lv_test_print("Compare the mask spans with applying the masks one by one:");
+    lv_test_print("----------------------------------------------------------");
+
+    static lv_opa_t buf_span[TEST_LINE_MAX];
+    static lv_opa_t buf_ref[TEST_LINE_MAX];
+    test_mask_param_t params[TEST_MASK_MAX];
+    int16_t ids[TEST_MASK_MAX];
+
+    uint32_t i;
+    for(i = 0; i < sizeof(map_buf); i++) map_buf[i] = (lv_opa_t)(i * 7);
+
+    rnd_seed = 1234;
+    uint32_t line_cnt = 0;
+    uint32_t cover_cnt = 0;
+    uint32_t diff_cnt = 0;
+    uint32_t cover_err_cnt = 0;
+
+    uint32_t it;
+    for(it = 0; it < TEST_ITERATIONS; it++) {
+        uint32_t mask_cnt = rnd(1, TEST_MASK_MAX);
+        uint32_t m;
+        for(m = 0; m < mask_cnt; m++) {
+            add_random_mask(&params[m]);
+            ids[m] = lv_draw_mask_add(&params[m], NULL);
+        }
+
+        lv_coord_t y;
+        for(y = -5; y < TEST_AREA_SIZE + 5; y++) {
+            lv_coord_t x = rnd(-10, TEST_AREA_SIZE - 10);
+            lv_coord_t len = rnd(1, TEST_LINE_MAX);
+
+            memset(buf_span, 0xFF, len);
+            memset(buf_ref, 0xFF, len);
+
+            lv_coord_t cover_start;
+            lv_coord_t cover_len;
+            lv_draw_mask_res_t res_span = lv_draw_mask_apply_span(buf_span, x, y, len, &cover_start, &cover_len);
+            lv_draw_mask_res_t res_ref = apply_per_mask(params, mask_cnt, buf_ref, x, y, len);
+            fill_result(buf_span, res_span, len);
+            fill_result(buf_ref, res_ref, len);
+
+            line_cnt++;
+            if(memcmp(buf_span, buf_ref, len) != 0) diff_cnt++;
+
+            /*The covered pixels have to be fully opaque with every mask*/
+            if(cover_len > 0) {
+                cover_cnt++;
+                if(cover_start < 0 || cover_start + cover_len > len) cover_err_cnt++;
+                else {
+                    lv_coord_t k;
+                    for(k = cover_start; k < cover_start + cover_len; k++) {
+                        if(buf_ref[k] != LV_OPA_COVER) {
+                            cover_err_cnt++;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for(m = 0; m < mask_cnt; m++) lv_draw_mask_remove_id(ids[m]);
+    }
+
+    lv_test_assert_int_eq(0, lv_draw_mask_get_cnt(), "every mask is removed");
+    lv_test_assert_int_gt(0, cover_cnt, "lines with covered part");
+    lv_test_assert_int_eq(0, diff_cnt, "lines different from the per mask result");
+    lv_test_assert_int_eq(0, cover_err_cnt, "lines with not covered pixels in the covered part");
+    lv_test_print("   %d lines are compared", line_cnt);
+}
+
+/**
+ * Initialize a mask with random type and parameters
+ */
+static void add_random_mask(test_mask_param_t * param)
+{
+    lv_area_t a;
+    a.x1 = rnd(0, TEST_AREA_SIZE / 2);
+    a.y1 = rnd(0, TEST_AREA_SIZE / 2);
+    a.x2 = a.x1 + rnd(0, TEST_AREA_SIZE / 2 - 1);
+    a.y2 = a.y1 + rnd(0, TEST_AREA_SIZE / 2 - 1);
+
+    switch(rnd(0, 6)) {
+        case 0: /*Horizontal or vertical line*/
+            if(rnd(0, 1)) lv_draw_mask_line_points_init(&param->line, a.x1, a.y1, a.x2, a.y1, rnd(0, 3));
+            else lv_draw_mask_line_points_init(&param->line, a.x1, a.y1, a.x1, a.y2, rnd(0, 3));
+            break;
+        case 1: /*Sloped line*/
+            lv_draw_mask_line_points_init(&param->line, a.x1, a.y1, a.x2, a.y2, rnd(0, 3));
+            break;
+        case 2:
+            lv_draw_mask_angle_init(&param->angle, a.x1, a.y1, rnd(0, 359), rnd(0, 359));
+            break;
+        case 3:
+        case 4:
+            lv_draw_mask_radius_init(&param->radius, &a, rnd(0, TEST_AREA_SIZE / 4), rnd(0, 1));
+            break;
+        case 5:
+            lv_draw_mask_fade_init(&param->fade, &a, rnd(0, 255), rnd(a.y1, a.y2), rnd(0, 255), a.y2);
+            break;
+        default:
+            lv_draw_mask_map_init(&param->map, &a, map_buf);
+            break;
+    }
+}
+
+/**
+ * Apply the masks by calling their callbacks one by one, like `lv_draw_mask_apply()` did before the spans
+ */
+static lv_draw_mask_res_t apply_per_mask(test_mask_param_t * params, uint32_t cnt, lv_opa_t * mask_buf,
+                                         lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len)
+{
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_draw_mask_res_t res = params[i].dsc.cb(mask_buf, abs_x, abs_y, len, &params[i]);
+        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+    }
+
+    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+/**
+ * Set the final opacities in the mask buffer according to the result of the masking
+ */
+static void fill_result(lv_opa_t * mask_buf, lv_draw_mask_res_t res, lv_coord_t len)
+{
+    if(res == LV_DRAW_MASK_RES_TRANSP) memset(mask_buf, LV_OPA_TRANSP, len);
+    else if(res == LV_DRAW_MASK_RES_FULL_COVER) memset(mask_buf, LV_OPA_COVER, len);
+}
+
+/**
+ * A simple deterministic pseudo random number in the `min..max` range
+ */
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return min + (lv_coord_t)((rnd_seed >> 16) % (max - min + 1));
+}
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file lv_test_draw_mask.h
+ *
+ */
+
+#ifndef LV_TEST_DRAW_MASK_H
+#define LV_TEST_DRAW_MASK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+void lv_test_draw_mask(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TEST_DRAW_MASK_H*/
@@ -0,0 +1,178 @@
+/**
+ * @file lv_test_draw_rect.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_draw_rect.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_SHADOW_R       4       /*Radius of the shadows*/
+#define TEST_SHADOW_CNT     (LV_SHADOW_CACHE_ENTRY_CNT + 2)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+static void shadow_cache(void);
+static void draw_shadow(lv_obj_t * obj, lv_coord_t sw, lv_draw_shadow_cache_stat_t * stat);
+static lv_coord_t shadow_width(uint32_t i);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_rect(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_rect tests");
+    lv_test_print("========================");
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    shadow_cache();
+#else
+    lv_test_print("SKIP: shadow cache test because it requires LV_USE_SHADOW 1 and LV_SHADOW_CACHE_SIZE > 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+
+/**
+ * Draw more different shadows than `LV_SHADOW_CACHE_ENTRY_CNT` and check the statistics of the cache.
+ * The shadow might be drawn in more parts (e.g. in tiles) but only the first part should calculate it.
+ */
+static void shadow_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Cache the shadows:");
+    lv_test_print("------------------");
+
+    lv_draw_shadow_cache_clean();
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_reset_style_list(obj, LV_OBJ_PART_MAIN);
+    lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, TEST_SHADOW_R);
+    lv_obj_set_style_local_shadow_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_pos(obj, 30, 30);
+    lv_obj_set_size(obj, 40, 40);
+
+    lv_draw_shadow_cache_stat_t stat_prev;
+    lv_draw_shadow_cache_stat_t stat;
+    lv_draw_shadow_cache_get_stat(&stat_prev);
+    lv_test_assert_int_eq(0, stat_prev.entry_cnt, "no shadows after clean");
+    lv_test_assert_int_eq(0, stat_prev.mem_size, "no memory after clean");
+
+    uint32_t i;
+    for(i = 0; i < TEST_SHADOW_CNT; i++) {
+        draw_shadow(obj, shadow_width(i), &stat);
+        lv_test_assert_int_eq(1, stat.miss_cnt - stat_prev.miss_cnt, "a new shadow is calculated once");
+        if(i < LV_SHADOW_CACHE_ENTRY_CNT) {
+            lv_test_assert_int_eq(i + 1, stat.entry_cnt, "a new shadow is added");
+            lv_test_assert_int_eq(0, stat.evict_cnt - stat_prev.evict_cnt, "no shadow is evicted");
+        }
+        else {
+            lv_test_assert_int_eq(LV_SHADOW_CACHE_ENTRY_CNT, stat.entry_cnt, "the cache is full");
+            lv_test_assert_int_eq(1, stat.evict_cnt - stat_prev.evict_cnt, "the oldest shadow is evicted");
+        }
+        lv_test_assert_true(stat.mem_size <= LV_SHADOW_CACHE_MEM_SIZE, "the memory is in the limit");
+        stat_prev = stat;
+    }
+
+    /*The memory of the last `LV_SHADOW_CACHE_ENTRY_CNT` corners*/
+    uint32_t mem_size = 0;
+    for(i = TEST_SHADOW_CNT - LV_SHADOW_CACHE_ENTRY_CNT; i < TEST_SHADOW_CNT; i++) {
+        uint32_t size = shadow_width(i) + TEST_SHADOW_R;
+        mem_size += size * size;
+    }
+    lv_test_assert_int_eq(mem_size, stat.mem_size, "the memory of the cached shadows");
+
+    /*The oldest cached shadow is a hit and becomes the most recently used*/
+    draw_shadow(obj, shadow_width(TEST_SHADOW_CNT - LV_SHADOW_CACHE_ENTRY_CNT), &stat);
+    lv_test_assert_int_eq(0, stat.miss_cnt - stat_prev.miss_cnt, "no miss on a cached shadow");
+    lv_test_assert_int_gt(0, stat.hit_cnt - stat_prev.hit_cnt, "hit on a cached shadow");
+    lv_test_assert_int_eq(0, stat.evict_cnt - stat_prev.evict_cnt, "no evict on a cached shadow");
+    stat_prev = stat;
+
+    /*So the next new shadow evicts the second oldest*/
+    draw_shadow(obj, shadow_width(0), &stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt - stat_prev.miss_cnt, "an evicted shadow is calculated again");
+    lv_test_assert_int_eq(1, stat.evict_cnt - stat_prev.evict_cnt, "the least recently used shadow is evicted");
+    stat_prev = stat;
+
+    draw_shadow(obj, shadow_width(TEST_SHADOW_CNT - LV_SHADOW_CACHE_ENTRY_CNT), &stat);
+    lv_test_assert_int_eq(0, stat.miss_cnt - stat_prev.miss_cnt, "the recently used shadow is kept");
+    stat_prev = stat;
+
+    draw_shadow(obj, shadow_width(TEST_SHADOW_CNT - LV_SHADOW_CACHE_ENTRY_CNT + 1), &stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt - stat_prev.miss_cnt, "the least recently used shadow was evicted");
+    stat_prev = stat;
+
+    /*Too large shadows are not cached*/
+    draw_shadow(obj, LV_SHADOW_CACHE_SIZE, &stat);
+    lv_test_assert_int_eq(0, stat.evict_cnt - stat_prev.evict_cnt, "a large shadow evicts nothing");
+    lv_test_assert_int_eq(LV_SHADOW_CACHE_ENTRY_CNT, stat.entry_cnt, "a large shadow is not cached");
+    lv_test_assert_int_gt(0, stat.miss_cnt - stat_prev.miss_cnt, "a large shadow is always calculated");
+
+    lv_obj_del(obj);
+    lv_refr_now(NULL);
+
+    lv_draw_shadow_cache_clean();
+    lv_draw_shadow_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "no shadows after clean");
+    lv_test_assert_int_eq(0, stat.mem_size, "no memory after clean");
+}
+
+/**
+ * Set the shadow width of an object and refresh the object
+ * @param obj pointer to an object
+ * @param sw the new shadow width
+ * @param stat store the statistics of the shadow cache after the refresh here
+ */
+static void draw_shadow(lv_obj_t * obj, lv_coord_t sw, lv_draw_shadow_cache_stat_t * stat)
+{
+    lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, sw);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_draw_shadow_cache_get_stat(stat);
+}
+
+/**
+ * The shadow widths to use. The corners (`sw + r`) are smaller than `LV_SHADOW_CACHE_SIZE`.
+ * @param i index of the shadow
+ * @return a shadow width
+ */
+static lv_coord_t shadow_width(uint32_t i)
+{
+    return 2 + i * 2;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file lv_test_font_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_font_cache.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_GLYPH_MAX      256     /*Max. number of glyphs to load*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE && LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+static void glyph_cache(void);
+static uint32_t collect_glyphs(const lv_font_t * font);
+static void model_add(uint32_t letter, uint32_t size);
+static void model_use(uint32_t letter);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE && LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+static uint32_t letters[TEST_GLYPH_MAX];
+static uint32_t sizes[TEST_GLYPH_MAX];
+
+/*The expected content of the cache. The most recently used is the first.*/
+static uint32_t model_letters[TEST_GLYPH_MAX];
+static uint32_t model_sizes[TEST_GLYPH_MAX];
+static uint32_t model_cnt;
+static uint32_t model_mem_size;
+static uint32_t model_evict_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_font_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("=========================");
+    lv_test_print("Start lv_font cache tests");
+    lv_test_print("=========================");
+
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE && LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+    glyph_cache();
+#else
+    lv_test_print("SKIP: glyph cache test because it requires LV_FONT_GLYPH_CACHE_MEM_SIZE > 0, "
+                  "LV_USE_FONT_COMPRESSED 1 and LV_FONT_MONTSERRAT_28_COMPRESSED 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_FONT_GLYPH_CACHE_MEM_SIZE && LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28_COMPRESSED
+
+/**
+ * Decompress more glyphs than `LV_FONT_GLYPH_CACHE_MEM_SIZE` and compare the statistics of the cache
+ * with a simple least recently used model.
+ */
+static void glyph_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Cache the decompressed glyphs:");
+    lv_test_print("------------------------------");
+
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    uint32_t glyph_cnt = collect_glyphs(font);
+
+    uint32_t size_sum = 0;
+    uint32_t i;
+    for(i = 0; i < glyph_cnt; i++) size_sum += sizes[i];
+    if(size_sum <= LV_FONT_GLYPH_CACHE_MEM_SIZE) {
+        lv_test_print("SKIP: glyph cache test because the glyphs of the font fit into LV_FONT_GLYPH_CACHE_MEM_SIZE");
+        return;
+    }
+
+    lv_font_glyph_cache_clean();
+
+    lv_font_glyph_cache_stat_t stat_prev;
+    lv_font_glyph_cache_stat_t stat;
+    lv_font_glyph_cache_get_stat(&stat_prev);
+    lv_test_assert_int_eq(0, stat_prev.entry_cnt, "no glyphs after clean");
+    lv_test_assert_int_eq(0, stat_prev.mem_size, "no memory after clean");
+
+    /*The statistics are not reset by clean*/
+    model_cnt = 0;
+    model_mem_size = 0;
+    model_evict_cnt = stat_prev.evict_cnt;
+    uint32_t evict_cnt_start = stat_prev.evict_cnt;
+
+    /*Count the errors to not flood the log with an assert for every glyph*/
+    uint32_t miss_err_cnt = 0;
+    uint32_t hit_err_cnt = 0;
+    uint32_t mem_err_cnt = 0;
+    for(i = 0; i < glyph_cnt; i++) {
+        /*A new glyph is a miss and it's added to the cache*/
+        lv_font_get_glyph_bitmap(font, letters[i]);
+        model_add(letters[i], sizes[i]);
+        lv_font_glyph_cache_get_stat(&stat);
+        if(stat.miss_cnt - stat_prev.miss_cnt != 1 || stat.hit_cnt != stat_prev.hit_cnt) miss_err_cnt++;
+        stat_prev = stat;
+
+        /*It's a hit the next time*/
+        lv_font_get_glyph_bitmap(font, letters[i]);
+        lv_font_glyph_cache_get_stat(&stat);
+        if(stat.hit_cnt - stat_prev.hit_cnt != 1 || stat.miss_cnt != stat_prev.miss_cnt) hit_err_cnt++;
+        stat_prev = stat;
+
+        if(stat.mem_size > LV_FONT_GLYPH_CACHE_MEM_SIZE) mem_err_cnt++;
+    }
+
+    lv_test_assert_int_eq(0, miss_err_cnt, "the new glyphs are misses");
+    lv_test_assert_int_eq(0, hit_err_cnt, "the cached glyphs are hits");
+    lv_test_assert_int_eq(0, mem_err_cnt, "the memory is always in the limit");
+    lv_test_assert_int_gt(evict_cnt_start, stat.evict_cnt, "glyphs are evicted");
+    lv_test_assert_int_eq(model_evict_cnt, stat.evict_cnt, "the least recently used glyphs are evicted");
+    lv_test_assert_int_eq(model_cnt, stat.entry_cnt, "number of cached glyphs");
+    lv_test_assert_int_eq(model_mem_size, stat.mem_size, "memory of the cached glyphs");
+
+    /*Use the oldest cached glyph to keep it when the first (evicted) glyph is loaded again*/
+    uint32_t oldest = model_letters[model_cnt - 1];
+    lv_font_get_glyph_bitmap(font, oldest);
+    model_use(oldest);
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat_prev.hit_cnt + 1, stat.hit_cnt, "the oldest glyph is still cached");
+    stat_prev = stat;
+
+    lv_font_get_glyph_bitmap(font, letters[0]);
+    model_add(letters[0], sizes[0]);
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat_prev.miss_cnt + 1, stat.miss_cnt, "the first glyph was evicted");
+    lv_test_assert_int_eq(model_evict_cnt, stat.evict_cnt, "the least recently used glyphs are evicted again");
+    lv_test_assert_int_eq(model_mem_size, stat.mem_size, "memory of the cached glyphs again");
+    stat_prev = stat;
+
+    lv_font_get_glyph_bitmap(font, oldest);
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat_prev.hit_cnt + 1, stat.hit_cnt, "the recently used glyph is kept");
+
+    lv_font_glyph_cache_drop_font(font);
+    lv_font_glyph_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "no glyphs after dropping the font");
+    lv_test_assert_int_eq(0, stat.mem_size, "no memory after dropping the font");
+}
+
+/**
+ * Collect the letters with a bitmap and the size of their decompressed bitmap
+ * @param font pointer to a font
+ * @return number of letters in `letters` and `sizes`
+ */
+static uint32_t collect_glyphs(const lv_font_t * font)
+{
+    uint32_t cnt = 0;
+    uint32_t letter;
+    for(letter = 0x21; letter <= 0xF8FF && cnt < TEST_GLYPH_MAX; letter++) {
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) continue;
+        uint32_t px_cnt = (uint32_t)g.box_w * g.box_h;
+        if(px_cnt == 0) continue;
+
+        /*Compressed 3 bpp glyphs are decompressed to 4 bpp*/
+        uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+        letters[cnt] = letter;
+        sizes[cnt] = (px_cnt * bpp + 7) >> 3;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+/**
+ * Add a glyph to the model as the most recently used and drop the least recently used glyphs to stay in the limit
+ * @param letter an UNICODE letter
+ * @param size size of the bitmap
+ */
+static void model_add(uint32_t letter, uint32_t size)
+{
+    while(model_mem_size + size > LV_FONT_GLYPH_CACHE_MEM_SIZE && model_cnt > 0) {
+        model_cnt--;
+        model_mem_size -= model_sizes[model_cnt];
+        model_evict_cnt++;
+    }
+
+    memmove(&model_letters[1], &model_letters[0], model_cnt * sizeof(model_letters[0]));
+    memmove(&model_sizes[1], &model_sizes[0], model_cnt * sizeof(model_sizes[0]));
+    model_letters[0] = letter;
+    model_sizes[0] = size;
+    model_cnt++;
+    model_mem_size += size;
+}
+
+/**
+ * Make a glyph of the model the most recently used
+ * @param letter an UNICODE letter
+ */
+static void model_use(uint32_t letter)
+{
+    uint32_t i;
+    for(i = 0; i < model_cnt; i++) {
+        if(model_letters[i] == letter) break;
+    }
+    if(i == model_cnt) return;
+
+    uint32_t size = model_sizes[i];
+    memmove(&model_letters[1], &model_letters[0], i * sizeof(model_letters[0]));
+    memmove(&model_sizes[1], &model_sizes[0], i * sizeof(model_sizes[0]));
+    model_letters[0] = letter;
+    model_sizes[0] = size;
+}
+
+#endif
+
+#endif
@@ -33,6 +33,7 @@
 
 #if LV_USE_FILESYSTEM
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_lazy_font(lv_font_t * f1, lv_font_t * f2);
 #endif
 
 /**********************
@@ -67,9 +68,28 @@ void lv_test_font_loader(void)
     compare_fonts(&font_2, font_2_bin);
     compare_fonts(&font_3, font_3_bin);
 
-    lv_font_free(font_1_bin);
     lv_font_free(font_2_bin);
     lv_font_free(font_3_bin);
+
+    /*The lazily loaded glyphs should be the same as the glyphs loaded at once*/
+    lv_font_t * font_1_lazy = lv_font_load_lazy("f:font_1.fnt");
+    compare_lazy_font(font_1_bin, font_1_lazy);
+
+#if LV_USE_FS_POSIX
+    /*The glyphs of the fonts loaded from a mapped file should be the same*/
+    lv_font_t * font_2_mapped = lv_font_load("P:font_2.fnt");
+    compare_fonts(&font_2, font_2_mapped);
+    lv_font_free(font_2_mapped);
+
+    lv_font_t * font_1_mapped = lv_font_load_lazy("P:font_1.fnt");
+    compare_lazy_font(font_1_bin, font_1_mapped);
+    lv_font_free(font_1_mapped);
+#endif
+
+    lv_font_free(font_1_bin);
+    lv_font_free(font_1_lazy);
+
+    lv_test_assert_true(lv_font_load_lazy("f:not_exist.fnt") == NULL, "lazy load of a missing file");
 #else
     lv_test_print("SKIP: font load test because it requires LV_USE_FILESYSTEM 1 and LV_FONT_FMT_TXT_LARGE 0");
 #endif
@@ -200,7 +220,7 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
                 lv_test_assert_array_eq(
                         dsc1->glyph_bitmap + glyph_dsc1[i].bitmap_index,
                         dsc2->glyph_bitmap + glyph_dsc2[i].bitmap_index,
-                        size1 - 1, "glyph_bitmap");
+                        size1, "glyph_bitmap");
             }
         }
         lv_test_assert_int_eq(glyph_dsc1[i].adv_w, glyph_dsc2[i].adv_w, "adv_w");
@@ -215,6 +235,65 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 }
 #endif
 
+#if LV_USE_FILESYSTEM
+/*Compare the glyphs of a lazily loaded font with the glyphs of the same font loaded at once through the font API*/
+static void compare_lazy_font(lv_font_t * f1, lv_font_t * f2)
+{
+    static uint8_t bitmap1[1024];
+
+    lv_test_assert_true(f1 != NULL && f2 != NULL, "font not null");
+    lv_test_assert_int_eq(f1->line_height, f2->line_height, "line_height");
+    lv_test_assert_int_eq(f1->base_line, f2->base_line, "base_line");
+
+    lv_font_fmt_txt_dsc_t * dsc1 = (lv_font_fmt_txt_dsc_t *) f1->dsc;
+    lv_font_fmt_txt_dsc_t * dsc2 = (lv_font_fmt_txt_dsc_t *) f2->dsc;
+    lv_test_assert_ptr_eq(NULL, dsc2->glyph_dsc, "lazy glyph_dsc");
+    lv_test_assert_ptr_eq(NULL, dsc2->glyph_bitmap, "lazy glyph_bitmap");
+
+    /*Count the differing glyphs to not flood the log with an assert for every glyph*/
+    uint32_t glyph_cnt = 0;
+    uint32_t dsc_err_cnt = 0;
+    uint32_t bitmap_err_cnt = 0;
+
+    for(int i = 0; i < dsc1->cmap_num; ++i) {
+        uint32_t letter;
+        uint32_t letter_end = dsc1->cmaps[i].range_start + dsc1->cmaps[i].range_length;
+        for(letter = dsc1->cmaps[i].range_start; letter < letter_end; letter++) {
+            lv_font_glyph_dsc_t g1;
+            lv_font_glyph_dsc_t g2;
+            bool ret1 = lv_font_get_glyph_dsc(f1, &g1, letter, letter + 1);
+            bool ret2 = lv_font_get_glyph_dsc(f2, &g2, letter, letter + 1);
+            if(ret1 != ret2) {
+                dsc_err_cnt++;
+                continue;
+            }
+            if(!ret1) continue;
+
+            glyph_cnt++;
+            if(g1.adv_w != g2.adv_w || g1.box_w != g2.box_w || g1.box_h != g2.box_h ||
+               g1.ofs_x != g2.ofs_x || g1.ofs_y != g2.ofs_y) {
+                dsc_err_cnt++;
+                continue;
+            }
+
+            /*Compressed 3 bpp glyphs are decompressed to 4 bpp*/
+            uint32_t bpp = (g1.bpp == 3 && dsc1->bitmap_format != LV_FONT_FMT_TXT_PLAIN) ? 4 : g1.bpp;
+            uint32_t size = (g1.box_w * g1.box_h * bpp + 7) / 8;
+            if(size == 0 || size > sizeof(bitmap1)) continue;
+
+            /*The decompressed bitmaps might be in the same buffer so save the first*/
+            memcpy(bitmap1, lv_font_get_glyph_bitmap(f1, letter), size);
+            const uint8_t * bitmap2 = lv_font_get_glyph_bitmap(f2, letter);
+            if(bitmap2 == NULL || memcmp(bitmap1, bitmap2, size) != 0) bitmap_err_cnt++;
+        }
+    }
+
+    lv_test_assert_int_gt(0, glyph_cnt, "lazy glyphs compared");
+    lv_test_assert_int_eq(0, dsc_err_cnt, "lazy glyph_dsc mismatches");
+    lv_test_assert_int_eq(0, bitmap_err_cnt, "lazy glyph_bitmap mismatches");
+}
+#endif
+
 #pragma GCC diagnostic pop
 /**********************
  *   STATIC FUNCTIONS
@@ -0,0 +1,219 @@
+/**
+ * @file lv_test_fs.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_fs.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_FILE_MAX   (8 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+static void posix_overwrite(void);
+#if LV_USE_FS_PACK
+static void pack_read_fonts(void);
+static void pack_load_font(void);
+static uint32_t read_file(const char * path, uint8_t * buf);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_fs(void)
+{
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+    lv_test_print("");
+    lv_test_print("=================");
+    lv_test_print("Start lv_fs tests");
+    lv_test_print("=================");
+
+    posix_overwrite();
+#if LV_USE_FS_PACK
+    pack_read_fonts();
+    pack_load_font();
+#endif
+#else
+    lv_test_print("SKIP: file system test because it requires LV_USE_FILESYSTEM 1 and LV_USE_FS_POSIX 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+
+/**
+ * Opening a file for writing should truncate it
+ */
+static void posix_overwrite(void)
+{
+    lv_test_print("");
+    lv_test_print("Overwrite a file with the POSIX driver:");
+    lv_test_print("---------------------------------------");
+
+    static const char path[] = "P:lv_test_fs.tmp";
+    lv_fs_file_t f;
+    uint32_t bw;
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR), "open for write");
+    lv_fs_write(&f, "long content", 12, &bw);
+    lv_fs_close(&f);
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR), "open again for write");
+    lv_fs_write(&f, "short", 5, &bw);
+    lv_fs_close(&f);
+
+    char buf[16];
+    uint32_t br = 0;
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD), "open for read");
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_fs_close(&f);
+
+    lv_test_assert_int_eq(5, br, "size of the overwritten file");
+    lv_test_assert_array_eq((const uint8_t *)"short", (const uint8_t *)buf, 5, "content of the overwritten file");
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_remove(path), "remove the file");
+}
+
+#if LV_USE_FS_PACK
+
+extern lv_font_t font_1;
+
+/**
+ * Mount the archives of the test fonts created by `build.py` with `scripts/lv_pack.py`
+ * and compare their files with the original files:
+ * - 'A': opened with the POSIX driver so it's mapped
+ * - 'B': opened with the driver of the tests which can't map so it's read
+ * - 'C': compressed, opened with the driver of the tests
+ */
+static void pack_read_fonts(void)
+{
+    lv_test_print("");
+    lv_test_print("Read the files of an archive:");
+    lv_test_print("-----------------------------");
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_pack_mount('A', "P:lv_test_fonts.lvpk"), "mount a mapped archive");
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_pack_mount('B', "f:lv_test_fonts.lvpk"), "mount a read archive");
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_pack_mount('C', "f:lv_test_fonts_rle.lvpk"),
+                          "mount a compressed archive");
+    lv_test_assert_int_eq(LV_FS_RES_NOT_EX, lv_fs_pack_mount('D', "P:not_exist.lvpk"), "mount a missing archive");
+
+    static uint8_t ref_buf[TEST_FILE_MAX];
+    static uint8_t act_buf[TEST_FILE_MAX];
+    static const char * names[] = {"font_1.fnt", "font_2.fnt", "font_3.fnt"};
+    static const char letters[] = {'A', 'B', 'C'};
+    char path[32];
+    uint32_t i;
+    uint32_t l;
+    for(i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        lv_snprintf(path, sizeof(path), "f:%s", names[i]);
+        uint32_t ref_size = read_file(path, ref_buf);
+        lv_test_assert_int_gt(0, ref_size, "size of the original file");
+
+        for(l = 0; l < sizeof(letters); l++) {
+            lv_snprintf(path, sizeof(path), "%c:%s", letters[l], names[i]);
+            uint32_t act_size = read_file(path, act_buf);
+            lv_test_assert_int_eq(ref_size, act_size, "size of the packed file");
+            lv_test_assert_array_eq(ref_buf, act_buf, ref_size, "content of the packed file");
+        }
+    }
+
+    /*The files of the mapped archive can be mapped too*/
+    lv_fs_file_t f;
+    const void * map = NULL;
+    uint32_t map_size = 0;
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "A:font_1.fnt", LV_FS_MODE_RD), "open a packed file");
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_map(&f, &map, &map_size), "map a packed file");
+    lv_fs_close(&f);
+    uint32_t ref_size = read_file("f:font_1.fnt", ref_buf);
+    lv_test_assert_int_eq(ref_size, map_size, "size of the mapped file");
+    if(map) lv_test_assert_array_eq(ref_buf, map, ref_size, "content of the mapped file");
+
+    lv_test_assert_int_eq(LV_FS_RES_NOT_EX, lv_fs_open(&f, "A:not_exist.fnt", LV_FS_MODE_RD), "open a missing file");
+    lv_test_assert_int_eq(LV_FS_RES_NOT_EX, lv_fs_open(&f, "B:font_1", LV_FS_MODE_RD), "open a prefix of a file");
+    lv_test_assert_int_eq(LV_FS_RES_DENIED, lv_fs_open(&f, "B:font_1.fnt", LV_FS_MODE_WR), "open a file for write");
+}
+
+/**
+ * Load a font from every archive and compare its glyphs with the built-in font
+ */
+static void pack_load_font(void)
+{
+    lv_test_print("");
+    lv_test_print("Load a font from an archive:");
+    lv_test_print("----------------------------");
+
+    static const char * paths[] = {"A:font_1.fnt", "B:font_1.fnt", "C:font_1.fnt"};
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_font_t * font = lv_font_load(paths[i]);
+        lv_test_assert_true(font != NULL, "font loaded from the archive");
+        if(font == NULL) continue;
+
+        uint32_t err_cnt = 0;
+        uint32_t letter;
+        for(letter = 0x20; letter < 0x7F; letter++) {
+            lv_font_glyph_dsc_t g1;
+            lv_font_glyph_dsc_t g2;
+            bool ret1 = lv_font_get_glyph_dsc(&font_1, &g1, letter, 0);
+            bool ret2 = lv_font_get_glyph_dsc(font, &g2, letter, 0);
+            if(ret1 != ret2) err_cnt++;
+            else if(ret1 && (g1.adv_w != g2.adv_w || g1.box_w != g2.box_w || g1.box_h != g2.box_h ||
+                             g1.ofs_x != g2.ofs_x || g1.ofs_y != g2.ofs_y || g1.bpp != g2.bpp)) err_cnt++;
+        }
+        lv_test_assert_int_eq(0, err_cnt, "glyphs different from the built-in font");
+
+        lv_font_free(font);
+    }
+}
+
+/**
+ * Read a whole file
+ * @param path path of the file
+ * @param buf store the content here (`TEST_FILE_MAX` bytes)
+ * @return size of the file or 0 on error
+ */
+static uint32_t read_file(const char * path, uint8_t * buf)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return 0;
+
+    uint32_t br = 0;
+    lv_fs_read(&f, buf, TEST_FILE_MAX, &br);
+    lv_fs_close(&f);
+
+    return br;
+}
+
+#endif
+
+#endif
+
+#endif
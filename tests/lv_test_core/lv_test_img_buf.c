@@ -0,0 +1,178 @@
+/**
+ * @file lv_test_img_buf.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_buf.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_CONFIG_NUM     2000
+#define TEST_SRC_MAX        40
+#define TEST_LINE_MAX       160
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static void transform_line_same_as_px(void);
+static void init_random_src(lv_img_transform_dsc_t * dsc);
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static uint32_t rnd_seed;
+static uint8_t src_buf[TEST_SRC_MAX * TEST_SRC_MAX * LV_IMG_PX_SIZE_ALPHA_BYTE + 256 * sizeof(lv_color32_t)];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_buf(void)
+{
+#if LV_USE_IMG_TRANSFORM
+    lv_test_print("");
+    lv_test_print("======================");
+    lv_test_print("Start lv_img_buf tests");
+    lv_test_print("======================");
+
+    transform_line_same_as_px();
+#else
+    lv_test_print("SKIP: image buffer test because it requires LV_USE_IMG_TRANSFORM 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_IMG_TRANSFORM
+
+/**
+ * Transform random images with random angle, zoom and pivot
+ * and compare `_lv_img_buf_transform_line()` with `_lv_img_buf_transform()` called for every pixel.
+ */
+static void transform_line_same_as_px(void)
+{
+    lv_test_print("");
+    lv_test_print("Compare the line transformation with the pixel transformation:");
+    lv_test_print("---------------------------------------------------------------");
+
+    static lv_color_t color_buf[TEST_LINE_MAX];
+    static lv_opa_t opa_buf[TEST_LINE_MAX];
+
+    rnd_seed = 2468;
+
+    uint32_t px_cnt = 0;
+    uint32_t visible_cnt = 0;
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < TEST_CONFIG_NUM; i++) {
+        lv_img_transform_dsc_t dsc_line;
+        _lv_memset_00(&dsc_line, sizeof(dsc_line));
+        init_random_src(&dsc_line);
+        dsc_line.cfg.pivot_x = rnd(-10, dsc_line.cfg.src_w + 10);
+        dsc_line.cfg.pivot_y = rnd(-10, dsc_line.cfg.src_h + 10);
+        dsc_line.cfg.angle = rnd(0, 3) == 0 ? 0 : rnd(0, 3599);
+        dsc_line.cfg.zoom = rnd(0, 3) == 0 ? LV_IMG_ZOOM_NONE : rnd(32, 1024);
+        dsc_line.cfg.color = lv_color_make(rnd(0, 255), rnd(0, 255), rnd(0, 255));
+        dsc_line.cfg.antialias = rnd(0, 1) ? true : false;
+
+        lv_img_transform_dsc_t dsc_px;
+        _lv_memcpy(&dsc_px, &dsc_line, sizeof(dsc_px));
+        _lv_img_buf_transform_init(&dsc_line);
+        _lv_img_buf_transform_init(&dsc_px);
+
+        /*Some lines through the transformed image*/
+        uint32_t line;
+        for(line = 0; line < 4; line++) {
+            lv_coord_t x = rnd(-2 * TEST_SRC_MAX, TEST_SRC_MAX / 2);
+            lv_coord_t y = rnd(-TEST_SRC_MAX, 2 * TEST_SRC_MAX);
+            lv_coord_t len = rnd(1, TEST_LINE_MAX);
+            _lv_img_buf_transform_line(&dsc_line, x, y, len, color_buf, opa_buf);
+
+            lv_coord_t p;
+            for(p = 0; p < len; p++) {
+                px_cnt++;
+                bool ret = _lv_img_buf_transform(&dsc_px, x + p, y);
+                lv_opa_t opa = ret ? dsc_px.res.opa : LV_OPA_TRANSP;
+                if(opa_buf[p] != opa) {
+                    diff_cnt++;
+                    continue;
+                }
+                if(opa == LV_OPA_TRANSP) continue;
+
+                visible_cnt++;
+                /*The alpha byte of the 32 bit colors is not used*/
+                if((lv_color_to32(color_buf[p]) & 0xFFFFFF) != (lv_color_to32(dsc_px.res.color) & 0xFFFFFF)) diff_cnt++;
+            }
+        }
+    }
+
+    lv_test_assert_int_gt(px_cnt / 20, visible_cnt, "visible pixels");
+    lv_test_assert_int_eq(0, diff_cnt, "different pixels");
+}
+
+/**
+ * Fill the source image with random pixels in a random color format
+ * @param dsc set the source image in its `cfg`
+ */
+static void init_random_src(lv_img_transform_dsc_t * dsc)
+{
+    static const lv_img_cf_t cfs[] = {
+        LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA, LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED,
+        LV_IMG_CF_INDEXED_1BIT, LV_IMG_CF_INDEXED_2BIT, LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_INDEXED_8BIT,
+        LV_IMG_CF_ALPHA_1BIT, LV_IMG_CF_ALPHA_2BIT, LV_IMG_CF_ALPHA_4BIT, LV_IMG_CF_ALPHA_8BIT
+    };
+
+    dsc->cfg.cf = cfs[rnd(0, sizeof(cfs) / sizeof(cfs[0]) - 1)];
+    dsc->cfg.src_w = rnd(1, TEST_SRC_MAX);
+    dsc->cfg.src_h = rnd(1, TEST_SRC_MAX);
+    dsc->cfg.src = src_buf;
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->cfg.src_w, dsc->cfg.src_h, dsc->cfg.cf);
+    uint32_t i;
+    for(i = 0; i < size; i++) src_buf[i] = (uint8_t)rnd(0, 255);
+
+    /*Make some pixels transparent*/
+    if(dsc->cfg.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_color_t ct = LV_COLOR_TRANSP;
+        uint32_t px_num = (uint32_t)dsc->cfg.src_w * dsc->cfg.src_h;
+        for(i = 0; i < px_num; i++) {
+            if(rnd(0, 3) == 0) _lv_memcpy_small(&src_buf[i * sizeof(lv_color_t)], &ct, sizeof(lv_color_t));
+        }
+    }
+}
+
+/**
+ * A simple deterministic pseudo random number in the `min..max` range
+ */
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return min + (lv_coord_t)((rnd_seed >> 16) % (max - min + 1));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+/**
+ * @file lv_test_img_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_cache.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_CNT        12
+#define TEST_IMG_W          256
+/*About 3 images fit into the limit*/
+#define TEST_IMG_H          (LV_IMG_CACHE_MEM_SIZE / (TEST_IMG_W * LV_COLOR_SIZE / 8) / 3)
+
+/*The test decoder opens these sources without a file*/
+#define TEST_SRC_PREFIX     "T:img_cache_"
+
+/*Opening the images is "slow" so the hits make them live longer*/
+#define TEST_TIME_TO_OPEN   10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE && LV_IMG_CACHE_MEM_SIZE
+static void mem_limit(void);
+static void open_img(uint32_t i);
+static const lv_img_cache_entry_t * find_entry(uint32_t i);
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE && LV_IMG_CACHE_MEM_SIZE
+static char srcs[TEST_IMG_CNT][32];
+static uint32_t open_err_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_img_cache tests");
+    lv_test_print("========================");
+
+#if LV_IMG_CACHE_DEF_SIZE && LV_IMG_CACHE_MEM_SIZE
+    mem_limit();
+#else
+    lv_test_print("SKIP: image cache test because it requires LV_IMG_CACHE_DEF_SIZE > 0 and LV_IMG_CACHE_MEM_SIZE > 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_CACHE_DEF_SIZE && LV_IMG_CACHE_MEM_SIZE
+
+/**
+ * Open more images decoded into the RAM than `LV_IMG_CACHE_MEM_SIZE` and check that the images with
+ * the least life are closed to stay in the limit while the others can be still found in the cache.
+ */
+static void mem_limit(void)
+{
+    lv_test_print("");
+    lv_test_print("Limit the memory of the decoded images:");
+    lv_test_print("---------------------------------------");
+
+    uint32_t img_size = lv_img_buf_get_img_size(TEST_IMG_W, TEST_IMG_H, LV_IMG_CF_TRUE_COLOR);
+    uint32_t fit_cnt = LV_IMG_CACHE_MEM_SIZE / img_size;
+    if(TEST_IMG_H == 0 || TEST_IMG_H > 2047 || fit_cnt + 1 > LV_IMG_CACHE_DEF_SIZE) {
+        lv_test_print("SKIP: image cache test because LV_IMG_CACHE_MEM_SIZE doesn't fit to LV_IMG_CACHE_DEF_SIZE");
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < TEST_IMG_CNT; i++) {
+        lv_snprintf(srcs[i], sizeof(srcs[i]), TEST_SRC_PREFIX "%d", i);
+    }
+
+    lv_img_decoder_t * decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, decoder_info);
+    lv_img_decoder_set_open_cb(decoder, decoder_open);
+    lv_img_decoder_set_close_cb(decoder, decoder_close);
+
+    lv_img_cache_invalidate_src(NULL);
+    open_err_cnt = 0;
+
+    lv_img_cache_stat_t stat_prev;
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&stat_prev);
+    lv_test_assert_int_eq(0, stat_prev.entry_cnt, "no images after invalidate");
+    lv_test_assert_int_eq(0, stat_prev.mem_size, "no memory after invalidate");
+
+    /*Fill the limit*/
+    for(i = 0; i < fit_cnt; i++) open_img(i);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(fit_cnt, stat.miss_cnt - stat_prev.miss_cnt, "the new images are misses");
+    lv_test_assert_int_eq(0, stat.evict_cnt - stat_prev.evict_cnt, "no images are evicted in the limit");
+    lv_test_assert_int_eq(fit_cnt, stat.entry_cnt, "the images are cached");
+    lv_test_assert_int_eq(fit_cnt * img_size, stat.mem_size, "the memory of the decoded images");
+    stat_prev = stat;
+
+    /*Use the first image to make it live longer. So the second is closed for the next image.*/
+    open_img(0);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.hit_cnt - stat_prev.hit_cnt, "the first image is a hit");
+    stat_prev = stat;
+
+    open_img(fit_cnt);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt - stat_prev.miss_cnt, "the new image is a miss");
+    lv_test_assert_int_eq(1, stat.evict_cnt - stat_prev.evict_cnt, "an image is evicted to stay in the limit");
+    lv_test_assert_int_eq(fit_cnt, stat.entry_cnt, "the number of images in the limit");
+    lv_test_assert_int_eq(fit_cnt * img_size, stat.mem_size, "the memory of the images in the limit");
+    lv_test_assert_true(find_entry(1) == NULL, "the image with the least life is evicted");
+
+    const lv_img_cache_entry_t * entry = find_entry(0);
+    lv_test_assert_true(entry != NULL, "the used image is kept");
+    if(entry) {
+        lv_test_assert_int_eq(1, entry->hit_cnt, "hit count of the used image");
+        lv_test_assert_int_eq(img_size, entry->mem_size, "memory of the used image");
+    }
+    stat_prev = stat;
+
+    /*Open the rest of the images and always stay in the limit*/
+    uint32_t mem_err_cnt = 0;
+    for(i = fit_cnt + 1; i < TEST_IMG_CNT; i++) {
+        open_img(i);
+        lv_img_cache_get_stat(&stat);
+        if(stat.mem_size > LV_IMG_CACHE_MEM_SIZE) mem_err_cnt++;
+    }
+    lv_test_assert_int_eq(0, mem_err_cnt, "the memory is always in the limit");
+    lv_test_assert_int_eq(TEST_IMG_CNT - fit_cnt - 1, stat.evict_cnt - stat_prev.evict_cnt, "an image is evicted for every new image");
+    lv_test_assert_true(find_entry(TEST_IMG_CNT - 1) != NULL, "the last image is cached");
+    stat_prev = stat;
+
+    /*The remaining images should be still found in their hash buckets*/
+    uint32_t cached_cnt = 0;
+    for(i = 0; i < TEST_IMG_CNT; i++) {
+        if(find_entry(i) == NULL) continue;
+        open_img(i);
+        cached_cnt++;
+    }
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(stat.entry_cnt, cached_cnt, "the cached images are found");
+    lv_test_assert_int_eq(cached_cnt, stat.hit_cnt - stat_prev.hit_cnt, "the cached images are hits");
+    lv_test_assert_int_eq(0, stat.miss_cnt - stat_prev.miss_cnt, "the cached images are not misses");
+    stat_prev = stat;
+
+    open_img(1);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt - stat_prev.miss_cnt, "the evicted image is opened again");
+    lv_test_assert_int_eq(0, open_err_cnt, "all images are opened");
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "no images after invalidate");
+    lv_test_assert_int_eq(0, stat.mem_size, "no memory after invalidate");
+
+    lv_img_decoder_delete(decoder);
+}
+
+/**
+ * Open a test image with the cache and release it
+ * @param i index of the image
+ */
+static void open_img(uint32_t i)
+{
+    lv_img_cache_entry_t * entry = _lv_img_cache_open(srcs[i], LV_COLOR_BLACK);
+    if(entry == NULL) {
+        open_err_cnt++;
+        return;
+    }
+
+    _lv_img_cache_release(entry, false);
+}
+
+/**
+ * Find a test image in the cache without opening it
+ * @param i index of the image
+ * @return the cache entry of the image or NULL if not cached
+ */
+static const lv_img_cache_entry_t * find_entry(uint32_t i)
+{
+    uint16_t id;
+    for(id = 0; id < LV_IMG_CACHE_DEF_SIZE; id++) {
+        const lv_img_cache_entry_t * entry = lv_img_cache_get_entry(id);
+        if(entry && strcmp(entry->dec_dsc.src, srcs[i]) == 0) return entry;
+    }
+
+    return NULL;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, TEST_SRC_PREFIX, strlen(TEST_SRC_PREFIX)) != 0) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->w = TEST_IMG_W;
+    header->h = TEST_IMG_H;
+    return LV_RES_OK;
+}
+
+/**
+ * "Decode" the image into the RAM
+ */
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    uint8_t * buf = lv_mem_alloc(size);
+    if(buf == NULL) return LV_RES_INV;
+
+    _lv_memset(buf, 0x55, size);
+    dsc->img_data = buf;
+    dsc->time_to_open = TEST_TIME_TO_OPEN;
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    lv_mem_free(dsc->img_data);
+    dsc->img_data = NULL;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ * @file lv_test_img_decoder.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_decoder.h"
+#include <stdio.h>
+#include <string.h>
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_W          60
+#define TEST_IMG_H          40
+#define TEST_CLIP_X         50
+#define TEST_CLIP_Y         50
+#define TEST_CLIP_W         41
+#define TEST_CLIP_H         27
+#define TEST_IMG_OFS_X      (-13)
+#define TEST_IMG_OFS_Y      (-9)
+
+/*The 'f' drive of the test reads the files with `fopen` relative to the working directory*/
+#define TEST_FILE_NAME      "lv_test_img_decoder.bin"
+#define TEST_FILE_PATH      "f:" TEST_FILE_NAME
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_FILESYSTEM && LV_USE_IMG
+static void file_same_as_variable(lv_img_cf_t cf, const char * name);
+static void read_last_line(void);
+static void init_random_img(lv_img_cf_t cf);
+static bool save_img(void);
+static void get_screen_area(uint32_t * buf);
+static uint32_t rnd(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_FILESYSTEM && LV_USE_IMG
+static uint32_t rnd_seed;
+static uint8_t img_data[TEST_IMG_W * TEST_IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t img_dsc;
+static lv_obj_t * clip_obj;
+static lv_obj_t * img_obj;
+static uint32_t ref_px[TEST_CLIP_W * TEST_CLIP_H];
+static uint32_t act_px[TEST_CLIP_W * TEST_CLIP_H];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_decoder(void)
+{
+    lv_test_print("");
+    lv_test_print("==========================");
+    lv_test_print("Start lv_img_decoder tests");
+    lv_test_print("==========================");
+
+#if LV_USE_FILESYSTEM && LV_USE_IMG
+    rnd_seed = 2468;
+
+    /*Clip the image on every side with a parent without background, border and padding*/
+    clip_obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_reset_style_list(clip_obj, LV_OBJ_PART_MAIN);
+    lv_obj_set_pos(clip_obj, TEST_CLIP_X, TEST_CLIP_Y);
+    lv_obj_set_size(clip_obj, TEST_CLIP_W, TEST_CLIP_H);
+    img_obj = lv_img_create(clip_obj, NULL);
+
+    file_same_as_variable(LV_IMG_CF_TRUE_COLOR, "true color");
+    file_same_as_variable(LV_IMG_CF_TRUE_COLOR_ALPHA, "true color alpha");
+#if LV_IMG_CF_INDEXED
+    file_same_as_variable(LV_IMG_CF_INDEXED_4BIT, "indexed 4 bit");
+#endif
+#if LV_IMG_CF_ALPHA
+    file_same_as_variable(LV_IMG_CF_ALPHA_2BIT, "alpha 2 bit");
+#endif
+    read_last_line();
+
+    lv_obj_del(clip_obj);
+    remove(TEST_FILE_NAME);
+#else
+    lv_test_print("SKIP: image decoder test because it requires LV_USE_FILESYSTEM 1 and LV_USE_IMG 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM && LV_USE_IMG
+
+/**
+ * Draw a random image from a variable and from a file which can't be mapped, clipped on every side.
+ * The file is read in blocks (through the readahead buffer if enabled) and should look the same.
+ * @param cf color format of the image
+ * @param name name of the color format to print
+ */
+static void file_same_as_variable(lv_img_cf_t cf, const char * name)
+{
+    char buf[64];
+    lv_snprintf(buf, sizeof(buf), "Draw a clipped %s image from a file", name);
+    lv_test_print("");
+    lv_test_print(buf);
+    uint32_t len = strlen(buf);
+    _lv_memset(buf, '-', len);
+    lv_test_print(buf);
+
+    /*The same variable and file are used with all formats so forget the old ones*/
+    lv_img_cache_invalidate_src(&img_dsc);
+    lv_img_cache_invalidate_src(TEST_FILE_PATH);
+
+    init_random_img(cf);
+    lv_test_assert_true(save_img(), "save the image file");
+
+    lv_img_set_src(img_obj, &img_dsc);
+    lv_obj_set_pos(img_obj, TEST_IMG_OFS_X, TEST_IMG_OFS_Y);
+    get_screen_area(ref_px);
+
+    lv_img_set_src(img_obj, TEST_FILE_PATH);
+    lv_obj_set_pos(img_obj, TEST_IMG_OFS_X, TEST_IMG_OFS_Y);
+    get_screen_area(act_px);
+
+    lv_test_assert_array_eq((uint8_t *)ref_px, (uint8_t *)act_px, sizeof(ref_px), "pixels of the image file");
+}
+
+/**
+ * Read the end of the last file directly. It's not mapped so it can't be opened into the memory
+ * and the last read runs to the end of the file (and the readahead buffer).
+ */
+static void read_last_line(void)
+{
+    lv_test_print("");
+    lv_test_print("Read the last line of an image file");
+    lv_test_print("-----------------------------------");
+
+    lv_img_cache_invalidate_src(TEST_FILE_PATH);
+
+    init_random_img(LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_test_assert_true(save_img(), "save the image file");
+
+    lv_img_decoder_dsc_t dsc;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, TEST_FILE_PATH, LV_COLOR_BLACK), "open the image file");
+    lv_test_assert_true(dsc.img_data == NULL, "the file is read in blocks");
+
+    /*The last 3 lines and the end of a line*/
+    static uint8_t line_buf[3 * TEST_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    lv_area_t a;
+    lv_area_set(&a, 0, TEST_IMG_H - 3, TEST_IMG_W - 1, TEST_IMG_H - 1);
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_read_area(&dsc, &a, line_buf), "read the last lines");
+    uint32_t size = 3 * TEST_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_test_assert_array_eq(&img_data[sizeof(img_data) - size], line_buf, size, "the last lines are the same");
+
+    lv_area_set(&a, TEST_IMG_W - 5, TEST_IMG_H - 1, TEST_IMG_W - 1, TEST_IMG_H - 1);
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_read_area(&dsc, &a, line_buf), "read the last pixels");
+    size = 5 * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_test_assert_array_eq(&img_data[sizeof(img_data) - size], line_buf, size, "the last pixels are the same");
+
+    /*Go back to the beginning after reading the end*/
+    lv_area_set(&a, 0, 0, TEST_IMG_W - 1, 0);
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_read_area(&dsc, &a, line_buf), "read the first line");
+    size = TEST_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_test_assert_array_eq(img_data, line_buf, size, "the first line is the same");
+
+    lv_img_decoder_close(&dsc);
+}
+
+/**
+ * Fill `img_dsc` with random pixels (and palette)
+ * @param cf color format of the image
+ */
+static void init_random_img(lv_img_cf_t cf)
+{
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.cf = cf;
+    img_dsc.header.w = TEST_IMG_W;
+    img_dsc.header.h = TEST_IMG_H;
+    img_dsc.data_size = lv_img_buf_get_img_size(TEST_IMG_W, TEST_IMG_H, cf);
+    img_dsc.data = img_data;
+
+    uint32_t i;
+    for(i = 0; i < img_dsc.data_size; i++) img_data[i] = (uint8_t)(rnd() >> 8);
+}
+
+/**
+ * Save `img_dsc` to the test file as a `.bin` image
+ * @return true: saved
+ */
+static bool save_img(void)
+{
+    FILE * fp = fopen(TEST_FILE_NAME, "wb");
+    if(fp == NULL) return false;
+
+    bool ok = fwrite(&img_dsc.header, sizeof(lv_img_header_t), 1, fp) == 1 &&
+              fwrite(img_dsc.data, img_dsc.data_size, 1, fp) == 1;
+    fclose(fp);
+
+    return ok;
+}
+
+/**
+ * Refresh the whole screen and get the pixels of the clipping object
+ * @param buf store the pixels here as 32 bit RGB
+ */
+static void get_screen_area(uint32_t * buf)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    extern lv_color_t test_fb[];
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < TEST_CLIP_H; y++) {
+        for(x = 0; x < TEST_CLIP_W; x++) {
+            lv_color_t c = test_fb[(TEST_CLIP_Y + y) * hor_res + TEST_CLIP_X + x];
+            buf[y * TEST_CLIP_W + x] = lv_color_to32(c) & 0xFFFFFF;
+        }
+    }
+}
+
+/**
+ * A simple deterministic pseudo random number
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return rnd_seed >> 16;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,258 @@
+/**
+ * @file lv_test_indev.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_indev.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_OBJ_NUM        40
+#define TEST_SCENE_SIZE     200
+#define TEST_POINT_STEP     3
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void del_indexed_screen(void);
+static void search_same_as_recursive(void);
+static void create_scene(lv_obj_t * scr, lv_obj_t ** objs);
+static void mutate_scene(lv_obj_t * scr, lv_obj_t ** objs);
+static void set_random_props(lv_obj_t * obj);
+static uint32_t compare_search(lv_obj_t * scr);
+static lv_obj_t * search_ref(lv_obj_t * obj, lv_point_t * point);
+static bool is_target(lv_obj_t * obj);
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_seed;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_indev(void)
+{
+    if(LV_MEM_CUSTOM == 0 && LV_MEM_SIZE < 12 * 1024) {
+        lv_test_print("SKIP: indev test because it requires LV_MEM_SIZE >= 12 kB for the objects");
+        return;
+    }
+
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_indev tests");
+    lv_test_print("====================");
+
+    del_indexed_screen();
+    search_same_as_recursive();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Delete a screen whose index is built. The index should be freed too.
+ */
+static void del_indexed_screen(void)
+{
+    lv_test_print("");
+    lv_test_print("Delete an indexed screen:");
+    lv_test_print("-------------------------");
+
+    static lv_obj_t * objs[TEST_OBJ_NUM];
+
+    /*Create the scene once without searching to allocate the lazily allocated buffers (e.g. of the styles)*/
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    rnd_seed = 1234;
+    create_scene(scr, objs);
+    lv_obj_del(scr);
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    scr = lv_obj_create(NULL, NULL);
+    rnd_seed = 1234;
+    create_scene(scr, objs);
+    lv_test_assert_int_eq(0, compare_search(scr), "points with different search result");
+    lv_obj_del(scr);
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    /*The fragmentation can change the free size by a few bytes. The index takes more than 1 kB.*/
+    lv_test_assert_true(mon_end.free_size + 64 >= mon_start.free_size, "the index of the deleted screen is freed");
+}
+
+/**
+ * Search the objects on a random scene with `lv_indev_search_obj()` and with a plain recursive search.
+ * The scene is changed a few times to check that the index of the screen is rebuilt.
+ */
+static void search_same_as_recursive(void)
+{
+    lv_test_print("");
+    lv_test_print("Compare the search with the recursive search:");
+    lv_test_print("---------------------------------------------");
+
+    static lv_obj_t * objs[TEST_OBJ_NUM];
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    rnd_seed = 4321;
+    create_scene(scr, objs);
+
+    uint32_t diff_cnt = compare_search(scr);
+    uint32_t round;
+    for(round = 0; round < 4; round++) {
+        mutate_scene(scr, objs);
+        diff_cnt += compare_search(scr);
+    }
+
+    lv_test_assert_int_eq(0, diff_cnt, "points with different search result");
+
+    lv_obj_del(scr);
+}
+
+static void create_scene(lv_obj_t * scr, lv_obj_t ** objs)
+{
+    uint32_t i;
+    for(i = 0; i < TEST_OBJ_NUM; i++) {
+        /*Create an object on the screen or on an earlier object*/
+        lv_coord_t parent_id = rnd(-1, (lv_coord_t)i - 1);
+        lv_obj_t * parent = parent_id < 0 ? scr : objs[parent_id];
+        objs[i] = lv_obj_create(parent, NULL);
+        set_random_props(objs[i]);
+    }
+}
+
+/**
+ * Move, hide, change and recreate a few objects
+ */
+static void mutate_scene(lv_obj_t * scr, lv_obj_t ** objs)
+{
+    uint32_t i;
+    for(i = 0; i < TEST_OBJ_NUM / 4; i++) {
+        uint32_t id = rnd(0, TEST_OBJ_NUM - 1);
+        if(objs[id] == NULL) continue;
+        switch(rnd(0, 3)) {
+            case 0:
+                set_random_props(objs[id]);
+                break;
+            case 1:
+                lv_obj_move_foreground(objs[id]);
+                break;
+            case 2:
+                lv_obj_set_parent(objs[id], scr);
+                break;
+            default: {
+                    /*Delete the object with its children and create a new object instead of it*/
+                    lv_obj_t * del = objs[id];
+                    lv_obj_t * parent = lv_obj_get_parent(del);
+                    uint32_t j;
+                    for(j = 0; j < TEST_OBJ_NUM; j++) {
+                        lv_obj_t * par = objs[j];
+                        while(par && par != del) par = lv_obj_get_parent(par);
+                        if(par) objs[j] = NULL;
+                    }
+                    lv_obj_del(del);
+                    objs[id] = lv_obj_create(parent, NULL);
+                    set_random_props(objs[id]);
+                }
+                break;
+        }
+    }
+}
+
+static void set_random_props(lv_obj_t * obj)
+{
+    lv_obj_set_pos(obj, rnd(-20, TEST_SCENE_SIZE / 2), rnd(-20, TEST_SCENE_SIZE / 2));
+    lv_obj_set_size(obj, rnd(1, TEST_SCENE_SIZE / 2), rnd(1, TEST_SCENE_SIZE / 2));
+    lv_obj_set_hidden(obj, rnd(0, 7) == 0);
+    lv_obj_set_click(obj, rnd(0, 7) != 0);
+    lv_obj_set_adv_hittest(obj, rnd(0, 15) == 0);
+    if(rnd(0, 7) == 0) lv_obj_add_state(obj, LV_STATE_DISABLED);
+    else lv_obj_clear_state(obj, LV_STATE_DISABLED);
+#if LV_USE_EXT_CLICK_AREA != LV_EXT_CLICK_AREA_OFF
+    if(rnd(0, 3) == 0) lv_obj_set_ext_click_area(obj, rnd(0, 5), rnd(0, 5), rnd(0, 5), rnd(0, 5));
+#endif
+}
+
+/**
+ * Search every few pixels of the scene and count the different results.
+ * The search is called twice to build the index of the screen, then it's compared.
+ */
+static uint32_t compare_search(lv_obj_t * scr)
+{
+    lv_point_t p = {10, 10};
+    lv_indev_search_obj(scr, &p);
+    lv_indev_search_obj(scr, &p);
+
+    uint32_t diff_cnt = 0;
+    for(p.y = -10; p.y < TEST_SCENE_SIZE; p.y += TEST_POINT_STEP) {
+        for(p.x = -10; p.x < TEST_SCENE_SIZE; p.x += TEST_POINT_STEP) {
+            if(lv_indev_search_obj(scr, &p) != search_ref(scr, &p)) diff_cnt++;
+        }
+    }
+
+    return diff_cnt;
+}
+
+/**
+ * The recursive search without the index
+ */
+static lv_obj_t * search_ref(lv_obj_t * obj, lv_point_t * point)
+{
+    if(lv_obj_hittest(obj, point) == false) return NULL;
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        lv_obj_t * found = search_ref(child, point);
+        if(found) return found;
+        child = lv_obj_get_child(obj, child);
+    }
+
+    return is_target(obj) ? obj : NULL;
+}
+
+static bool is_target(lv_obj_t * obj)
+{
+    if(lv_obj_get_click(obj) == false) return false;
+
+    lv_obj_t * par = obj;
+    while(par) {
+        if(lv_obj_get_hidden(par)) return false;
+        par = lv_obj_get_parent(par);
+    }
+
+    if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
+        if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) return false;
+    }
+
+    return true;
+}
+
+/**
+ * A simple deterministic pseudo random number in the `min..max` range
+ */
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return min + (lv_coord_t)((rnd_seed >> 16) % (max - min + 1));
+}
+
+#endif
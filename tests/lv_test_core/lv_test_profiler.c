@@ -0,0 +1,196 @@
+/**
+ * @file lv_test_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_profiler.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_PROFILER
+static void profile_frames(void);
+static void profile_radius_cache(void);
+static void dump_trace(void);
+static void trace_write_cb(const char * str, void * user_data);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_PROFILER
+static uint32_t trace_len;
+static uint32_t trace_event_cnt;
+static bool trace_begin_ok;
+static char trace_last[64];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_profiler(void)
+{
+#if LV_USE_PROFILER
+    lv_test_print("");
+    lv_test_print("=======================");
+    lv_test_print("Start lv_profiler tests");
+    lv_test_print("=======================");
+
+    profile_frames();
+    profile_radius_cache();
+    dump_trace();
+#else
+    lv_test_print("SKIP: profiler test because it requires LV_USE_PROFILER 1");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_PROFILER
+static void profile_frames(void)
+{
+    lv_test_print("");
+    lv_test_print("Profile the refreshing of a screen:");
+    lv_test_print("-----------------------------------");
+
+    lv_obj_t * btn = lv_btn_create(lv_scr_act(), NULL);
+    lv_obj_set_size(btn, 100, 50);
+
+    lv_profiler_clear();
+    lv_test_assert_int_eq(0, lv_profiler_get_event_cnt(), "event count after clear");
+
+    uint32_t frame_prev = lv_profiler_get_last_frame();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t frame = lv_profiler_get_last_frame();
+    lv_test_assert_int_eq(frame_prev + 1, frame, "a frame is finished");
+    lv_test_assert_int_gt(0, lv_profiler_get_event_cnt(), "events are recorded");
+
+    uint32_t frame_time = lv_profiler_get_sum(LV_PROFILER_FRAME_LAST, LV_PROFILER_PHASE_FRAME, NULL);
+    lv_test_assert_int_gt(0, frame_time, "frame time");
+    lv_test_assert_int_eq(frame_time, lv_profiler_get_sum(frame, LV_PROFILER_PHASE_FRAME, NULL), "frame time by ID");
+    lv_test_assert_int_gt(0, lv_profiler_get_sum(frame, LV_PROFILER_PHASE_DESIGN, "lv_btn"), "lv_btn design time");
+    lv_test_assert_int_eq(0, lv_profiler_get_sum(frame, LV_PROFILER_PHASE_DESIGN, "lv_not_exist"),
+                          "design time of a missing type");
+    lv_test_assert_true(lv_profiler_get_sum(frame, LV_PROFILER_PHASE_JOIN, NULL) <= frame_time,
+                        "join time is in the frame time");
+    lv_test_assert_int_eq(0, lv_profiler_get_sum(frame + 1, LV_PROFILER_PHASE_FRAME, NULL), "time of a future frame");
+
+    /*The frames, the design callbacks and the flush should be recorded*/
+    uint32_t phase_cnt[_LV_PROFILER_PHASE_NUM] = {0};
+    lv_profiler_event_t e;
+    uint32_t i;
+    for(i = 0; lv_profiler_get_event(i, &e); i++) {
+        if(e.frame == frame) phase_cnt[e.phase]++;
+    }
+    lv_test_assert_int_eq(lv_profiler_get_event_cnt(), i, "every event can be read");
+    lv_test_assert_int_eq(1, phase_cnt[LV_PROFILER_PHASE_FRAME], "frame events");
+    lv_test_assert_int_eq(1, phase_cnt[LV_PROFILER_PHASE_JOIN], "join events");
+    lv_test_assert_int_gt(0, phase_cnt[LV_PROFILER_PHASE_DESIGN], "design events");
+    lv_test_assert_int_gt(0, phase_cnt[LV_PROFILER_PHASE_FLUSH], "flush events");
+
+    /*Nothing is invalidated so nothing should be recorded*/
+    uint32_t event_cnt = lv_profiler_get_event_cnt();
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(frame, lv_profiler_get_last_frame(), "no frame without invalid areas");
+    lv_test_assert_int_eq(event_cnt, lv_profiler_get_event_cnt(), "no events without invalid areas");
+
+    lv_obj_del(btn);
+}
+
+static void profile_radius_cache(void)
+{
+#if LV_DRAW_MASK_RADIUS_CACHE_MEM_SIZE
+    lv_test_print("");
+    lv_test_print("Profile the rounded corner cache:");
+    lv_test_print("---------------------------------");
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(obj, 100, 50);
+    lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 17);
+
+    lv_draw_mask_radius_cache_stat_t stat_prev;
+    lv_draw_mask_radius_cache_stat_t stat;
+    lv_draw_mask_radius_cache_get_stat(&stat_prev);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_draw_mask_radius_cache_get_stat(&stat);
+
+    uint32_t hit_cnt = lv_profiler_get_cnt(LV_PROFILER_FRAME_LAST, LV_PROFILER_PHASE_CACHE, "radius_cache_hit");
+    uint32_t miss_cnt = lv_profiler_get_cnt(LV_PROFILER_FRAME_LAST, LV_PROFILER_PHASE_CACHE, "radius_cache_miss");
+    lv_test_assert_int_gt(0, hit_cnt + miss_cnt, "radius cache events");
+    lv_test_assert_int_eq(stat.hit_cnt - stat_prev.hit_cnt, hit_cnt, "radius cache hits");
+    lv_test_assert_int_eq(stat.miss_cnt - stat_prev.miss_cnt, miss_cnt, "radius cache misses");
+    lv_test_assert_int_eq(hit_cnt + miss_cnt, lv_profiler_get_cnt(LV_PROFILER_FRAME_LAST, LV_PROFILER_PHASE_CACHE, NULL),
+                          "cache events");
+
+    lv_obj_del(obj);
+#endif
+}
+
+static void dump_trace(void)
+{
+    lv_test_print("");
+    lv_test_print("Dump the trace of a frame:");
+    lv_test_print("--------------------------");
+
+    lv_profiler_clear();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    trace_len = 0;
+    trace_event_cnt = 0;
+    trace_begin_ok = false;
+    trace_last[0] = '\0';
+    lv_profiler_dump_trace(trace_write_cb, NULL);
+
+    lv_test_assert_true(trace_begin_ok, "trace begins with the event list");
+    lv_test_assert_int_eq(lv_profiler_get_event_cnt(), trace_event_cnt, "every event is in the trace");
+    lv_test_assert_str_eq("],\"displayTimeUnit\":\"ms\"}\n", trace_last, "trace ends with the display unit");
+
+    lv_profiler_clear();
+    lv_test_assert_int_eq(0, lv_profiler_get_event_cnt(), "event count after clear");
+    lv_profiler_event_t e;
+    lv_test_assert_true(lv_profiler_get_event(0, &e) == false, "no event after clear");
+}
+
+static void trace_write_cb(const char * str, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    if(trace_len == 0) trace_begin_ok = strcmp(str, "{\"traceEvents\":[\n") == 0;
+
+    /*Every event is written in one call*/
+    if(strstr(str, "\"ph\":\"X\"")) trace_event_cnt++;
+
+    trace_len += strlen(str);
+    strncpy(trace_last, str, sizeof(trace_last) - 1);
+    trace_last[sizeof(trace_last) - 1] = '\0';
+}
+#endif
+
+#endif
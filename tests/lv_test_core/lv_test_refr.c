@@ -0,0 +1,746 @@
+/**
+ * @file lv_test_refr.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_refr.h"
+#include <string.h>
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_REGION_SIZE    200
+#define TEST_ROUND_NUM      60
+#define TEST_FLUSH_MAX      256
+
+/*Marks the invalidated pixels in `px_map`. The lower bits count how many times the pixel was flushed*/
+#define TEST_PX_INV         0x80
+#define TEST_PX_CNT_MASK    0x7F
+
+#define TEST_TILE_IMG_W     32
+#define TEST_TILE_IMG_H     64
+#define TEST_TILE_ROUND_NUM 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_REFR_AREA_MERGE
+static void merge_areas(bool rounder);
+static uint32_t inv_random_areas(lv_disp_t * disp, lv_area_t * areas);
+static void mark_area(const lv_area_t * area, uint8_t inc, uint8_t flag);
+static void record_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void round_cb(lv_disp_drv_t * disp_drv, lv_area_t * area);
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max);
+#endif
+#if LV_USE_TILE_RENDER
+static void tiles_same_as_single(void);
+static void tiles_after_style_mod(void);
+static void tile_scene_create(void);
+static void tile_scene_delete(void);
+static void render_scene(bool tiles);
+static bool scene_caches_valid(void);
+static void count_tiles_cb(lv_disp_drv_t * disp_drv, uint32_t tile_cnt);
+#endif
+#if LV_USE_REFR_OCCLUSION
+static void occlusion(void);
+static lv_obj_t * occlusion_rect_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t size);
+static uint32_t occlusion_refr(lv_obj_t * cont);
+static lv_design_res_t victim_design_cb(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+#endif
+#if LV_MEM_BUF_ARENA_SIZE
+static void mem_buf_arena(void);
+static void mem_buf_arena_refr(void);
+static lv_design_res_t arena_design_cb(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_REFR_AREA_MERGE
+static uint32_t rnd_seed;
+static uint8_t px_map[TEST_REGION_SIZE * TEST_REGION_SIZE];
+static lv_area_t flushed_areas[TEST_FLUSH_MAX];
+static uint32_t flush_cnt;
+static void (*flush_cb_ori)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+#endif
+#if LV_USE_TILE_RENDER
+static lv_color_t single_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static void (*render_tiles_cb_ori)(lv_disp_drv_t * disp_drv, uint32_t tile_cnt);
+static uint32_t tile_cnt_max;
+static lv_obj_t * scr_ori;
+static lv_obj_t * scene_scr;
+static lv_obj_t * scene_rect;
+static lv_obj_t * scene_label;
+static lv_style_t scene_style;
+static uint8_t scene_img_data[TEST_TILE_IMG_W * TEST_TILE_IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t scene_img;
+static const char * scene_btnm_map[] = {"A", "B", "\n", "C", "D", "\n", "E", ""};
+#endif
+#if LV_USE_REFR_OCCLUSION
+static lv_design_cb_t victim_design_ori;
+static uint32_t victim_draw_cnt;
+#endif
+#if LV_MEM_BUF_ARENA_SIZE
+static uint32_t arena_draw_cnt;
+static uint32_t arena_err_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_refr tests");
+    lv_test_print("===================");
+
+#if LV_USE_REFR_AREA_MERGE
+    merge_areas(false);
+    merge_areas(true);
+#else
+    lv_test_print("SKIP: area merge test because it requires LV_USE_REFR_AREA_MERGE 1");
+#endif
+
+#if LV_USE_TILE_RENDER
+    tile_scene_create();
+    tiles_same_as_single();
+    tiles_after_style_mod();
+    tile_scene_delete();
+#else
+    lv_test_print("SKIP: tile render test because it requires LV_USE_TILE_RENDER 1");
+#endif
+
+#if LV_USE_REFR_OCCLUSION
+    occlusion();
+#else
+    lv_test_print("SKIP: occlusion test because it requires LV_USE_REFR_OCCLUSION 1");
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    mem_buf_arena();
+    mem_buf_arena_refr();
+#else
+    lv_test_print("SKIP: arena test because it requires LV_MEM_BUF_ARENA_SIZE > 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_REFR_AREA_MERGE
+
+/**
+ * Invalidate random overlapping and nested areas (sometimes more than `LV_INV_BUF_SIZE`),
+ * refresh the display and compare the flushed areas and the statistics with the invalidated areas.
+ * @param rounder true: round the areas to 8 pixels wide columns
+ */
+static void merge_areas(bool rounder)
+{
+    lv_test_print("");
+    if(rounder) {
+        lv_test_print("Merge the invalidated areas with rounder:");
+        lv_test_print("-----------------------------------------");
+    }
+    else {
+        lv_test_print("Merge the invalidated areas:");
+        lv_test_print("----------------------------");
+    }
+
+    lv_disp_t * disp = lv_disp_get_default();
+
+    /*Refresh the areas invalidated by the previous tests*/
+    lv_refr_now(disp);
+
+    flush_cb_ori = disp->driver.flush_cb;
+    disp->driver.flush_cb = record_flush_cb;
+    if(rounder) disp->driver.rounder_cb = round_cb;
+
+    rnd_seed = rounder ? 5678 : 8765;
+
+    uint32_t cover_err_cnt = 0;
+    uint32_t overlap_cnt = 0;
+    uint32_t stat_err_cnt = 0;
+    uint32_t overflow_cnt = 0;
+    uint32_t round;
+    for(round = 0; round < TEST_ROUND_NUM; round++) {
+        lv_area_t areas[LV_INV_BUF_SIZE * 2];
+        uint32_t area_num = inv_random_areas(disp, areas);
+        if(area_num > LV_INV_BUF_SIZE) overflow_cnt++;
+
+        flush_cnt = 0;
+        lv_refr_now(disp);
+
+        lv_refr_area_stat_t stat;
+        lv_refr_get_area_stat(&stat);
+
+        _lv_memset_00(px_map, sizeof(px_map));
+        uint32_t i;
+        for(i = 0; i < area_num; i++) mark_area(&areas[i], 0, TEST_PX_INV);
+
+        uint32_t flushed_px = 0;
+        for(i = 0; i < flush_cnt && i < TEST_FLUSH_MAX; i++) {
+            mark_area(&flushed_areas[i], 1, 0);
+            flushed_px += lv_area_get_size(&flushed_areas[i]);
+        }
+
+        uint32_t inv_px = 0;
+        for(i = 0; i < sizeof(px_map); i++) {
+            if(px_map[i] & TEST_PX_INV) {
+                inv_px++;
+                if((px_map[i] & TEST_PX_CNT_MASK) == 0) cover_err_cnt++;
+            }
+            if((px_map[i] & TEST_PX_CNT_MASK) > 1) overlap_cnt++;
+        }
+
+        if(flush_cnt > TEST_FLUSH_MAX) stat_err_cnt++;
+        if(stat.area_cnt != flush_cnt) stat_err_cnt++;
+        if(stat.px_drawn != flushed_px) stat_err_cnt++;
+        if(stat.px_drawn < stat.px_ideal) stat_err_cnt++;
+
+        /*The rounded and the merged areas are larger than the invalidated ones*/
+        if(rounder || area_num > LV_INV_BUF_SIZE) {
+            if(stat.px_ideal < inv_px) stat_err_cnt++;
+        }
+        else {
+            if(stat.px_ideal != inv_px) stat_err_cnt++;
+        }
+    }
+
+    disp->driver.flush_cb = flush_cb_ori;
+    disp->driver.rounder_cb = NULL;
+
+    lv_test_assert_int_gt(0, overflow_cnt, "rounds with more areas than LV_INV_BUF_SIZE");
+    lv_test_assert_int_eq(0, cover_err_cnt, "invalidated pixels which are not redrawn");
+    if(rounder == false) {
+        lv_test_assert_int_eq(0, overlap_cnt, "pixels redrawn more than once");
+    }
+    lv_test_assert_int_eq(0, stat_err_cnt, "wrong area statistics");
+}
+
+/**
+ * Invalidate random areas in the top left corner of the display.
+ * Some areas are placed inside or next to a previous one.
+ * @param disp pointer to the display
+ * @param areas store the invalidated areas here (max. `2 * LV_INV_BUF_SIZE`)
+ * @return number of invalidated areas
+ */
+static uint32_t inv_random_areas(lv_disp_t * disp, lv_area_t * areas)
+{
+    uint32_t area_num = rnd(1, LV_INV_BUF_SIZE * 2);
+    uint32_t i;
+    for(i = 0; i < area_num; i++) {
+        lv_area_t * a = &areas[i];
+        lv_coord_t type = i == 0 ? 0 : rnd(0, 3);
+        if(type == 1) {
+            /*Nested into a previous area*/
+            const lv_area_t * outer = &areas[rnd(0, (lv_coord_t)i - 1)];
+            a->x1 = rnd(outer->x1, outer->x2);
+            a->y1 = rnd(outer->y1, outer->y2);
+            a->x2 = rnd(a->x1, outer->x2);
+            a->y2 = rnd(a->y1, outer->y2);
+        }
+        else if(type == 2) {
+            /*Overlapping a previous area*/
+            const lv_area_t * other = &areas[rnd(0, (lv_coord_t)i - 1)];
+            a->x1 = rnd(other->x1, other->x2);
+            a->y1 = rnd(other->y1 - 10, other->y2);
+            a->x2 = a->x1 + rnd(0, TEST_REGION_SIZE / 2);
+            a->y2 = a->y1 + rnd(0, TEST_REGION_SIZE / 4);
+        }
+        else {
+            a->x1 = rnd(0, TEST_REGION_SIZE - 1);
+            a->y1 = rnd(0, TEST_REGION_SIZE - 1);
+            a->x2 = a->x1 + rnd(0, TEST_REGION_SIZE / 3);
+            a->y2 = a->y1 + rnd(0, TEST_REGION_SIZE / 3);
+        }
+
+        if(a->y1 < 0) a->y1 = 0;
+        if(a->x2 >= TEST_REGION_SIZE) a->x2 = TEST_REGION_SIZE - 1;
+        if(a->y2 >= TEST_REGION_SIZE) a->y2 = TEST_REGION_SIZE - 1;
+
+        _lv_inv_area(disp, a);
+    }
+
+    return area_num;
+}
+
+/**
+ * Mark the pixels of an area in `px_map`
+ * @param area pointer to an area. Only its part in the test region is marked.
+ * @param inc add this to the counter of the pixels
+ * @param flag OR this to the pixels
+ */
+static void mark_area(const lv_area_t * area, uint8_t inc, uint8_t flag)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = LV_MATH_MAX(area->y1, 0); y <= LV_MATH_MIN(area->y2, TEST_REGION_SIZE - 1); y++) {
+        uint8_t * px = &px_map[y * TEST_REGION_SIZE];
+        for(x = LV_MATH_MAX(area->x1, 0); x <= LV_MATH_MIN(area->x2, TEST_REGION_SIZE - 1); x++) {
+            if((px[x] & TEST_PX_CNT_MASK) != TEST_PX_CNT_MASK) px[x] += inc;
+            px[x] |= flag;
+        }
+    }
+}
+
+static void record_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    if(flush_cnt < TEST_FLUSH_MAX) lv_area_copy(&flushed_areas[flush_cnt], area);
+    flush_cnt++;
+
+    flush_cb_ori(disp_drv, area, color_p);
+}
+
+static void round_cb(lv_disp_drv_t * disp_drv, lv_area_t * area)
+{
+    LV_UNUSED(disp_drv);
+
+    area->x1 &= ~0x7;
+    area->x2 |= 0x7;
+
+    lv_coord_t max_x = lv_disp_get_hor_res(lv_disp_get_default()) - 1;
+    if(area->x2 > max_x) area->x2 = max_x;
+}
+
+/**
+ * A simple deterministic pseudo random number in the `min..max` range
+ */
+static lv_coord_t rnd(lv_coord_t min, lv_coord_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return min + (lv_coord_t)((rnd_seed >> 16) % (max - min + 1));
+}
+
+#endif
+
+#if LV_USE_TILE_RENDER
+
+/**
+ * Render a scene whose objects span all tiles and compare it with the single-threaded rendering
+ */
+static void tiles_same_as_single(void)
+{
+    lv_test_print("");
+    lv_test_print("Render the tiles in parallel:");
+    lv_test_print("-----------------------------");
+
+    extern lv_color_t test_fb[];
+
+    tile_cnt_max = 0;
+    render_scene(true);
+    lv_test_assert_int_gt(1, tile_cnt_max, "tiles handed to render_tiles_cb");
+    _lv_memcpy(single_fb, test_fb, sizeof(single_fb));
+
+    render_scene(false);
+    lv_test_assert_array_eq((uint8_t *)test_fb, (uint8_t *)single_fb, sizeof(single_fb), "tiles same as single-threaded");
+
+#if LV_IMG_CACHE_DEF_SIZE
+    uint32_t pin_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < LV_IMG_CACHE_DEF_SIZE; i++) {
+        const lv_img_cache_entry_t * entry = lv_img_cache_get_entry(i);
+        if(entry) pin_cnt += entry->pin_cnt;
+    }
+    lv_test_assert_int_eq(0, pin_cnt, "images left pinned after the tiles");
+#endif
+}
+
+/**
+ * Modify a style shared by the objects of the scene and let the tiles update the style caches at the same time.
+ * The workers shouldn't leave the caches invalid or ignored and the result should be the same as the
+ * single-threaded rendering.
+ */
+static void tiles_after_style_mod(void)
+{
+    lv_test_print("");
+    lv_test_print("Render the tiles after a style change:");
+    lv_test_print("--------------------------------------");
+
+    extern lv_color_t test_fb[];
+
+    uint32_t diff_cnt = 0;
+    uint32_t cache_err_cnt = 0;
+    uint32_t round;
+    for(round = 0; round < TEST_TILE_ROUND_NUM; round++) {
+        lv_style_set_bg_color(&scene_style, LV_STATE_DEFAULT, LV_COLOR_MAKE(round * 30, 0xFF - round * 30, 0x80));
+        lv_style_set_radius(&scene_style, LV_STATE_DEFAULT, round * 3);
+        lv_style_set_border_width(&scene_style, LV_STATE_DEFAULT, round & 0x1 ? 3 : 0);
+        lv_style_set_shadow_width(&scene_style, LV_STATE_DEFAULT, round & 0x2 ? 10 : 0);
+        lv_style_set_clip_corner(&scene_style, LV_STATE_DEFAULT, round & 0x4 ? true : false);
+        lv_style_set_text_letter_space(&scene_style, LV_STATE_DEFAULT, round & 0x1);
+        lv_obj_report_style_mod(&scene_style);
+
+        render_scene(true);
+        if(scene_caches_valid() == false) cache_err_cnt++;
+        _lv_memcpy(single_fb, test_fb, sizeof(single_fb));
+
+        render_scene(false);
+        if(memcmp(test_fb, single_fb, sizeof(single_fb))) diff_cnt++;
+    }
+
+    lv_test_assert_int_eq(0, cache_err_cnt, "rounds with invalid or ignored style caches");
+    lv_test_assert_int_eq(0, diff_cnt, "rounds different from the single-threaded rendering");
+}
+
+/**
+ * Create a screen with a shadowed rectangle, a long label, an image and a button matrix.
+ * All of them are taller than a tile.
+ */
+static void tile_scene_create(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    render_tiles_cb_ori = disp->driver.render_tiles_cb;
+    scr_ori = lv_disp_get_scr_act(disp);
+
+    scene_scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scene_scr);
+
+    lv_coord_t h = lv_disp_get_ver_res(disp);
+
+    lv_style_init(&scene_style);
+
+    scene_rect = lv_obj_create(scene_scr, NULL);
+    lv_obj_add_style(scene_rect, LV_OBJ_PART_MAIN, &scene_style);
+    lv_obj_set_pos(scene_rect, 20, 20);
+    lv_obj_set_size(scene_rect, 100, h - 40);
+
+    scene_label = lv_label_create(scene_scr, NULL);
+    lv_obj_add_style(scene_label, LV_LABEL_PART_MAIN, &scene_style);
+    lv_label_set_long_mode(scene_label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_pos(scene_label, 140, 10);
+    lv_obj_set_width(scene_label, 120);
+    lv_label_set_text(scene_label, "The tiles of the screen are rendered by more workers at the same time. "
+                      "They share the style caches, the image cache and the glyph cache, "
+                      "but every worker blends into its own rows of the display buffer. "
+                      "The result should be the same as if only one worker rendered the whole screen.");
+
+    /*A semi-transparent gradient with fully transparent and opaque columns*/
+    scene_img.header.always_zero = 0;
+    scene_img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    scene_img.header.w = TEST_TILE_IMG_W;
+    scene_img.header.h = TEST_TILE_IMG_H;
+    scene_img.data_size = sizeof(scene_img_data);
+    scene_img.data = scene_img_data;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < TEST_TILE_IMG_H; y++) {
+        for(x = 0; x < TEST_TILE_IMG_W; x++) {
+            lv_opa_t opa = x < 8 ? LV_OPA_TRANSP : x < 20 ? LV_OPA_COVER : (lv_opa_t)(y * 4);
+            lv_img_buf_set_px_color(&scene_img, x, y, LV_COLOR_MAKE(x * 8, y * 4, 0x80));
+            lv_img_buf_set_px_alpha(&scene_img, x, y, opa);
+        }
+    }
+
+    lv_obj_t * img = lv_img_create(scene_scr, NULL);
+    lv_img_set_src(img, &scene_img);
+    lv_obj_set_pos(img, 280, h / 2 - TEST_TILE_IMG_H / 2);
+
+    lv_obj_t * btnm = lv_btnmatrix_create(scene_scr, NULL);
+    lv_obj_add_style(btnm, LV_BTNMATRIX_PART_BTN, &scene_style);
+    lv_btnmatrix_set_map(btnm, scene_btnm_map);
+    lv_obj_set_pos(btnm, 330, 20);
+    lv_obj_set_size(btnm, 140, h - 40);
+}
+
+static void tile_scene_delete(void)
+{
+    lv_scr_load(scr_ori);
+    lv_obj_del(scene_scr);
+    lv_style_reset(&scene_style);
+    lv_img_cache_invalidate_src(&scene_img);
+}
+
+/**
+ * Redraw the whole screen
+ * @param tiles true: render the tiles in parallel; false: render the screen on the calling thread
+ */
+static void render_scene(bool tiles)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    disp->driver.render_tiles_cb = tiles ? count_tiles_cb : NULL;
+
+    lv_obj_invalidate(scene_scr);
+    lv_refr_now(disp);
+
+    disp->driver.render_tiles_cb = render_tiles_cb_ori;
+}
+
+/**
+ * Check the style caches of the parts using the shared style.
+ * The buttons of the button matrix are not checked because their caching is disabled while they are drawn.
+ * @return true: all caches are valid and not ignored
+ */
+static bool scene_caches_valid(void)
+{
+    const lv_style_list_t * lists[] = {
+        lv_obj_get_style_list(scene_rect, LV_OBJ_PART_MAIN),
+        lv_obj_get_style_list(scene_label, LV_LABEL_PART_MAIN),
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        if(lists[i]->valid_cache == 0 || lists[i]->ignore_cache) return false;
+    }
+
+    return true;
+}
+
+static void count_tiles_cb(lv_disp_drv_t * disp_drv, uint32_t tile_cnt)
+{
+    if(tile_cnt > tile_cnt_max) tile_cnt_max = tile_cnt;
+
+    render_tiles_cb_ori(disp_drv, tile_cnt);
+}
+
+#endif
+
+#if LV_USE_REFR_OCCLUSION
+
+/**
+ * Refresh an area with an object under other objects and check whether it's drawn.
+ * The area is larger than the objects on top so only the occlusion can skip the object.
+ */
+static void occlusion(void)
+{
+    lv_test_print("");
+    lv_test_print("Skip the objects hidden by opaque objects:");
+    lv_test_print("------------------------------------------");
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_reset_style_list(cont, LV_OBJ_PART_MAIN);
+    lv_obj_set_pos(cont, 20, 20);
+    lv_obj_set_size(cont, 120, 120);
+
+    lv_obj_t * victim = occlusion_rect_create(cont, 40, 40, 20);
+    victim_design_ori = lv_obj_get_design_cb(victim);
+    lv_obj_set_design_cb(victim, victim_design_cb);
+
+    lv_obj_t * rect = occlusion_rect_create(cont, 30, 30, 40);
+    lv_test_assert_int_eq(0, occlusion_refr(cont), "an object under an opaque object is not drawn");
+
+    lv_obj_move_background(rect);
+    lv_test_assert_int_gt(0, occlusion_refr(cont), "an object above an opaque object is drawn");
+    lv_obj_move_foreground(rect);
+
+    lv_obj_set_style_local_bg_opa(rect, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_test_assert_int_gt(0, occlusion_refr(cont), "an object under a semi-transparent object is drawn");
+    lv_obj_set_style_local_bg_opa(rect, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+
+    /*The shadow of the object is larger than the opaque object*/
+    lv_obj_set_style_local_shadow_width(victim, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 30);
+    lv_test_assert_int_gt(0, occlusion_refr(cont), "an object with a larger shadow is drawn");
+    lv_obj_set_style_local_shadow_width(victim, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+
+    /*The shadow of the opaque object doesn't hide anything*/
+    lv_obj_set_style_local_shadow_width(rect, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 30);
+    lv_obj_set_pos(victim, 72, 45);
+    lv_obj_set_size(victim, 10, 10);
+    lv_test_assert_int_gt(0, occlusion_refr(cont), "an object under the shadow of an opaque object is drawn");
+    lv_obj_del(rect);
+
+    /*The corners of a masking object clip its opaque child*/
+    lv_obj_t * masking = occlusion_rect_create(cont, 30, 30, 40);
+    lv_obj_set_style_local_radius(masking, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 15);
+    lv_obj_set_style_local_clip_corner(masking, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, true);
+    occlusion_rect_create(masking, 0, 0, 40);
+    lv_obj_set_pos(victim, 30, 30);
+    lv_obj_set_size(victim, 6, 6);
+    lv_test_assert_int_gt(0, occlusion_refr(cont), "an object under the masked corner of an opaque object is drawn");
+
+    /*Without masking the opaque child hides the objects between the corners*/
+    lv_obj_set_style_local_clip_corner(masking, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, false);
+    lv_obj_set_pos(victim, 47, 47);
+    lv_test_assert_int_eq(0, occlusion_refr(cont), "an object under the opaque child of a not masking object is not drawn");
+
+    lv_obj_del(cont);
+    lv_refr_now(NULL);
+}
+
+/**
+ * Create an opaque rectangle without theme styles
+ * @param parent pointer to the parent
+ * @param x x coordinate relative to the parent
+ * @param y y coordinate relative to the parent
+ * @param size width and height
+ * @return pointer to the new object
+ */
+static lv_obj_t * occlusion_rect_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t size)
+{
+    lv_obj_t * obj = lv_obj_create(parent, NULL);
+    lv_obj_reset_style_list(obj, LV_OBJ_PART_MAIN);
+    lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, size, size);
+
+    return obj;
+}
+
+/**
+ * Refresh a container and count how many times the victim object was drawn
+ * @param cont pointer to the container
+ * @return number of draws
+ */
+static uint32_t occlusion_refr(lv_obj_t * cont)
+{
+    lv_refr_now(NULL);
+
+    victim_draw_cnt = 0;
+    lv_obj_invalidate(cont);
+    lv_refr_now(NULL);
+
+    return victim_draw_cnt;
+}
+
+static lv_design_res_t victim_design_cb(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*The tiles might be drawn in parallel*/
+        _LV_WORKER_LOCK();
+        victim_draw_cnt++;
+        _LV_WORKER_UNLOCK();
+    }
+
+    return victim_design_ori(obj, clip_area, mode);
+}
+
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+
+/**
+ * Take and release temporary buffers directly and check the statistics of the arena
+ */
+static void mem_buf_arena(void)
+{
+    lv_test_print("");
+    lv_test_print("Take the temporary buffers from the arena:");
+    lv_test_print("------------------------------------------");
+
+    lv_mem_buf_arena_stat_t stat_prev;
+    lv_mem_buf_arena_stat_t stat;
+    lv_mem_buf_arena_get_stat(&stat_prev);
+    lv_test_assert_int_eq(0, stat_prev.used, "the arena is empty between the refreshes");
+
+    uint32_t mark = _lv_mem_buf_arena_get_mark();
+    uint8_t * buf1 = _lv_mem_buf_get(100);
+    uint8_t * buf2 = _lv_mem_buf_get(200);
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_true(stat.used >= 300, "the buffers are in the arena");
+    lv_test_assert_true(stat.max_used >= stat.used, "the high-water mark is above the used bytes");
+    lv_test_assert_int_eq(stat_prev.fallback_cnt, stat.fallback_cnt, "no fallback if the buffers fit");
+    uint32_t used = stat.used;
+
+    /*The arena is rewound only over the released buffers at its top*/
+    _lv_mem_buf_release(buf1);
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_int_eq(used, stat.used, "a released buffer below a used one is kept");
+
+    _lv_mem_buf_release(buf2);
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.used, "the arena is rewound over the released buffers");
+
+    /*The buffers which don't fit into the arena are allocated from the heap*/
+    buf1 = _lv_mem_buf_get(stat.total_size - 64);
+    buf2 = _lv_mem_buf_get(100);
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_true(buf2 != NULL, "the buffer is allocated from the heap");
+    lv_test_assert_int_eq(stat_prev.fallback_cnt + 1, stat.fallback_cnt, "fallback if the arena is full");
+    lv_test_assert_true(stat.max_used >= stat.total_size - 64, "the high-water mark of the full arena");
+    _lv_mem_buf_release(buf2);
+
+    /*The buffers not released by a draw are dropped after the area*/
+    _lv_mem_buf_arena_rewind(mark);
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.used, "the arena is rewound to the mark");
+
+    /*Free the buffer allocated from the heap*/
+    _lv_mem_buf_free_all();
+}
+
+/**
+ * Fill the arena while an object is drawn and check the statistics after the refresh
+ */
+static void mem_buf_arena_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("Use the arena while refreshing:");
+    lv_test_print("-------------------------------");
+
+    /*It's lower than 2 tiles so it's drawn by the calling thread*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_reset_style_list(obj, LV_OBJ_PART_MAIN);
+    lv_obj_set_pos(obj, 10, 10);
+    lv_obj_set_size(obj, 20, 20);
+    lv_obj_set_design_cb(obj, arena_design_cb);
+    lv_refr_now(NULL);
+
+    lv_mem_buf_arena_stat_t stat_prev;
+    lv_mem_buf_arena_stat_t stat;
+    lv_mem_buf_arena_get_stat(&stat_prev);
+
+    arena_draw_cnt = 0;
+    arena_err_cnt = 0;
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    lv_mem_buf_arena_get_stat(&stat);
+    lv_test_assert_int_gt(0, arena_draw_cnt, "the object is drawn");
+    lv_test_assert_int_eq(0, arena_err_cnt, "the arena is used while drawing");
+    lv_test_assert_int_eq(stat_prev.fallback_cnt + arena_draw_cnt, stat.fallback_cnt, "fallback while drawing");
+    lv_test_assert_true(stat.max_used >= stat.total_size - 64, "the high-water mark after the refresh");
+    lv_test_assert_int_eq(0, stat.used, "the arena is empty after the refresh");
+
+    lv_obj_del(obj);
+    lv_refr_now(NULL);
+}
+
+/**
+ * Fill the arena and take one more buffer from the heap
+ */
+static lv_design_res_t arena_design_cb(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(clip_area);
+
+    if(mode == LV_DESIGN_COVER_CHK) return LV_DESIGN_RES_NOT_COVER;
+    if(mode != LV_DESIGN_DRAW_MAIN) return LV_DESIGN_RES_OK;
+
+    arena_draw_cnt++;
+
+    lv_mem_buf_arena_stat_t stat;
+    lv_mem_buf_arena_get_stat(&stat);
+    uint32_t used = stat.used;
+    uint32_t size = stat.total_size - used - 64;
+
+    uint8_t * buf1 = _lv_mem_buf_get(size);
+    uint8_t * buf2 = _lv_mem_buf_get(100);
+    lv_mem_buf_arena_get_stat(&stat);
+    if(buf2 == NULL || stat.used < used + size || stat.max_used < stat.used) arena_err_cnt++;
+
+    _lv_mem_buf_release(buf2);
+    _lv_mem_buf_release(buf1);
+
+    return LV_DESIGN_RES_OK;
+}
+
+#endif
+
+#endif
@@ -15,6 +15,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define TEST_INDEX_STATE_MAX    8
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +29,20 @@ static void add_remove_read_prop(void);
 static void cascade(void);
 static void copy(void);
 static void states(void);
+static void flat_cache(void);
+static void prop_lookup(void);
+static void lookup_set(lv_style_t * style, lv_state_t state, lv_style_int_t value);
+static bool lookup_remove(lv_style_t * style, lv_state_t state);
+static uint32_t lookup_check(const lv_style_t * style);
 static void mem_leak(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*The expected `LV_STYLE_PAD_TOP` states and values of the property lookup test*/
+static lv_state_t lookup_states[TEST_INDEX_STATE_MAX];
+static lv_style_int_t lookup_values[TEST_INDEX_STATE_MAX];
+static uint32_t lookup_cnt;
 
 /**********************
  *      MACROS
@@ -54,6 +64,8 @@ void lv_test_style(void)
     cascade();
     copy();
     states();
+    flat_cache();
+    prop_lookup();
     mem_leak();
 }
 
@@ -410,6 +422,245 @@ static void states(void)
     _lv_style_list_reset(&style_list);
 }
 
+/**
+ * Read the properties of objects before and after each change which should drop them from the flat cache.
+ * The same values should be read with and without `LV_USE_STYLE_FLAT_CACHE`.
+ */
+static void flat_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Test the flat style cache of the objects:");
+    lv_test_print("-----------------------------------------");
+
+    /*Use only the test styles, no theme styles and transitions*/
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * child = lv_obj_create(parent1, NULL);
+    lv_obj_reset_style_list(parent1, LV_OBJ_PART_MAIN);
+    lv_obj_reset_style_list(parent2, LV_OBJ_PART_MAIN);
+    lv_obj_reset_style_list(child, LV_OBJ_PART_MAIN);
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, LV_STATE_DEFAULT, LV_COLOR_RED);
+    lv_style_set_bg_color(&style, LV_STATE_PRESSED, LV_COLOR_GREEN);
+    lv_obj_add_style(parent1, LV_OBJ_PART_MAIN, &style);
+    lv_obj_add_style(child, LV_OBJ_PART_MAIN, &style);
+
+    lv_style_t style_inherit;
+    lv_style_init(&style_inherit);
+    lv_style_set_text_letter_space(&style_inherit, LV_STATE_DEFAULT, 3);
+    lv_style_set_text_letter_space(&style_inherit, LV_STATE_PRESSED, 4);
+    lv_obj_add_style(parent1, LV_OBJ_PART_MAIN, &style_inherit);
+
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Read a property");
+#if LV_USE_STYLE_FLAT_CACHE
+    lv_style_value_t v;
+    lv_style_list_t * list = lv_obj_get_style_list(child, LV_OBJ_PART_MAIN);
+    lv_test_assert_int_eq(LV_RES_OK, _lv_style_list_get_flat(list, LV_STYLE_BG_COLOR, &v), "The read property is cached");
+#endif
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Read it again");
+
+    lv_obj_set_style_local_bg_color(child, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+    lv_test_assert_color_eq(LV_COLOR_BLUE, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Set a local property");
+    lv_obj_remove_style_local_prop(child, LV_OBJ_PART_MAIN, LV_STYLE_BG_COLOR);
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Remove a local property");
+
+    lv_obj_add_state(child, LV_STATE_PRESSED);
+    lv_test_assert_color_eq(LV_COLOR_GREEN, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Add a state");
+    lv_obj_clear_state(child, LV_STATE_PRESSED);
+    lv_test_assert_color_eq(LV_COLOR_RED, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Clear a state");
+
+    lv_style_set_bg_color(&style, LV_STATE_DEFAULT, LV_COLOR_YELLOW);
+    lv_obj_report_style_mod(&style);
+    lv_test_assert_color_eq(LV_COLOR_YELLOW, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Report a modified style");
+
+    lv_test_assert_int_eq(3, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Read an inherited property");
+    lv_obj_set_style_local_text_letter_space(parent1, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 5);
+    lv_test_assert_int_eq(5, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Set the inherited property on the parent");
+
+    lv_obj_add_state(parent1, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(4, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Add a state to the parent");
+    lv_obj_clear_state(parent1, LV_STATE_PRESSED);
+    lv_test_assert_int_eq(5, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Clear the state of the parent");
+
+    lv_obj_set_parent(child, parent2);
+    lv_test_assert_int_eq(0, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Move to a new parent");
+    lv_obj_set_style_local_text_letter_space(parent2, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 6);
+    lv_test_assert_int_eq(6, lv_obj_get_style_text_letter_space(child, LV_OBJ_PART_MAIN), "Set the inherited property on the new parent");
+    lv_test_assert_color_eq(LV_COLOR_YELLOW, lv_obj_get_style_bg_color(child, LV_OBJ_PART_MAIN), "Read a not inherited property after moving");
+
+    /*Clean up*/
+    lv_obj_del(parent1);
+    lv_obj_del(parent2);
+    lv_style_reset(&style);
+    lv_style_reset(&style_inherit);
+}
+
+/**
+ * Read a property in every state combination from a style with more states of it and other properties.
+ * With `LV_USE_STYLE_INDEX` the first read indexes the style and adding or removing properties drops the index
+ * so the results should be the same as without the index.
+ */
+static void prop_lookup(void)
+{
+    lv_test_print("");
+    lv_test_print("Look up the properties of a style:");
+    lv_test_print("----------------------------------");
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lookup_cnt = 0;
+
+    /*Mix the states and the other properties*/
+    _lv_style_set_int(&style, LV_STYLE_RADIUS, 3);
+    lookup_set(&style, LV_STATE_PRESSED, 2);
+    _lv_style_set_color(&style, LV_STYLE_TEXT_COLOR, LV_COLOR_RED);
+    lookup_set(&style, LV_STATE_DEFAULT, 1);
+    _lv_style_set_opa(&style, LV_STYLE_BG_OPA | (LV_STATE_PRESSED << LV_STYLE_STATE_POS), LV_OPA_40);
+    lookup_set(&style, LV_STATE_FOCUSED | LV_STATE_PRESSED, 4);
+    _lv_style_set_ptr(&style, LV_STYLE_TEXT_FONT, LV_THEME_DEFAULT_FONT_NORMAL);
+    lookup_set(&style, LV_STATE_FOCUSED, 3);
+
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states of a property");
+#if LV_USE_STYLE_INDEX
+    lv_test_assert_true(style.index != NULL, "the style is indexed by the first read");
+#endif
+
+    lv_style_int_t value;
+    lv_color_t color;
+    lv_opa_t opa;
+    const void * ptr;
+    lv_test_assert_int_eq(0, _lv_style_get_int(&style, LV_STYLE_RADIUS, &value), "read an other int property");
+    lv_test_assert_int_eq(3, value, "value of an other int property");
+    lv_test_assert_int_eq(0, _lv_style_get_color(&style, LV_STYLE_TEXT_COLOR, &color), "read a color property");
+    lv_test_assert_color_eq(LV_COLOR_RED, color, "value of a color property");
+    lv_test_assert_int_eq(-1, _lv_style_get_opa(&style, LV_STYLE_BG_OPA, &opa), "an opa property not in this state");
+    lv_test_assert_int_eq(LV_STATE_PRESSED, _lv_style_get_opa(&style,
+                                                              LV_STYLE_BG_OPA | (LV_STATE_PRESSED << LV_STYLE_STATE_POS), &opa),
+                          "read an opa property in a state");
+    lv_test_assert_int_eq(LV_OPA_40, opa, "value of an opa property");
+    lv_test_assert_int_eq(0, _lv_style_get_ptr(&style, LV_STYLE_TEXT_FONT, &ptr), "read a pointer property");
+    lv_test_assert_ptr_eq(LV_THEME_DEFAULT_FONT_NORMAL, ptr, "value of a pointer property");
+    lv_test_assert_int_eq(-1, _lv_style_get_int(&style, LV_STYLE_PAD_BOTTOM, &value), "a missing property");
+
+    /*Add properties after the first read*/
+    lookup_set(&style, LV_STATE_HOVERED, 5);
+    _lv_style_set_int(&style, LV_STYLE_PAD_BOTTOM, 9);
+#if LV_USE_STYLE_INDEX
+    lv_test_assert_true(style.index == NULL, "adding a property drops the index");
+#endif
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states after adding one");
+    lv_test_assert_int_eq(0, _lv_style_get_int(&style, LV_STYLE_PAD_BOTTOM, &value), "read an added property");
+    lv_test_assert_int_eq(9, value, "value of an added property");
+
+    /*Change a value in place*/
+    lookup_set(&style, LV_STATE_PRESSED, 12);
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states after changing one");
+
+    /*Remove properties*/
+    lv_test_assert_true(lookup_remove(&style, LV_STATE_PRESSED), "remove a state of a property");
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states after removing one");
+    lv_test_assert_true(lookup_remove(&style, LV_STATE_PRESSED) == false, "remove a removed state");
+    lv_test_assert_true(lookup_remove(&style, LV_STATE_CHECKED) == false, "remove a missing state");
+    lv_test_assert_true(lv_style_remove_prop(&style, LV_STYLE_PAD_BOTTOM), "remove a property");
+    lv_test_assert_int_eq(-1, _lv_style_get_int(&style, LV_STYLE_PAD_BOTTOM, &value), "read a removed property");
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states after removing an other property");
+
+    /*The copy has the same properties and it's independent of the original*/
+    lv_style_t style_copy;
+    lv_style_init(&style_copy);
+    lv_style_copy(&style_copy, &style);
+    lv_test_assert_int_eq(0, lookup_check(&style_copy), "read the states of a copy");
+
+    _lv_style_set_int(&style_copy, LV_STYLE_PAD_TOP, 100);
+    _lv_style_set_int(&style_copy, LV_STYLE_PAD_BOTTOM, 101);
+    lv_test_assert_int_eq(0, lookup_check(&style), "read the states of the original after changing the copy");
+    lv_test_assert_int_eq(-1, _lv_style_get_int(&style, LV_STYLE_PAD_BOTTOM, &value), "no new property in the original");
+
+    lv_style_reset(&style_copy);
+    lv_style_reset(&style);
+}
+
+/**
+ * Set `LV_STYLE_PAD_TOP` in a state in a style and in the expected states
+ * @param style pointer to a style
+ * @param state the state of the property
+ * @param value the new value
+ */
+static void lookup_set(lv_style_t * style, lv_state_t state, lv_style_int_t value)
+{
+    _lv_style_set_int(style, LV_STYLE_PAD_TOP | (state << LV_STYLE_STATE_POS), value);
+
+    uint32_t i;
+    for(i = 0; i < lookup_cnt; i++) {
+        if(lookup_states[i] == state) break;
+    }
+    if(i == lookup_cnt) {
+        if(lookup_cnt >= TEST_INDEX_STATE_MAX) return;
+        lookup_cnt++;
+    }
+
+    lookup_states[i] = state;
+    lookup_values[i] = value;
+}
+
+/**
+ * Remove `LV_STYLE_PAD_TOP` in a state from a style and from the expected states
+ * @param style pointer to a style
+ * @param state the state of the property
+ * @return the result of `lv_style_remove_prop()`
+ */
+static bool lookup_remove(lv_style_t * style, lv_state_t state)
+{
+    uint32_t i;
+    for(i = 0; i < lookup_cnt; i++) {
+        if(lookup_states[i] == state) {
+            lookup_cnt--;
+            lookup_states[i] = lookup_states[lookup_cnt];
+            lookup_values[i] = lookup_values[lookup_cnt];
+            break;
+        }
+    }
+
+    return lv_style_remove_prop(style, LV_STYLE_PAD_TOP | (state << LV_STYLE_STATE_POS));
+}
+
+/**
+ * Read `LV_STYLE_PAD_TOP` in every state combination and compare it with the expected states:
+ * the same state or else the highest state without other states than the requested.
+ * @param style pointer to a style
+ * @return number of wrong results
+ */
+static uint32_t lookup_check(const lv_style_t * style)
+{
+    uint32_t err_cnt = 0;
+    uint32_t state;
+    for(state = 0; state <= 0x3F; state++) {
+        int32_t weight_exp = -1;
+        lv_style_int_t value_exp = 0;
+        uint32_t i;
+        for(i = 0; i < lookup_cnt; i++) {
+            if(lookup_states[i] == state) {
+                weight_exp = state;
+                value_exp = lookup_values[i];
+                break;
+            }
+            if((lookup_states[i] & (~state)) == 0 && lookup_states[i] > weight_exp) {
+                weight_exp = lookup_states[i];
+                value_exp = lookup_values[i];
+            }
+        }
+
+        lv_style_int_t value = 0;
+        int16_t weight = _lv_style_get_int(style, LV_STYLE_PAD_TOP | (state << LV_STYLE_STATE_POS), &value);
+        if(weight != weight_exp) err_cnt++;
+        else if(weight >= 0 && value != value_exp) err_cnt++;
+    }
+
+    return err_cnt;
+}
+
 static void mem_leak(void)
 {
 
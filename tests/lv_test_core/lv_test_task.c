@@ -0,0 +1,225 @@
+/**
+ * @file lv_test_task.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_task.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_TASK_NUM   4
+#define TEST_LOG_SIZE   16
+#define TEST_PERIOD     10000   /*Long enough to run the tasks only when they are made ready*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void run_by_prio(void);
+static void set_prio_while_running(void);
+static void del_while_running(void);
+static void run_all(void);
+static void log_cb(lv_task_t * task);
+static void set_prio_cb(lv_task_t * task);
+static void del_cb(lv_task_t * task);
+static void del_self_cb(lv_task_t * task);
+static bool task_exists(lv_task_t * task);
+static uint32_t task_count(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_task_t * tasks[TEST_TASK_NUM];
+static uint8_t run_log[TEST_LOG_SIZE];
+static uint32_t run_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_task(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_task tests");
+    lv_test_print("===================");
+
+    run_by_prio();
+    set_prio_while_running();
+    del_while_running();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void run_by_prio(void)
+{
+    lv_test_print("");
+    lv_test_print("Run the ready tasks by priority:");
+    lv_test_print("--------------------------------");
+
+    tasks[0] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_LOW, (void *)0);
+    tasks[1] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_HIGHEST, (void *)1);
+    tasks[2] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_MID, (void *)2);
+    tasks[3] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_HIGH, (void *)3);
+
+    run_all();
+    static const uint8_t order[] = {1, 3, 2, 0};
+    lv_test_assert_int_eq(sizeof(order), run_cnt, "every task ran once");
+    lv_test_assert_array_eq(order, run_log, sizeof(order), "the higher priority runs first");
+
+    run_cnt = 0;
+    lv_task_handler();
+    lv_test_assert_int_eq(0, run_cnt, "no task is ready again");
+
+    lv_test_print("Turn off a task");
+    lv_task_set_prio(tasks[3], LV_TASK_PRIO_OFF);
+    run_all();
+    static const uint8_t order_off[] = {1, 2, 0};
+    lv_test_assert_int_eq(sizeof(order_off), run_cnt, "the turned off task doesn't run");
+    lv_test_assert_array_eq(order_off, run_log, sizeof(order_off), "order without the turned off task");
+
+    uint32_t i;
+    for(i = 0; i < TEST_TASK_NUM; i++) lv_task_del(tasks[i]);
+}
+
+static void set_prio_while_running(void)
+{
+    lv_test_print("");
+    lv_test_print("Change the priorities in a task:");
+    lv_test_print("--------------------------------");
+
+    /* Task 1 lowers the priority of task 0 which already ran and raises task 3's.
+     * Task 0 shouldn't run again and task 3 should run before task 2.*/
+    tasks[0] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_HIGHEST, (void *)0);
+    tasks[1] = lv_task_create(set_prio_cb, TEST_PERIOD, LV_TASK_PRIO_HIGH, (void *)1);
+    tasks[2] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_MID, (void *)2);
+    tasks[3] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_LOWEST, (void *)3);
+
+    run_all();
+    static const uint8_t order[] = {0, 1, 3, 2};
+    lv_test_assert_int_eq(sizeof(order), run_cnt, "every task ran once");
+    lv_test_assert_array_eq(order, run_log, sizeof(order), "the new priorities are used");
+
+    /*In the next round the new priorities are used from the beginning*/
+    lv_task_set_cb(tasks[1], log_cb);
+    run_all();
+    static const uint8_t order_next[] = {3, 1, 2, 0};
+    lv_test_assert_int_eq(sizeof(order_next), run_cnt, "every task ran once again");
+    lv_test_assert_array_eq(order_next, run_log, sizeof(order_next), "order in the next round");
+
+    uint32_t i;
+    for(i = 0; i < TEST_TASK_NUM; i++) lv_task_del(tasks[i]);
+}
+
+static void del_while_running(void)
+{
+    lv_test_print("");
+    lv_test_print("Delete tasks in a task:");
+    lv_test_print("-----------------------");
+
+    /* Task 1 deletes task 0 which already ran and task 2 which didn't run yet.
+     * Task 3 deletes itself.*/
+    uint32_t cnt_prev = task_count();
+    tasks[0] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_HIGHEST, (void *)0);
+    tasks[1] = lv_task_create(del_cb, TEST_PERIOD, LV_TASK_PRIO_HIGH, (void *)1);
+    tasks[2] = lv_task_create(log_cb, TEST_PERIOD, LV_TASK_PRIO_MID, (void *)2);
+    tasks[3] = lv_task_create(del_self_cb, TEST_PERIOD, LV_TASK_PRIO_LOW, (void *)3);
+
+    run_all();
+    static const uint8_t order[] = {0, 1, 3};
+    lv_test_assert_int_eq(sizeof(order), run_cnt, "the deleted task didn't run");
+    lv_test_assert_array_eq(order, run_log, sizeof(order), "order with deleted tasks");
+    lv_test_assert_true(task_exists(tasks[1]), "the deleting task exists");
+    lv_test_assert_int_eq(cnt_prev + 1, task_count(), "the deleted tasks are removed");
+
+    lv_task_set_cb(tasks[1], log_cb);
+    run_all();
+    lv_test_assert_int_eq(1, run_cnt, "only the remaining task runs");
+
+    lv_task_del(tasks[1]);
+}
+
+/**
+ * Make the test tasks ready and call `lv_task_handler()`
+ */
+static void run_all(void)
+{
+    uint32_t i;
+    for(i = 0; i < TEST_TASK_NUM; i++) {
+        if(tasks[i]) lv_task_ready(tasks[i]);
+    }
+
+    run_cnt = 0;
+    lv_task_handler();
+}
+
+static void log_cb(lv_task_t * task)
+{
+    if(run_cnt < TEST_LOG_SIZE) run_log[run_cnt] = (uint8_t)(lv_uintptr_t)task->user_data;
+    run_cnt++;
+}
+
+static void set_prio_cb(lv_task_t * task)
+{
+    log_cb(task);
+    lv_task_set_prio(tasks[0], LV_TASK_PRIO_LOWEST);
+    lv_task_set_prio(tasks[3], LV_TASK_PRIO_HIGHEST);
+}
+
+static void del_cb(lv_task_t * task)
+{
+    log_cb(task);
+    lv_task_del(tasks[0]);
+    lv_task_del(tasks[2]);
+    tasks[0] = NULL;
+    tasks[2] = NULL;
+}
+
+static void del_self_cb(lv_task_t * task)
+{
+    log_cb(task);
+    lv_task_del(task);
+    tasks[3] = NULL;
+}
+
+static bool task_exists(lv_task_t * task)
+{
+    lv_task_t * t = lv_task_get_next(NULL);
+    while(t) {
+        if(t == task) return true;
+        t = lv_task_get_next(t);
+    }
+
+    return false;
+}
+
+static uint32_t task_count(void)
+{
+    uint32_t cnt = 0;
+    lv_task_t * t = lv_task_get_next(NULL);
+    while(t) {
+        cnt++;
+        t = lv_task_get_next(t);
+    }
+
+    return cnt;
+}
+
+#endif
@@ -3,17 +3,25 @@
 #include <stdlib.h>
 #include "lv_test_core/lv_test_core.h"
 #include "lv_test_widgets/lv_test_label.h"
+#include "lv_test_widgets/lv_test_canvas.h"
 
 #if LV_BUILD_TEST
 #include <sys/time.h>
 
 static void hal_init(void);
+#if LV_USE_TILE_RENDER
+static void worker_init(void);
+#endif
 static void dummy_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 
 lv_color_t test_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
 
 int main(void)
 {
+#if LV_USE_TILE_RENDER
+    worker_init();
+#endif
+
     printf("Call lv_init...\n");
     lv_init();
 
@@ -21,6 +29,7 @@ int main(void)
 
     lv_test_core();
     lv_test_label();
+    lv_test_canvas();
 
     printf("Exit with success!\n");
     return 0;
@@ -83,6 +92,61 @@ static bool ready_cb(struct _lv_fs_drv_t * drv)
 }
 #endif
 
+#if LV_USE_TILE_RENDER
+static _Thread_local uint32_t worker_id;
+static pthread_mutex_t worker_mutex;
+
+uint32_t lv_test_worker_id(void)
+{
+    return worker_id;
+}
+
+void lv_test_worker_lock(void)
+{
+    pthread_mutex_lock(&worker_mutex);
+}
+
+void lv_test_worker_unlock(void)
+{
+    pthread_mutex_unlock(&worker_mutex);
+}
+
+static void * worker_thread(void * p)
+{
+    worker_id = (uint32_t)(uintptr_t)p;
+    lv_refr_tile(worker_id);
+    return NULL;
+}
+
+/*The lock is used by `lv_init()` too so create it first*/
+static void worker_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&worker_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+/*Render the first tile on the calling thread and the others on new threads*/
+static void render_tiles_cb(lv_disp_drv_t * disp_drv, uint32_t tile_cnt)
+{
+    (void) disp_drv;
+
+    pthread_t threads[LV_TILE_RENDER_WORKER_NUM];
+    uint32_t i;
+    for(i = 1; i < tile_cnt; i++) {
+        pthread_create(&threads[i], NULL, worker_thread, (void *)(uintptr_t)i);
+    }
+
+    lv_refr_tile(0);
+
+    for(i = 1; i < tile_cnt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+#endif
+
 static void hal_init(void)
 {
     static lv_disp_buf_t disp_buf;
@@ -94,6 +158,9 @@ static void hal_init(void)
     lv_disp_drv_init(&disp_drv);
     disp_drv.buffer = &disp_buf;
     disp_drv.flush_cb = dummy_flush_cb;
+#if LV_USE_TILE_RENDER
+    disp_drv.render_tiles_cb = render_tiles_cb;
+#endif
     lv_disp_drv_register(&disp_drv);
 
 #if LV_USE_FILESYSTEM
@@ -142,4 +209,15 @@ uint32_t custom_tick_get(void)
     return time_ms;
 }
 
+uint32_t custom_time_us(void)
+{
+    static uint64_t start_us = 0;
+    struct timeval tv_now;
+    gettimeofday(&tv_now, NULL);
+    uint64_t now_us = (uint64_t)tv_now.tv_sec * 1000000 + tv_now.tv_usec;
+    if(start_us == 0) start_us = now_us;
+
+    return (uint32_t)(now_us - start_us);
+}
+
 #endif
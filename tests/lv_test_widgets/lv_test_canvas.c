@@ -0,0 +1,195 @@
+/**
+ * @file lv_test_canvas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_canvas.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_CANVAS_X       50
+#define TEST_CANVAS_Y       50
+#define TEST_CANVAS_SIZE    20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_CANVAS
+static void redraw_argb(void);
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+static void file_same_as_variable(void);
+static void get_screen_area(uint32_t * buf);
+#endif
+static uint32_t get_screen_px(lv_coord_t x, lv_coord_t y);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_canvas(void)
+{
+    lv_test_print("");
+    lv_test_print("=====================");
+    lv_test_print("Start lv_canvas tests");
+    lv_test_print("=====================");
+
+#if LV_USE_CANVAS
+    redraw_argb();
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+    file_same_as_variable();
+#endif
+#else
+    lv_test_print("Skip canvas test: LV_USE_CANVAS == 0");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_CANVAS
+
+/**
+ * Draw on an ARGB canvas after it was shown. The new content should be shown,
+ * not the content the image cache saw the first time.
+ */
+static void redraw_argb(void)
+{
+    lv_test_print("");
+    lv_test_print("Redraw an ARGB canvas");
+    lv_test_print("---------------------------");
+
+    static lv_color_t cbuf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(TEST_CANVAS_SIZE, TEST_CANVAS_SIZE)];
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, cbuf, TEST_CANVAS_SIZE, TEST_CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_obj_set_pos(canvas, TEST_CANVAS_X, TEST_CANVAS_Y);
+
+    lv_canvas_fill_bg(canvas, LV_COLOR_RED, LV_OPA_COVER);
+    uint32_t px_red = get_screen_px(TEST_CANVAS_X + TEST_CANVAS_SIZE / 2, TEST_CANVAS_Y + TEST_CANVAS_SIZE / 2);
+
+    lv_canvas_fill_bg(canvas, LV_COLOR_BLUE, LV_OPA_COVER);
+    uint32_t px_blue = get_screen_px(TEST_CANVAS_X + TEST_CANVAS_SIZE / 2, TEST_CANVAS_Y + TEST_CANVAS_SIZE / 2);
+
+    lv_test_assert_int_eq(lv_color_to32(LV_COLOR_RED) & 0xFFFFFF, px_red, "first color of the canvas");
+    lv_test_assert_int_eq(lv_color_to32(LV_COLOR_BLUE) & 0xFFFFFF, px_blue, "redrawn color of the canvas");
+
+    lv_obj_del(canvas);
+}
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+/**
+ * Save an ARGB canvas to a file and show it with an image.
+ * The mapped file is drawn from the runs of the image cache (if enabled) and should look the same.
+ */
+static void file_same_as_variable(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw the ARGB canvas from a file");
+    lv_test_print("---------------------------");
+
+    static const char path[] = "P:lv_test_canvas.bin";
+    static lv_color_t cbuf[LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(TEST_CANVAS_SIZE, TEST_CANVAS_SIZE)];
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas, cbuf, TEST_CANVAS_SIZE, TEST_CANVAS_SIZE, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_obj_set_pos(canvas, TEST_CANVAS_X, TEST_CANVAS_Y);
+
+    /*Semi-transparent background with an opaque rectangle and a transparent stripe*/
+    lv_canvas_fill_bg(canvas, LV_COLOR_GREEN, LV_OPA_50);
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = LV_COLOR_RED;
+    lv_canvas_draw_rect(canvas, 2, 2, TEST_CANVAS_SIZE - 4, TEST_CANVAS_SIZE / 2, &rect_dsc);
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < TEST_CANVAS_SIZE; y++) {
+        for(x = TEST_CANVAS_SIZE / 2; x < TEST_CANVAS_SIZE / 2 + 3; x++) lv_img_buf_set_px_alpha(dsc, x, y, LV_OPA_TRANSP);
+    }
+
+    static uint32_t ref_px[TEST_CANVAS_SIZE * TEST_CANVAS_SIZE];
+    get_screen_area(ref_px);
+
+    lv_fs_file_t f;
+    uint32_t bw;
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR), "open the image file for write");
+    lv_fs_write(&f, &dsc->header, sizeof(lv_img_header_t), &bw);
+    lv_fs_write(&f, dsc->data, lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf), &bw);
+    lv_fs_close(&f);
+
+    lv_obj_set_hidden(canvas, true);
+    lv_obj_t * img = lv_img_create(lv_scr_act(), NULL);
+    lv_img_set_src(img, path);
+    lv_obj_set_pos(img, TEST_CANVAS_X, TEST_CANVAS_Y);
+
+    static uint32_t act_px[TEST_CANVAS_SIZE * TEST_CANVAS_SIZE];
+    get_screen_area(act_px);
+
+    lv_test_assert_array_eq((uint8_t *)ref_px, (uint8_t *)act_px, sizeof(ref_px), "pixels of the image file");
+
+    lv_obj_del(img);
+    lv_obj_del(canvas);
+    lv_img_cache_invalidate_src(path);
+    lv_fs_remove(path);
+}
+
+/**
+ * Refresh the whole screen and get the pixels under the canvas
+ * @param buf store the pixels here as 32 bit RGB
+ */
+static void get_screen_area(uint32_t * buf)
+{
+    get_screen_px(0, 0);
+
+    extern lv_color_t test_fb[];
+    lv_coord_t hor_res = lv_disp_get_hor_res(lv_disp_get_default());
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < TEST_CANVAS_SIZE; y++) {
+        for(x = 0; x < TEST_CANVAS_SIZE; x++) {
+            lv_color_t c = test_fb[(TEST_CANVAS_Y + y) * hor_res + TEST_CANVAS_X + x];
+            buf[y * TEST_CANVAS_SIZE + x] = lv_color_to32(c) & 0xFFFFFF;
+        }
+    }
+}
+#endif
+
+/**
+ * Refresh the whole screen and get a pixel of the frame buffer
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @return the color of the pixel as 32 bit RGB
+ */
+static uint32_t get_screen_px(lv_coord_t x, lv_coord_t y)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    extern lv_color_t test_fb[];
+    return lv_color_to32(test_fb[y * lv_disp_get_hor_res(disp) + x]) & 0xFFFFFF;
+}
+
+#endif
+
+#endif
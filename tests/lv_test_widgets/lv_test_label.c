@@ -24,6 +24,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+static void letter_pos(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -46,6 +47,7 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+    letter_pos();
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -66,4 +68,47 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+
+static void letter_pos(void)
+{
+    lv_test_print("");
+    lv_test_print("Find the letters of a multi-line label");
+    lv_test_print("---------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, 100);
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog.\nLine 2\n\nThe last line");
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t txt_h = lv_obj_get_height(label) - lv_obj_get_style_pad_top(label, LV_LABEL_PART_MAIN) -
+                       lv_obj_get_style_pad_bottom(label, LV_LABEL_PART_MAIN);
+
+    lv_point_t p;
+    lv_label_get_letter_pos(label, 0, &p);
+    lv_test_assert_int_eq(0, p.y, "First letter in the first line");
+
+    uint32_t last = _lv_txt_get_encoded_length(lv_label_get_text(label)) - 1;
+    lv_label_get_letter_pos(label, last, &p);
+    lv_test_assert_int_eq(txt_h - lv_font_get_line_height(font), p.y, "Last letter in the last line");
+
+    uint32_t i;
+    bool ok = true;
+    for(i = 0; i <= last; i++) {
+        lv_label_get_letter_pos(label, i, &p);
+        p.x++;
+        p.y++;
+        if(lv_label_get_letter_on(label, &p) != i) ok = false;
+    }
+    lv_test_assert_true(ok, "Get the letters back from their positions");
+
+    /*The positions should follow the width change*/
+    lv_label_get_letter_pos(label, last, &p);
+    lv_coord_t y_ori = p.y;
+    lv_obj_set_width(label, 50);
+    lv_label_get_letter_pos(label, last, &p);
+    lv_test_assert_int_gt(y_ori, p.y, "Last letter is lower in a narrower label");
+
+    lv_obj_del(label);
+}
 #endif